@@ -13,6 +13,11 @@ macro(SetGlobalCompilerAndLinkerSettings)
         message(STATUS "Platform is 32-bit")
     endif(CMAKE_SIZEOF_VOID_P EQUAL 8)
 
+    # without tracing the FC_TRACE_SCOPE macro expands to nothing
+    if(NOT FREECAD_USE_TRACING)
+        add_definitions(-DFC_NO_TRACING)
+    endif(NOT FREECAD_USE_TRACING)
+
     # check for mips64 platform
     if("${CMAKE_SYSTEM_PROCESSOR}" STREQUAL "mips64")
         message(STATUS "Architecture: mips64")
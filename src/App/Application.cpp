@@ -86,6 +86,7 @@
 #include <Base/QuantityPy.h>
 #include <Base/UnitPy.h>
 #include <Base/TypePy.h>
+#include <Base/Trace.h>
 
 #include "GeoFeature.h"
 #include "FeatureTest.h"
@@ -113,6 +114,7 @@
 #include "OriginFeature.h"
 #include "Origin.h"
 #include "MaterialObject.h"
+#include "MemorySampler.h"
 #include "TextDocument.h"
 #include "ExpressionParser.h"
 #include "Transactions.h"
@@ -1590,6 +1592,21 @@ void Application::cleanupUnits()
 
 void Application::destruct(void)
 {
+    MemorySampler::stop();
+
+    // writing the trace of the session
+    std::map<std::string,std::string>::iterator it = mConfig.find("TraceFile");
+    if (it != mConfig.end()) {
+        try {
+            std::size_t count = Base::Trace::saveChromeTrace(it->second);
+            Console().Log("Saved %lu trace events to %s\n",
+                          static_cast<unsigned long>(count), it->second.c_str());
+        }
+        catch (const Base::Exception& e) {
+            Console().Error("%s\n", e.what());
+        }
+    }
+
     // saving system parameter
     Console().Log("Saving system parameter...\n");
     _pcSysParamMngr->SaveDocument();
@@ -2097,6 +2114,7 @@ void parseProgramOptions(int ac, char ** av, const string& exe, variables_map& v
     //("write-log,l", value<string>(), "write a log file")
     ("write-log,l", descr.str().c_str())
     ("log-file", value<string>(), "Unlike --write-log this allows logging to an arbitrary file")
+    ("trace-file", value<string>(), "Writes a trace of the main operations in Chrome trace format to the file on exit")
     ("user-cfg,u", value<string>(),"User config file to load/save user settings")
     ("system-cfg,s", value<string>(),"System config file to load/save system settings")
     ("run-test,t",   value<string>()   ,"Test case - or 0 for all")
@@ -2305,6 +2323,10 @@ void processProgramOptions(const variables_map& vm, std::map<std::string,std::st
         mConfig["LoggingFileName"] = vm["log-file"].as<string>();
     }
 
+    if (vm.count("trace-file")) {
+        mConfig["TraceFile"] = vm["trace-file"].as<string>();
+    }
+
     if (vm.count("user-cfg")) {
         mConfig["UserParameter"] = vm["user-cfg"].as<string>();
     }
@@ -2433,6 +2455,10 @@ void Application::initConfig(int argc, char ** argv)
     else
         _pConsoleObserverFile = 0;
 
+    // tracing Init ===========================================================
+    if (mConfig.find("TraceFile") != mConfig.end())
+        Base::Trace::setEnabled(true);
+
     // Banner ===========================================================
     if (!(mConfig["RunMode"] == "Cmd")) {
         // Remove banner if FreeCAD is invoked via the -c command as regular
@@ -2548,6 +2574,11 @@ void Application::initApplication(void)
     int denom = hGrp->GetInt("FracInch", Base::QuantityFormat::getDefaultDenominator());
     Base::QuantityFormat::setDefaultDenominator(denom);
 
+    // choose the parser to read project files
+    hGrp = App::GetApplication().GetParameterGroupByPath
+       ("User parameter:BaseApp/Preferences/Document");
+    Base::XMLReader::setDefaultParser(hGrp->GetBool("PullXMLParser", false) ?
+        Base::XMLReader::PullParser : Base::XMLReader::XercesParser);
 
 #if defined (_DEBUG)
     Console().Log("Application is built with debug information\n");
@@ -503,6 +503,7 @@ private:
     // static python wrapper of the exported functions
     static PyObject* sGetParam          (PyObject *self,PyObject *args);
     static PyObject* sSaveParameter     (PyObject *self,PyObject *args);
+    static PyObject* sGetParameterLookups(PyObject *self,PyObject *args);
     static PyObject* sGetVersion        (PyObject *self,PyObject *args);
     static PyObject* sGetConfig         (PyObject *self,PyObject *args);
     static PyObject* sSetConfig         (PyObject *self,PyObject *args);
@@ -522,6 +523,15 @@ private:
 
     static PyObject* sLoadFile          (PyObject *self,PyObject *args);
     static PyObject* sOpenDocument      (PyObject *self,PyObject *args, PyObject *kwd);
+    static PyObject* sSetXMLParser      (PyObject *self,PyObject *args);
+    static PyObject* sGetXMLParser      (PyObject *self,PyObject *args);
+    static PyObject* sSetTracing        (PyObject *self,PyObject *args);
+    static PyObject* sGetTracing        (PyObject *self,PyObject *args);
+    static PyObject* sClearTrace        (PyObject *self,PyObject *args);
+    static PyObject* sGetTraceEvents    (PyObject *self,PyObject *args);
+    static PyObject* sSaveTrace         (PyObject *self,PyObject *args);
+    static PyObject* sSetMemorySampling (PyObject *self,PyObject *args);
+    static PyObject* sGetMemorySampling (PyObject *self,PyObject *args);
     static PyObject* sSaveDocument      (PyObject *self,PyObject *args);
     static PyObject* sSaveDocumentAs    (PyObject *self,PyObject *args);
     static PyObject* sNewDocument       (PyObject *self,PyObject *args, PyObject *kwd);
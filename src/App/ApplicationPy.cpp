@@ -40,11 +40,15 @@
 #include <Base/Interpreter.h>
 #include <Base/Exception.h>
 #include <Base/Parameter.h>
+#include <Base/Reader.h>
 #include <Base/Console.h>
 #include <Base/Factory.h>
 #include <Base/FileInfo.h>
 #include <Base/UnitsApi.h>
 #include <Base/Sequencer.h>
+#include <Base/Trace.h>
+
+#include "MemorySampler.h"
 
 //using Base::GetConsole;
 using namespace Base;
@@ -62,6 +66,11 @@ PyMethodDef Application::Methods[] = {
     {"saveParameter",  (PyCFunction) Application::sSaveParameter, METH_VARARGS,
      "saveParameter(config='User parameter') -> None\n"
      "Save parameter set to file. The default set is 'User parameter'"},
+    {"getParameterLookups", (PyCFunction) Application::sGetParameterLookups, METH_VARARGS,
+     "getParameterLookups(reset=False) -> (int, int)\n"
+     "Returns the number of lookups of single parameter values and how many\n"
+     "of them had to search the XML tree because the value wasn't cached.\n"
+     "If reset is True the counters are set to zero afterwards."},
     {"Version",        (PyCFunction) Application::sGetVersion, METH_VARARGS,
      "Print the version to the output."},
     {"ConfigGet",      (PyCFunction) Application::sGetConfig, METH_VARARGS,
@@ -117,6 +126,40 @@ PyMethodDef Application::Methods[] = {
      "          or the file cannot be loaded an I/O exception is thrown.\n"
      "          In this case the document is kept alive.\n"
      "hidden: whether to hide document 3D view."},
+    {"setXMLParser",   (PyCFunction) Application::sSetXMLParser, METH_VARARGS,
+     "setXMLParser(string) -> None\n\n"
+     "Set the parser used to read project files, either 'Xerces' for the\n"
+     "validating SAX parser or 'Pull' for the fast in-memory parser."},
+    {"getXMLParser",   (PyCFunction) Application::sGetXMLParser, METH_VARARGS,
+     "getXMLParser() -> string\n\n"
+     "Return the parser used to read project files."},
+    {"setTracing",     (PyCFunction) Application::sSetTracing, METH_VARARGS,
+     "setTracing(bool) -> None\n\n"
+     "Switch the recording of the main operations (recompute, save, restore,\n"
+     "solver, boolean operations and tessellation) on or off."},
+    {"getTracing",     (PyCFunction) Application::sGetTracing, METH_VARARGS,
+     "getTracing() -> bool\n\n"
+     "Return whether the main operations are recorded."},
+    {"clearTrace",     (PyCFunction) Application::sClearTrace, METH_VARARGS,
+     "clearTrace() -> None\n\n"
+     "Discard the recorded operations."},
+    {"getTraceEvents", (PyCFunction) Application::sGetTraceEvents, METH_VARARGS,
+     "getTraceEvents() -> list\n\n"
+     "Return the recorded operations ordered by their start as tuples of\n"
+     "(category, name, detail, thread, start, duration), the times in seconds."},
+    {"saveTrace",      (PyCFunction) Application::sSaveTrace, METH_VARARGS,
+     "saveTrace(filename) -> int\n\n"
+     "Write the recorded operations in Chrome trace format that can be viewed\n"
+     "with chrome://tracing or Perfetto and return their number."},
+    {"setMemorySampling", (PyCFunction) Application::sSetMemorySampling, METH_VARARGS,
+     "setMemorySampling(interval, [filename]) -> None\n\n"
+     "Record the memory usage of the open documents at most every interval\n"
+     "seconds after a recompute, a transaction or the opening or closing of a\n"
+     "document. The samples are appended as JSON lines to the file or written\n"
+     "to the log. An interval of 0 stops the sampling."},
+    {"getMemorySampling", (PyCFunction) Application::sGetMemorySampling, METH_VARARGS,
+     "getMemorySampling() -> tuple or None\n\n"
+     "Return (interval, filename) of the memory sampling or None if it's off."},
 //  {"saveDocument",   (PyCFunction) Application::sSaveDocument, METH_VARARGS,
 //   "saveDocument(string) -- Save the document to a file."},
 //  {"saveDocumentAs", (PyCFunction) Application::sSaveDocumentAs, METH_VARARGS},
@@ -267,6 +310,131 @@ PyObject* Application::sOpenDocument(PyObject * /*self*/, PyObject *args, PyObje
     }
 }
 
+PyObject* Application::sSetXMLParser(PyObject * /*self*/, PyObject *args)
+{
+    char* name;
+    if (!PyArg_ParseTuple(args, "s", &name))
+        return NULL;
+
+    if (strcmp(name, "Xerces") == 0) {
+        Base::XMLReader::setDefaultParser(Base::XMLReader::XercesParser);
+    }
+    else if (strcmp(name, "Pull") == 0) {
+        Base::XMLReader::setDefaultParser(Base::XMLReader::PullParser);
+    }
+    else {
+        PyErr_Format(PyExc_ValueError, "Unknown XML parser '%s', use 'Xerces' or 'Pull'", name);
+        return NULL;
+    }
+
+    Py_Return;
+}
+
+PyObject* Application::sGetXMLParser(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    if (Base::XMLReader::defaultParser() == Base::XMLReader::PullParser)
+        return Py::new_reference_to(Py::String("Pull"));
+    return Py::new_reference_to(Py::String("Xerces"));
+}
+
+PyObject* Application::sSetTracing(PyObject * /*self*/, PyObject *args)
+{
+    PyObject *on;
+    if (!PyArg_ParseTuple(args, "O!", &PyBool_Type, &on))
+        return NULL;
+
+    Base::Trace::setEnabled(PyObject_IsTrue(on) ? true : false);
+    Py_Return;
+}
+
+PyObject* Application::sGetTracing(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    return Py::new_reference_to(Py::Boolean(Base::Trace::isEnabled()));
+}
+
+PyObject* Application::sClearTrace(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    Base::Trace::clear();
+    Py_Return;
+}
+
+PyObject* Application::sGetTraceEvents(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    PY_TRY {
+        std::vector<Base::Trace::Event> events = Base::Trace::getEvents();
+        Py::List list;
+        for (const auto &ev : events) {
+            Py::Tuple tuple(6);
+            tuple.setItem(0, Py::String(ev.category));
+            tuple.setItem(1, Py::String(ev.name));
+            tuple.setItem(2, Py::String(ev.detail));
+            tuple.setItem(3, Py::Long(static_cast<unsigned long>(ev.thread)));
+            tuple.setItem(4, Py::Float(ev.begin * 1e-9));
+            tuple.setItem(5, Py::Float(ev.duration * 1e-9));
+            list.append(tuple);
+        }
+        return Py::new_reference_to(list);
+    } PY_CATCH;
+}
+
+PyObject* Application::sSaveTrace(PyObject * /*self*/, PyObject *args)
+{
+    char *fileName;
+    if (!PyArg_ParseTuple(args, "et", "utf-8", &fileName))
+        return NULL;
+
+    std::string utf8Name = fileName;
+    PyMem_Free(fileName);
+
+    PY_TRY {
+        std::size_t count = Base::Trace::saveChromeTrace(utf8Name);
+        return Py::new_reference_to(Py::Long(static_cast<unsigned long>(count)));
+    } PY_CATCH;
+}
+
+PyObject* Application::sSetMemorySampling(PyObject * /*self*/, PyObject *args)
+{
+    double interval;
+    char *fileName = 0;
+    if (!PyArg_ParseTuple(args, "d|et", &interval, "utf-8", &fileName))
+        return NULL;
+
+    std::string utf8Name;
+    if (fileName) {
+        utf8Name = fileName;
+        PyMem_Free(fileName);
+    }
+
+    MemorySampler::start(interval, utf8Name);
+    Py_Return;
+}
+
+PyObject* Application::sGetMemorySampling(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    if (!MemorySampler::isActive())
+        Py_Return;
+
+    Py::Tuple tuple(2);
+    tuple.setItem(0, Py::Float(MemorySampler::getInterval()));
+    tuple.setItem(1, Py::String(MemorySampler::getFileName()));
+    return Py::new_reference_to(tuple);
+}
+
 PyObject* Application::sNewDocument(PyObject * /*self*/, PyObject *args, PyObject *kwd)
 {
     char *docName = 0;
@@ -436,6 +604,20 @@ PyObject* Application::sSaveParameter(PyObject * /*self*/, PyObject *args)
     }PY_CATCH;
 }
 
+PyObject* Application::sGetParameterLookups(PyObject * /*self*/, PyObject *args)
+{
+    PyObject *reset = Py_False;
+    if (!PyArg_ParseTuple(args, "|O!", &PyBool_Type, &reset))
+        return NULL;
+
+    Py::Tuple tuple(2);
+    tuple.setItem(0, Py::Long(ParameterGrp::GetLookupCount()));
+    tuple.setItem(1, Py::Long(ParameterGrp::GetDOMLookupCount()));
+    if (PyObject_IsTrue(reset))
+        ParameterGrp::ResetLookupCounts();
+    return Py::new_reference_to(tuple);
+}
+
 
 PyObject* Application::sGetConfig(PyObject * /*self*/, PyObject *args)
 {
@@ -112,6 +112,7 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include <Base/Tools.h>
 #include <Base/Uuid.h>
 #include <Base/Sequencer.h>
+#include <Base/Trace.h>
 
 #ifdef _MSC_VER
 #include <zipios++/zipios-config.h>
@@ -184,7 +185,7 @@ struct DocumentP
     bool opentransaction;
     std::bitset<32> StatusBits;
     int iUndoMode;
-    unsigned int UndoMemSize;
+    unsigned int UndoMemLimit;
     unsigned int UndoMaxStackSize;
     std::string programVersion;
 #ifdef USE_OLD_DAG
@@ -194,6 +195,10 @@ struct DocumentP
 #endif //USE_OLD_DAG
     std::multimap<const App::DocumentObject*,
         std::unique_ptr<App::DocumentObjectExecReturn> > _RecomputeLog;
+    // sorted dependency list of all objects, see getSortedDependencyList()
+    std::vector<DocumentObject*> depListCache;
+    unsigned long depListRevision;
+    int depListOptions;
 
     DocumentP() {
         static std::random_device _RD;
@@ -214,8 +219,10 @@ struct DocumentP
         StatusBits.set((size_t)Document::KeepTrailingDigits, true);
         StatusBits.set((size_t)Document::Restoring, false);
         iUndoMode = 0;
-        UndoMemSize = 0;
+        UndoMemLimit = 0;
         UndoMaxStackSize = 20;
+        depListRevision = 0;
+        depListOptions = -1;
     }
 
     void addRecomputeLog(const char *why, App::DocumentObject *obj) {
@@ -256,6 +263,7 @@ struct DocumentP
     topologicalSort(const std::vector<App::DocumentObject*>& objects) const;
     std::vector<App::DocumentObject*>
     static partialTopologicalSort(const std::vector<App::DocumentObject*>& objects);
+    const std::vector<App::DocumentObject*> &getSortedDependencyList(int options);
 };
 
 } // namespace App
@@ -1243,6 +1251,14 @@ void Document::_commitTransaction(bool notify)
             delete mUndoTransactions.front();
             mUndoTransactions.pop_front();
         }
+        // the memory limit keeps at least the last transaction
+        if(d->UndoMemLimit) {
+            while(mUndoTransactions.size() > 1 && getUndoMemSize() > d->UndoMemLimit) {
+                mUndoMap.erase(mUndoTransactions.front()->getID());
+                delete mUndoTransactions.front();
+                mUndoTransactions.pop_front();
+            }
+        }
         signalCommitTransaction(*this);
 
         // closeActiveTransaction() may call again _commitTransaction()
@@ -1439,12 +1455,24 @@ int Document::getUndoMode(void) const
 
 unsigned int Document::getUndoMemSize (void) const
 {
-    return d->UndoMemSize;
+    std::uint64_t size = 0;
+    for (auto transaction : mUndoTransactions)
+        size += transaction->getMemSize();
+    for (auto transaction : mRedoTransactions)
+        size += transaction->getMemSize();
+    if (d->activeUndoTransaction)
+        size += d->activeUndoTransaction->getMemSize();
+    return clampMemSize(size);
 }
 
 void Document::setUndoLimit(unsigned int UndoMemSize)
 {
-    d->UndoMemSize = UndoMemSize;
+    d->UndoMemLimit = UndoMemSize;
+}
+
+unsigned int Document::getUndoLimit(void) const
+{
+    return d->UndoMemLimit;
 }
 
 void Document::setMaxUndoStackSize(unsigned int UndoMaxStackSize)
@@ -1702,13 +1730,13 @@ void Document::Save (Base::Writer &writer) const
                     << App::Application::Config()["BuildVersionMajor"] << "."
                     << App::Application::Config()["BuildVersionMinor"] << "R"
                     << App::Application::Config()["BuildRevision"]
-                    << "\" FileVersion=\"" << writer.getFileVersion() << "\">" << endl;
+                    << "\" FileVersion=\"" << writer.getFileVersion() << "\">" << '\n';
 
     PropertyContainer::Save(writer);
 
     // writing the features types
     writeObjects(d->objectArray, writer);
-    writer.Stream() << "</Document>" << endl;
+    writer.Stream() << "</Document>" << '\n';
 }
 
 void Document::Restore(Base::XMLReader &reader)
@@ -1841,19 +1869,19 @@ void Document::exportObjects(const std::vector<App::DocumentObject*>& obj, std::
 
     Base::ZipWriter writer(out);
     writer.putNextEntry("Document.xml");
-    writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl;
+    writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << '\n';
     writer.Stream() << "<Document SchemaVersion=\"4\" ProgramVersion=\""
                         << App::Application::Config()["BuildVersionMajor"] << "."
                         << App::Application::Config()["BuildVersionMinor"] << "R"
                         << App::Application::Config()["BuildRevision"]
-                        << "\" FileVersion=\"1\">" << endl;
+                        << "\" FileVersion=\"1\">" << '\n';
     // Add this block to have the same layout as for normal documents
-    writer.Stream() << "<Properties Count=\"0\">" << endl;
-    writer.Stream() << "</Properties>" << endl;
+    writer.Stream() << "<Properties Count=\"0\">" << '\n';
+    writer.Stream() << "</Properties>" << '\n';
 
     // writing the object types
     writeObjects(obj, writer);
-    writer.Stream() << "</Document>" << endl;
+    writer.Stream() << "</Document>" << '\n';
 
     // Hook for others to add further data.
     signalExportObjects(obj, writer);
@@ -1877,7 +1905,7 @@ void Document::writeObjects(const std::vector<App::DocumentObject*>& obj,
     writer.Stream() << writer.ind() << "<Objects Count=\"" << obj.size();
     if(!isExporting(0))
         writer.Stream() << "\" " FC_ATTR_DEPENDENCIES "=\"1";
-    writer.Stream() << "\">" << endl;
+    writer.Stream() << "\">" << '\n';
 
     writer.incInd(); // indentation for 'Object type'
 
@@ -1889,21 +1917,21 @@ void Document::writeObjects(const std::vector<App::DocumentObject*>& obj,
                 << "<" FC_ELEMENT_OBJECT_DEPS " " FC_ATTR_DEP_OBJ_NAME "=\""
                 << o->getNameInDocument() << "\" " FC_ATTR_DEP_COUNT "=\"" << outList.size();
             if(outList.empty()) {
-                writer.Stream() << "\"/>" << endl;
+                writer.Stream() << "\"/>" << '\n';
                 continue;
             }
             int partial = o->canLoadPartial();
             if(partial>0)
                 writer.Stream() << "\" " FC_ATTR_DEP_ALLOW_PARTIAL << "=\"" << partial;
-            writer.Stream() << "\">" << endl;
+            writer.Stream() << "\">" << '\n';
             writer.incInd();
             for(auto dep : outList) {
                 auto name = dep?dep->getNameInDocument():"";
                 writer.Stream() << writer.ind() << "<" FC_ELEMENT_OBJECT_DEP " "
-                    FC_ATTR_DEP_OBJ_NAME "=\"" << (name?name:"") << "\"/>" << endl;
+                    FC_ATTR_DEP_OBJ_NAME "=\"" << (name?name:"") << "\"/>" << '\n';
             }
             writer.decInd();
-            writer.Stream() << writer.ind() << "</" FC_ELEMENT_OBJECT_DEPS ">" << endl;
+            writer.Stream() << writer.ind() << "</" FC_ELEMENT_OBJECT_DEPS ">" << '\n';
         }
     }
 
@@ -1928,14 +1956,14 @@ void Document::writeObjects(const std::vector<App::DocumentObject*>& obj,
             if(desc)
                 writer.Stream() << "Error=\"" << Property::encodeAttribute(desc) << "\" ";
         }
-        writer.Stream() << "/>" << endl;
+        writer.Stream() << "/>" << '\n';
     }
 
     writer.decInd();  // indentation for 'Object type'
-    writer.Stream() << writer.ind() << "</Objects>" << endl;
+    writer.Stream() << writer.ind() << "</Objects>" << '\n';
 
     // writing the features itself
-    writer.Stream() << writer.ind() << "<ObjectData Count=\"" << obj.size() <<"\">" << endl;
+    writer.Stream() << writer.ind() << "<ObjectData Count=\"" << obj.size() <<"\">" << '\n';
 
     writer.incInd(); // indentation for 'Object name'
     for (it = obj.begin(); it != obj.end(); ++it) {
@@ -1943,13 +1971,13 @@ void Document::writeObjects(const std::vector<App::DocumentObject*>& obj,
         if((*it)->hasExtensions())
             writer.Stream() << " Extensions=\"True\"";
 
-        writer.Stream() << ">" << endl;
+        writer.Stream() << ">" << '\n';
         (*it)->Save(writer);
-        writer.Stream() << writer.ind() << "</Object>" << endl;
+        writer.Stream() << writer.ind() << "</Object>" << '\n';
     }
 
     writer.decInd(); // indentation for 'Object name'
-    writer.Stream() << writer.ind() << "</ObjectData>" << endl;
+    writer.Stream() << writer.ind() << "</ObjectData>" << '\n';
     writer.decInd();  // indentation for 'Objects count'
 }
 
@@ -2214,7 +2242,12 @@ Document::importObjects(Base::XMLReader& reader)
 
 unsigned int Document::getMemSize (void) const
 {
-    unsigned int size = 0;
+    return clampMemSize(getMemoryUsage());
+}
+
+std::uint64_t Document::getMemoryUsage (void) const
+{
+    std::uint64_t size = 0;
 
     // size of the DocObjects in the document
     std::vector<DocumentObject*>::const_iterator it;
@@ -2592,6 +2625,7 @@ private:
 
 bool Document::saveToFile(const char* filename) const
 {
+    FC_TRACE_SCOPE("App", "save", getName());
     signalStartSave(*this, filename);
 
     auto hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
@@ -2634,11 +2668,12 @@ bool Document::saveToFile(const char* filename) const
 
         if (hGrp->GetBool("SaveBinaryBrep", false))
             writer.setMode("BinaryBrep");
+        writer.setShortestFloats(hGrp->GetBool("ShortestFloats", false));
 
-        writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl
-                        << "<!--" << endl
-                        << " FreeCAD Document, see https://www.freecadweb.org for more information..." << endl
-                        << "-->" << endl;
+        writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << '\n'
+                        << "<!--" << '\n'
+                        << " FreeCAD Document, see https://www.freecadweb.org for more information..." << '\n'
+                        << "-->" << '\n';
         Document::Save(writer);
 
         // Special handling for Gui document.
@@ -2694,6 +2729,7 @@ bool Document::isAnyRestoring() {
 void Document::restore (const char *filename,
         bool delaySignal, const std::vector<std::string> &objNames)
 {
+    FC_TRACE_SCOPE("App", "restore", getName());
     clearUndos();
     d->activeObject = 0;
 
@@ -2819,7 +2855,8 @@ bool Document::afterRestore(const std::vector<DocumentObject *> &objArray, bool
     }
 
     std::set<DocumentObject*> objSet(objArray.begin(),objArray.end());
-    auto objs = getDependencyList(objArray.empty()?d->objectArray:objArray,DepSort);
+    auto objs = objArray.empty() ? d->getSortedDependencyList(0)
+                                 : getDependencyList(objArray,DepSort);
     for (auto obj : objs) {
         if(objSet.find(obj)==objSet.end())
             continue;
@@ -3115,15 +3152,11 @@ static void _buildDependencyList(const std::vector<App::DocumentObject*> &object
     }
 }
 
-std::vector<App::DocumentObject*> Document::getDependencyList(
-    const std::vector<App::DocumentObject*>& objectArray, int options)
+// Sorts the dependency list of the given objects, returns false if there is a
+// cyclic dependency and the list is only partially sorted.
+static bool _sortDependencyList(const std::vector<App::DocumentObject*>& objectArray,
+        int options, std::vector<App::DocumentObject*> &ret)
 {
-    std::vector<App::DocumentObject*> ret;
-    if(!(options & DepSort)) {
-        _buildDependencyList(objectArray,options,&ret,0,0);
-        return ret;
-    }
-
     DependencyList depList;
     std::map<DocumentObject*,Vertex> objectMap;
     std::map<Vertex,DocumentObject*> vertexMap;
@@ -3184,14 +3217,47 @@ std::vector<App::DocumentObject*> Document::getDependencyList(
         FC_ERR(e.what());
         ret = DocumentP::partialTopologicalSort(objectArray);
         std::reverse(ret.begin(),ret.end());
-        return ret;
+        return false;
     }
 
+    ret.reserve(make_order.size());
     for (std::list<Vertex>::reverse_iterator i = make_order.rbegin();i != make_order.rend(); ++i)
         ret.push_back(vertexMap[*i]);
+    return true;
+}
+
+std::vector<App::DocumentObject*> Document::getDependencyList(
+    const std::vector<App::DocumentObject*>& objectArray, int options)
+{
+    std::vector<App::DocumentObject*> ret;
+    if(!(options & DepSort)) {
+        _buildDependencyList(objectArray,options,&ret,0,0);
+        return ret;
+    }
+    _sortDependencyList(objectArray,options,ret);
     return ret;
 }
 
+// The sorted dependency list of all objects is needed on every recompute of
+// the document. It is only rebuilt if a link has changed or an object has been
+// added or removed since the last call. A partial order caused by a cyclic
+// dependency is not cached, so that the error is reported again.
+const std::vector<App::DocumentObject*> &DocumentP::getSortedDependencyList(int options)
+{
+    options |= Document::DepSort;
+    unsigned long revision = DocumentObject::getDependencyRevision();
+    if (depListOptions == options && depListRevision == revision)
+        return depListCache;
+
+    depListCache.clear();
+    depListOptions = -1;
+    if (_sortDependencyList(objectArray, options, depListCache)) {
+        depListOptions = options;
+        depListRevision = revision;
+    }
+    return depListCache;
+}
+
 std::vector<App::Document*> Document::getDependentDocuments(bool sort) {
     return getDependentDocuments({this},sort);
 }
@@ -3452,6 +3518,7 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     d->clearRecomputeLog();
 
     FC_TIME_INIT(t);
+    FC_TRACE_SCOPE("App", "recompute", getName());
 
     Base::ObjectStatusLocker<Document::Status, Document> exe(Document::Recomputing, this);
     signalBeforeRecompute(*this);
@@ -3475,7 +3542,8 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     }
     std::reverse(topoSortedObjects.begin(),topoSortedObjects.end());
 #else
-    auto topoSortedObjects = getDependencyList(objs.empty()?d->objectArray:objs,DepSort|options);
+    auto topoSortedObjects = objs.empty() ? d->getSortedDependencyList(options)
+                                          : getDependencyList(objs,DepSort|options);
 #endif
     for(auto obj : topoSortedObjects)
         obj->setStatus(ObjectStatus::PendingRecompute,true);
@@ -3688,9 +3756,12 @@ std::vector<App::DocumentObject*> DocumentP::topologicalSort(const std::vector<A
 {
     // topological sort algorithm described here:
     // https://de.wikipedia.org/wiki/Topologische_Sortierung#Algorithmus_f.C3.BCr_das_Topologische_Sortieren
+    // The objects with an input degree of zero are kept in a queue, so that
+    // each object and link is visited only once.
     vector < App::DocumentObject* > ret;
     ret.reserve(objects.size());
-    map < App::DocumentObject*,int > countMap;
+    std::unordered_map < App::DocumentObject*,int > countMap;
+    std::deque < App::DocumentObject* > roots;
 
     for (auto objectIt : objects) {
         // We now support externally linked objects
@@ -3702,36 +3773,30 @@ std::vector<App::DocumentObject*> DocumentP::topologicalSort(const std::vector<A
         std::sort(in.begin(), in.end());
         in.erase(std::unique(in.begin(), in.end()), in.end());
 
-        countMap[objectIt] = in.size();
+        if (countMap.emplace(objectIt, in.size()).second && in.empty())
+            roots.push_back(objectIt);
     }
 
-    auto rootObjeIt = find_if(countMap.begin(), countMap.end(), [](pair < App::DocumentObject*, int > count)->bool {
-        return count.second == 0;
-    });
-
-    if (rootObjeIt == countMap.end()){
+    if (roots.empty()){
         cerr << "Document::topologicalSort: cyclic dependency detected (no root object)" << endl;
         return ret;
     }
 
-    while (rootObjeIt != countMap.end()){
-        rootObjeIt->second = rootObjeIt->second - 1;
+    while (!roots.empty()){
+        auto root = roots.front();
+        roots.pop_front();
 
         //we need outlist with unique entries
-        auto out = rootObjeIt->first->getOutList();
+        auto out = root->getOutList();
         std::sort(out.begin(), out.end());
         out.erase(std::unique(out.begin(), out.end()), out.end());
 
         for (auto outListIt : out) {
             auto outListMapIt = countMap.find(outListIt);
-            if (outListMapIt != countMap.end())
-                outListMapIt->second = outListMapIt->second - 1;
+            if (outListMapIt != countMap.end() && --outListMapIt->second == 0)
+                roots.push_back(outListIt);
         }
-        ret.push_back(rootObjeIt->first);
-
-        rootObjeIt = find_if(countMap.begin(), countMap.end(), [](pair < App::DocumentObject*, int > count)->bool {
-            return count.second == 0;
-        });
+        ret.push_back(root);
     }
 
     return ret;
@@ -3751,6 +3816,7 @@ const char * Document::getErrorDescription(const App::DocumentObject*Obj) const
 int Document::_recomputeFeature(DocumentObject* Feat)
 {
     FC_LOG("Recomputing " << Feat->getFullName());
+    FC_TRACE_SCOPE("App", "execute", Feat->getNameInDocument());
 
     DocumentObjectExecReturn  *returnCode = 0;
     try {
@@ -3865,6 +3931,7 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName,
     d->objectIdMap[pcObject->_Id] = pcObject;
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    DocumentObject::_touchDependencies();
     // insert in the vector
     d->objectArray.push_back(pcObject);
     // insert in the adjacence list and reference through the ConectionMap
@@ -3967,6 +4034,7 @@ std::vector<DocumentObject *> Document::addObjects(const char* sType, const std:
         d->objectIdMap[pcObject->_Id] = pcObject;
         // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
         pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+        DocumentObject::_touchDependencies();
         // insert in the vector
         d->objectArray.push_back(pcObject);
 
@@ -4031,6 +4099,7 @@ void Document::addObject(DocumentObject* pcObject, const char* pObjectName)
     d->objectIdMap[pcObject->_Id] = pcObject;
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    DocumentObject::_touchDependencies();
     // insert in the vector
     d->objectArray.push_back(pcObject);
 
@@ -4062,6 +4131,7 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
     d->objectArray.push_back(pcObject);
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    DocumentObject::_touchDependencies();
 
     // do no transactions if we do a rollback!
     if (!d->rollback) {
@@ -243,6 +243,8 @@ public:
 
     /// returns the complete document memory consumption, including all managed DocObjects and Undo Redo.
     unsigned int getMemSize (void) const override;
+    /// the same as getMemSize() but summed up in 64 bits, so it isn't limited to 4 GB
+    std::uint64_t getMemoryUsage (void) const;
 
     /** @name Object handling  */
     //@{
@@ -403,9 +405,13 @@ public:
     /// Check if a transaction is open and its list is empty.
     /// If no transaction is open true is returned.
     bool isTransactionEmpty() const;
-    /// Set the Undo limit in Byte!
+    /// Set the Undo limit in Byte! Zero means no limit.
     void setUndoLimit(unsigned int UndoMemSize=0);
-    /// Returns the actual memory consumption of the Undo redo stuff.
+    /// Returns the Undo limit in Byte
+    unsigned int getUndoLimit(void) const;
+    /** Returns the actual memory consumption of the Undo redo stuff. Data that
+     * a property shares with its copies in the transactions is only counted in part.
+     */
     unsigned int getUndoMemSize (void) const;
     /// Set the Undo limit as stack size
     void setMaxUndoStackSize(unsigned int UndoMaxStackSize=20);
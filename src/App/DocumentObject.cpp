@@ -25,6 +25,8 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <stack>
+# include <unordered_set>
 #endif
 
 #include <Base/Writer.h>
@@ -57,6 +59,8 @@ PROPERTY_SOURCE(App::DocumentObject, App::TransactionalObject)
 
 DocumentObjectExecReturn *DocumentObject::StdReturn = 0;
 
+static unsigned long _DependencyRevision;
+
 //===========================================================================
 // DocumentObject
 //===========================================================================
@@ -93,6 +97,7 @@ DocumentObject::~DocumentObject(void)
         // Call before decrementing the reference counter, otherwise a heap error can occur
         obj->setInvalid();
     }
+    ++_DependencyRevision;
 }
 
 App::DocumentObjectExecReturn *DocumentObject::recompute(void)
@@ -276,6 +281,7 @@ const char* DocumentObject::detachFromDocument()
 {
     const std::string* name = pcNameInDocument;
     pcNameInDocument = 0;
+    ++_DependencyRevision;
     return name ? name->c_str() : 0;
 }
 
@@ -478,67 +484,61 @@ std::set<App::DocumentObject*> DocumentObject::getInListEx(bool recursive) const
     return ret;
 }
 
-void _getOutListRecursive(std::set<DocumentObject*>& objSet,
-                          const DocumentObject* obj,
-                          const DocumentObject* checkObj, int depth)
-{
-    for (const auto objIt : obj->getOutList()) {
-        // if the check object is in the recursive inList we have a cycle!
-        if (objIt == checkObj || depth <= 0) {
-            throw Base::BadGraphError("DocumentObject::getOutListRecursive(): cyclic dependency detected!");
-        }
-
-        // if the element was already in the set then there is no need to process it again
-        auto pair = objSet.insert(objIt);
-        if (pair.second)
-            _getOutListRecursive(objSet, objIt, checkObj, depth-1);
-    }
-}
-
 std::vector<App::DocumentObject*> DocumentObject::getOutListRecursive(void) const
 {
-    // number of objects in document is a good estimate in result size
-    int maxDepth = GetApplication().checkLinkDepth(0);
     std::set<App::DocumentObject*> result;
-
-    // using a recursive helper to collect all OutLists
-    _getOutListRecursive(result, this, this, maxDepth);
+    std::stack<const App::DocumentObject*> pendings;
+    pendings.push(this);
+    while(!pendings.empty()) {
+        auto obj = pendings.top();
+        pendings.pop();
+        for (const auto objIt : obj->getOutList()) {
+            // if the check object is in the recursive inList we have a cycle!
+            if (objIt == this)
+                throw Base::BadGraphError("DocumentObject::getOutListRecursive(): cyclic dependency detected!");
+
+            // if the element was already in the set then there is no need to process it again
+            if (objIt && result.insert(objIt).second)
+                pendings.push(objIt);
+        }
+    }
 
     std::vector<App::DocumentObject*> array;
     array.insert(array.begin(), result.begin(), result.end());
     return array;
 }
 
-// helper for isInInListRecursive()
-bool _isInInListRecursive(const DocumentObject* act,
-                          const DocumentObject* checkObj, int depth)
+// Depth first search along the InList or OutList that stops as soon as one
+// of the objects is found. Each object is visited only once, so this is linear
+// in the number of links even if the dependency graph has many converging paths.
+static bool _isLinkedRecursive(const DocumentObject* act,
+                               const std::unordered_set<const DocumentObject*> &checkObjs,
+                               bool inList)
 {
-#ifndef  USE_OLD_DAG
-    for (auto obj : act->getInList()) {
-        if (obj == checkObj)
-            return true;
-        // if we reach the depth limit we have a cycle!
-        if (depth <= 0) {
-            throw Base::BadGraphError("DocumentObject::isInInListRecursive(): cyclic dependency detected!");
+    std::unordered_set<const DocumentObject*> visited;
+    std::stack<const DocumentObject*> pendings;
+    visited.insert(act);
+    pendings.push(act);
+    while(!pendings.empty()) {
+        auto obj = pendings.top();
+        pendings.pop();
+        const auto &links = inList ? obj->getInList() : obj->getOutList();
+        for (auto o : links) {
+            if (!o || !o->getNameInDocument())
+                continue;
+            if (checkObjs.count(o))
+                return true;
+            if (visited.insert(o).second)
+                pendings.push(o);
         }
-
-        if (_isInInListRecursive(obj, checkObj, depth - 1))
-            return true;
     }
-#else
-    (void)act;
-    (void)checkObj;
-    (void)depth;
-#endif
-
     return false;
 }
 
 bool DocumentObject::isInInListRecursive(DocumentObject *linkTo) const
 {
-#if 0
-    int maxDepth = getDocument()->countObjects() + 2;
-    return _isInInListRecursive(this, linkTo, maxDepth);
+#ifndef  USE_OLD_DAG
+    return this==linkTo || _isLinkedRecursive(this, {linkTo}, true);
 #else
     return this==linkTo || getInListEx(true).count(linkTo);
 #endif
@@ -557,35 +557,9 @@ bool DocumentObject::isInInList(DocumentObject *linkTo) const
 #endif
 }
 
-// helper for isInOutListRecursive()
-bool _isInOutListRecursive(const DocumentObject* act,
-                           const DocumentObject* checkObj, int depth)
-{
-#ifndef  USE_OLD_DAG
-    for (auto obj : act->getOutList()) {
-        if (obj == checkObj)
-            return true;
-        // if we reach the depth limit we have a cycle!
-        if (depth <= 0) {
-            throw Base::BadGraphError("DocumentObject::isInOutListRecursive(): cyclic dependency detected!");
-        }
-
-        if (_isInOutListRecursive(obj, checkObj, depth - 1))
-            return true;
-    }
-#else
-    (void)act;
-    (void)checkObj;
-    (void)depth;
-#endif
-
-    return false;
-}
-
 bool DocumentObject::isInOutListRecursive(DocumentObject *linkTo) const
 {
-    int maxDepth = getDocument()->countObjects() + 2;
-    return _isInOutListRecursive(this, linkTo, maxDepth);
+    return _isLinkedRecursive(this, {linkTo}, false);
 }
 
 std::vector<std::list<App::DocumentObject*> >
@@ -618,6 +592,14 @@ bool DocumentObject::testIfLinkDAGCompatible(const std::vector<DocumentObject *>
         return false;
     else
         return true;
+#elif !defined(USE_OLD_DAG)
+    std::unordered_set<const DocumentObject*> objs(linksTo.begin(), linksTo.end());
+    objs.erase(nullptr);
+    if(objs.empty())
+        return true;
+    if(objs.count(this))
+        return false;
+    return !_isLinkedRecursive(this, objs, true);
 #else
     auto inLists = getInListEx(true);
     inLists.emplace(const_cast<DocumentObject*>(this));
@@ -766,6 +748,15 @@ void DocumentObject::clearOutListCache() const {
     _outList.clear();
     _outListMap.clear();
     _outListCached = false;
+    ++_DependencyRevision;
+}
+
+unsigned long DocumentObject::getDependencyRevision() {
+    return _DependencyRevision;
+}
+
+void DocumentObject::_touchDependencies() {
+    ++_DependencyRevision;
 }
 
 PyObject *DocumentObject::getPyObject(void)
@@ -992,6 +983,7 @@ void App::DocumentObject::_removeBackLink(DocumentObject* rmvObj)
     auto it = std::find(_inList.begin(), _inList.end(), rmvObj);
     if(it != _inList.end())
         _inList.erase(it);
+    ++_DependencyRevision;
 #else
     (void)rmvObj;
 #endif
@@ -1005,6 +997,7 @@ void App::DocumentObject::_addBackLink(DocumentObject* newObj)
     //this removal would clear the object from the inlist, even though there may be other link properties 
     //from this object that link to us.
     _inList.push_back(newObj);
+    ++_DependencyRevision;
 #else
     (void)newObj;
 #endif //USE_OLD_DAG    
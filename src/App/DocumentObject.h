@@ -269,6 +269,13 @@ public:
     void _removeBackLink(DocumentObject*);
     /// internal, used by PropertyLink to maintain DAG back links
     void _addBackLink(DocumentObject*);
+    /** Returns a counter that is increased whenever a link between any two
+     * objects changes, or an object is added to or removed from a document.
+     * It is used to cache the dependency order of the objects.
+     */
+    static unsigned long getDependencyRevision();
+    /// internal, increase the dependency revision
+    static void _touchDependencies();
     //@}
 
     /**
@@ -454,6 +454,31 @@ PyObject*  DocumentPy::clearUndos(PyObject * args)
     Py_Return;
 }
 
+PyObject*  DocumentPy::getMemoryUsage(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    PY_TRY {
+        Document* doc = getDocumentPtr();
+        Py::Dict objects;
+        for (auto obj : doc->getObjects()) {
+            std::uint64_t size = obj->getMemSize();
+            objects.setItem(obj->getNameInDocument(), Py::asObject(PyLong_FromUnsignedLongLong(size)));
+        }
+        std::uint64_t props = doc->PropertyContainer::getMemSize();
+        std::uint64_t undo = doc->getUndoMemSize();
+        std::uint64_t total = doc->getMemoryUsage();
+
+        Py::Dict dict;
+        dict.setItem("Objects", objects);
+        dict.setItem("Properties", Py::asObject(PyLong_FromUnsignedLongLong(props)));
+        dict.setItem("UndoRedo", Py::asObject(PyLong_FromUnsignedLongLong(undo)));
+        dict.setItem("Total", Py::asObject(PyLong_FromUnsignedLongLong(total)));
+        return Py::new_reference_to(dict);
+    } PY_CATCH;
+}
+
 PyObject*  DocumentPy::recompute(PyObject * args)
 {
     PyObject *pyobjs = Py_None;
@@ -639,6 +664,19 @@ Py::Int DocumentPy::getUndoRedoMemSize(void) const
     return Py::Int((long)getDocumentPtr()->getUndoMemSize());
 }
 
+Py::Int DocumentPy::getUndoMemLimit(void) const
+{
+    return Py::Int((long)getDocumentPtr()->getUndoLimit());
+}
+
+void DocumentPy::setUndoMemLimit(Py::Int arg)
+{
+    long limit = static_cast<long>(arg);
+    if (limit < 0)
+        throw Py::ValueError("Undo limit must not be negative");
+    getDocumentPtr()->setUndoLimit(static_cast<unsigned int>(limit));
+}
+
 Py::Int DocumentPy::getUndoCount(void) const
 {
     return Py::Int((long)getDocumentPtr()->getAvailableUndos());
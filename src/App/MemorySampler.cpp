@@ -0,0 +1,177 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <chrono>
+# include <iomanip>
+# include <sstream>
+# include <vector>
+#endif
+
+#include <boost_signals2.hpp>
+
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+
+#include "MemorySampler.h"
+#include "Application.h"
+#include "Document.h"
+#include "DocumentObject.h"
+
+using namespace App;
+
+namespace {
+
+struct SamplerData
+{
+    double interval = 0.0;
+    std::string fileName;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point last;
+    std::vector<boost::signals2::scoped_connection> connections;
+};
+
+SamplerData& samplerData()
+{
+    static SamplerData data;
+    return data;
+}
+
+// the number of objects listed per document
+const std::size_t LargestObjects = 5;
+
+}
+
+void MemorySampler::start(double interval, const std::string& fileName)
+{
+    stop();
+    if (interval <= 0.0)
+        return;
+
+    SamplerData& data = samplerData();
+    data.interval = interval;
+    data.fileName = fileName;
+    data.start = std::chrono::steady_clock::now();
+    data.last = data.start - std::chrono::hours(1);
+
+    Application& app = GetApplication();
+    data.connections.emplace_back(app.signalRecomputed.connect(
+        [](const Document&) { onEvent(); }));
+    data.connections.emplace_back(app.signalCloseTransaction.connect(
+        [](bool) { onEvent(); }));
+    data.connections.emplace_back(app.signalFinishRestoreDocument.connect(
+        [](const Document&) { onEvent(); }));
+    data.connections.emplace_back(app.signalDeletedDocument.connect(
+        []() { onEvent(); }));
+}
+
+void MemorySampler::stop()
+{
+    SamplerData& data = samplerData();
+    data.connections.clear();
+    data.interval = 0.0;
+    data.fileName.clear();
+}
+
+bool MemorySampler::isActive()
+{
+    return samplerData().interval > 0.0;
+}
+
+double MemorySampler::getInterval()
+{
+    return samplerData().interval;
+}
+
+const std::string& MemorySampler::getFileName()
+{
+    return samplerData().fileName;
+}
+
+void MemorySampler::onEvent()
+{
+    SamplerData& data = samplerData();
+    auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<double>(now - data.last).count() < data.interval)
+        return;
+
+    try {
+        sample();
+    }
+    catch (const Base::Exception& e) {
+        // don't fail the operation that triggered the sample
+        Base::Console().Error("Memory sampling stopped: %s\n", e.what());
+        stop();
+    }
+}
+
+void MemorySampler::sample()
+{
+    SamplerData& data = samplerData();
+    data.last = std::chrono::steady_clock::now();
+    double time = std::chrono::duration<double>(data.last - data.start).count();
+
+    // the names of documents and objects are identifiers, they need no escaping
+    std::ostringstream str;
+    str << "{\"time\":" << std::fixed << std::setprecision(3) << time << ",\"documents\":[";
+    std::vector<Document*> docs = GetApplication().getDocuments();
+    for (std::size_t i = 0; i < docs.size(); i++) {
+        Document* doc = docs[i];
+        std::vector<std::pair<std::uint64_t, const char*>> objects;
+        for (auto obj : doc->getObjects())
+            objects.emplace_back(obj->getMemSize(), obj->getNameInDocument());
+        std::size_t count = std::min(objects.size(), LargestObjects);
+        std::partial_sort(objects.begin(), objects.begin() + count, objects.end(),
+                          [](const std::pair<std::uint64_t, const char*>& a,
+                             const std::pair<std::uint64_t, const char*>& b) {
+                              return a.first > b.first;
+                          });
+
+        str << (i > 0 ? "," : "") << "{\"name\":\"" << doc->getName()
+            << "\",\"total\":" << doc->getMemoryUsage()
+            << ",\"undoRedo\":" << doc->getUndoMemSize()
+            << ",\"objects\":" << objects.size() << ",\"largest\":[";
+        for (std::size_t j = 0; j < count; j++) {
+            str << (j > 0 ? "," : "") << "[\"" << objects[j].second << "\"," << objects[j].first << "]";
+        }
+        str << "]}";
+    }
+    str << "]}";
+
+    if (data.fileName.empty()) {
+        Base::Console().Log("Memory usage: %s\n", str.str().c_str());
+    }
+    else {
+        Base::FileInfo fi(data.fileName);
+        Base::ofstream file(fi, std::ios::out | std::ios::app);
+        if (!file)
+            throw Base::FileException("Cannot open file", fi);
+        file << str.str() << '\n';
+    }
+}
@@ -0,0 +1,63 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef APP_MEMORYSAMPLER_H
+#define APP_MEMORYSAMPLER_H
+
+#include <string>
+
+namespace App
+{
+
+/**
+ * The MemorySampler records the memory usage of the open documents during a
+ * long session, at most once per interval. Instead of a timer, that would
+ * need an event loop, it's triggered by the events that change the memory
+ * usage: a recompute, the end of a transaction and the opening or closing of
+ * a document.
+ *
+ * A sample is appended as a line of JSON to a file, or written to the log if
+ * no file is given. It has the time in seconds since the start of sampling and
+ * for every document its total size, the size of the undo/redo stacks and the
+ * largest objects, all in bytes.
+ */
+class AppExport MemorySampler
+{
+public:
+    /// Starts sampling, an interval in seconds of zero or less stops it
+    static void start(double interval, const std::string& fileName = std::string());
+    static void stop();
+    static bool isActive();
+    static double getInterval();
+    static const std::string& getFileName();
+    /// Takes a sample now, throws Base::FileException if the file can't be written
+    static void sample();
+
+private:
+    static void onEvent();
+};
+
+} // namespace App
+
+#endif // APP_MEMORYSAMPLER_H
@@ -227,8 +227,22 @@ public:
 
     /// Returns a new copy of the property (mainly for Undo/Redo and transactions)
     virtual Property *Copy(void) const = 0;
+    /** Returns a copy of the property that is kept for Undo/Redo.
+     * Unlike Copy() the returned property may share its data with this one,
+     * so it must only be used on the thread that owns the document.
+     */
+    virtual Property *copyForUndo(void) const {
+        return Copy();
+    }
     /// Paste the value from the property (mainly for Undo/Redo and transactions)
     virtual void Paste(const Property &from) = 0;
+    /** Returns the memory used by a copy of the property kept for Undo/Redo.
+     * Properties whose copies share the data with the original until one of
+     * them is modified only count their part of the shared data.
+     */
+    virtual unsigned int getUndoMemSize (void) const {
+        return getMemSize();
+    }
 
     /// Called when a child property has changed value
     virtual void hasSetChildValue(Property &) {}
@@ -68,10 +68,10 @@ unsigned int PropertyContainer::getMemSize (void) const
     std::map<std::string,Property*> Map;
     getPropertyMap(Map);
     std::map<std::string,Property*>::const_iterator It;
-    unsigned int size = 0;
+    std::uint64_t size = 0;
     for (It = Map.begin(); It != Map.end();++It)
         size += It->second->getMemSize();
-    return size;
+    return clampMemSize(size);
 }
 
 
@@ -242,7 +242,7 @@ void PropertyContainer::Save (Base::Writer &writer) const
 
     writer.incInd(); // indentation for 'Properties Count'
     writer.Stream() << writer.ind() << "<Properties Count=\"" << Map.size()
-                    << "\" TransientCount=\"" << transients.size() << "\">" << endl;
+                    << "\" TransientCount=\"" << transients.size() << "\">" << '\n';
 
     // First store transient properties to persist their status value. We use
     // a new element named "_Property" so that the save file can be opened by
@@ -251,7 +251,7 @@ void PropertyContainer::Save (Base::Writer &writer) const
     for(auto prop : transients) {
         writer.Stream() << writer.ind() << "<_Property name=\"" << prop->getName() 
             << "\" type=\"" << prop->getTypeId().getName() 
-            << "\" status=\"" << prop->getStatus() << "\"/>" << std::endl;
+            << "\" status=\"" << prop->getStatus() << "\"/>" << '\n';
     }
     writer.decInd();
 
@@ -273,11 +273,11 @@ void PropertyContainer::Save (Base::Writer &writer) const
                 || it->second->getType() & Prop_Transient) 
         {
             writer.decInd();
-            writer.Stream() << "</Property>" << std::endl;
+            writer.Stream() << "</Property>" << '\n';
             continue;
         }
 
-        writer.Stream() << std::endl;
+        writer.Stream() << '\n';
        
         writer.incInd(); // indentation for the actual property
 
@@ -302,10 +302,10 @@ void PropertyContainer::Save (Base::Writer &writer) const
         }
 #endif
         writer.decInd(); // indentation for the actual property
-        writer.Stream() << writer.ind() << "</Property>" << endl;    
+        writer.Stream() << writer.ind() << "</Property>" << '\n';    
         writer.decInd(); // indentation for 'Property name'
     }
-    writer.Stream() << writer.ind() << "</Properties>" << endl;
+    writer.Stream() << writer.ind() << "</Properties>" << '\n';
     writer.decInd(); // indentation for 'Properties Count'
 }
 
@@ -164,10 +164,10 @@ void PropertyExpressionEngine::Save(Base::Writer &writer) const
 {
     writer.Stream() << writer.ind() << "<ExpressionEngine count=\"" <<  expressions.size();
     if(PropertyExpressionContainer::_XLinks.empty()) {
-        writer.Stream() << "\">" << std::endl;
+        writer.Stream() << "\">" << '\n';
         writer.incInd();
     } else {
-        writer.Stream() << "\" xlink=\"1\">" << std::endl;
+        writer.Stream() << "\" xlink=\"1\">" << '\n';
         writer.incInd();
         PropertyExpressionContainer::Save(writer);
     }
@@ -178,10 +178,10 @@ void PropertyExpressionEngine::Save(Base::Writer &writer) const
         if (it->second.expression->comment.size() > 0)
             writer.Stream() << " comment=\"" 
                 << Property::encodeAttribute(it->second.expression->comment) << "\"";
-        writer.Stream() << "/>" << std::endl;
+        writer.Stream() << "/>" << '\n';
     }
     writer.decInd();
-    writer.Stream() << writer.ind() << "</ExpressionEngine>" << std::endl;
+    writer.Stream() << writer.ind() << "</ExpressionEngine>" << '\n';
 }
 
 void PropertyExpressionEngine::Restore(Base::XMLReader &reader)
@@ -365,15 +365,15 @@ void PropertyFileIncluded::Save (Base::Writer &writer) const
         if (!_cValue.empty()) {
             Base::FileInfo file(_cValue.c_str());
             writer.Stream() << writer.ind() << "<FileIncluded data=\""
-                            << file.fileName() << "\">" << std::endl;
+                            << file.fileName() << "\">" << '\n';
             // write the file in the XML stream
             writer.incInd();
             writer.insertBinFile(_cValue.c_str());
             writer.decInd();
-            writer.Stream() << writer.ind() <<"</FileIncluded>" << endl;
+            writer.Stream() << writer.ind() <<"</FileIncluded>" << '\n';
         }
         else {
-            writer.Stream() << writer.ind() << "<FileIncluded data=\"\"/>" << std::endl;
+            writer.Stream() << writer.ind() << "<FileIncluded data=\"\"/>" << '\n';
         }
     }
     else {
@@ -383,10 +383,10 @@ void PropertyFileIncluded::Save (Base::Writer &writer) const
             std::string filename = writer.addFile(file.fileName().c_str(), this);
             filename = encodeAttribute(filename);
             writer.Stream() << writer.ind() << "<FileIncluded file=\""
-                            << filename << "\"/>" << std::endl;
+                            << filename << "\"/>" << '\n';
         }
         else {
-            writer.Stream() << writer.ind() << "<FileIncluded file=\"\"/>" << std::endl;
+            writer.Stream() << writer.ind() << "<FileIncluded file=\"\"/>" << '\n';
         }
     }
 }
@@ -150,7 +150,7 @@ void PropertyVector::setPyObject(PyObject *value)
 
 void PropertyVector::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<PropertyVector valueX=\"" <<  _cVec.x << "\" valueY=\"" <<  _cVec.y << "\" valueZ=\"" <<  _cVec.z <<"\"/>" << endl;
+    writer.Stream() << writer.ind() << "<PropertyVector valueX=\"" <<  _cVec.x << "\" valueY=\"" <<  _cVec.y << "\" valueZ=\"" <<  _cVec.z <<"\"/>" << '\n';
 }
 
 void PropertyVector::Restore(Base::XMLReader &reader)
@@ -328,7 +328,7 @@ Base::Vector3d PropertyVectorList::getPyValue(PyObject *item) const {
 void PropertyVectorList::Save (Base::Writer &writer) const
 {
     if (!writer.isForceXML()) {
-        writer.Stream() << writer.ind() << "<VectorList file=\"" << writer.addFile(getName(), this) << "\"/>" << std::endl;
+        writer.Stream() << writer.ind() << "<VectorList file=\"" << writer.addFile(getName(), this) << "\"/>" << '\n';
     }
 }
 
@@ -348,18 +348,19 @@ void PropertyVectorList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
+    static_assert(sizeof(Base::Vector3d) == 3 * sizeof(double), "vectors must be stored without padding");
     if (!isSinglePrecision()) {
-        for (std::vector<Base::Vector3d>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << it->x << it->y << it->z;
-        }
+        str.write(reinterpret_cast<const double*>(_lValueList.data()), 3 * _lValueList.size());
     }
     else {
+        std::vector<float> values;
+        values.reserve(3 * _lValueList.size());
         for (std::vector<Base::Vector3d>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float x = (float)it->x;
-            float y = (float)it->y;
-            float z = (float)it->z;
-            str << x << y << z;
+            values.push_back((float)it->x);
+            values.push_back((float)it->y);
+            values.push_back((float)it->z);
         }
+        str.write(values.data(), values.size());
     }
 }
 
@@ -370,15 +371,13 @@ void PropertyVectorList::RestoreDocFile(Base::Reader &reader)
     str >> uCt;
     std::vector<Base::Vector3d> values(uCt);
     if (!isSinglePrecision()) {
-        for (std::vector<Base::Vector3d>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> it->x >> it->y >> it->z;
-        }
+        str.read(reinterpret_cast<double*>(values.data()), 3 * values.size());
     }
     else {
-        float x,y,z;
-        for (std::vector<Base::Vector3d>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> x >> y >> z;
-            it->Set(x, y, z);
+        std::vector<float> buffer(3 * values.size());
+        str.read(buffer.data(), buffer.size());
+        for (std::size_t i = 0; i < values.size(); i++) {
+            values[i].Set(buffer[3 * i], buffer[3 * i + 1], buffer[3 * i + 2]);
         }
     }
     setValues(values);
@@ -483,7 +482,7 @@ void PropertyMatrix::Save (Base::Writer &writer) const
     writer.Stream() << " a21=\"" <<  _cMat[1][0] << "\" a22=\"" <<  _cMat[1][1] << "\" a23=\"" <<  _cMat[1][2] << "\" a24=\"" <<  _cMat[1][3] << "\"";
     writer.Stream() << " a31=\"" <<  _cMat[2][0] << "\" a32=\"" <<  _cMat[2][1] << "\" a33=\"" <<  _cMat[2][2] << "\" a34=\"" <<  _cMat[2][3] << "\"";
     writer.Stream() << " a41=\"" <<  _cMat[3][0] << "\" a42=\"" <<  _cMat[3][1] << "\" a43=\"" <<  _cMat[3][2] << "\" a44=\"" <<  _cMat[3][3] << "\"";
-    writer.Stream() <<"/>" << endl;
+    writer.Stream() <<"/>" << '\n';
 }
 
 void PropertyMatrix::Restore(Base::XMLReader &reader)
@@ -713,7 +712,7 @@ void PropertyPlacement::Save (Base::Writer &writer) const
                     << "\" Ox=\"" <<  axis.x
                     << "\" Oy=\"" <<  axis.y
                     << "\" Oz=\"" <<  axis.z << "\"";
-    writer.Stream() <<"/>" << endl;
+    writer.Stream() <<"/>" << '\n';
 }
 
 void PropertyPlacement::Restore(Base::XMLReader &reader)
@@ -802,7 +801,7 @@ Base::Placement PropertyPlacementList::getPyValue(PyObject *item) const {
 void PropertyPlacementList::Save (Base::Writer &writer) const
 {
     if (!writer.isForceXML()) {
-        writer.Stream() << writer.ind() << "<PlacementList file=\"" << writer.addFile(getName(), this) << "\"/>" << std::endl;
+        writer.Stream() << writer.ind() << "<PlacementList file=\"" << writer.addFile(getName(), this) << "\"/>" << '\n';
     }
 }
 
@@ -817,28 +816,48 @@ void PropertyPlacementList::Restore(Base::XMLReader &reader)
     }
 }
 
+namespace {
+// A placement is stored as position and quaternion, i.e. 7 numbers
+template <typename T>
+void writePlacements(Base::OutputStream& str, const std::vector<Base::Placement>& list)
+{
+    std::vector<T> values;
+    values.reserve(7 * list.size());
+    for (std::vector<Base::Placement>::const_iterator it = list.begin(); it != list.end(); ++it) {
+        const Base::Vector3d& pos = it->getPosition();
+        const Base::Rotation& rot = it->getRotation();
+        values.push_back((T)pos.x);
+        values.push_back((T)pos.y);
+        values.push_back((T)pos.z);
+        for (int i = 0; i < 4; i++)
+            values.push_back((T)rot[i]);
+    }
+    str.write(values.data(), values.size());
+}
+
+template <typename T>
+void readPlacements(Base::InputStream& str, std::vector<Base::Placement>& list)
+{
+    std::vector<T> values(7 * list.size());
+    str.read(values.data(), values.size());
+    for (std::size_t i = 0; i < list.size(); i++) {
+        const T* v = &values[7 * i];
+        list[i].setPosition(Base::Vector3d(v[0], v[1], v[2]));
+        list[i].setRotation(Base::Rotation(v[3], v[4], v[5], v[6]));
+    }
+}
+}
+
 void PropertyPlacementList::SaveDocFile (Base::Writer &writer) const
 {
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
     if (!isSinglePrecision()) {
-        for (std::vector<Base::Placement>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << it->getPosition().x << it->getPosition().y << it->getPosition().z
-                << it->getRotation()[0] << it->getRotation()[1] << it->getRotation()[2] << it->getRotation()[3] ;
-        }
+        writePlacements<double>(str, _lValueList);
     }
     else {
-        for (std::vector<Base::Placement>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float x = (float)it->getPosition().x;
-            float y = (float)it->getPosition().y;
-            float z = (float)it->getPosition().z;
-            float q0 = (float)it->getRotation()[0];
-            float q1 = (float)it->getRotation()[1];
-            float q2 = (float)it->getRotation()[2];
-            float q3 = (float)it->getRotation()[3];
-            str << x << y << z << q0 << q1 << q2 << q3;
-        }
+        writePlacements<float>(str, _lValueList);
     }
 }
 
@@ -849,24 +868,10 @@ void PropertyPlacementList::RestoreDocFile(Base::Reader &reader)
     str >> uCt;
     std::vector<Base::Placement> values(uCt);
     if (!isSinglePrecision()) {
-        for (std::vector<Base::Placement>::iterator it = values.begin(); it != values.end(); ++it) {
-            Base::Vector3d pos;
-            double q0, q1, q2, q3;
-            str >> pos.x >> pos.y >> pos.z >> q0 >> q1 >> q2 >> q3;
-            Base::Rotation rot(q0,q1,q2,q3);
-            it->setPosition(pos);
-            it->setRotation(rot);
-        }
+        readPlacements<double>(str, values);
     }
     else {
-        float x,y,z,q0,q1,q2,q3;
-        for (std::vector<Base::Placement>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> x >> y >> z >> q0 >> q1 >> q2 >> q3;
-            Base::Vector3d pos(x, y, z);
-            Base::Rotation rot(q0,q1,q2,q3);
-            it->setPosition(pos);
-            it->setRotation(rot);
-        }
+        readPlacements<float>(str, values);
     }
     setValues(values);
 }
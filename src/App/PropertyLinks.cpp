@@ -483,7 +483,7 @@ void PropertyLink::setPyObject(PyObject *value)
 
 void PropertyLink::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Link value=\"" <<  (_pcLink?_pcLink->getExportName():"") <<"\"/>" << std::endl;
+    writer.Stream() << writer.ind() << "<Link value=\"" <<  (_pcLink?_pcLink->getExportName():"") <<"\"/>" << '\n';
 }
 
 void PropertyLink::Restore(Base::XMLReader &reader)
@@ -731,18 +731,18 @@ DocumentObject *PropertyLinkList::getPyValue(PyObject *item) const
 
 void PropertyLinkList::Save(Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<LinkList count=\"" << getSize() << "\">" << endl;
+    writer.Stream() << writer.ind() << "<LinkList count=\"" << getSize() << "\">" << '\n';
     writer.incInd();
     for (int i = 0; i<getSize(); i++) {
         DocumentObject* obj = _lValueList[i];
         if (obj)
-            writer.Stream() << writer.ind() << "<Link value=\"" << obj->getExportName() << "\"/>" << endl;
+            writer.Stream() << writer.ind() << "<Link value=\"" << obj->getExportName() << "\"/>" << '\n';
         else
-            writer.Stream() << writer.ind() << "<Link value=\"\"/>" << endl;
+            writer.Stream() << writer.ind() << "<Link value=\"\"/>" << '\n';
     }
 
     writer.decInd();
-    writer.Stream() << writer.ind() << "</LinkList>" << endl;
+    writer.Stream() << writer.ind() << "</LinkList>" << '\n';
 }
 
 void PropertyLinkList::Restore(Base::XMLReader &reader)
@@ -1308,7 +1308,7 @@ void PropertyLinkSub::Save (Base::Writer &writer) const
         internal_name = _pcLinkSub->getExportName();
     writer.Stream() << writer.ind() << "<LinkSub value=\""
         <<  internal_name <<"\" count=\"" <<  _cSubList.size();
-    writer.Stream() << "\">" << std::endl;
+    writer.Stream() << "\">" << '\n';
     writer.incInd();
     auto owner = dynamic_cast<DocumentObject*>(getContainer());
     bool exporting = owner && owner->isExporting();
@@ -1338,10 +1338,10 @@ void PropertyLinkSub::Save (Base::Writer &writer) const
                 }
             }
         }
-        writer.Stream()<<"\"/>" << endl;
+        writer.Stream()<<"\"/>" << '\n';
     }
     writer.decInd();
-    writer.Stream() << writer.ind() << "</LinkSub>" << endl ;
+    writer.Stream() << writer.ind() << "</LinkSub>" << '\n' ;
 }
 
 void PropertyLinkSub::Restore(Base::XMLReader &reader)
@@ -2086,7 +2086,7 @@ void PropertyLinkSubList::Save (Base::Writer &writer) const
         if(obj && obj->getNameInDocument())
             ++count;
     }
-    writer.Stream() << writer.ind() << "<LinkSubList count=\"" << count <<"\">" << endl;
+    writer.Stream() << writer.ind() << "<LinkSubList count=\"" << count <<"\">" << '\n';
     writer.incInd();
     auto owner = dynamic_cast<DocumentObject*>(getContainer());
     bool exporting = owner && owner->isExporting();
@@ -2120,11 +2120,11 @@ void PropertyLinkSubList::Save (Base::Writer &writer) const
                 }
             }
         }
-        writer.Stream() << "\"/>" << endl;
+        writer.Stream() << "\"/>" << '\n';
     }
 
     writer.decInd();
-    writer.Stream() << writer.ind() << "</LinkSubList>" << endl ;
+    writer.Stream() << writer.ind() << "</LinkSubList>" << '\n' ;
 }
 
 void PropertyLinkSubList::Restore(Base::XMLReader &reader)
@@ -3218,7 +3218,7 @@ void PropertyXLink::Save (Base::Writer &writer) const {
         writer.Stream() << "\" partial=\"1";
 
     if(_SubList.empty()) {
-        writer.Stream() << "\"/>" << std::endl;
+        writer.Stream() << "\"/>" << '\n';
     } else if(_SubList.size() == 1) {
         const auto &subName = _SubList[0];
         const auto &shadowSub = _ShadowSubList[0];
@@ -3237,9 +3237,9 @@ void PropertyXLink::Save (Base::Writer &writer) const {
                     writer.Stream() << "\" " ATTR_SHADOW "=\"" << shadowSub.first;
             }
         }
-        writer.Stream() << "\"/>" << std::endl;
+        writer.Stream() << "\"/>" << '\n';
     }else {
-        writer.Stream() <<"\" count=\"" << _SubList.size() << "\">" << std::endl;
+        writer.Stream() <<"\" count=\"" << _SubList.size() << "\">" << '\n';
         writer.incInd();
         for(unsigned int i = 0;i<_SubList.size(); i++) {
             const auto &shadow = _ShadowSubList[i];
@@ -3262,10 +3262,10 @@ void PropertyXLink::Save (Base::Writer &writer) const {
                         writer.Stream() << "\" " ATTR_SHADOW "=\"" << shadow.first;
                 }
             }
-            writer.Stream()<<"\"/>" << endl;
+            writer.Stream()<<"\"/>" << '\n';
         }
         writer.decInd();
-        writer.Stream() << writer.ind() << "</XLink>" << endl ;
+        writer.Stream() << writer.ind() << "</XLink>" << '\n' ;
     }
 }
 
@@ -4026,12 +4026,12 @@ void PropertyXLinkSubList::Save (Base::Writer &writer) const
     writer.Stream() << writer.ind() << "<XLinkSubList count=\"" << _Links.size();
     if(testFlag(LinkAllowPartial))
         writer.Stream() << "\" partial=\"1";
-    writer.Stream() <<"\">" << endl;
+    writer.Stream() <<"\">" << '\n';
     writer.incInd();
     for(auto &l : _Links)
         l.Save(writer);
     writer.decInd();
-    writer.Stream() << writer.ind() << "</XLinkSubList>" << endl ;
+    writer.Stream() << writer.ind() << "</XLinkSubList>" << '\n' ;
 }
 
 void PropertyXLinkSubList::Restore(Base::XMLReader &reader)
@@ -4523,21 +4523,21 @@ void PropertyXLinkContainer::Save (Base::Writer &writer) const {
             writer.Stream() << "\" docs=\"" << docSet.size();
     }
 
-    writer.Stream() << "\">" << std::endl;
+    writer.Stream() << "\">" << '\n';
     writer.incInd();
 
     for(auto &v : docSet) {
         writer.Stream() << writer.ind() << "<DocMap "
             << "name=\"" << v.first->getName()
             << "\" label=\"" << encodeAttribute(v.first->Label.getValue())
-            << "\" index=\"" << v.second << "\"/>" << std::endl;
+            << "\" index=\"" << v.second << "\"/>" << '\n';
     }
 
     for(auto &v : _XLinks)
         v.second->Save(writer);
     writer.decInd();
 
-    writer.Stream() << writer.ind() << "</XLinks>" << std::endl;
+    writer.Stream() << writer.ind() << "</XLinks>" << '\n';
 }
 
 void PropertyXLinkContainer::Restore(Base::XMLReader &reader) {
@@ -295,7 +295,7 @@ void PropertyPythonObject::Save (Base::Writer &writer) const
         }
 
         saveObject(writer);
-        writer.Stream() << "/>" << std::endl;
+        writer.Stream() << "/>" << '\n';
     //}
     //else {
     //    writer.Stream() << writer.ind() << "<Python file=\"" << 
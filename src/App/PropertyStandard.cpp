@@ -115,7 +115,7 @@ void PropertyInteger::setPyObject(PyObject *value)
 
 void PropertyInteger::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Integer value=\"" <<  _lValue <<"\"/>" << std::endl;
+    writer.Stream() << writer.ind() << "<Integer value=\"" <<  _lValue <<"\"/>" << '\n';
 }
 
 void PropertyInteger::Restore(Base::XMLReader &reader)
@@ -246,7 +246,7 @@ void PropertyPath::setPyObject(PyObject *value)
 void PropertyPath::Save (Base::Writer &writer) const
 {
     std::string val = encodeAttribute(_cValue.string());
-    writer.Stream() << writer.ind() << "<Path value=\"" <<  val <<"\"/>" << std::endl;
+    writer.Stream() << writer.ind() << "<Path value=\"" <<  val <<"\"/>" << '\n';
 }
 
 void PropertyPath::Restore(Base::XMLReader &reader)
@@ -393,17 +393,17 @@ void PropertyEnumeration::Save(Base::Writer &writer) const
     writer.Stream() << writer.ind() << "<Integer value=\"" <<  _enum.getInt() <<"\"";
     if (_enum.isCustom())
         writer.Stream() << " CustomEnum=\"true\"";
-    writer.Stream() << "/>" << std::endl;
+    writer.Stream() << "/>" << '\n';
     if (_enum.isCustom()) {
         std::vector<std::string> items = getEnumVector();
-        writer.Stream() << writer.ind() << "<CustomEnumList count=\"" <<  items.size() <<"\">" << endl;
+        writer.Stream() << writer.ind() << "<CustomEnumList count=\"" <<  items.size() <<"\">" << '\n';
         writer.incInd();
         for(std::vector<std::string>::iterator it = items.begin(); it != items.end(); ++it) {
             std::string val = encodeAttribute(*it);
-            writer.Stream() << writer.ind() << "<Enum value=\"" <<  val <<"\"/>" << endl;
+            writer.Stream() << writer.ind() << "<Enum value=\"" <<  val <<"\"/>" << '\n';
         }
         writer.decInd();
-        writer.Stream() << writer.ind() << "</CustomEnumList>" << endl;
+        writer.Stream() << writer.ind() << "</CustomEnumList>" << '\n';
     }
 }
 
@@ -706,12 +706,12 @@ long PropertyIntegerList::getPyValue(PyObject *item) const {
 
 void PropertyIntegerList::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<IntegerList count=\"" <<  getSize() <<"\">" << endl;
+    writer.Stream() << writer.ind() << "<IntegerList count=\"" <<  getSize() <<"\">" << '\n';
     writer.incInd();
     for(int i = 0;i<getSize(); i++)
-        writer.Stream() << writer.ind() << "<I v=\"" <<  _lValueList[i] <<"\"/>" << endl; ;
+        writer.Stream() << writer.ind() << "<I v=\"" <<  _lValueList[i] <<"\"/>" << '\n';
     writer.decInd();
-    writer.Stream() << writer.ind() << "</IntegerList>" << endl ;
+    writer.Stream() << writer.ind() << "</IntegerList>" << '\n' ;
 }
 
 void PropertyIntegerList::Restore(Base::XMLReader &reader)
@@ -832,12 +832,12 @@ void PropertyIntegerSet::setPyObject(PyObject *value)
 
 void PropertyIntegerSet::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<IntegerSet count=\"" <<  _lValueSet.size() <<"\">" << endl;
+    writer.Stream() << writer.ind() << "<IntegerSet count=\"" <<  _lValueSet.size() <<"\">" << '\n';
     writer.incInd();
     for(std::set<long>::const_iterator it=_lValueSet.begin();it!=_lValueSet.end();++it)
-        writer.Stream() << writer.ind() << "<I v=\"" <<  *it <<"\"/>" << endl; ;
+        writer.Stream() << writer.ind() << "<I v=\"" <<  *it <<"\"/>" << '\n';
     writer.decInd();
-    writer.Stream() << writer.ind() << "</IntegerSet>" << endl ;
+    writer.Stream() << writer.ind() << "</IntegerSet>" << '\n' ;
 }
 
 void PropertyIntegerSet::Restore(Base::XMLReader &reader)
@@ -942,7 +942,7 @@ void PropertyFloat::setPyObject(PyObject *value)
 
 void PropertyFloat::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Float value=\"" <<  _dValue <<"\"/>" << std::endl;
+    writer.Stream() << writer.ind() << "<Float value=\"" <<  _dValue <<"\"/>" << '\n';
 }
 
 void PropertyFloat::Restore(Base::XMLReader &reader)
@@ -1187,16 +1187,16 @@ double PropertyFloatList::getPyValue(PyObject *item) const {
 void PropertyFloatList::Save (Base::Writer &writer) const
 {
     if (writer.isForceXML()) {
-        writer.Stream() << writer.ind() << "<FloatList count=\"" <<  getSize() <<"\">" << endl;
+        writer.Stream() << writer.ind() << "<FloatList count=\"" <<  getSize() <<"\">" << '\n';
         writer.incInd();
         for(int i = 0;i<getSize(); i++)
-            writer.Stream() << writer.ind() << "<F v=\"" <<  _lValueList[i] <<"\"/>" << endl; ;
+            writer.Stream() << writer.ind() << "<F v=\"" <<  _lValueList[i] <<"\"/>" << '\n';
         writer.decInd();
-        writer.Stream() << writer.ind() <<"</FloatList>" << endl ;
+        writer.Stream() << writer.ind() <<"</FloatList>" << '\n' ;
     }
     else {
         writer.Stream() << writer.ind() << "<FloatList file=\"" <<
-            (getSize()?writer.addFile(getName(), this):"") << "\"/>" << std::endl;
+            (getSize()?writer.addFile(getName(), this):"") << "\"/>" << '\n';
     }
 }
 
@@ -1217,15 +1217,11 @@ void PropertyFloatList::SaveDocFile (Base::Writer &writer) const
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
     if (!isSinglePrecision()) {
-        for (std::vector<double>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << *it;
-        }
+        str.write(_lValueList.data(), _lValueList.size());
     }
     else {
-        for (std::vector<double>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float v = (float)*it;
-            str << v;
-        }
+        std::vector<float> values(_lValueList.begin(), _lValueList.end());
+        str.write(values.data(), values.size());
     }
 }
 
@@ -1236,16 +1232,12 @@ void PropertyFloatList::RestoreDocFile(Base::Reader &reader)
     str >> uCt;
     std::vector<double> values(uCt);
     if (!isSinglePrecision()) {
-        for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> *it;
-        }
+        str.read(values.data(), values.size());
     }
     else {
-        for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-            float val;
-            str >> val;
-            (*it) = val;
-        }
+        std::vector<float> buffer(uCt);
+        str.read(buffer.data(), buffer.size());
+        values.assign(buffer.begin(), buffer.end());
     }
     setValues(values);
 }
@@ -1452,7 +1444,7 @@ void PropertyString::Save (Base::Writer &writer) const
     }
     if(!exported)
         val = encodeAttribute(_cValue);
-    writer.Stream() <<"value=\"" << val <<"\"/>" << std::endl;
+    writer.Stream() <<"value=\"" << val <<"\"/>" << '\n';
 }
 
 void PropertyString::Restore(Base::XMLReader &reader)
@@ -1603,7 +1595,7 @@ void PropertyUUID::setPyObject(PyObject *value)
 
 void PropertyUUID::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Uuid value=\"" << _uuid.getValue() <<"\"/>" << std::endl;
+    writer.Stream() << writer.ind() << "<Uuid value=\"" << _uuid.getValue() <<"\"/>" << '\n';
 }
 
 void PropertyUUID::Restore(Base::XMLReader &reader)
@@ -1718,14 +1710,14 @@ unsigned int PropertyStringList::getMemSize () const
 
 void PropertyStringList::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<StringList count=\"" <<  getSize() <<"\">" << endl;
+    writer.Stream() << writer.ind() << "<StringList count=\"" <<  getSize() <<"\">" << '\n';
     writer.incInd();
     for(int i = 0;i<getSize(); i++) {
         std::string val = encodeAttribute(_lValueList[i]);
-        writer.Stream() << writer.ind() << "<String value=\"" <<  val <<"\"/>" << endl;
+        writer.Stream() << writer.ind() << "<String value=\"" <<  val <<"\"/>" << '\n';
     }
     writer.decInd();
-    writer.Stream() << writer.ind() << "</StringList>" << endl ;
+    writer.Stream() << writer.ind() << "</StringList>" << '\n' ;
 }
 
 void PropertyStringList::Restore(Base::XMLReader &reader)
@@ -1887,15 +1879,15 @@ unsigned int PropertyMap::getMemSize () const
 
 void PropertyMap::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Map count=\"" <<  getSize() <<"\">" << endl;
+    writer.Stream() << writer.ind() << "<Map count=\"" <<  getSize() <<"\">" << '\n';
     writer.incInd();
     for (std::map<std::string,std::string>::const_iterator it = _lValueList.begin();it!= _lValueList.end(); ++it) {
         writer.Stream() << writer.ind() << "<Item key=\"" <<  encodeAttribute(it->first)
-                                        << "\" value=\"" <<  encodeAttribute(it->second) <<"\"/>" << endl;
+                                        << "\" value=\"" <<  encodeAttribute(it->second) <<"\"/>" << '\n';
     }
 
     writer.decInd();
-    writer.Stream() << writer.ind() << "</Map>" << endl ;
+    writer.Stream() << writer.ind() << "</Map>" << '\n' ;
 }
 
 void PropertyMap::Restore(Base::XMLReader &reader)
@@ -1994,7 +1986,7 @@ void PropertyBool::Save (Base::Writer &writer) const
         writer.Stream() << "true" <<"\"/>" ;
     else
         writer.Stream() << "false" <<"\"/>" ;
-    writer.Stream() << std::endl;
+    writer.Stream() << '\n';
 }
 
 void PropertyBool::Restore(Base::XMLReader &reader)
@@ -2117,7 +2109,7 @@ void PropertyBoolList::Save (Base::Writer &writer) const
     std::string bitset;
     boost::to_string(_lValueList, bitset);
     writer.Stream() << bitset <<"\"/>" ;
-    writer.Stream() << std::endl;
+    writer.Stream() << '\n';
 }
 
 void PropertyBoolList::Restore(Base::XMLReader &reader)
@@ -2271,7 +2263,7 @@ void PropertyColor::setPyObject(PyObject *value)
 void PropertyColor::Save (Base::Writer &writer) const
 {
     writer.Stream() << writer.ind() << "<PropertyColor value=\""
-    <<  _cCol.getPackedValue() <<"\"/>" << endl;
+    <<  _cCol.getPackedValue() <<"\"/>" << '\n';
 }
 
 void PropertyColor::Restore(Base::XMLReader &reader)
@@ -2351,7 +2343,7 @@ void PropertyColorList::Save (Base::Writer &writer) const
 {
     if (!writer.isForceXML()) {
         writer.Stream() << writer.ind() << "<ColorList file=\"" <<
-            (getSize()?writer.addFile(getName(), this):"") << "\"/>" << std::endl;
+            (getSize()?writer.addFile(getName(), this):"") << "\"/>" << '\n';
     }
 }
 
@@ -2373,9 +2365,13 @@ void PropertyColorList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
+    // write the packed colors at once
+    std::vector<uint32_t> values;
+    values.reserve(_lValueList.size());
     for (std::vector<App::Color>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << it->getPackedValue();
+        values.push_back(it->getPackedValue());
     }
+    str.write(values.data(), values.size());
 }
 
 void PropertyColorList::RestoreDocFile(Base::Reader &reader)
@@ -2383,11 +2379,12 @@ void PropertyColorList::RestoreDocFile(Base::Reader &reader)
     Base::InputStream str(reader);
     uint32_t uCt=0;
     str >> uCt;
+    std::vector<uint32_t> packed(uCt); // must be 32 bit long
+    if (!str.read(packed.data(), packed.size()))
+        throw Base::BadFormatError("Reading colors failed");
     std::vector<Color> values(uCt);
-    uint32_t value; // must be 32 bit long
-    for (std::vector<App::Color>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> value;
-        it->setPackedValue(value);
+    for (std::size_t i = 0; i < packed.size(); i++) {
+        values[i].setPackedValue(packed[i]);
     }
     setValues(values);
 }
@@ -2506,7 +2503,7 @@ void PropertyMaterial::Save (Base::Writer &writer) const
         << "\" emissiveColor=\"" <<  _cMat.emissiveColor.getPackedValue()
         << "\" shininess=\""     <<  _cMat.shininess
         << "\" transparency=\""  <<  _cMat.transparency
-        << "\"/>" << endl;
+        << "\"/>" << '\n';
 }
 
 void PropertyMaterial::Restore(Base::XMLReader &reader)
@@ -2592,7 +2589,7 @@ void PropertyMaterialList::Save(Base::Writer &writer) const
 {
     if (!writer.isForceXML()) {
         writer.Stream() << writer.ind() << "<MaterialList file=\"" <<
-            (getSize()?writer.addFile(getName(), this):"") << "\"/>" << std::endl;
+            (getSize()?writer.addFile(getName(), this):"") << "\"/>" << '\n';
     }
 }
 
@@ -2688,13 +2685,13 @@ PyObject *PropertyPersistentObject::getPyObject(void){
 void PropertyPersistentObject::Save(Base::Writer &writer) const{
     inherited::Save(writer);
 #define ELEMENT_PERSISTENT_OBJ "PersistentObject"
-    writer.Stream() << writer.ind() << "<" ELEMENT_PERSISTENT_OBJ ">" << std::endl;
+    writer.Stream() << writer.ind() << "<" ELEMENT_PERSISTENT_OBJ ">" << '\n';
     if(_pObject) {
         writer.incInd();
         _pObject->Save(writer);
         writer.decInd();
     }
-    writer.Stream() << writer.ind() << "</" ELEMENT_PERSISTENT_OBJ ">" << std::endl;
+    writer.Stream() << writer.ind() << "</" ELEMENT_PERSISTENT_OBJ ">" << '\n';
 }
 
 void PropertyPersistentObject::Restore(Base::XMLReader &reader){
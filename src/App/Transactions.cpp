@@ -112,7 +112,14 @@ int Transaction::getLastID() {
 
 unsigned int Transaction::getMemSize (void) const
 {
-    return 0;
+    std::uint64_t size = 0;
+    for (auto &info : _Objects) {
+        size += info.second->getMemSize();
+        // the transaction owns a removed object until it's destroyed, see ~Transaction()
+        if (info.second->status == TransactionObject::New && !info.first->isAttachedToDocument())
+            size += info.first->getMemSize();
+    }
+    return clampMemSize(size);
 }
 
 void Transaction::Save (Base::Writer &/*writer*/) const
@@ -367,7 +374,7 @@ void TransactionObject::setProperty(const Property* pcProp)
     if(!data.property && data.name.empty()) {
         static_cast<DynamicProperty::PropData&>(data) = 
             pcProp->getContainer()->getDynamicPropertyData(pcProp);
-        data.property = pcProp->Copy();
+        data.property = pcProp->copyForUndo();
         data.propertyType = pcProp->getTypeId();
         data.property->setStatusValue(pcProp->getStatus());
     }
@@ -398,7 +405,7 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
     if(add) 
         data.property = 0;
     else {
-        data.property = pcProp->Copy();
+        data.property = pcProp->copyForUndo();
         data.propertyType = pcProp->getTypeId();
         data.property->setStatusValue(pcProp->getStatus());
     }
@@ -406,7 +413,12 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
 
 unsigned int TransactionObject::getMemSize (void) const
 {
-    return 0;
+    std::uint64_t size = 0;
+    for (auto &v : _PropChangeMap) {
+        if (v.second.property)
+            size += v.second.property->getUndoMemSize();
+    }
+    return clampMemSize(size);
 }
 
 void TransactionObject::Save (Base::Writer &/*writer*/) const
@@ -52,6 +52,7 @@
 #   ifdef FC_OS_WIN32
 #   include <io.h>
 #   endif
+#   include <atomic>
 #   include <sstream>
 #   include <stdio.h>
 #endif
@@ -214,6 +215,11 @@ inline bool DOMTreeErrorReporter::getSawErrors() const
     return fSawErrors;
 }
 
+namespace {
+std::atomic<unsigned long> LookupCount(0);
+std::atomic<unsigned long> DOMLookupCount(0);
+}
+
 
 //**************************************************************************
 //**************************************************************************
@@ -427,15 +433,14 @@ bool ParameterGrp::HasGroup(const char* Name) const
 
 bool ParameterGrp::GetBool(const char* Name, bool bPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
-    // if not return preset
-    if (!pcElem) return bPreset;
-    // if yes check the value and return
-    if (strcmp(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),"1"))
-        return false;
-    else
+    return GetCached<bool>(_boolCache, Name, bPreset, [this, Name](bool& value) {
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
+        if (!pcElem) return false;
+        // if yes check the value
+        value = strcmp(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),"1") == 0;
         return true;
+    });
 }
 
 void  ParameterGrp::SetBool(const char* Name, bool bValue)
@@ -445,6 +450,7 @@ void  ParameterGrp::SetBool(const char* Name, bool bValue)
     if (pcElem) {
         // and set the value
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(bValue?"1":"0").unicodeForm());
+        SetCached<bool>(_boolCache, Name, bValue);
         // trigger observer
         Notify(Name);
     }
@@ -496,12 +502,13 @@ std::vector<std::pair<std::string,bool> > ParameterGrp::GetBoolMap(const char *
 
 long ParameterGrp::GetInt(const char* Name, long lPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
-    // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return atol (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    return GetCached<long>(_intCache, Name, lPreset, [this, Name](long& value) {
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
+        if (!pcElem) return false;
+        value = atol (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+        return true;
+    });
 }
 
 void  ParameterGrp::SetInt(const char* Name, long lValue)
@@ -513,6 +520,7 @@ void  ParameterGrp::SetInt(const char* Name, long lValue)
         // and set the value
         sprintf(cBuf,"%li",lValue);
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        SetCached<long>(_intCache, Name, lValue);
         // trigger observer
         Notify(Name);
     }
@@ -559,12 +567,13 @@ std::vector<std::pair<std::string,long> > ParameterGrp::GetIntMap(const char * s
 
 unsigned long ParameterGrp::GetUnsigned(const char* Name, unsigned long lPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
-    // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return strtoul (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10);
+    return GetCached<unsigned long>(_unsignedCache, Name, lPreset, [this, Name](unsigned long& value) {
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
+        if (!pcElem) return false;
+        value = strtoul (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10);
+        return true;
+    });
 }
 
 void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
@@ -576,6 +585,7 @@ void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
         // and set the value
         sprintf(cBuf,"%lu",lValue);
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        SetCached<unsigned long>(_unsignedCache, Name, lValue);
         // trigger observer
         Notify(Name);
     }
@@ -622,12 +632,13 @@ std::vector<std::pair<std::string,unsigned long> > ParameterGrp::GetUnsignedMap(
 
 double ParameterGrp::GetFloat(const char* Name, double dPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
-    // if not return preset
-    if (!pcElem) return dPreset;
-    // if yes check the value and return
-    return atof (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    return GetCached<double>(_floatCache, Name, dPreset, [this, Name](double& value) {
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
+        if (!pcElem) return false;
+        value = atof (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+        return true;
+    });
 }
 
 void  ParameterGrp::SetFloat(const char* Name, double dValue)
@@ -639,6 +650,8 @@ void  ParameterGrp::SetFloat(const char* Name, double dValue)
         // and set the value
         sprintf(cBuf,"%.12f",dValue); // use %.12f instead of %f to handle values < 1.0e-6
         pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+        // cache the value as it is read back from the DOM
+        SetCached<double>(_floatCache, Name, atof(cBuf));
         // trigger observer
         Notify(Name);
     }
@@ -712,6 +725,7 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
         else {
             pcElem2->setNodeValue(XUTF8Str(sValue).unicodeForm());
         }
+        SetCached<std::string>(_asciiCache, Name, sValue);
         // trigger observer
         Notify(Name);
     }
@@ -719,21 +733,19 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
 
 std::string ParameterGrp::GetASCII(const char* Name, const char * pPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
-    // if not return preset
-    if (!pcElem) {
-        if (pPreset==0)
-            return std::string("");
-        else
-            return std::string(pPreset);
-    }
-    // if yes check the value and return
-    DOMNode *pcElem2 = pcElem->getFirstChild();
-    if (pcElem2)
-        return std::string(StrXUTF8(pcElem2->getNodeValue()).c_str());
-    else
-        return std::string("");
+    std::string preset;
+    if (pPreset)
+        preset = pPreset;
+    return GetCached<std::string>(_asciiCache, Name, preset, [this, Name](std::string& value) {
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
+        if (!pcElem) return false;
+        // if yes check the value
+        DOMNode *pcElem2 = pcElem->getFirstChild();
+        if (pcElem2)
+            value = StrXUTF8(pcElem2->getNodeValue()).c_str();
+        return true;
+    });
 }
 
 std::vector<std::string> ParameterGrp::GetASCIIs(const char * sFilter) const
@@ -797,6 +809,7 @@ void ParameterGrp::RemoveASCII(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    RemoveCached<std::string>(_asciiCache, Name);
 
     // trigger observer
     Notify(Name);
@@ -812,6 +825,7 @@ void ParameterGrp::RemoveBool(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    RemoveCached<bool>(_boolCache, Name);
 
     // trigger observer
     Notify(Name);
@@ -840,6 +854,7 @@ void ParameterGrp::RemoveFloat(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    RemoveCached<double>(_floatCache, Name);
 
     // trigger observer
     Notify(Name);
@@ -855,6 +870,7 @@ void ParameterGrp::RemoveInt(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    RemoveCached<long>(_intCache, Name);
 
     // trigger observer
     Notify(Name);
@@ -870,6 +886,7 @@ void ParameterGrp::RemoveUnsigned(const char* Name)
 
     DOMNode* node = _pGroupNode->removeChild(pcElem);
     node->release();
+    RemoveCached<unsigned long>(_unsignedCache, Name);
 
     // trigger observer
     Notify(Name);
@@ -966,6 +983,8 @@ void ParameterGrp::Clear(void)
         child->release();
     }
 
+    ClearCache();
+
     // trigger observer
     Notify("");
 }
@@ -1011,6 +1030,61 @@ XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *ParameterGrp::FindElement(XERCES_CPP_
     return NULL;
 }
 
+template <typename T, typename Func>
+T ParameterGrp::GetCached(ValueCache<T>& cache, const char* Name, const T& preset, Func readValue) const
+{
+    ++LookupCount;
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    auto it = cache.find(Name);
+    if (it == cache.end()) {
+        ++DOMLookupCount;
+        CachedValue<T> entry{false, T()};
+        entry.exists = readValue(entry.value);
+        it = cache.emplace(Name, entry).first;
+    }
+    return it->second.exists ? it->second.value : preset;
+}
+
+template <typename T>
+void ParameterGrp::SetCached(ValueCache<T>& cache, const char* Name, const T& value)
+{
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    cache[Name] = CachedValue<T>{true, value};
+}
+
+template <typename T>
+void ParameterGrp::RemoveCached(ValueCache<T>& cache, const char* Name)
+{
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    cache[Name] = CachedValue<T>{false, T()};
+}
+
+void ParameterGrp::ClearCache()
+{
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    _boolCache.clear();
+    _intCache.clear();
+    _unsignedCache.clear();
+    _floatCache.clear();
+    _asciiCache.clear();
+}
+
+unsigned long ParameterGrp::GetLookupCount()
+{
+    return LookupCount;
+}
+
+unsigned long ParameterGrp::GetDOMLookupCount()
+{
+    return DOMLookupCount;
+}
+
+void ParameterGrp::ResetLookupCounts()
+{
+    LookupCount = 0;
+    DOMLookupCount = 0;
+}
+
 XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *ParameterGrp::FindNextElement(XERCES_CPP_NAMESPACE_QUALIFIER DOMNode *Prev, const char* Type) const
 {
     DOMNode *clChild = Prev;
@@ -1354,6 +1428,7 @@ int ParameterManager::LoadDocument(const XERCES_CPP_NAMESPACE_QUALIFIER InputSou
         throw XMLBaseException("Malformed Parameter document: Root group not found");
 
     _pGroupNode = FindElement(rootElem,"FCParamGroup","Root");
+    ClearCache();
 
     if (!_pGroupNode)
         throw XMLBaseException("Malformed Parameter document: Root group not found");
@@ -1533,6 +1608,7 @@ void  ParameterManager::CreateDocument(void)
     _pGroupNode = _pDocument->createElement(XStr("FCParamGroup").unicodeForm());
     static_cast<DOMElement*>(_pGroupNode)->setAttribute(XStr("Name").unicodeForm(), XStr("Root").unicodeForm());
     rootElem->appendChild(_pGroupNode);
+    ClearCache();
 }
 
 void  ParameterManager::CheckDocument() const
@@ -58,6 +58,9 @@
 #endif
 
 #include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <xercesc/util/XercesDefs.hpp>
 
@@ -237,6 +240,17 @@ public:
      */
     void NotifyAll();
 
+    /** @name Lookup statistics
+     * The number of calls of the Get methods for single values of all groups
+     * and how many of them had to search the DOM because the value wasn't
+     * cached yet.
+     */
+    //@{
+    static unsigned long GetLookupCount();
+    static unsigned long GetDOMLookupCount();
+    static void ResetLookupCounts();
+    //@}
+
 protected:
     /// constructor is protected (handle concept)
     ParameterGrp(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *GroupNode=0L,const char* sName=0L);
@@ -263,6 +277,32 @@ protected:
      */
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *FindOrCreateElement(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *Start, const char* Type, const char* Name) const;
 
+    /** @name Value cache
+     * The Get methods keep the values read from the DOM, including the fact
+     * that an entry doesn't exist, so that a repeated lookup doesn't need to
+     * search the DOM. The Set and Remove methods update the cache before the
+     * observers are notified, Clear() and loading a document drop it.
+     */
+    //@{
+    template <typename T>
+    struct CachedValue
+    {
+        bool exists;
+        T value;
+    };
+    template <typename T>
+    using ValueCache = std::unordered_map<std::string, CachedValue<T> >;
+
+    /// \a readValue searches the DOM, returns false if there is no entry
+    template <typename T, typename Func>
+    T GetCached(ValueCache<T>& cache, const char* Name, const T& preset, Func readValue) const;
+    template <typename T>
+    void SetCached(ValueCache<T>& cache, const char* Name, const T& value);
+    template <typename T>
+    void RemoveCached(ValueCache<T>& cache, const char* Name);
+    void ClearCache();
+    //@}
+
 
     /// DOM Node of the Base node of this group
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *_pGroupNode;
@@ -271,6 +311,13 @@ protected:
     /// map of already exported groups
     std::map <std::string ,Base::Reference<ParameterGrp> > _GroupMap;
 
+    mutable std::mutex _cacheMutex;
+    mutable ValueCache<bool> _boolCache;
+    mutable ValueCache<long> _intCache;
+    mutable ValueCache<unsigned long> _unsignedCache;
+    mutable ValueCache<double> _floatCache;
+    mutable ValueCache<std::string> _asciiCache;
+
 };
 
 /** The parameter serializer class
@@ -111,7 +111,7 @@ void Persistence::dumpToStream(std::ostream& stream, int compression)
         writer.setMode("BinaryBrep");
 
         //save the content (we need to encapsulte it with xml tags to be able to read single element xmls like happen for properties)
-        writer.Stream() << "<Content>" << std::endl;
+        writer.Stream() << "<Content>" << '\n';
         Save(writer);
         writer.Stream() << "</Content>";
         writer.writeFiles();
@@ -28,6 +28,8 @@
 
 
 #include <assert.h>
+#include <cstdint>
+#include <limits>
 
 #include "BaseClass.h"
 
@@ -49,6 +51,13 @@ public:
      * which runs fast! Is it two bytes or a GB?
      */
     virtual unsigned int getMemSize (void) const = 0;
+    /** Converts a size summed up in 64 bits to the result of getMemSize(),
+     * sizes beyond its range are clamped instead of wrapping around.
+     */
+    static unsigned int clampMemSize(std::uint64_t size) {
+        return size > std::numeric_limits<unsigned int>::max()
+            ? std::numeric_limits<unsigned int>::max() : static_cast<unsigned int>(size);
+    }
     /** This method is used to save properties to an XML document.
      * A good example you'll find in PropertyStandard.cpp, e.g. the vector:
      * \code
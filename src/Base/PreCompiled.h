@@ -62,6 +62,8 @@
 #endif
 
 // STL
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <list>
 #include <map>
@@ -24,6 +24,9 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <cstdlib>
+# include <cstring>
 # include <xercesc/sax/SAXParseException.hpp>
 # include <xercesc/sax/SAXException.hpp>
 # include <xercesc/sax2/XMLReaderFactory.hpp>
@@ -56,6 +59,393 @@ XERCES_CPP_NAMESPACE_USE
 using namespace std;
 
 
+// ---------------------------------------------------------------------------
+//  Base::XMLPullParser
+// ---------------------------------------------------------------------------
+
+namespace Base {
+
+/**
+ * A non-validating XML parser that reads the whole document into memory and
+ * parses it in place. It understands what FreeCAD writes: elements with
+ * attributes, character data, CDATA sections, comments, processing
+ * instructions and a DOCTYPE declaration. Attribute names and values are
+ * unescaped and terminated inside the buffer, so no string is allocated per
+ * element. Only UTF-8 encoded documents are supported.
+ */
+class XMLPullParser
+{
+public:
+    enum Event {
+        EndOfDocument,
+        StartTag,
+        EmptyTag,
+        EndTag,
+        Text,
+        StartCDATA,
+        EndCDATA
+    };
+
+    explicit XMLPullParser(std::istream& str)
+      : _pos(nullptr), _end(nullptr), _name(nullptr), _nameLength(0)
+      , _text(nullptr), _textLength(0), _cdata(0)
+    {
+        const std::size_t chunk = 0x10000;
+        std::size_t size = 0;
+        for (;;) {
+            _buffer.resize(size + chunk);
+            str.read(&_buffer[size], chunk);
+            size += static_cast<std::size_t>(str.gcount());
+            if (!str)
+                break;
+        }
+        _buffer.resize(size);
+
+        _pos = &_buffer[0];
+        _end = _pos + size;
+        // skip the byte order mark
+        if (size >= 3 && std::memcmp(_pos, "\xEF\xBB\xBF", 3) == 0)
+            _pos += 3;
+    }
+
+    /// returns true if the data looks like an XML document
+    bool isValid() const
+    {
+        const char* p = skipSpace(_pos);
+        return p < _end && *p == '<';
+    }
+
+    Event next()
+    {
+        // the content of a CDATA section is reported as text
+        if (_cdata == 1) {
+            _cdata = 2;
+            return Text;
+        }
+        else if (_cdata == 2) {
+            _cdata = 0;
+            return EndCDATA;
+        }
+
+        for (;;) {
+            if (_pos >= _end) {
+                if (!_elements.empty())
+                    error("Unexpected end of document");
+                return EndOfDocument;
+            }
+
+            if (*_pos != '<') {
+                char* begin = _pos;
+                char* lt = static_cast<char*>(std::memchr(_pos, '<', _end - _pos));
+                _pos = lt ? lt : _end;
+                if (skipSpace(begin) == _pos)
+                    continue;
+                _text = begin;
+                _textLength = decode(begin, _pos, false) - begin;
+                return Text;
+            }
+
+            if (_pos + 1 >= _end)
+                error("Unexpected end of document");
+
+            switch (_pos[1]) {
+            case '/':
+                parseEndTag();
+                return EndTag;
+            case '?':
+                _pos = skipPast(_pos + 2, "?>");
+                break;
+            case '!':
+                if (startsWith(_pos, "<!--")) {
+                    _pos = skipPast(_pos + 4, "-->");
+                }
+                else if (startsWith(_pos, "<![CDATA[")) {
+                    char* begin = _pos + 9;
+                    _pos = skipPast(begin, "]]>");
+                    _text = begin;
+                    _textLength = _pos - 3 - begin;
+                    _cdata = 1;
+                    return StartCDATA;
+                }
+                else {
+                    skipDeclaration();
+                }
+                break;
+            default:
+                return parseStartTag() ? EmptyTag : StartTag;
+            }
+        }
+    }
+
+    /// the name of the current start or end tag
+    const char* name() const
+    {
+        return _name;
+    }
+    std::size_t nameLength() const
+    {
+        return _nameLength;
+    }
+    /// the text of a Text event
+    const char* text() const
+    {
+        return _text;
+    }
+    std::size_t textLength() const
+    {
+        return _textLength;
+    }
+
+    /// the attributes of the last start tag
+    std::size_t attributeCount() const
+    {
+        return _attributes.size();
+    }
+    const char* attribute(const char* name) const
+    {
+        for (const auto& it : _attributes) {
+            if (std::strcmp(it.first, name) == 0)
+                return it.second;
+        }
+        return nullptr;
+    }
+
+private:
+    static bool isSpace(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+    }
+    static bool isNameEnd(char c)
+    {
+        return isSpace(c) || c == '>' || c == '/' || c == '=';
+    }
+    static bool startsWith(const char* p, const char* token)
+    {
+        return std::strncmp(p, token, std::strlen(token)) == 0;
+    }
+
+    char* skipSpace(char* p) const
+    {
+        while (p < _end && isSpace(*p))
+            ++p;
+        return p;
+    }
+    char* skipName(char* p) const
+    {
+        while (p < _end && !isNameEnd(*p))
+            ++p;
+        return p;
+    }
+    /// returns the position behind \a token
+    char* skipPast(char* p, const char* token) const
+    {
+        std::size_t len = std::strlen(token);
+        while (p + len <= _end) {
+            p = static_cast<char*>(std::memchr(p, token[0], _end - p));
+            if (!p || p + len > _end)
+                break;
+            if (std::memcmp(p, token, len) == 0)
+                return p + len;
+            ++p;
+        }
+        error("Unexpected end of document");
+    }
+    /// skips a declaration like DOCTYPE including an internal subset
+    void skipDeclaration()
+    {
+        int depth = 0;
+        for (char* p = _pos + 2; p < _end; ++p) {
+            if (*p == '[')
+                ++depth;
+            else if (*p == ']')
+                --depth;
+            else if (*p == '>' && depth <= 0) {
+                _pos = p + 1;
+                return;
+            }
+        }
+        error("Unexpected end of document");
+    }
+
+    /// returns true for an empty element tag
+    bool parseStartTag()
+    {
+        char* p = _pos + 1;
+        char* end = skipName(p);
+        if (end == p)
+            error("Invalid element name");
+        _name = p;
+        _nameLength = end - p;
+        _attributes.clear();
+
+        for (p = end;;) {
+            p = skipSpace(p);
+            if (p >= _end)
+                error("Unexpected end of document");
+            if (*p == '>') {
+                _pos = p + 1;
+                _elements.emplace_back(_name, _nameLength);
+                return false;
+            }
+            if (*p == '/') {
+                if (p + 1 >= _end || p[1] != '>')
+                    error("Expected '>' after '/'");
+                _pos = p + 2;
+                return true;
+            }
+
+            char* attrName = p;
+            char* attrNameEnd = skipName(p);
+            if (attrNameEnd == attrName)
+                error("Invalid attribute name");
+            p = skipSpace(attrNameEnd);
+            if (p >= _end || *p != '=')
+                error("Expected '=' after attribute name");
+            p = skipSpace(p + 1);
+            if (p >= _end || (*p != '"' && *p != '\''))
+                error("Expected quoted attribute value");
+            char* value = p + 1;
+            char* valueEnd = static_cast<char*>(std::memchr(value, *p, _end - value));
+            if (!valueEnd)
+                error("Unterminated attribute value");
+
+            // the decoded value is never longer, so it can be terminated
+            // at the latest where the closing quote was
+            *attrNameEnd = '\0';
+            *decode(value, valueEnd, true) = '\0';
+            _attributes.emplace_back(attrName, value);
+            p = valueEnd + 1;
+        }
+    }
+
+    void parseEndTag()
+    {
+        char* p = _pos + 2;
+        char* end = skipName(p);
+        _name = p;
+        _nameLength = end - p;
+        if (_elements.empty() || _elements.back().second != _nameLength ||
+            std::memcmp(_elements.back().first, _name, _nameLength) != 0)
+            error("Mismatched end tag");
+        _elements.pop_back();
+
+        p = skipSpace(end);
+        if (p >= _end || *p != '>')
+            error("Expected '>' in end tag");
+        _pos = p + 1;
+    }
+
+    /** Replaces entity and character references and normalizes line ends
+     * in place, returns the new end of the text.
+     */
+    char* decode(char* begin, char* end, bool attribute) const
+    {
+        char* out = begin;
+        for (char* in = begin; in < end;) {
+            char c = *in;
+            if (c == '&') {
+                char* semi = static_cast<char*>(std::memchr(in, ';', end - in));
+                if (!semi)
+                    error("Unterminated entity reference");
+                out = decodeReference(in + 1, semi, out);
+                in = semi + 1;
+                continue;
+            }
+            else if (c == '\r') {
+                // a CR LF pair counts as a single line end
+                if (in + 1 < end && in[1] == '\n')
+                    ++in;
+                c = '\n';
+            }
+            if (attribute && isSpace(c))
+                c = ' ';
+            *out++ = c;
+            ++in;
+        }
+        return out;
+    }
+
+    /// decodes the reference between '&' and ';', the result is never longer
+    char* decodeReference(const char* ref, const char* semi, char* out) const
+    {
+        std::size_t len = semi - ref;
+        if (len > 1 && ref[0] == '#') {
+            char* stop = nullptr;
+            unsigned long code;
+            if (ref[1] == 'x')
+                code = std::strtoul(ref + 2, &stop, 16);
+            else
+                code = std::strtoul(ref + 1, &stop, 10);
+            if (stop != semi || code == 0 || code > 0x10FFFF)
+                error("Invalid character reference");
+            // encode as UTF-8
+            if (code < 0x80) {
+                *out++ = static_cast<char>(code);
+            }
+            else if (code < 0x800) {
+                *out++ = static_cast<char>(0xC0 | (code >> 6));
+                *out++ = static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else if (code < 0x10000) {
+                *out++ = static_cast<char>(0xE0 | (code >> 12));
+                *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else {
+                *out++ = static_cast<char>(0xF0 | (code >> 18));
+                *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (code & 0x3F));
+            }
+            return out;
+        }
+
+        static const struct {
+            const char* name;
+            std::size_t length;
+            char value;
+        } entities[] = {
+            {"lt", 2, '<'}, {"gt", 2, '>'}, {"amp", 3, '&'},
+            {"quot", 4, '"'}, {"apos", 4, '\''}
+        };
+        for (const auto& it : entities) {
+            if (it.length == len && std::memcmp(it.name, ref, len) == 0) {
+                *out++ = it.value;
+                return out;
+            }
+        }
+        error("Unknown entity reference");
+    }
+
+    [[noreturn]] void error(const char* msg) const
+    {
+        const char* begin = _buffer.c_str();
+        const char* pos = std::min<const char*>(_pos, _end);
+        std::ostringstream str;
+        str << msg << " in line " << std::count(begin, pos, '\n') + 1;
+        throw Base::XMLParseException(str.str());
+    }
+
+private:
+    std::string _buffer;
+    char* _pos;
+    char* _end;
+    const char* _name;
+    std::size_t _nameLength;
+    const char* _text;
+    std::size_t _textLength;
+    /// 1 if the text of a CDATA section is next, 2 if its end is next
+    int _cdata;
+    std::vector<std::pair<const char*, const char*>> _attributes;
+    /// the names of the open elements
+    std::vector<std::pair<const char*, std::size_t>> _elements;
+};
+
+}
+
+namespace {
+Base::XMLReader::ParserType DefaultParserType = Base::XMLReader::XercesParser;
+}
 
 // ---------------------------------------------------------------------------
 //  Base::XMLReader: Constructors and Destructor
@@ -63,7 +453,7 @@ using namespace std;
 
 Base::XMLReader::XMLReader(const char* FileName, std::istream& str)
   : DocumentSchema(0), ProgramVersion(""), FileVersion(0), Level(0),
-    CharacterCount(0), ReadType(None), _File(FileName), _valid(false),
+    CharacterCount(0), ReadType(None), _File(FileName), parser(0), _valid(false),
     _verbose(true)
 {
 #ifdef _MSC_VER
@@ -72,6 +462,12 @@ Base::XMLReader::XMLReader(const char* FileName, std::istream& str)
     str.imbue(std::locale::classic());
 #endif
 
+    if (DefaultParserType == PullParser) {
+        pull.reset(new XMLPullParser(str));
+        _valid = pull->isValid();
+        return;
+    }
+
     // create the parser
     parser = XMLReaderFactory::createXMLReader();
     //parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, false);
@@ -115,6 +511,21 @@ Base::XMLReader::~XMLReader()
     delete parser;
 }
 
+void Base::XMLReader::setDefaultParser(ParserType type)
+{
+    DefaultParserType = type;
+}
+
+Base::XMLReader::ParserType Base::XMLReader::defaultParser()
+{
+    return DefaultParserType;
+}
+
+Base::XMLReader::ParserType Base::XMLReader::parserType() const
+{
+    return pull ? PullParser : XercesParser;
+}
+
 const char* Base::XMLReader::localName(void) const
 {
     return LocalName.c_str();
@@ -122,78 +533,66 @@ const char* Base::XMLReader::localName(void) const
 
 unsigned int Base::XMLReader::getAttributeCount(void) const
 {
+    if (pull)
+        return (unsigned int)pull->attributeCount();
     return (unsigned int)AttrMap.size();
 }
 
-long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
+const char* Base::XMLReader::findAttribute(const char* AttrName) const
 {
+    if (pull)
+        return pull->attribute(AttrName);
+
     AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    return pos != AttrMap.end() ? pos->second.c_str() : 0;
+}
 
-    if (pos != AttrMap.end()) {
-        return atol(pos->second.c_str());
-    }
-    else {
+const char* Base::XMLReader::getAttributeValue(const char* AttrName) const
+{
+    const char* value = findAttribute(AttrName);
+    if (!value) {
         // wrong name, use hasAttribute if not sure!
         std::ostringstream msg;
         msg << "XML Attribute: \"" << AttrName << "\" not found";
         throw Base::XMLAttributeError(msg.str());
     }
+    return value;
 }
 
-unsigned long Base::XMLReader::getAttributeAsUnsigned(const char* AttrName) const
+long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    return atol(getAttributeValue(AttrName));
+}
 
-    if (pos != AttrMap.end()) {
-        return strtoul(pos->second.c_str(),0,10);
-    }
-    else {
-        // wrong name, use hasAttribute if not sure!
-        std::ostringstream msg;
-        msg << "XML Attribute: \"" << AttrName << "\" not found";
-        throw Base::XMLAttributeError(msg.str());
-    }
+unsigned long Base::XMLReader::getAttributeAsUnsigned(const char* AttrName) const
+{
+    return strtoul(getAttributeValue(AttrName),0,10);
 }
 
 double Base::XMLReader::getAttributeAsFloat  (const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
-
-    if (pos != AttrMap.end()) {
-        return atof(pos->second.c_str());
-    }
-    else {
-        // wrong name, use hasAttribute if not sure!
-        std::ostringstream msg;
-        msg << "XML Attribute: \"" << AttrName << "\" not found";
-        throw Base::XMLAttributeError(msg.str());
-    }
+    return atof(getAttributeValue(AttrName));
 }
 
 const char*  Base::XMLReader::getAttribute (const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
-
-    if (pos != AttrMap.end()) {
-        return pos->second.c_str();
-    }
-    else {
-        // wrong name, use hasAttribute if not sure!
-        std::ostringstream msg;
-        msg << "XML Attribute: \"" << AttrName << "\" not found";
-        throw Base::XMLAttributeError(msg.str());
-    }
+    return getAttributeValue(AttrName);
 }
 
 bool Base::XMLReader::hasAttribute (const char* AttrName) const
 {
-    return AttrMap.find(AttrName) != AttrMap.end();
+    return findAttribute(AttrName) != 0;
 }
 
 bool Base::XMLReader::read(void)
 {
     ReadType = None;
 
+    if (pull) {
+        readPullEvent();
+        return true;
+    }
+
     try {
         parser->parseNext(token);
     }
@@ -237,6 +636,41 @@ bool Base::XMLReader::read(void)
     return true;
 }
 
+void Base::XMLReader::readPullEvent()
+{
+    // emulate the events of the SAX handlers below
+    switch (pull->next()) {
+    case XMLPullParser::StartTag:
+        Level++;
+        LocalName.assign(pull->name(), pull->nameLength());
+        ReadType = StartElement;
+        break;
+    case XMLPullParser::EmptyTag:
+        LocalName.assign(pull->name(), pull->nameLength());
+        ReadType = StartEndElement;
+        break;
+    case XMLPullParser::EndTag:
+        Level--;
+        LocalName.assign(pull->name(), pull->nameLength());
+        ReadType = EndElement;
+        break;
+    case XMLPullParser::Text:
+        Characters.assign(pull->text(), pull->textLength());
+        CharacterCount += (unsigned int)pull->textLength();
+        ReadType = Chars;
+        break;
+    case XMLPullParser::StartCDATA:
+        ReadType = StartCDATA;
+        break;
+    case XMLPullParser::EndCDATA:
+        ReadType = EndCDATA;
+        break;
+    case XMLPullParser::EndOfDocument:
+        ReadType = EndDocument;
+        break;
+    }
+}
+
 void Base::XMLReader::readElement(const char* ElementName)
 {
     bool ok;
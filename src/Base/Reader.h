@@ -48,6 +48,7 @@ XERCES_CPP_NAMESPACE_END
 namespace Base
 {
 
+class XMLPullParser;
 
 /** The XML reader class
  * This is an important helper class for the store and retrieval system
@@ -111,6 +112,11 @@ void PropertyContainer::Restore(Base::Reader &reader)
     reader.readEndElement("Properties");
 }
  *  \endcode
+ *  \par
+ * The document can be parsed with the Xerces SAX parser or with a fast
+ * non-validating pull parser that reads the whole document into memory and
+ * parses it in place. Which one is used is decided by setDefaultParser()
+ * when the reader is created.
  * \see Base::Persistence
  * \author Juergen Riegel
  */
@@ -123,6 +129,10 @@ public:
         PartialRestoreInProperty = 2,           // Local to the Property
         PartialRestoreInObject = 3              // Local to the object partially restored itself
     };
+    enum ParserType {
+        XercesParser,   /**< The Xerces SAX parser reading the stream progressively */
+        PullParser      /**< The in-memory pull parser */
+    };
     /// open the file and read the first element
     XMLReader(const char* FileName, std::istream&);
     ~XMLReader();
@@ -131,6 +141,15 @@ public:
     bool isVerbose() const { return _verbose; }
     void setVerbose(bool on) { _verbose = on; }
 
+    /** @name Parser selection */
+    //@{
+    /// set the parser used by readers created from now on
+    static void setDefaultParser(ParserType);
+    static ParserType defaultParser();
+    /// the parser used by this reader
+    ParserType parserType() const;
+    //@}
+
     /** @name Parser handling */
     //@{
     /// get the local name of the current Element
@@ -217,6 +236,12 @@ public:
 protected:
     /// read the next element
     bool read(void);
+    /// get the value of an attribute, throws XMLAttributeError if it doesn't exist
+    const char* getAttributeValue(const char* AttrName) const;
+    /// look up an attribute, returns null if it doesn't exist
+    const char* findAttribute(const char* AttrName) const;
+    /// read the next event of the pull parser
+    void readPullEvent();
 
     // -----------------------------------------------------------------------
     //  Handlers for the SAX ContentHandler interface
@@ -290,6 +315,7 @@ protected:
     std::vector<std::string> FileNames;
 
     std::bitset<32> StatusBits;
+    std::unique_ptr<XMLPullParser> pull;
 };
 
 class BaseExport Reader : public std::istream
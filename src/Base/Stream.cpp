@@ -28,6 +28,7 @@
 # include <QByteArray>
 # include <QDataStream>
 # include <QIODevice>
+# include <algorithm>
 # include <cstdlib>
 # include <string>
 # include <cstdio>
@@ -144,6 +145,26 @@ OutputStream& OutputStream::operator << (double d)
     return *this;
 }
 
+void OutputStream::writeArray (const void* data, std::size_t count, std::size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    if (!_swap || size == 1) {
+        _out.write(bytes, static_cast<std::streamsize>(count * size));
+        return;
+    }
+
+    // swap a block at a time to keep the extra memory small
+    const std::size_t blockBytes = 65536;
+    std::size_t blockCount = std::max<std::size_t>(1, blockBytes / size);
+    std::vector<char> block(std::min(count, blockCount) * size);
+    for (std::size_t i = 0; i < count; i += blockCount) {
+        std::size_t num = std::min(blockCount, count - i);
+        std::memcpy(block.data(), bytes + i * size, num * size);
+        SwapEndianArray(block.data(), num, size);
+        _out.write(block.data(), static_cast<std::streamsize>(num * size));
+    }
+}
+
 InputStream::InputStream(std::istream &rin) : _in(rin)
 {
 }
@@ -226,6 +247,14 @@ InputStream& InputStream::operator >> (double& d)
     return *this;
 }
 
+void InputStream::readArray (void* data, std::size_t count, std::size_t size)
+{
+    char* bytes = static_cast<char*>(data);
+    _in.read(bytes, static_cast<std::streamsize>(count * size));
+    if (_swap)
+        SwapEndianArray(bytes, count, size);
+}
+
 // ----------------------------------------------------------------------
 
 ByteArrayOStreambuf::ByteArrayOStreambuf(QByteArray& ba) : _buffer(new QBuffer(&ba))
@@ -23,6 +23,12 @@
 
 #include "PreCompiled.h"
 
+#ifndef _PreComp_
+# include <algorithm>
+# include <cstdint>
+# include <cstring>
+#endif
+
 #include "Swap.h"
 
 unsigned short Base::SwapOrder (void)
@@ -99,4 +105,58 @@ void Base::SwapVar (double& d)
   d = dTmp;
 }
 
+namespace {
+
+inline uint16_t swap16 (uint16_t v)
+{
+  return static_cast<uint16_t>((v >> 8) | (v << 8));
+}
+
+inline uint32_t swap32 (uint32_t v)
+{
+  return (v >> 24) | ((v >> 8) & 0x0000ff00u) | ((v << 8) & 0x00ff0000u) | (v << 24);
+}
+
+inline uint64_t swap64 (uint64_t v)
+{
+  return (static_cast<uint64_t>(swap32(static_cast<uint32_t>(v))) << 32) |
+          swap32(static_cast<uint32_t>(v >> 32));
+}
+
+// The memcpy calls avoid unaligned access and are removed by the compiler
+template <typename T, T (*Swap)(T)>
+void swapArray (char* data, std::size_t count)
+{
+  for (std::size_t i = 0; i < count; i++) {
+    T v;
+    std::memcpy(&v, data + i * sizeof(T), sizeof(T));
+    v = Swap(v);
+    std::memcpy(data + i * sizeof(T), &v, sizeof(T));
+  }
+}
+
+}
+
+void Base::SwapEndianArray (char* data, std::size_t count, std::size_t size)
+{
+  switch (size) {
+  case 0:
+  case 1:
+    break;
+  case 2:
+    swapArray<uint16_t, swap16>(data, count);
+    break;
+  case 4:
+    swapArray<uint32_t, swap32>(data, count);
+    break;
+  case 8:
+    swapArray<uint64_t, swap64>(data, count);
+    break;
+  default:
+    for (std::size_t i = 0; i < count; i++)
+      std::reverse(data + i * size, data + (i + 1) * size);
+    break;
+  }
+}
+
 
@@ -24,6 +24,8 @@
 #ifndef BASE_SWAP_H
 #define BASE_SWAP_H
 
+#include <cstddef>
+
 #define LOW_ENDIAN	(unsigned short) 0x4949
 #define HIGH_ENDIAN	(unsigned short) 0x4D4D
 
@@ -58,6 +60,12 @@ void SwapEndian(T& v)
   v = tmp;
 }
 
+/** Reverses the byte order of \a count values of \a size bytes in place.
+ * For values of 2, 4 and 8 bytes the loops are written so that the compiler
+ * can turn them into vector shuffles.
+ */
+BaseExport void SwapEndianArray (char* data, std::size_t count, std::size_t size);
+
 } // namespace Base
 
 
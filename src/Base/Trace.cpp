@@ -0,0 +1,271 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <chrono>
+# include <cstring>
+# include <memory>
+# include <mutex>
+#endif
+
+#include "Trace.h"
+#include "Exception.h"
+#include "FileInfo.h"
+#include "Stream.h"
+
+using namespace Base;
+
+namespace {
+
+const std::chrono::steady_clock::time_point Epoch = std::chrono::steady_clock::now();
+
+// The spans of a thread. Only the thread itself writes to its buffer, a
+// reader takes the spans up to 'head' and afterwards drops the ones that
+// may have been overwritten in the meantime.
+struct TraceBuffer
+{
+    TraceBuffer(std::size_t size, unsigned int thread)
+        : events(size), head(0), start(0), thread(thread) {}
+
+    std::vector<Trace::Event> events;
+    std::atomic<std::uint64_t> head;   ///< number of spans ever written
+    std::atomic<std::uint64_t> start;  ///< number of spans when last cleared
+    unsigned int thread;
+};
+
+// The buffers outlive their threads, so that the spans of a finished worker
+// thread can still be written. They are removed by Trace::clear().
+struct TraceRegistry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    unsigned int lastThread = 0;
+};
+
+TraceRegistry &registry()
+{
+    static TraceRegistry reg;
+    return reg;
+}
+
+std::atomic<std::size_t> BufferSize(16384);
+thread_local std::shared_ptr<TraceBuffer> ThreadBuffer;
+
+TraceBuffer *threadBuffer()
+{
+    if (!ThreadBuffer) {
+        TraceRegistry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        ThreadBuffer = std::make_shared<TraceBuffer>(
+            std::max<std::size_t>(BufferSize.load(), 1), ++reg.lastThread);
+        reg.buffers.push_back(ThreadBuffer);
+    }
+    return ThreadBuffer.get();
+}
+
+void copyDetail(char *dst, const char *src)
+{
+    const std::size_t size = sizeof(Trace::Event::detail);
+    if (src) {
+        std::size_t len = std::strlen(src);
+        if (len >= size) {
+            // don't split a multi-byte UTF-8 character
+            len = size - 1;
+            while (len > 0 && (static_cast<unsigned char>(src[len]) & 0xC0) == 0x80)
+                --len;
+        }
+        std::memcpy(dst, src, len);
+        dst[len] = 0;
+    }
+    else {
+        dst[0] = 0;
+    }
+}
+
+void writeString(std::ostream &out, const char *str)
+{
+    static const char hex[] = "0123456789abcdef";
+    out << '"';
+    for (; *str; ++str) {
+        unsigned char c = static_cast<unsigned char>(*str);
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (c < 0x20)
+            out << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+// Chrome trace times are microseconds, write nanoseconds with three decimals
+// without depending on the locale of the stream
+void writeTime(std::ostream &out, std::int64_t ns)
+{
+    if (ns < 0) {
+        out << '-';
+        ns = -ns;
+    }
+    std::int64_t frac = ns % 1000;
+    out << ns / 1000 << '.' << char('0' + frac / 100)
+        << char('0' + frac / 10 % 10) << char('0' + frac % 10);
+}
+
+}
+
+std::atomic<bool> Trace::enabled(false);
+
+void Trace::setEnabled(bool on)
+{
+    enabled.store(on);
+}
+
+void Trace::setBufferSize(std::size_t size)
+{
+    BufferSize.store(size);
+}
+
+std::size_t Trace::getBufferSize()
+{
+    return BufferSize.load();
+}
+
+void Trace::clear()
+{
+    TraceRegistry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto &buffers = reg.buffers;
+    // the buffers of finished threads are only referenced here
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                  [](const std::shared_ptr<TraceBuffer> &buffer) {
+                      return buffer.use_count() == 1;
+                  }), buffers.end());
+    for (auto &buffer : buffers)
+        buffer->start.store(buffer->head.load(std::memory_order_acquire));
+}
+
+std::vector<Trace::Event> Trace::getEvents()
+{
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    {
+        TraceRegistry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffers = reg.buffers;
+    }
+
+    std::vector<Event> result;
+    for (auto &buffer : buffers) {
+        const std::uint64_t size = buffer->events.size();
+        std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+        std::uint64_t first = std::max(buffer->start.load(), head > size ? head - size : 0);
+        std::size_t offset = result.size();
+        for (std::uint64_t i = first; i < head; ++i)
+            result.push_back(buffer->events[i % size]);
+
+        // The slots are copied while the thread may be writing to them. This
+        // is a data race that is tolerated: the spans that the thread has
+        // overwritten or may be writing to are dropped afterwards. Besides
+        // the finished spans up to newHead this is the slot of newHead itself.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::uint64_t newHead = buffer->head.load(std::memory_order_relaxed);
+        if (newHead + 1 > first + size) {
+            std::uint64_t lost = std::min(newHead + 1 - size - first, head - first);
+            result.erase(result.begin() + offset, result.begin() + offset + lost);
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(), [](const Event &a, const Event &b) {
+        return a.begin < b.begin;
+    });
+    return result;
+}
+
+std::size_t Trace::writeChromeTrace(std::ostream &out)
+{
+    std::vector<Event> events = getEvents();
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto &ev : events) {
+        out << (first ? "\n" : ",\n") << "{\"name\":";
+        first = false;
+        writeString(out, ev.name);
+        out << ",\"cat\":";
+        writeString(out, ev.category);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << ev.thread << ",\"ts\":";
+        writeTime(out, ev.begin);
+        out << ",\"dur\":";
+        writeTime(out, ev.duration);
+        if (ev.detail[0]) {
+            out << ",\"args\":{\"detail\":";
+            writeString(out, ev.detail);
+            out << '}';
+        }
+        out << '}';
+    }
+    out << "\n]}\n";
+    return events.size();
+}
+
+std::size_t Trace::saveChromeTrace(const std::string &fileName)
+{
+    Base::FileInfo fi(fileName);
+    Base::ofstream file(fi, std::ios::out | std::ios::binary);
+    if (!file)
+        throw Base::FileException("Cannot open trace file", fi);
+    std::size_t count = writeChromeTrace(file);
+    file.close();
+    if (file.fail())
+        throw Base::FileException("Cannot write trace file", fi);
+    return count;
+}
+
+std::int64_t Trace::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - Epoch).count();
+}
+
+void Trace::record(const char *category, const char *name, const char *detail,
+                   std::int64_t begin, std::int64_t end)
+{
+    TraceBuffer *buffer = threadBuffer();
+    std::uint64_t index = buffer->head.load(std::memory_order_relaxed);
+    Event &ev = buffer->events[index % buffer->events.size()];
+    ev.category = category;
+    ev.name = name;
+    copyDetail(ev.detail, detail);
+    ev.thread = buffer->thread;
+    ev.begin = begin;
+    ev.duration = end - begin;
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+void TraceScope::start(const char *detail)
+{
+    copyDetail(this->detail, detail);
+    begin = Trace::now();
+}
@@ -0,0 +1,146 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef BASE_TRACE_H
+#define BASE_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#ifndef FC_GLOBAL_H
+#include <FCGlobal.h>
+#endif
+
+namespace Base
+{
+
+/** Tracing of the main operations
+ *
+ * A span is a section of code that is recorded with its category, name,
+ * an optional detail text, its thread, start time and duration. A span lasts
+ * from the FC_TRACE_SCOPE macro to the end of the enclosing block:
+ * \code
+ * int Document::recompute()
+ * {
+ *     FC_TRACE_SCOPE("App", "recompute", getName());
+ *     ...
+ * }
+ * \endcode
+ * The category and name must be string literals, the detail text is copied.
+ *
+ * Every thread records its spans into its own ring buffer without any
+ * locking, when the buffer is full the oldest spans are overwritten.
+ * Tracing is off by default and then a span only checks an atomic flag.
+ * If FreeCAD is built with FREECAD_USE_TRACING off the macro expands to
+ * nothing at all.
+ *
+ * The recorded spans are written in the JSON format of the Chrome trace
+ * viewer (chrome://tracing) that is also read by https://ui.perfetto.dev.
+ */
+class BaseExport Trace
+{
+public:
+    /// A recorded span, the times are nanoseconds since the start of the application
+    struct Event
+    {
+        const char *category;
+        const char *name;
+        char detail[48];
+        unsigned int thread;
+        std::int64_t begin;
+        std::int64_t duration;
+    };
+
+    static void setEnabled(bool on);
+    static bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+    /** Sets the number of spans a thread keeps, it takes effect for the
+     * threads that record their first span afterwards.
+     */
+    static void setBufferSize(std::size_t size);
+    static std::size_t getBufferSize();
+    /// Discards the recorded spans of all threads
+    static void clear();
+    /** Returns the recorded spans of all threads ordered by their start.
+     * The oldest span of a full buffer is left out because its thread may
+     * be overwriting it.
+     */
+    static std::vector<Event> getEvents();
+    /// Writes the recorded spans in Chrome trace format and returns their number
+    static std::size_t writeChromeTrace(std::ostream &out);
+    /// Writes the recorded spans to a file, throws Base::FileException on failure
+    static std::size_t saveChromeTrace(const std::string &fileName);
+
+    /// The current time in nanoseconds since the start of the application
+    static std::int64_t now();
+    static void record(const char *category, const char *name, const char *detail,
+                       std::int64_t begin, std::int64_t end);
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+/// Records a span from its construction to its destruction
+class BaseExport TraceScope
+{
+public:
+    TraceScope(const char *category, const char *name, const char *detail = nullptr)
+        : category(category), name(name), begin(-1) {
+        if (Trace::isEnabled())
+            start(detail);
+    }
+    ~TraceScope() {
+        if (begin >= 0)
+            Trace::record(category, name, detail, begin, Trace::now());
+    }
+
+private:
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    void start(const char *detail);
+
+    const char *category;
+    const char *name;
+    std::int64_t begin;
+    char detail[sizeof(Trace::Event::detail)];
+};
+
+} //namespace Base
+
+#ifndef FC_NO_TRACING
+# define _FC_TRACE_NAME2(_line) _fc_trace_scope##_line
+# define _FC_TRACE_NAME(_line) _FC_TRACE_NAME2(_line)
+/** Records a span until the end of the enclosing block, the arguments are
+ * the category, the name and optionally a detail text of the span.
+ */
+# define FC_TRACE_SCOPE(...) Base::TraceScope _FC_TRACE_NAME(__LINE__)(__VA_ARGS__)
+#else
+# define FC_TRACE_SCOPE(...) do {} while (0)
+#endif
+
+#endif // BASE_TRACE_H
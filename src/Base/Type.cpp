@@ -24,6 +24,8 @@
 
 #ifndef _PreComp_
 # include <assert.h>
+# include <cstring>
+# include <unordered_map>
 #endif
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
@@ -49,9 +51,34 @@ struct Base::TypeData
   Type parent;
   Type type;
   Type::instantiationMethod instMethod;
+  /// the types from the root type down to this type, see isDerivedFrom()
+  std::vector<Type> ancestors;
 };
 
-map<string,unsigned int> Type::typemap;
+namespace {
+
+// The key of the type map points to the name held by TypeData and stores its
+// hash, so a lookup neither allocates a string nor hashes the name again.
+struct TypeName
+{
+  const char *name;
+  std::size_t hash;
+};
+
+struct TypeNameHasher
+{
+  std::size_t operator()(const TypeName &key) const {
+    return key.hash;
+  }
+  bool operator()(const TypeName &a, const TypeName &b) const {
+    return a.name == b.name || std::strcmp(a.name, b.name) == 0;
+  }
+};
+
+std::unordered_map<TypeName, unsigned int, TypeNameHasher, TypeNameHasher> typemap;
+
+}
+
 vector<TypeData*>        Type::typedata;
 set<string>              Type::loadModuleSet;
 
@@ -144,10 +171,13 @@ const Type Type::createType(const Type parent, const char *name, instantiationMe
   Type newType;
   newType.index = Type::typedata.size();
   TypeData * typeData = new TypeData(name, newType, parent,method);
+  if (parent != badType())
+    typeData->ancestors = typedata[parent.getKey()]->ancestors;
+  typeData->ancestors.push_back(newType);
   Type::typedata.push_back(typeData);
 
   // add to dictionary for fast lookup
-  Type::typemap[name] = newType.getKey();
+  typemap[TypeName{typeData->name.c_str(), hashName(name)}] = newType.getKey();
 
   return newType;
 }
@@ -158,8 +188,10 @@ void Type::init(void)
   assert(Type::typedata.size() == 0);
 
 
-  Type::typedata.push_back(new TypeData("BadType"));
-  Type::typemap["BadType"] = 0;
+  TypeData * typeData = new TypeData("BadType");
+  typeData->ancestors.push_back(badType());
+  Type::typedata.push_back(typeData);
+  typemap[TypeName{typeData->name.c_str(), hashName("BadType")}] = 0;
 
 
 }
@@ -173,11 +205,12 @@ void Type::destruct(void)
   loadModuleSet.clear();
 }
 
-Type Type::fromName(const char *name)
+Type Type::fromName(const char *name, std::size_t hash)
 {
-  std::map<std::string,unsigned int>::const_iterator pos;
+  if (!name)
+    return Type::badType();
 
-  pos = typemap.find(name);
+  auto pos = typemap.find(TypeName{name, hash});
   if (pos != typemap.end())
     return typedata[pos->second]->type;
   else
@@ -204,15 +237,11 @@ const Type Type::getParent(void) const
 
 bool Type::isDerivedFrom(const Type type) const
 {
-
-  Type temp(*this);
-  do {
-    if (temp == type)
-      return true;
-    temp = temp.getParent();
-  } while (temp != badType());
-
-  return false;
+  // If this type is derived from the other one, the other type is on the
+  // path from the root type at the depth of the other type.
+  const std::vector<Type> &path = typedata[index]->ancestors;
+  std::size_t depth = typedata[type.index]->ancestors.size();
+  return depth <= path.size() && path[depth - 1] == type;
 }
 
 int Type::getAllDerivedFrom(const Type type, std::vector<Type> & List)
@@ -26,6 +26,7 @@
 
 // Std. configurations
 
+#include <cstddef>
 #include <string>
 #include <map>
 #include <set>
@@ -76,6 +77,12 @@ struct TypeData;
   One important note about the use of Type to register class
   information: super classes must be registered before any of their
   derived classes are.
+
+  The names of the types are kept in a hash table, a lookup by name
+  doesn't allocate memory and the hash of a constant name is computed
+  by the compiler. Every type knows the path from its root type, so
+  isDerivedFrom() takes constant time whatever the depth of the class
+  hierarchy is.
 */
 class BaseExport Type
 {
@@ -95,6 +102,10 @@ public:
   typedef void * (*instantiationMethod)(void);
 
   static Type fromName(const char *name);
+  /// Looks up a type by its name and the hash of the name, see hashName()
+  static Type fromName(const char *name, std::size_t hash);
+  /// Returns the hash of a type name, evaluated at compile time for a constant name
+  static constexpr std::size_t hashName(const char *name);
   static Type fromKey(unsigned int key);
   const char *getName(void) const;
   const Type getParent(void) const;
@@ -132,7 +143,6 @@ private:
   unsigned int index;
 
 
-  static std::map<std::string,unsigned int> typemap;
   static std::vector<TypeData*>     typedata;
 
   static std::set<std::string>  loadModuleSet;
@@ -194,6 +204,23 @@ Type::isBad(void) const
   return (this->index == 0);
 }
 
+inline constexpr std::size_t
+Type::hashName(const char *name)
+{
+  // FNV-1a
+  std::size_t hash = sizeof(std::size_t) > 4 ? std::size_t(14695981039346656037ULL) : 2166136261U;
+  const std::size_t prime = sizeof(std::size_t) > 4 ? std::size_t(1099511628211ULL) : 16777619U;
+  for (; name && *name; ++name)
+    hash = (hash ^ static_cast<unsigned char>(*name)) * prime;
+  return hash;
+}
+
+inline Type
+Type::fromName(const char *name)
+{
+  return fromName(name, hashName(name));
+}
+
 } //namespace Base
 
 
@@ -36,13 +36,129 @@
 #include "Tools.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <locale>
 #include <limits>
+#include <type_traits>
+#if __has_include(<charconv>)
+# include <charconv>
+#endif
 
 using namespace Base;
 using namespace std;
 using namespace zipios;
 
+namespace {
+
+/**
+ * The number formatting of the writer streams. Floating point numbers
+ * written with the default precision of the writer are written in the
+ * shortest form that reads back to the same value, integers are formatted
+ * directly. Everything else is passed to the standard implementation.
+ */
+class ShortestNumPut : public std::num_put<char>
+{
+public:
+    static const std::streamsize DefaultPrecision = std::numeric_limits<double>::digits10 + 1;
+
+protected:
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, long v) const override
+    {
+        if (!isDecimal(io))
+            return std::num_put<char>::do_put(out, io, fill, v);
+        return putInteger(out, v);
+    }
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, unsigned long v) const override
+    {
+        if (!isDecimal(io))
+            return std::num_put<char>::do_put(out, io, fill, v);
+        return putInteger(out, v);
+    }
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, long long v) const override
+    {
+        if (!isDecimal(io))
+            return std::num_put<char>::do_put(out, io, fill, v);
+        return putInteger(out, v);
+    }
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, unsigned long long v) const override
+    {
+        if (!isDecimal(io))
+            return std::num_put<char>::do_put(out, io, fill, v);
+        return putInteger(out, v);
+    }
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, double v) const override
+    {
+        std::ios_base::fmtflags flags = io.flags();
+        std::ios_base::fmtflags floatfield = flags & std::ios_base::floatfield;
+        if (io.width() != 0 || io.precision() != DefaultPrecision || !std::isfinite(v) ||
+            (flags & (std::ios_base::showpos | std::ios_base::showpoint | std::ios_base::uppercase)) ||
+            (floatfield != std::ios_base::fixed && floatfield != std::ios_base::fmtflags(0)))
+            return std::num_put<char>::do_put(out, io, fill, v);
+
+        char buf[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        char* end = std::to_chars(buf, buf + sizeof(buf), v).ptr;
+#else
+        // the shortest of 15, 16 or 17 significant digits that reads back
+        int len = 0;
+        for (int prec = 15; prec <= 17; prec++) {
+            len = snprintf(buf, sizeof(buf), "%.*g", prec, v);
+            if (strtod(buf, nullptr) == v)
+                break;
+        }
+        char* end = buf + len;
+#endif
+        return std::copy(buf, end, out);
+    }
+
+private:
+    static bool isDecimal(std::ios_base& io)
+    {
+        std::ios_base::fmtflags flags = io.flags();
+        std::ios_base::fmtflags basefield = flags & std::ios_base::basefield;
+        return io.width() == 0 && !(flags & std::ios_base::showpos) &&
+            (basefield == std::ios_base::dec || basefield == std::ios_base::fmtflags(0));
+    }
+
+    template <typename T>
+    static iter_type putInteger(iter_type out, T v)
+    {
+        typedef typename std::make_unsigned<T>::type Unsigned;
+        char buf[24];
+        char* end = buf + sizeof(buf);
+        char* begin = end;
+        bool negative = v < T(0);
+        Unsigned value = negative ? Unsigned(0) - Unsigned(v) : Unsigned(v);
+        do {
+            *--begin = char('0' + value % 10);
+            value /= 10;
+        }
+        while (value);
+        if (negative)
+            *--begin = '-';
+        return std::copy(begin, end, out);
+    }
+};
+
+std::locale classicLocale()
+{
+#ifdef _MSC_VER
+    return std::locale::empty();
+#else
+    return std::locale::classic();
+#endif
+}
+
+const std::locale& shortestLocale()
+{
+    static const std::locale loc(classicLocale(), new ShortestNumPut);
+    return loc;
+}
+
+}
+
 
 
 // ---------------------------------------------------------------------------
@@ -50,7 +166,7 @@ using namespace zipios;
 // ---------------------------------------------------------------------------
 
 Writer::Writer(void)
-  : indent(0),forceXML(false),fileVersion(1)
+  : indent(0),forceXML(false),shortestFloats(false),fileVersion(1)
 {
     indBuf[0] = '\0';
 }
@@ -70,7 +186,7 @@ void Writer::insertAsciiFile(const char* FileName)
     char ch;
     while (from.get(ch))
         Stream().put(ch);
-    Stream() << "]]>" << endl;
+    Stream() << "]]>" << '\n';
 }
 
 void Writer::insertBinFile(const char* FileName)
@@ -86,7 +202,7 @@ void Writer::insertBinFile(const char* FileName)
     std::vector<unsigned char> bytes(fileSize);
     from.read((char*)&bytes[0], fileSize);
     Stream() << Base::base64_encode(&bytes[0], fileSize);
-    Stream() << "]]>" << endl;
+    Stream() << "]]>" << '\n';
 }
 
 void Writer::setForceXML(bool on)
@@ -99,6 +215,24 @@ bool Writer::isForceXML(void)
     return forceXML;
 }
 
+void Writer::setShortestFloats(bool on)
+{
+    shortestFloats = on;
+    Stream().imbue(on ? shortestLocale() : classicLocale());
+}
+
+bool Writer::isShortestFloats() const
+{
+    return shortestFloats;
+}
+
+void Writer::initStream(std::ostream& str) const
+{
+    str.imbue(shortestFloats ? shortestLocale() : classicLocale());
+    str.precision(std::numeric_limits<double>::digits10 + 1);
+    str.setf(ios::fixed,ios::floatfield);
+}
+
 void Writer::setFileVersion(int v)
 {
     fileVersion = v;
@@ -243,25 +377,13 @@ void Writer::decInd(void)
 ZipWriter::ZipWriter(const char* FileName)
   : ZipStream(FileName)
 {
-#ifdef _MSC_VER
-    ZipStream.imbue(std::locale::empty());
-#else
-    ZipStream.imbue(std::locale::classic());
-#endif
-    ZipStream.precision(std::numeric_limits<double>::digits10 + 1);
-    ZipStream.setf(ios::fixed,ios::floatfield);
+    initStream(ZipStream);
 }
 
 ZipWriter::ZipWriter(std::ostream& os)
   : ZipStream(os)
 {
-#ifdef _MSC_VER
-    ZipStream.imbue(std::locale::empty());
-#else
-    ZipStream.imbue(std::locale::classic());
-#endif
-    ZipStream.precision(std::numeric_limits<double>::digits10 + 1);
-    ZipStream.setf(ios::fixed,ios::floatfield);
+    initStream(ZipStream);
 }
 
 void ZipWriter::writeFiles(void)
@@ -286,6 +408,7 @@ ZipWriter::~ZipWriter()
 
 FileWriter::FileWriter(const char* DirName) : DirName(DirName)
 {
+    initStream(FileStream);
 }
 
 FileWriter::~FileWriter()
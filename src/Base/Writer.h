@@ -113,6 +113,18 @@ public:
     void decInd(void);
     //@}
 
+    /** @name number formatting */
+    //@{
+    /** Write floating point numbers in the shortest form that reads back to
+     * the same value instead of the fixed format with 16 decimals. It is off
+     * by default, so that the output is byte-identical to older versions.
+     * Numbers written with a precision other than the default one are not
+     * affected.
+     */
+    void setShortestFloats(bool on);
+    bool isShortestFloats() const;
+    //@}
+
     virtual std::ostream &Stream(void)=0;
 
     /// name for underlying file saves
@@ -120,6 +132,8 @@ public:
 
 protected:
     std::string getUniqueFileName(const char *Name);
+    /// set up the locale and number format of the stream of a sub-class
+    void initStream(std::ostream&) const;
     struct FileEntry {
         std::string FileName;
         const Base::Persistence *Object;
@@ -133,6 +147,7 @@ protected:
     char indBuf[1024];
 
     bool forceXML;
+    bool shortestFloats;
     int fileVersion;
 };
 
@@ -1336,13 +1336,15 @@ bool Document::saveCopy(void)
 
 unsigned int Document::getMemSize (void) const
 {
-    unsigned int size = 0;
+    std::uint64_t size = 0;
 
-    // size of the view providers in the document
+    // size of the view providers in the document, nodes shared by several
+    // view providers are counted once
+    std::set<SoNode*> visited;
     std::map<const App::DocumentObject*,ViewProviderDocumentObject*>::const_iterator it;
     for (it = d->_ViewProviderMap.begin(); it != d->_ViewProviderMap.end(); ++it)
-        size += it->second->getMemSize();
-    return size;
+        size += it->second->getMemSize(visited);
+    return Base::Persistence::clampMemSize(size);
 }
 
 /**
@@ -351,6 +351,24 @@ PyObject* DocumentPy::toggleInSceneGraph(PyObject *args) {
     Py_Return;
 }
 
+PyObject* DocumentPy::getMemoryUsage(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    PY_TRY {
+        Py::Dict dict;
+        for (auto obj : getDocumentPtr()->getDocument()->getObjects()) {
+            ViewProvider* vp = getDocumentPtr()->getViewProvider(obj);
+            if (vp) {
+                unsigned long size = vp->getMemSize();
+                dict.setItem(obj->getNameInDocument(), Py::Long(size));
+            }
+        }
+        return Py::new_reference_to(dict);
+    } PY_CATCH;
+}
+
 Py::Object DocumentPy::getActiveObject(void) const
 {
     App::DocumentObject *object = getDocumentPtr()->getDocument()->getActiveObject();
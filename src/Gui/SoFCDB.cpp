@@ -40,6 +40,25 @@
 #include <Inventor/VRMLnodes/SoVRMLShape.h>
 #include <Inventor/fields/SoSFNode.h>
 #include <Inventor/fields/SoMFNode.h>
+#include <Inventor/fields/SoSFImage.h>
+#include <Inventor/fields/SoMFBool.h>
+#include <Inventor/fields/SoMFColor.h>
+#include <Inventor/fields/SoMFDouble.h>
+#include <Inventor/fields/SoMFEnum.h>
+#include <Inventor/fields/SoMFFloat.h>
+#include <Inventor/fields/SoMFInt32.h>
+#include <Inventor/fields/SoMFMatrix.h>
+#include <Inventor/fields/SoMFPlane.h>
+#include <Inventor/fields/SoMFRotation.h>
+#include <Inventor/fields/SoMFShort.h>
+#include <Inventor/fields/SoMFString.h>
+#include <Inventor/fields/SoMFUInt32.h>
+#include <Inventor/fields/SoMFUShort.h>
+#include <Inventor/fields/SoMFVec2f.h>
+#include <Inventor/fields/SoMFVec3d.h>
+#include <Inventor/fields/SoMFVec3f.h>
+#include <Inventor/fields/SoMFVec4f.h>
+#include <Inventor/misc/SoChildList.h>
 
 #include <Base/FileInfo.h>
 #include <Base/Stream.h>
@@ -758,3 +777,95 @@ SoGroup* Gui::SoFCDB::getStorage()
   assert(storage); //call init first.
   return storage;
 }
+
+namespace {
+// the size of the values of a multiple-value field
+std::size_t getMFieldSize(SoMField* field)
+{
+    static const std::pair<SoType, std::size_t> sizes[] = {
+        {SoMFVec3f::getClassTypeId(),    sizeof(SbVec3f)},
+        {SoMFColor::getClassTypeId(),    sizeof(SbColor)},
+        {SoMFVec2f::getClassTypeId(),    sizeof(SbVec2f)},
+        {SoMFVec4f::getClassTypeId(),    sizeof(SbVec4f)},
+        {SoMFVec3d::getClassTypeId(),    sizeof(SbVec3d)},
+        {SoMFInt32::getClassTypeId(),    sizeof(int32_t)},
+        {SoMFUInt32::getClassTypeId(),   sizeof(uint32_t)},
+        {SoMFFloat::getClassTypeId(),    sizeof(float)},
+        {SoMFDouble::getClassTypeId(),   sizeof(double)},
+        {SoMFShort::getClassTypeId(),    sizeof(short)},
+        {SoMFUShort::getClassTypeId(),   sizeof(unsigned short)},
+        {SoMFBool::getClassTypeId(),     sizeof(SbBool)},
+        {SoMFEnum::getClassTypeId(),     sizeof(int)},
+        {SoMFRotation::getClassTypeId(), sizeof(SbRotation)},
+        {SoMFPlane::getClassTypeId(),    sizeof(SbPlane)},
+        {SoMFMatrix::getClassTypeId(),   sizeof(SbMatrix)},
+    };
+
+    std::size_t num = static_cast<std::size_t>(field->getNum());
+    if (field->isOfType(SoMFString::getClassTypeId())) {
+        SoMFString* strings = static_cast<SoMFString*>(field);
+        std::size_t size = num * sizeof(SbString);
+        for (int i=0; i<strings->getNum(); i++)
+            size += static_cast<std::size_t>((*strings)[i].getLength());
+        return size;
+    }
+
+    for (const auto& it : sizes) {
+        if (field->isOfType(it.first))
+            return num * it.second;
+    }
+
+    // nodes, paths and other fields hold at least a pointer per value
+    return num * sizeof(void*);
+}
+}
+
+std::size_t Gui::SoFCDB::getMemSize(SoNode* root, std::set<SoNode*>& visited)
+{
+    if (!root || !visited.insert(root).second)
+        return 0;
+
+    // the exact size of a node class isn't known, take the base class
+    std::size_t size = sizeof(SoNode);
+
+    const SoFieldData* fielddata = root->getFieldData();
+    if (fielddata) {
+        for (int i=0; i<fielddata->getNumFields(); i++) {
+            SoField* field = fielddata->getField(root, i);
+            size += sizeof(SoField);
+            if (field->isOfType(SoSFNode::getClassTypeId())) {
+                size += getMemSize(static_cast<SoSFNode*>(field)->getValue(), visited);
+            }
+            else if (field->isOfType(SoMFNode::getClassTypeId())) {
+                SoMFNode* mfNode = static_cast<SoMFNode*>(field);
+                size += getMFieldSize(mfNode);
+                for (int j=0; j<mfNode->getNum(); j++)
+                    size += getMemSize(mfNode->getNode(j), visited);
+            }
+            else if (field->isOfType(SoSFImage::getClassTypeId())) {
+                SbVec2s dim;
+                int nc;
+                static_cast<SoSFImage*>(field)->getValue(dim, nc);
+                size += static_cast<std::size_t>(dim[0]) * static_cast<std::size_t>(dim[1]) * nc;
+            }
+            else if (field->isOfType(SoMField::getClassTypeId())) {
+                size += getMFieldSize(static_cast<SoMField*>(field));
+            }
+        }
+    }
+
+    SoChildList* children = root->getChildren();
+    if (children) {
+        size += static_cast<std::size_t>(children->getLength()) * sizeof(void*);
+        for (int i=0; i<children->getLength(); i++)
+            size += getMemSize((*children)[i], visited);
+    }
+
+    return size;
+}
+
+std::size_t Gui::SoFCDB::getMemSize(SoNode* root)
+{
+    std::set<SoNode*> visited;
+    return getMemSize(root, visited);
+}
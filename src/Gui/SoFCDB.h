@@ -25,6 +25,7 @@
 #define GUI_SOFCDB_H
 
 #include <map>
+#include <set>
 #include <string>
 #include <iosfwd>
 #include <Inventor/SbBasic.h>
@@ -58,6 +59,13 @@ public:
      * on why this is needed.
      */
     static SoGroup* getStorage();
+    /** Estimates the memory used by the scene graph of \a root in bytes, that
+     * is the nodes with their fields and the arrays of the multiple-value
+     * fields. Nodes already in \a visited are skipped, so that shared nodes
+     * are counted only once over several calls.
+     */
+    static std::size_t getMemSize(SoNode* root, std::set<SoNode*>& visited);
+    static std::size_t getMemSize(SoNode* root);
 
 private:
     static void writeX3D(SoVRMLGroup* node, bool exportViewpoints, std::ostream& out);
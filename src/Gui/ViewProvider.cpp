@@ -873,6 +873,29 @@ SoSeparator* ViewProvider::getFrontRoot(void) const
     return nullptr;
 }
 
+unsigned int ViewProvider::getMemSize(void) const
+{
+    std::set<SoNode*> visited;
+    return getMemSize(visited);
+}
+
+unsigned int ViewProvider::getMemSize(std::set<SoNode*>& visited) const
+{
+    std::uint64_t size = App::TransactionalObject::getMemSize();
+
+    SoGroup* childRoot = getChildRoot();
+    if (childRoot && visited.insert(childRoot).second) {
+        // only count the group node, its children belong to other objects
+        size += sizeof(SoGroup);
+    }
+
+    size += SoFCDB::getMemSize(pcRoot, visited);
+    size += SoFCDB::getMemSize(getFrontRoot(), visited);
+    size += SoFCDB::getMemSize(getBackRoot(), visited);
+    size += SoFCDB::getMemSize(pcAnnotation, visited);
+    return clampMemSize(size);
+}
+
 std::vector< App::DocumentObject* > ViewProvider::claimChildren(void) const
 {
     std::vector< App::DocumentObject* > vec;
@@ -25,6 +25,7 @@
 #define GUI_VIEWPROVIDER_H
 
 #include <map>
+#include <set>
 #include <vector>
 #include <string>
 #include <bitset>
@@ -140,6 +141,15 @@ public:
     virtual SoGroup* getChildRoot(void) const;
     // returns the root node of the Provider (3D)
     virtual SoSeparator* getBackRoot(void) const;
+    /** Returns the size of the properties and the scene graph of the view
+     * provider. The roots of claimed children are counted by their own view
+     * providers.
+     */
+    virtual unsigned int getMemSize(void) const override;
+    /** Like getMemSize() but skips the scene graph nodes already in \a visited,
+     * so that nodes shared by several view providers are counted once.
+     */
+    unsigned int getMemSize(std::set<SoNode*>& visited) const;
     ///Indicate whether to be added to scene graph or not
     virtual bool canAddToSceneGraph() const {return true;}
 
@@ -167,6 +167,7 @@ PyMOD_INIT_FUNC(Fem)
     Fem::PropertyFemMesh                      ::init();
 
     Fem::FemResultObject                      ::init();
+    Fem::PropertyNodeNumberList               ::init();
     Fem::FemResultObjectPython                ::init();
 
     Fem::FemSetObject                         ::init();
@@ -64,6 +64,7 @@
 #include "FemMesh.h"
 #include "FemMeshObject.h"
 #include "FemMeshPy.h"
+#include "FemResultObject.h"
 #ifdef FC_USE_VTK
 #include "FemPostPipeline.h"
 #include "FemVTKTools.h"
@@ -72,6 +73,28 @@
 #include <Base/Vector3D.h>
 #include <Mod/Part/App/OCCError.h>
 
+namespace {
+Fem::FemResultObject* getResultObject(PyObject* pcObj)
+{
+    App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(pcObj)->getDocumentObjectPtr();
+    if (!obj || !obj->isDerivedFrom(Fem::FemResultObject::getClassTypeId()))
+        throw Py::TypeError("Object is not a FEM result");
+    return static_cast<Fem::FemResultObject*>(obj);
+}
+
+App::Property* getResultList(Fem::FemResultObject* res, const char* name)
+{
+    App::Property* prop = res->getPropertyByName(name);
+    if (!prop)
+        throw Py::AttributeError(std::string("Result has no list ") + name);
+    if (!prop->isDerivedFrom(App::PropertyFloatList::getClassTypeId()) &&
+        !prop->isDerivedFrom(App::PropertyVectorList::getClassTypeId()) &&
+        !prop->isDerivedFrom(App::PropertyIntegerList::getClassTypeId()))
+        throw Py::TypeError(std::string("Unsupported list type of ") + name);
+    return prop;
+}
+}
+
 namespace Fem {
 class Module : public Py::ExtensionModule<Module>
 {
@@ -101,6 +124,15 @@ public:
         add_varargs_method("show",&Module::show,
             "show(shape,[string]) -- Add the mesh to the active document or create one if no document exists."
         );
+        add_varargs_method("getResultArray",&Module::getResultArray,
+            "getResultArray(result,string) -- Return a result list as bytes, to be used e.g. with numpy.frombuffer().\n"
+            "Float lists are returned as float64 values, vector lists as float64 x, y, z triples and\n"
+            "integer lists (like NodeNumbers) as int64 values."
+        );
+        add_varargs_method("setResultArray",&Module::setResultArray,
+            "setResultArray(result,string,buffer) -- Set a result list from a contiguous buffer, e.g. a numpy array.\n"
+            "Float and vector lists take float64 values, integer lists int32 or int64 values."
+        );
         initialize("This module is the Fem module."); // register with Python
     }
 
@@ -313,6 +345,95 @@ private:
 
         return Py::None();
     }
+
+    Py::Object getResultArray(const Py::Tuple& args)
+    {
+        PyObject *pcObj;
+        char *name;
+        if (!PyArg_ParseTuple(args.ptr(), "O!s", &(App::DocumentObjectPy::Type), &pcObj, &name))
+            throw Py::Exception();
+
+        App::Property* prop = getResultList(getResultObject(pcObj), name);
+        if (prop->isDerivedFrom(App::PropertyFloatList::getClassTypeId())) {
+            const std::vector<double>& values = static_cast<App::PropertyFloatList*>(prop)->getValues();
+            return Py::asObject(PyBytes_FromStringAndSize(reinterpret_cast<const char*>(values.data()),
+                                                          values.size() * sizeof(double)));
+        }
+        else if (prop->isDerivedFrom(App::PropertyVectorList::getClassTypeId())) {
+            const std::vector<Base::Vector3d>& vectors = static_cast<App::PropertyVectorList*>(prop)->getValues();
+            std::vector<double> values;
+            values.reserve(3 * vectors.size());
+            for (const auto& v : vectors) {
+                values.push_back(v.x);
+                values.push_back(v.y);
+                values.push_back(v.z);
+            }
+            return Py::asObject(PyBytes_FromStringAndSize(reinterpret_cast<const char*>(values.data()),
+                                                          values.size() * sizeof(double)));
+        }
+        else {
+            const std::vector<long>& numbers = static_cast<App::PropertyIntegerList*>(prop)->getValues();
+            std::vector<int64_t> values(numbers.begin(), numbers.end());
+            return Py::asObject(PyBytes_FromStringAndSize(reinterpret_cast<const char*>(values.data()),
+                                                          values.size() * sizeof(int64_t)));
+        }
+    }
+
+    Py::Object setResultArray(const Py::Tuple& args)
+    {
+        PyObject *pcObj;
+        char *name;
+        PyObject *pcBuf;
+        if (!PyArg_ParseTuple(args.ptr(), "O!sO", &(App::DocumentObjectPy::Type), &pcObj, &name, &pcBuf))
+            throw Py::Exception();
+
+        App::Property* prop = getResultList(getResultObject(pcObj), name);
+
+        Py_buffer view;
+        if (PyObject_GetBuffer(pcBuf, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+            throw Py::Exception();
+        std::unique_ptr<Py_buffer, void(*)(Py_buffer*)> release(&view, PyBuffer_Release);
+
+        std::string format = view.format ? view.format : "B";
+        if (!format.empty() && (format[0] == '<' || format[0] == '=' || format[0] == '@'))
+            format.erase(0, 1);
+        Py_ssize_t count = view.itemsize > 0 ? view.len / view.itemsize : 0;
+
+        if (prop->isDerivedFrom(App::PropertyFloatList::getClassTypeId()) ||
+            prop->isDerivedFrom(App::PropertyVectorList::getClassTypeId())) {
+            if (format != "d")
+                throw Py::TypeError("Buffer of float64 values expected");
+            const double* data = static_cast<const double*>(view.buf);
+            if (prop->isDerivedFrom(App::PropertyFloatList::getClassTypeId())) {
+                static_cast<App::PropertyFloatList*>(prop)->setValues(std::vector<double>(data, data + count));
+            }
+            else {
+                if (count % 3 != 0)
+                    throw Py::ValueError("Number of values is not a multiple of three");
+                std::vector<Base::Vector3d> vectors(count / 3);
+                for (std::size_t i = 0; i < vectors.size(); i++)
+                    vectors[i].Set(data[3*i], data[3*i+1], data[3*i+2]);
+                static_cast<App::PropertyVectorList*>(prop)->setValues(vectors);
+            }
+        }
+        else {
+            std::vector<long> values(count);
+            if ((format == "i" || format == "l") && view.itemsize == 4) {
+                const int32_t* data = static_cast<const int32_t*>(view.buf);
+                std::copy(data, data + count, values.begin());
+            }
+            else if ((format == "q" || format == "l") && view.itemsize == 8) {
+                const int64_t* data = static_cast<const int64_t*>(view.buf);
+                std::copy(data, data + count, values.begin());
+            }
+            else {
+                throw Py::TypeError("Buffer of int32 or int64 values expected");
+            }
+            static_cast<App::PropertyIntegerList*>(prop)->setValues(values);
+        }
+
+        return Py::None();
+    }
 };
 
 PyObject* initModule()
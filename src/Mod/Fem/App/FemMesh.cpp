@@ -24,7 +24,10 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <cctype>
 # include <cstdlib>
+# include <cstring>
 # include <memory>
 # include <Python.h>
 # include <Bnd_Box.hxx>
@@ -41,6 +44,7 @@
 
 # include <boost/assign/list_of.hpp>
 # include <boost/tokenizer.hpp> //to simplify parsing input files we use the boost lib
+# include <boost/algorithm/string.hpp>
 
 # include <SMESH_Gen.hxx>
 # include <SMESH_Mesh.hxx>
@@ -52,6 +56,10 @@
 # include <SMESHDS_Mesh.hxx>
 //# include <SMDS_PolyhedralVolumeOfNodes.hxx>
 # include <SMDS_VolumeTool.hxx>
+# include <SMDS_MeshInfo.hxx>
+# include <SMDS_MeshCell.hxx>
+# include <SMDS_MeshNode.hxx>
+# include <SMDS_UnstructuredGrid.hxx>
 # include <StdMeshers_MaxLength.hxx>
 # include <StdMeshers_LocalLength.hxx>
 # include <StdMeshers_MaxElementArea.hxx>
@@ -65,6 +73,9 @@
 
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include <Base/Writer.h>
 #include <Base/Reader.h>
 #include <Base/Stream.h>
@@ -1106,6 +1117,480 @@ std::set<int> FemMesh::getFacesOnly(void) const
 }
 
 namespace {
+// corner nodes of the faces of the volume types, face numbers and node order as in
+// ViewProviderFEMMeshBuilder. Quadratic volumes start with the corner nodes of their
+// linear counterpart, so the mid side nodes are not needed to identify a face.
+const int TetraFaces[4][4]   = {{0,1,2,-1}, {0,3,1,-1}, {1,3,2,-1}, {2,3,0,-1}};
+const int PyramidFaces[5][4] = {{0,1,2,3}, {0,4,1,-1}, {1,4,2,-1}, {2,4,3,-1}, {3,4,0,-1}};
+const int PentaFaces[5][4]   = {{0,1,2,-1}, {3,5,4,-1}, {0,3,4,1}, {1,4,5,2}, {2,5,3,0}};
+const int HexaFaces[6][4]    = {{0,1,2,3}, {4,7,6,5}, {0,4,5,1}, {1,5,6,2}, {2,6,7,3}, {3,7,4,0}};
+
+// a contiguous range of faces, lines or elements handled by one thread
+typedef std::pair<std::size_t, std::size_t> IndexRange;
+
+std::vector<IndexRange> splitIndexRange(std::size_t count, std::size_t minChunkSize = 4096)
+{
+    std::size_t numChunks = std::max(1, QThread::idealThreadCount()) * 4;
+    std::size_t chunkSize = std::max<std::size_t>(count / numChunks + 1, minChunkSize);
+    std::vector<IndexRange> chunks;
+    for (std::size_t start = 0; start < count; start += chunkSize)
+        chunks.emplace_back(start, std::min(start + chunkSize, count));
+    return chunks;
+}
+}
+
+std::vector<std::pair<int, int> > FemMesh::getVolumeBoundaryFaces(void) const
+{
+    std::vector<int> faceNodes;
+    std::vector<int> faceOffsets;
+    std::vector<std::pair<int, int> > volumeFaces;
+
+    const SMDS_MeshInfo& info = myMesh->GetMeshDS()->GetMeshInfo();
+    std::size_t numFaces = info.NbTetras() * 4 + info.NbPyramids() * 5 + info.NbPrisms() * 5 + info.NbHexas() * 6;
+    faceNodes.reserve(numFaces * 4);
+    faceOffsets.reserve(numFaces + 1);
+    volumeFaces.reserve(numFaces);
+    faceOffsets.push_back(0);
+
+    SMDS_VolumeIteratorPtr aVolIter = myMesh->GetMeshDS()->volumesIterator();
+    while (aVolIter->more()) {
+        const SMDS_MeshVolume* aVol = aVolIter->next();
+        const int (*faces)[4] = nullptr;
+        int numVolFaces = 0;
+        switch (aVol->NbNodes()) {
+        case 4:
+        case 10:
+            faces = TetraFaces;
+            numVolFaces = 4;
+            break;
+        case 5:
+        case 13:
+            faces = PyramidFaces;
+            numVolFaces = 5;
+            break;
+        case 6:
+        case 15:
+            faces = PentaFaces;
+            numVolFaces = 5;
+            break;
+        case 8:
+        case 20:
+            faces = HexaFaces;
+            numVolFaces = 6;
+            break;
+        default:
+            // polyhedra are not handled
+            continue;
+        }
+
+        for (int f = 0; f < numVolFaces; f++) {
+            for (int n = 0; n < 4 && faces[f][n] >= 0; n++)
+                faceNodes.push_back(aVol->GetNode(faces[f][n])->GetID());
+            faceOffsets.push_back(static_cast<int>(faceNodes.size()));
+            volumeFaces.emplace_back(aVol->GetID(), f + 1);
+        }
+    }
+
+    std::vector<char> inner = findInnerFaces(faceNodes, faceOffsets);
+    std::vector<std::pair<int, int> > result;
+    for (std::size_t i = 0; i < inner.size(); i++) {
+        if (!inner[i])
+            result.push_back(volumeFaces[i]);
+    }
+
+    return result;
+}
+
+std::vector<char> FemMesh::findInnerFaces(const std::vector<int>& faceNodes,
+                                          const std::vector<int>& faceOffsets)
+{
+    std::size_t numFaces = faceOffsets.empty() ? 0 : faceOffsets.size() - 1;
+    std::vector<char> inner(numFaces, 0);
+    if (numFaces == 0)
+        return inner;
+
+    // step 1: sort the node IDs of each face and compute a hash from them
+    std::vector<int> keys(faceNodes);
+    std::vector<uint64_t> hashes(numFaces);
+    std::vector<IndexRange> chunks = splitIndexRange(numFaces);
+    QtConcurrent::blockingMap(chunks, [&](const IndexRange& range) {
+        for (std::size_t i = range.first; i < range.second; i++) {
+            int* begin = keys.data() + faceOffsets[i];
+            int* end = keys.data() + faceOffsets[i+1];
+            std::sort(begin, end);
+            uint64_t hash = 14695981039346656037ULL; // FNV-1a
+            for (int* it = begin; it != end; ++it) {
+                hash ^= static_cast<uint32_t>(*it);
+                hash *= 1099511628211ULL;
+            }
+            hashes[i] = hash;
+        }
+    });
+
+    // step 2: distribute the faces into buckets by the upper bits of their hash,
+    // equal faces always end up in the same bucket
+    const int bucketBits = 10;
+    const std::size_t numBuckets = std::size_t(1) << bucketBits;
+    std::vector<std::size_t> bucketOffsets(numBuckets + 1, 0);
+    for (std::size_t i = 0; i < numFaces; i++)
+        bucketOffsets[(hashes[i] >> (64 - bucketBits)) + 1]++;
+    for (std::size_t b = 0; b < numBuckets; b++)
+        bucketOffsets[b + 1] += bucketOffsets[b];
+    std::vector<std::size_t> fill(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    std::vector<int> order(numFaces);
+    for (std::size_t i = 0; i < numFaces; i++)
+        order[fill[hashes[i] >> (64 - bucketBits)]++] = static_cast<int>(i);
+
+    // step 3: sort each bucket and pair up neighbours with the same key
+    auto sameFace = [&](int a, int b) {
+        int sizeA = faceOffsets[a+1] - faceOffsets[a];
+        int sizeB = faceOffsets[b+1] - faceOffsets[b];
+        return hashes[a] == hashes[b] && sizeA == sizeB &&
+               std::equal(keys.begin() + faceOffsets[a], keys.begin() + faceOffsets[a+1],
+                          keys.begin() + faceOffsets[b]);
+    };
+    auto lessFace = [&](int a, int b) {
+        if (hashes[a] != hashes[b])
+            return hashes[a] < hashes[b];
+        return std::lexicographical_compare(keys.begin() + faceOffsets[a], keys.begin() + faceOffsets[a+1],
+                                            keys.begin() + faceOffsets[b], keys.begin() + faceOffsets[b+1]);
+    };
+
+    std::vector<std::size_t> buckets(numBuckets);
+    for (std::size_t b = 0; b < numBuckets; b++)
+        buckets[b] = b;
+    QtConcurrent::blockingMap(buckets, [&](std::size_t b) {
+        auto begin = order.begin() + bucketOffsets[b];
+        auto end = order.begin() + bucketOffsets[b+1];
+        // stable, so that a face shared by more than two elements is paired in input order
+        std::stable_sort(begin, end, lessFace);
+        for (auto it = begin; it != end && it + 1 != end; ) {
+            if (sameFace(*it, *(it + 1))) {
+                inner[*it] = 1;
+                inner[*(it + 1)] = 1;
+                it += 2;
+            }
+            else {
+                ++it;
+            }
+        }
+    });
+
+    return inner;
+}
+
+namespace {
+// a line of a text file without the line end
+typedef std::pair<const char*, const char*> TextLine;
+
+// A text file read into memory at once and split into lines, so that the lines
+// can be parsed in parallel
+class TextFile
+{
+public:
+    explicit TextFile(const std::string& fileName)
+    {
+        Base::FileInfo fi(fileName);
+        Base::ifstream str(fi, std::ios::in | std::ios::binary);
+        if (!str)
+            throw Base::FileException("Cannot open file", fi);
+        str.seekg(0, std::ios::end);
+        std::streamoff size = str.tellg();
+        str.seekg(0, std::ios::beg);
+        text.resize(static_cast<std::size_t>(std::max<std::streamoff>(size, 0)));
+        if (!text.empty())
+            str.read(&text[0], text.size());
+
+        const char* pos = text.c_str();
+        const char* end = pos + text.size();
+        while (pos < end) {
+            const char* eol = static_cast<const char*>(memchr(pos, '\n', end - pos));
+            if (!eol)
+                eol = end;
+            const char* last = eol;
+            if (last > pos && *(last - 1) == '\r')
+                --last;
+            lines.emplace_back(pos, last);
+            pos = eol + 1;
+        }
+    }
+
+    std::vector<TextLine> lines;
+
+private:
+    std::string text;
+};
+
+bool isBlank(const TextLine& line)
+{
+    for (const char* c = line.first; c != line.second; ++c) {
+        if (!isspace(static_cast<unsigned char>(*c)))
+            return false;
+    }
+    return true;
+}
+
+// case insensitive check of the start of a line
+bool startsWith(const TextLine& line, const char* keyword)
+{
+    const char* c = line.first;
+    for (; *keyword; ++keyword, ++c) {
+        if (c == line.second || toupper(static_cast<unsigned char>(*c)) != *keyword)
+            return false;
+    }
+    return true;
+}
+
+// skip white space and commas, the numbers in the mesh files are separated by them
+inline bool skipSeparators(const char*& pos, const char* end)
+{
+    while (pos < end && (*pos == ',' || isspace(static_cast<unsigned char>(*pos))))
+        ++pos;
+    return pos < end;
+}
+
+// the number can't run beyond the line end because the line end is a white space
+inline bool nextInt(const char*& pos, const char* end, int& value)
+{
+    if (!skipSeparators(pos, end))
+        return false;
+    char* next;
+    value = static_cast<int>(strtol(pos, &next, 10));
+    if (next == pos)
+        return false;
+    pos = next;
+    return true;
+}
+
+inline bool nextDouble(const char*& pos, const char* end, double& value)
+{
+    if (!skipSeparators(pos, end))
+        return false;
+    char* next;
+    value = strtod(pos, &next);
+    if (next == pos)
+        return false;
+    pos = next;
+    return true;
+}
+
+// Nodes and elements parsed from a mesh file, in flat arrays, to be added to a
+// SMESH mesh at once
+class MeshBuffer
+{
+public:
+    MeshBuffer()
+    {
+        elemOffsets.push_back(0);
+    }
+
+    void addNode(int id, double x, double y, double z)
+    {
+        nodeIds.push_back(id);
+        coords.push_back(x);
+        coords.push_back(y);
+        coords.push_back(z);
+    }
+
+    // the nodes are given in the SMESH order
+    void addElement(int id, int dim, const int* nodes, int numNodes)
+    {
+        elemIds.push_back(id);
+        elemDims.push_back(static_cast<char>(dim));
+        elemNodes.insert(elemNodes.end(), nodes, nodes + numNodes);
+        elemOffsets.push_back(static_cast<int>(elemNodes.size()));
+    }
+
+    std::size_t numNodes() const
+    {
+        return nodeIds.size();
+    }
+
+    std::size_t numElements() const
+    {
+        return elemIds.size();
+    }
+
+    // returns the number of elements added to the mesh
+    std::size_t insertInto(SMESHDS_Mesh* meshds, const char* format) const
+    {
+        for (std::size_t i = 0; i < nodeIds.size(); i++)
+            meshds->AddNodeWithID(coords[3*i], coords[3*i+1], coords[3*i+2], nodeIds[i]);
+
+        std::size_t added = 0;
+        std::vector<const SMDS_MeshNode*> n;
+        for (std::size_t i = 0; i < elemIds.size(); i++) {
+            int count = elemOffsets[i+1] - elemOffsets[i];
+            n.resize(count);
+            bool valid = true;
+            for (int j = 0; j < count; j++) {
+                n[j] = meshds->FindNode(elemNodes[elemOffsets[i] + j]);
+                valid = valid && n[j];
+            }
+            if (!valid) {
+                Base::Console().Warning("%s: Failed to add element %d, not all of its nodes exist\n",
+                                        format, elemIds[i]);
+                continue;
+            }
+
+            const SMDS_MeshElement* elem = nullptr;
+            int id = elemIds[i];
+            switch (elemDims[i] * 100 + count) {
+            case 102: elem = meshds->AddEdgeWithID(n[0], n[1], id); break;
+            case 103: elem = meshds->AddEdgeWithID(n[0], n[1], n[2], id); break;
+            case 203: elem = meshds->AddFaceWithID(n[0], n[1], n[2], id); break;
+            case 204: elem = meshds->AddFaceWithID(n[0], n[1], n[2], n[3], id); break;
+            case 206: elem = meshds->AddFaceWithID(n[0], n[1], n[2], n[3], n[4], n[5], id); break;
+            case 208: elem = meshds->AddFaceWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], id); break;
+            case 304: elem = meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], id); break;
+            case 306: elem = meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], id); break;
+            case 308: elem = meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], id); break;
+            case 310: elem = meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9], id); break;
+            case 315: elem = meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9],
+                                                     n[10], n[11], n[12], n[13], n[14], id); break;
+            case 320: elem = meshds->AddVolumeWithID(n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7], n[8], n[9],
+                                                     n[10], n[11], n[12], n[13], n[14], n[15], n[16], n[17], n[18], n[19], id); break;
+            default: break;
+            }
+            if (elem)
+                added++;
+            else
+                Base::Console().Warning("%s: Failed to add element %d\n", format, id);
+        }
+        return added;
+    }
+
+private:
+    std::vector<int> nodeIds;
+    std::vector<double> coords;
+    std::vector<int> elemIds;
+    std::vector<char> elemDims;
+    std::vector<int> elemNodes;
+    std::vector<int> elemOffsets;
+};
+
+// Abaqus element types with their SMESH dimension and the Abaqus position of the
+// SMESH nodes, as in feminout/importInpMesh.py
+struct AbaqusElementType
+{
+    const char* names[9];
+    int dim;
+    int numNodes;
+    int order[20];
+};
+
+const AbaqusElementType AbaqusElementTypes[] = {
+    {{"S3", "CPS3", "CPE3", "CAX3"}, 2, 3, {0,1,2}},
+    {{"S6", "CPS6", "CPE6", "CAX6"}, 2, 6, {0,1,2,3,4,5}},
+    {{"S4", "S4R", "CPS4", "CPS4R", "CPE4", "CPE4R", "CAX4", "CAX4R"}, 2, 4, {0,1,2,3}},
+    {{"S8", "S8R", "CPS8", "CPS8R", "CPE8", "CPE8R", "CAX8", "CAX8R"}, 2, 8, {0,1,2,3,4,5,6,7}},
+    {{"C3D4"}, 3, 4, {1,0,2,3}},
+    {{"C3D10"}, 3, 10, {1,0,2,3,4,6,5,8,7,9}},
+    {{"C3D8", "C3D8R", "C3D8I"}, 3, 8, {5,6,7,4,1,2,3,0}},
+    {{"C3D20", "C3D20R", "C3D20RI"}, 3, 20, {5,6,7,4,1,2,3,0,13,14,15,12,9,10,11,8,17,18,19,16}},
+    {{"C3D6"}, 3, 6, {4,5,3,1,2,0}},
+    {{"C3D15"}, 3, 15, {4,5,3,1,2,0,10,11,9,7,8,6,13,14,12}},
+    {{"B31", "B31R", "T3D2"}, 1, 2, {0,1}},
+    {{"B32", "B32R", "T3D3"}, 1, 3, {0,2,1}},
+};
+
+const AbaqusElementType* findAbaqusElementType(const std::string& name)
+{
+    for (const AbaqusElementType& type : AbaqusElementTypes) {
+        for (const char* const* it = type.names; *it; ++it) {
+            if (name == *it)
+                return &type;
+        }
+    }
+    return nullptr;
+}
+
+// value of a keyword parameter like TYPE=C3D10, upper case
+std::string getAbaqusParameter(const TextLine& line, const char* name)
+{
+    std::string keyword(line.first, line.second);
+    std::transform(keyword.begin(), keyword.end(), keyword.begin(), ::toupper);
+    std::size_t pos = 0;
+    while ((pos = keyword.find(',', pos)) != std::string::npos) {
+        ++pos;
+        std::size_t eq = keyword.find('=', pos);
+        std::size_t next = keyword.find(',', pos);
+        if (eq == std::string::npos || (next != std::string::npos && next < eq))
+            continue;
+        std::string key = keyword.substr(pos, eq - pos);
+        key.erase(std::remove_if(key.begin(), key.end(), ::isspace), key.end());
+        if (key == name) {
+            std::string value = keyword.substr(eq + 1, next == std::string::npos ? std::string::npos : next - eq - 1);
+            value.erase(std::remove_if(value.begin(), value.end(), ::isspace), value.end());
+            return value;
+        }
+    }
+    return std::string();
+}
+
+// collects the lines of an Abaqus file and of the files it includes
+void collectAbaqusLines(const std::string& fileName, std::vector<std::unique_ptr<TextFile> >& files,
+                        std::vector<TextLine>& lines)
+{
+    files.emplace_back(new TextFile(fileName));
+    const TextFile& file = *files.back();
+    lines.reserve(lines.size() + file.lines.size());
+    for (const TextLine& line : file.lines) {
+        if (startsWith(line, "*INCLUDE")) {
+            std::string include(line.first, line.second);
+            std::size_t eq = include.find('=');
+            if (eq == std::string::npos)
+                continue;
+            include = include.substr(eq + 1);
+            boost::algorithm::trim(include);
+            boost::algorithm::trim_if(include, boost::algorithm::is_any_of("\""));
+            Base::FileInfo fi(include);
+            if (!fi.isReadable())
+                fi.setFile(Base::FileInfo(fileName).dirPath() + "/" + include);
+            collectAbaqusLines(fi.filePath(), files, lines);
+        }
+        else {
+            lines.push_back(line);
+        }
+    }
+}
+
+// Z88 element types with their SMESH dimension and the Z88 position of the SMESH
+// nodes, as in feminout/importZ88Mesh.py
+struct Z88ElementType
+{
+    int types[7];
+    int dim;
+    int numNodes;
+    int order[20];
+};
+
+const Z88ElementType Z88ElementTypes[] = {
+    {{2, 4, 5, 9, 13, 25}, 1, 2, {0,1}},
+    {{3, 14, 24}, 2, 6, {0,1,2,3,4,5}},
+    {{7, 20, 23}, 2, 8, {0,1,2,3,4,5,6,7}},
+    {{17}, 3, 4, {3,1,2,0}},
+    {{16}, 3, 10, {0,1,3,2,4,7,9,6,5,8}},
+    {{1}, 3, 8, {0,1,2,3,4,5,6,7}},
+    {{10}, 3, 20, {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19}},
+};
+
+const Z88ElementType* findZ88ElementType(int z88Type)
+{
+    for (const Z88ElementType& type : Z88ElementTypes) {
+        for (const int* it = type.types; *it; ++it) {
+            if (*it == z88Type)
+                return &type;
+        }
+    }
+    return nullptr;
+}
+
+bool contains(const TextLine& line, const char* str)
+{
+    return std::search(line.first, line.second, str, str + strlen(str)) != line.second;
+}
+
 class NastranElement {
 public:
     virtual ~NastranElement() = default;
@@ -1490,6 +1975,85 @@ class CHEXA2Element : public NastranElement {
     }
 };
 
+
+// a Nastran card found in the file, its fields are parsed later
+struct NastranRecord
+{
+    NastranElementPtr element;
+    TextLine line1;
+    TextLine line2;
+    // free field cards continued on the next line are parsed as one line
+    bool joinLines = false;
+};
+
+// returns the continuation line of a card, an empty line at the end of the file
+TextLine nextLine(const std::vector<TextLine>& lines, std::size_t& index)
+{
+    static const char* empty = "";
+    if (index + 1 < lines.size())
+        return lines[++index];
+    return TextLine(empty, empty);
+}
+
+void readNastranRecords(std::vector<NastranRecord>& records)
+{
+    std::vector<IndexRange> chunks = splitIndexRange(records.size(), 1024);
+    std::vector<std::string> errors(chunks.size());
+    QtConcurrent::blockingMap(chunks, [&](const IndexRange& range) {
+        // exceptions must not leave the worker threads
+        try {
+            for (std::size_t i = range.first; i < range.second; i++) {
+                NastranRecord& record = records[i];
+                std::string str1(record.line1.first, record.line1.second);
+                std::string str2(record.line2.first, record.line2.second);
+                if (record.joinLines)
+                    record.element->read(str1.append(str2), "");
+                else
+                    record.element->read(str1, str2);
+            }
+        }
+        catch (const std::exception& e) {
+            errors[&range - chunks.data()] = e.what();
+        }
+    });
+
+    for (const std::string& error : errors) {
+        if (!error.empty())
+            throw Base::FileException((std::string("Problems reading file: ") + error).c_str());
+    }
+}
+
+inline void appendInt(std::string& str, int value)
+{
+    char buf[16];
+    int len = snprintf(buf, sizeof(buf), "%d", value);
+    str.append(buf, len);
+}
+
+// the same as writing to a stream with precision 13
+inline void appendDouble(std::string& str, double value)
+{
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), "%.13g", value);
+    str.append(buf, len);
+}
+
+// Formats the lines of a large section of a mesh file in parallel chunks and
+// writes them in their order
+template <typename Func>
+void writeLines(std::ostream& out, std::size_t count, Func formatLine)
+{
+    std::vector<IndexRange> chunks = splitIndexRange(count);
+    std::vector<std::string> text(chunks.size());
+    QtConcurrent::blockingMap(chunks, [&](const IndexRange& range) {
+        std::string& str = text[&range - chunks.data()];
+        for (std::size_t i = range.first; i < range.second; i++)
+            formatLine(i, str);
+    });
+    for (const std::string& it : text)
+        out.write(it.data(), it.size());
+}
+
 }
 
 void FemMesh::readNastran(const std::string &Filename)
@@ -1499,11 +2063,8 @@ void FemMesh::readNastran(const std::string &Filename)
 
     _Mtrx = Base::Matrix4D();
 
-    std::ifstream inputfile;
-    inputfile.open(Filename.c_str());
-    inputfile.seekg(std::ifstream::beg);
-    std::string line1,line2;
-    std::vector<NastranElementPtr> mesh_elements;
+    TextFile file(Filename);
+    std::vector<NastranRecord> records;
     enum Format {
         FreeField,
         SmallField,
@@ -1511,63 +2072,60 @@ void FemMesh::readNastran(const std::string &Filename)
     };
     Format nastranFormat = Format::LongField;
 
-    do
-    {
-        std::getline(inputfile,line1);
-        if (line1.size() == 0)
+    // the cards are classified sequentially because the format of the file is
+    // only known at its first comma, the fields are parsed afterwards in parallel
+    const std::vector<TextLine>& lines = file.lines;
+    for (std::size_t i = 0; i < lines.size(); i++) {
+        const TextLine& line1 = lines[i];
+        if (line1.first == line1.second)
             continue;
-        if (line1.find(',') != std::string::npos)
+        if (memchr(line1.first, ',', line1.second - line1.first))
             nastranFormat = Format::FreeField;
 
-        NastranElementPtr ptr;
-        if (line1.find("GRID*") != std::string::npos) { //We found a Grid line
+        NastranRecord record;
+        record.line1 = line1;
+        if (contains(line1, "GRID*")) { //We found a Grid line
             //Now lets extract the GRID Points = Nodes
             //As each GRID Line consists of two subsequent lines we have to
             //take care of that as well
             if (nastranFormat == Format::LongField) {
-                std::getline(inputfile,line2);
-                ptr = std::make_shared<GRIDLongFieldElement>();
-                ptr->read(line1, line2);
+                record.line2 = nextLine(lines, i);
+                record.element = std::make_shared<GRIDLongFieldElement>();
             }
         }
-        else if (line1.find("GRID") != std::string::npos) { //We found a Grid line
+        else if (contains(line1, "GRID")) { //We found a Grid line
             if (nastranFormat == Format::FreeField) {
-                ptr = std::make_shared<GRIDFreeFieldElement>();
-                ptr->read(line1, "");
+                record.element = std::make_shared<GRIDFreeFieldElement>();
             }
         }
-        else if (line1.find("CTRIA3") != std::string::npos) {
+        else if (contains(line1, "CTRIA3")) {
             if (nastranFormat == Format::FreeField) {
-                ptr = std::make_shared<CTRIA3FreeFieldElement>();
-                ptr->read(line1, "");
+                record.element = std::make_shared<CTRIA3FreeFieldElement>();
             }
             else {
-                ptr = std::make_shared<CTRIA3LongFieldElement>();
-                ptr->read(line1, "");
+                record.element = std::make_shared<CTRIA3LongFieldElement>();
             }
         }
-        else if (line1.find("CTETRA") != std::string::npos) {
+        else if (contains(line1, "CTETRA")) {
             //Lets extract the elements
             //As each Element Line consists of two subsequent lines as well
             //we have to take care of that
             //At a first step we only extract Quadratic Tetrahedral Elements
-            std::getline(inputfile,line2);
+            record.line2 = nextLine(lines, i);
             if (nastranFormat == Format::FreeField) {
-                ptr = std::make_shared<CTETRAFreeFieldElement>();
-                ptr->read(line1.append(line2), "");
+                record.element = std::make_shared<CTETRAFreeFieldElement>();
+                record.joinLines = true;
             }
             else {
-                ptr = std::make_shared<CTETRALongFieldElement>();
-                ptr->read(line1, line2);
+                record.element = std::make_shared<CTETRALongFieldElement>();
             }
         }
 
-        if (ptr && ptr->isValid()) {
-            mesh_elements.push_back(ptr);
-        }
+        if (record.element)
+            records.push_back(record);
     }
-    while (inputfile.good());
-    inputfile.close();
+
+    readNastranRecords(records);
 
     Base::Console().Log("    %f: File read, start building mesh\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 
@@ -1575,8 +2133,9 @@ void FemMesh::readNastran(const std::string &Filename)
     SMESHDS_Mesh* meshds = this->myMesh->GetMeshDS();
     meshds->ClearMesh();
 
-    for (auto it : mesh_elements) {
-        it->addToMesh(meshds);
+    for (const auto& it : records) {
+        if (it.element->isValid())
+            it.element->addToMesh(meshds);
     }
 
     Base::Console().Log("    %f: Done \n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
@@ -1590,118 +2149,96 @@ void FemMesh::readNastran95(const std::string &Filename)
 
     _Mtrx = Base::Matrix4D();
 
-    std::ifstream inputfile;
-    inputfile.open(Filename.c_str());
-    inputfile.seekg(std::ifstream::beg);
-    std::string line1,line2,tcard;
-
-    std::vector<NastranElementPtr> mesh_nodes;
-    std::vector<NastranElementPtr> mesh_elements;
+    TextFile file(Filename);
+    std::vector<NastranRecord> nodes;
+    std::vector<NastranRecord> elements;
 
-    do
-    {
-        NastranElementPtr node;
-        NastranElementPtr elem;
-        std::getline(inputfile, line1);
-        //cout << line1 << endl;
-        if (line1.size() == 0)
+    const std::vector<TextLine>& lines = file.lines;
+    for (std::size_t i = 0; i < lines.size(); i++) {
+        const TextLine& line1 = lines[i];
+        if (line1.first == line1.second)
             continue;
 
-        tcard = line1.substr(0, 8).c_str();
-        //boost::algorithm::trim(tcard);
-        if (line1.find("GRID*") != std::string::npos ) //We found a Grid line
+        NastranRecord node;
+        NastranRecord elem;
+        node.line1 = elem.line1 = line1;
+        std::string tcard(line1.first, std::min<std::ptrdiff_t>(line1.second - line1.first, 6));
+        if (contains(line1, "GRID*")) //We found a Grid line
         {
             //Now lets extract the GRID Points = Nodes
             //As each GRID Line consists of two subsequent lines we have to
             //take care of that as well
-            std::getline(inputfile,line2);
-            node = std::make_shared<GRIDLongFieldElement>();
-            node->read(line1, line2);
+            node.line2 = nextLine(lines, i);
+            node.element = std::make_shared<GRIDLongFieldElement>();
         }
-        else if (line1.find("GRID") != std::string::npos) //We found a Grid line
+        else if (contains(line1, "GRID")) //We found a Grid line
         {
-            //Base::Console().Log("Found a GRID\n");
             //D06.inp
             //GRID    109             .9      .7
             //Now lets extract the GRID Points = Nodes
             //Get the Nodal ID
-            node = std::make_shared<GRIDNastran95Element>();
-            node->read(line1, "");
+            node.element = std::make_shared<GRIDNastran95Element>();
         }
-        
+
         //1D
-        else if (line1.substr(0,6)=="CBAR")
+        else if (tcard == "CBAR")
         {
-            elem = std::make_shared<CBARElement>();
-            elem->read(line1, "");
+            elem.element = std::make_shared<CBARElement>();
         }
         //2d
-        else if (line1.substr(0,6)=="CTRMEM")
+        else if (tcard == "CTRMEM")
         {
             //D06
             //CTRMEM  322     1       179     180     185
-            elem = std::make_shared<CTRMEMElement>();
-            elem->read(line1, "");
+            elem.element = std::make_shared<CTRMEMElement>();
         }
-        else if (line1.substr(0, 6) == "CTRIA1")
+        else if (tcard == "CTRIA1")
         {
-            //D06
-            //CTRMEM  322     1       179     180     185
-            elem = std::make_shared<CTRIA1Element>();
-            elem->read(line1, "");
+            elem.element = std::make_shared<CTRIA1Element>();
         }
-        else if (line1.substr(0, 6) == "CQUAD1")
+        else if (tcard == "CQUAD1")
         {
-            //D06
-            //CTRMEM  322     1       179     180     185                                     
-            elem = std::make_shared<CQUAD1Element>();
-            elem->read(line1, "");
+            elem.element = std::make_shared<CQUAD1Element>();
         }
-        
+
         //3d element
-        else if (line1.find("CTETRA")!= std::string::npos)
+        else if (contains(line1, "CTETRA"))
         {
-            //d011121a.inp    
-            //CTETRA  3       200     104     114     3       103                             
-            elem = std::make_shared<CTETRANastran95Element>();
-            elem->read(line1, "");
+            //d011121a.inp
+            //CTETRA  3       200     104     114     3       103
+            elem.element = std::make_shared<CTETRANastran95Element>();
         }
-        else if (line1.find("CWEDGE")!= std::string::npos)
+        else if (contains(line1, "CWEDGE"))
         {
-            //d011121a.inp    
-            //CWEDGE  11      200     6       17      16      106     117     116             
-            elem = std::make_shared<CTETRANastran95Element>();
-            elem->read(line1, "");
+            //d011121a.inp
+            //CWEDGE  11      200     6       17      16      106     117     116
+            elem.element = std::make_shared<CTETRANastran95Element>();
         }
-        else if (line1.find("CHEXA1")!= std::string::npos)
+        else if (contains(line1, "CHEXA1"))
         {
-            //d011121a.inp    
-            //CHEXA1  1       200     1       2       13      12      101     102     +SOL1   
-            //+SOL1   113     112                                                             
-            std::getline(inputfile,line2);
-            elem = std::make_shared<CHEXA1Element>();
-            elem->read(line1, line2);
-        }
-        else if (line1.find("CHEXA2")!= std::string::npos)
-        {
-            //d011121a.inp    
-            //CHEXA1  1       200     1       2       13      12      101     102     +SOL1   
-            //+SOL1   113     112                                                             
-            std::getline(inputfile,line2);
-            elem = std::make_shared<CHEXA2Element>();
-            elem->read(line1, line2);
+            //d011121a.inp
+            //CHEXA1  1       200     1       2       13      12      101     102     +SOL1
+            //+SOL1   113     112
+            elem.line2 = nextLine(lines, i);
+            elem.element = std::make_shared<CHEXA1Element>();
         }
-
-        if (node && node->isValid()) {
-            mesh_nodes.push_back(node);
+        else if (contains(line1, "CHEXA2"))
+        {
+            //d011121a.inp
+            //CHEXA1  1       200     1       2       13      12      101     102     +SOL1
+            //+SOL1   113     112
+            elem.line2 = nextLine(lines, i);
+            elem.element = std::make_shared<CHEXA2Element>();
         }
 
-        if (elem && elem->isValid()) {
-            mesh_elements.push_back(elem);
-        }
+        if (node.element)
+            nodes.push_back(node);
+        if (elem.element)
+            elements.push_back(elem);
     }
-    while (inputfile.good());
-    inputfile.close();
+
+    readNastranRecords(nodes);
+    readNastranRecords(elements);
 
     Base::Console().Log("    %f: File read, start building mesh\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 
@@ -1709,12 +2246,14 @@ void FemMesh::readNastran95(const std::string &Filename)
     SMESHDS_Mesh* meshds = this->myMesh->GetMeshDS();
     meshds->ClearMesh();
 
-    for (auto it : mesh_nodes) {
-        it->addToMesh(meshds);
+    for (const auto& it : nodes) {
+        if (it.element->isValid())
+            it.element->addToMesh(meshds);
     }
 
-    for (auto it : mesh_elements) {
-        it->addToMesh(meshds);
+    for (const auto& it : elements) {
+        if (it.element->isValid())
+            it.element->addToMesh(meshds);
     }
 
     Base::Console().Log("    %f: Done \n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
@@ -1725,34 +2264,148 @@ void FemMesh::readAbaqus(const std::string &FileName)
     Base::TimeInfo Start;
     Base::Console().Log("Start: FemMesh::readAbaqus() =================================\n");
 
-    /*
-    Python command to read Abaqus inp mesh file from test suite:
-    from feminout.importInpMesh import read as read_inp
-    femmesh = read_inp(FreeCAD.ConfigGet("AppHomePath") + 'Mod/Fem/femtest/data/mesh/tetra10_mesh.inp')
-    */
+    _Mtrx = Base::Matrix4D();
 
-    PyObject* module = PyImport_ImportModule("feminout.importInpMesh");
-    if (!module)
-        return;
-    try {
-        Py::Module abaqusmod(module, true);
-        Py::Callable method(abaqusmod.getAttr("read"));
-        Py::Tuple args(1);
-        args.setItem(0, Py::String(FileName));
-        Py::Object mesh(method.apply(args));
-        if (PyObject_TypeCheck(mesh.ptr(), &FemMeshPy::Type)) {
-            FemMeshPy* fempy = static_cast<FemMeshPy*>(mesh.ptr());
-            FemMesh* fem = fempy->getFemMeshPtr();
-            *this = *fem; // the deep copy should be avoided, a pointer swap method could be implemented
-                          // see https://forum.freecadweb.org/viewtopic.php?f=10&t=31999&start=10#p274241
+    std::vector<std::unique_ptr<TextFile> > files;
+    std::vector<TextLine> lines;
+    collectAbaqusLines(FileName, files, lines);
+
+    // the data lines of the *NODE and *ELEMENT keywords of the model definition,
+    // a node block has no element type
+    struct DataBlock {
+        std::size_t first;
+        std::size_t last;
+        const AbaqusElementType* type;
+    };
+    std::vector<DataBlock> blocks;
+    std::set<std::string> unsupportedTypes;
+    bool modelDefinition = true;
+    bool readData = false;
+    for (std::size_t i = 0; i < lines.size(); i++) {
+        const TextLine& line = lines[i];
+        if (line.first == line.second || *line.first != '*') {
+            if (readData && !isBlank(line))
+                blocks.back().last = i + 1;
+            continue;
         }
-        else {
-            throw Base::FileException("Problems reading file");
+        if (line.second - line.first > 1 && line.first[1] == '*') // comment
+            continue;
+
+        readData = false;
+        if (startsWith(line, "*NODE") && modelDefinition) {
+            blocks.push_back({i + 1, i + 1, nullptr});
+            readData = true;
+        }
+        else if (startsWith(line, "*ELEMENT")) {
+            std::string typeName = getAbaqusParameter(line, "TYPE");
+            const AbaqusElementType* type = findAbaqusElementType(typeName);
+            if (type) {
+                blocks.push_back({i + 1, i + 1, type});
+                readData = true;
+            }
+            else if (!typeName.empty()) {
+                unsupportedTypes.insert(typeName);
+            }
+        }
+        else if (startsWith(line, "*STEP")) {
+            modelDefinition = false;
         }
     }
-    catch (Py::Exception& e) {
-        e.clear();
+
+    for (const std::string& it : unsupportedTypes)
+        Base::Console().Error("Error: %s not supported.\n", it.c_str());
+
+    Base::Console().Log("    %f: %d lines read, start parsing\n",
+        Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()), static_cast<int>(lines.size()));
+
+    // Each chunk of a block is parsed into a flat array of numbers. Elements may
+    // continue on the next line, so the element numbers are only grouped into
+    // elements after all chunks are parsed.
+    struct DataChunk {
+        const DataBlock* block;
+        IndexRange range;
+        std::vector<int> ids;
+        std::vector<double> coords;
+        std::string error;
+    };
+    std::vector<DataChunk> chunks;
+    for (const DataBlock& block : blocks) {
+        for (const IndexRange& range : splitIndexRange(block.last - block.first, 1024)) {
+            chunks.push_back(DataChunk());
+            chunks.back().block = &block;
+            chunks.back().range = IndexRange(block.first + range.first, block.first + range.second);
+        }
+    }
+
+    QtConcurrent::blockingMap(chunks, [&lines](DataChunk& chunk) {
+        for (std::size_t i = chunk.range.first; i < chunk.range.second; i++) {
+            const TextLine& line = lines[i];
+            if (isBlank(line) || *line.first == '*')
+                continue;
+            const char* pos = line.first;
+            int id;
+            if (!chunk.block->type) {
+                double x, y, z;
+                if (!nextInt(pos, line.second, id) || !nextDouble(pos, line.second, x) ||
+                    !nextDouble(pos, line.second, y) || !nextDouble(pos, line.second, z)) {
+                    chunk.error = "Invalid node: " + std::string(line.first, line.second);
+                    return;
+                }
+                chunk.ids.push_back(id);
+                chunk.coords.push_back(x);
+                chunk.coords.push_back(y);
+                chunk.coords.push_back(z);
+            }
+            else {
+                while (nextInt(pos, line.second, id))
+                    chunk.ids.push_back(id);
+            }
+        }
+    });
+
+    MeshBuffer buffer;
+    std::vector<int> numbers;
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        const DataChunk& chunk = chunks[i];
+        if (!chunk.error.empty())
+            throw Base::FileException(chunk.error.c_str(), FileName.c_str());
+
+        const AbaqusElementType* type = chunk.block->type;
+        if (!type) {
+            for (std::size_t j = 0; j < chunk.ids.size(); j++)
+                buffer.addNode(chunk.ids[j], chunk.coords[3*j], chunk.coords[3*j+1], chunk.coords[3*j+2]);
+            continue;
+        }
+
+        numbers.insert(numbers.end(), chunk.ids.begin(), chunk.ids.end());
+        if (i + 1 < chunks.size() && chunks[i + 1].block == chunk.block)
+            continue;
+
+        // last chunk of the element block
+        if (type->numNodes == 3 && type->dim == 1)
+            Base::Console().Error("Error: seg3 (3-node beam element type) not supported, yet.\n");
+        std::size_t stride = 1 + type->numNodes;
+        int nodes[20];
+        for (std::size_t j = 0; j + stride <= numbers.size(); j += stride) {
+            for (int k = 0; k < type->numNodes; k++)
+                nodes[k] = numbers[j + 1 + type->order[k]];
+            buffer.addElement(numbers[j], type->dim, nodes, type->numNodes);
+        }
+        numbers.clear();
+    }
+
+    Base::Console().Log("    %f: %d nodes and %d elements parsed, start building mesh\n",
+        Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()),
+        static_cast<int>(buffer.numNodes()), static_cast<int>(buffer.numElements()));
+
+    SMESHDS_Mesh* meshds = this->myMesh->GetMeshDS();
+    meshds->ClearMesh();
+    if (buffer.numNodes() == 0) {
+        Base::Console().Log("    No nodes found\n");
+        return;
     }
+    buffer.insertInto(meshds, "ABAQUS");
+
     Base::Console().Log("    %f: Done \n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 }
 
@@ -1761,34 +2414,107 @@ void FemMesh::readZ88(const std::string &FileName)
     Base::TimeInfo Start;
     Base::Console().Log("Start: FemMesh::readZ88() =================================\n");
 
-    /*
-    Python command to read Z88 mesh file from test suite:
-    from feminout.importZ88Mesh import read as read_z88
-    femmesh = read_z88(FreeCAD.ConfigGet("AppHomePath") + 'Mod/Fem/femtest/data/mesh/tetra10_mesh.z88')
-    */
+    _Mtrx = Base::Matrix4D();
 
-    PyObject* module = PyImport_ImportModule("feminout.importZ88Mesh");
-    if (!module)
+    // the mesh stays empty if the file can't be read completely
+    SMESHDS_Mesh* meshds = this->myMesh->GetMeshDS();
+    meshds->ClearMesh();
+
+    TextFile file(FileName);
+    const std::vector<TextLine>& lines = file.lines;
+
+    // header: dimension, number of nodes, number of elements, number of degrees of freedom, kflag
+    int header[5] = {0, 0, 0, 0, 0};
+    if (!lines.empty()) {
+        const char* pos = lines[0].first;
+        for (int& value : header) {
+            if (!nextInt(pos, lines[0].second, value))
+                break;
+        }
+    }
+    int numNodes = header[1];
+    int numElements = header[2];
+    if (header[4] != 0) {
+        Base::Console().Error("KFLAG = 1, Rotational coordinates not supported at the moment\n");
         return;
-    try {
-        Py::Module z88mod(module, true);
-        Py::Callable method(z88mod.getAttr("read"));
-        Py::Tuple args(1);
-        args.setItem(0, Py::String(FileName));
-        Py::Object mesh(method.apply(args));
-        if (PyObject_TypeCheck(mesh.ptr(), &FemMeshPy::Type)) {
-            FemMeshPy* fempy = static_cast<FemMeshPy*>(mesh.ptr());
-            FemMesh* fem = fempy->getFemMeshPtr();
-            *this = *fem; // the deep copy should be avoided, a pointer swap method could be implemented
-                          // see https://forum.freecadweb.org/viewtopic.php?f=10&t=31999&start=10#p274241
+    }
+    if (numNodes <= 0 || lines.size() < static_cast<std::size_t>(1 + numNodes + 2 * numElements)) {
+        Base::Console().Error("Z88: Unexpected end of file %s\n", FileName.c_str());
+        return;
+    }
+
+    // nodes: number, degrees of freedom, x, y, z (without z in 2D)
+    std::vector<int> nodeIds(numNodes);
+    std::vector<double> coords(3 * numNodes, 0.0);
+    std::vector<char> valid(numNodes + numElements, 0);
+    std::vector<IndexRange> nodeChunks = splitIndexRange(numNodes, 1024);
+    QtConcurrent::blockingMap(nodeChunks, [&](const IndexRange& range) {
+        for (std::size_t i = range.first; i < range.second; i++) {
+            const TextLine& line = lines[1 + i];
+            const char* pos = line.first;
+            int dof;
+            valid[i] = nextInt(pos, line.second, nodeIds[i]) && nextInt(pos, line.second, dof) &&
+                       nextDouble(pos, line.second, coords[3*i]) && nextDouble(pos, line.second, coords[3*i+1]);
+            if (header[0] == 3)
+                valid[i] = valid[i] && nextDouble(pos, line.second, coords[3*i+2]);
         }
-        else {
-            throw Base::FileException("Problems reading file");
+    });
+
+    // elements: a line with number and type, followed by a line with the nodes
+    std::vector<int> elemIds(numElements);
+    std::vector<int> elemTypes(numElements);
+    std::vector<int> elemNodes(20 * numElements);
+    std::vector<IndexRange> elemChunks = splitIndexRange(numElements, 1024);
+    QtConcurrent::blockingMap(elemChunks, [&](const IndexRange& range) {
+        std::size_t first = 1 + numNodes;
+        for (std::size_t i = range.first; i < range.second; i++) {
+            const TextLine& line1 = lines[first + 2 * i];
+            const TextLine& line2 = lines[first + 2 * i + 1];
+            const char* pos = line1.first;
+            if (!nextInt(pos, line1.second, elemIds[i]) || !nextInt(pos, line1.second, elemTypes[i]))
+                continue;
+            const Z88ElementType* type = findZ88ElementType(elemTypes[i]);
+            if (!type)
+                continue;
+            int nodes[20];
+            pos = line2.first;
+            bool ok = true;
+            for (int k = 0; k < type->numNodes && ok; k++)
+                ok = nextInt(pos, line2.second, nodes[k]);
+            if (!ok)
+                continue;
+            for (int k = 0; k < type->numNodes; k++)
+                elemNodes[20 * i + k] = nodes[type->order[k]];
+            valid[numNodes + i] = 1;
+        }
+    });
+
+    MeshBuffer buffer;
+    for (int i = 0; i < numNodes; i++) {
+        if (!valid[i]) {
+            Base::Console().Error("Z88: Invalid node in line %d\n", i + 2);
+            return;
         }
+        buffer.addNode(nodeIds[i], coords[3*i], coords[3*i+1], coords[3*i+2]);
     }
-    catch (Py::Exception& e) {
-        e.clear();
+    for (int i = 0; i < numElements; i++) {
+        const Z88ElementType* type = findZ88ElementType(elemTypes[i]);
+        if (!type && elemTypes[i] != 0) {
+            Base::Console().Error("Z88 element type %d is not supported at the moment\n", elemTypes[i]);
+            return;
+        }
+        if (!valid[numNodes + i]) {
+            Base::Console().Error("Z88: Invalid element in line %d\n", 2 + numNodes + 2 * i);
+            return;
+        }
+        buffer.addElement(elemIds[i], type->dim, &elemNodes[20 * i], type->numNodes);
     }
+
+    Base::Console().Log("    %f: %d nodes and %d elements parsed, start building mesh\n",
+        Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()), numNodes, numElements);
+
+    buffer.insertInto(meshds, "Z88");
+
     Base::Console().Log("    %f: Done \n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 }
 
@@ -1970,20 +2696,29 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
     }
 
     // get all data --> Extract Nodes and Elements of the current SMESH datastructure
-    typedef std::map<int, Base::Vector3d> VertexMap;
-    typedef std::map<int, std::vector<int> > NodesMap;
-    typedef std::map<std::string, NodesMap> ElementsMap;
+    // the lists are sorted by id once they are complete
+    typedef std::vector<std::pair<int, Base::Vector3d> > VertexList;
+    typedef std::vector<std::pair<int, std::vector<int> > > NodesList;
+    typedef std::map<std::string, NodesList> ElementsMap;
+    auto byId = [](const std::pair<int, std::vector<int> >& a, const std::pair<int, std::vector<int> >& b) {
+        return a.first < b.first;
+    };
 
     // get nodes
-    VertexMap vertexMap;  // empty nodes map
+    VertexList vertexList;  // empty nodes list
+    vertexList.reserve(myMesh->GetMeshDS()->NbNodes());
     SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
     Base::Vector3d current_node;
     while (aNodeIter->more()) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
         current_node.Set(aNode->X(),aNode->Y(),aNode->Z());
         current_node = _Mtrx * current_node;
-        vertexMap[aNode->GetID()] = current_node;
+        vertexList.emplace_back(aNode->GetID(), current_node);
     }
+    std::sort(vertexList.begin(), vertexList.end(),
+              [](const std::pair<int, Base::Vector3d>& a, const std::pair<int, Base::Vector3d>& b) {
+        return a.first < b.first;
+    });
 
     // get volumes
     ElementsMap elementsMapVol;  // empty volumes map
@@ -1998,7 +2733,7 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
             const std::vector<int>& order = elemOrderMap[it->second];
             for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
                 apair.second.push_back(aVol->GetNode(*jt)->GetID());
-            elementsMapVol[it->second].insert(apair);
+            elementsMapVol[it->second].push_back(std::move(apair));
         }
     }
 
@@ -2018,7 +2753,7 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
                 const std::vector<int>& order = elemOrderMap[it->second];
                 for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
                     apair.second.push_back(aFace->GetNode(*jt)->GetID());
-                elementsMapFac[it->second].insert(apair);
+                elementsMapFac[it->second].push_back(std::move(apair));
             }
         }
     }
@@ -2035,7 +2770,7 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
                 const std::vector<int>& order = elemOrderMap[it->second];
                 for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
                     apair.second.push_back(aFace->GetNode(*jt)->GetID());
-                elementsMapFac[it->second].insert(apair);
+                elementsMapFac[it->second].push_back(std::move(apair));
             }
         }
     }
@@ -2056,7 +2791,7 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
                 const std::vector<int>& order = elemOrderMap[it->second];
                 for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
                     apair.second.push_back(aEdge->GetNode(*jt)->GetID());
-                elementsMapEdg[it->second].insert(apair);
+                elementsMapEdg[it->second].push_back(std::move(apair));
             }
         }
     }
@@ -2073,11 +2808,16 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
                 const std::vector<int>& order = elemOrderMap[it->second];
                 for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
                     apair.second.push_back(aEdge->GetNode(*jt)->GetID());
-                elementsMapEdg[it->second].insert(apair);
+                elementsMapEdg[it->second].push_back(std::move(apair));
             }
         }
     }
 
+    for (ElementsMap* elementsMap : {&elementsMapVol, &elementsMapFac, &elementsMapEdg}) {
+        for (auto& it : *elementsMap)
+            std::sort(it.second.begin(), it.second.end(), byId);
+    }
+
     // write all data to file
     // take also care of special characters in path https://forum.freecadweb.org/viewtopic.php?f=10&t=37436
     Base::FileInfo fi(Filename);
@@ -2101,12 +2841,17 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
     anABAQUS_Output << "*Node, NSET=Nall" << std::endl;
     // This way we get sorted output.
     // See http://forum.freecadweb.org/viewtopic.php?f=18&t=12646&start=40#p103004
-    for (VertexMap::iterator it = vertexMap.begin(); it != vertexMap.end(); ++it) {
-        anABAQUS_Output << it->first << ", "
-            << it->second.x << ", "
-            << it->second.y << ", "
-            << it->second.z << std::endl;
-    }
+    // The lines of large meshes are formatted in parallel.
+    writeLines(anABAQUS_Output, vertexList.size(), [&vertexList](std::size_t i, std::string& str) {
+        appendInt(str, vertexList[i].first);
+        str += ", ";
+        appendDouble(str, vertexList[i].second.x);
+        str += ", ";
+        appendDouble(str, vertexList[i].second.y);
+        str += ", ";
+        appendDouble(str, vertexList[i].second.z);
+        str += '\n';
+    });
     anABAQUS_Output << std::endl << std::endl;;
 
 
@@ -2116,25 +2861,28 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
         for (ElementsMap::iterator it = elementsMapVol.begin(); it != elementsMapVol.end(); ++it) {
             anABAQUS_Output << "** Volume elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it->first << ", ELSET=Evolumes" << std::endl;
-            for (NodesMap::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
-                anABAQUS_Output << jt->first;
+            const NodesList& volumes = it->second;
+            writeLines(anABAQUS_Output, volumes.size(), [&volumes](std::size_t i, std::string& str) {
+                appendInt(str, volumes[i].first);
                 // Calculix allows max 16 entries in one line, a hexa20 has more !
                 int ct = 0;  // counter
                 bool first_line = true;
-                for (std::vector<int>::iterator kt = jt->second.begin(); kt != jt->second.end(); ++kt, ++ct) {
+                for (std::vector<int>::const_iterator kt = volumes[i].second.begin(); kt != volumes[i].second.end(); ++kt, ++ct) {
                     if (ct < 15) {
-                        anABAQUS_Output  << ", " << *kt;
+                        str += ", ";
+                        appendInt(str, *kt);
                     }
                     else {
                         if (first_line == true) {
-                            anABAQUS_Output << "," << std::endl;
+                            str += ",\n";
                             first_line = false;
                         }
-                        anABAQUS_Output << *kt << ", ";
+                        appendInt(str, *kt);
+                        str += ", ";
                     }
                 }
-                anABAQUS_Output << std::endl;
-            }
+                str += '\n';
+            });
         }
         elsetname += "Evolumes";
         anABAQUS_Output << std::endl;
@@ -2145,13 +2893,15 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
         for (ElementsMap::iterator it = elementsMapFac.begin(); it != elementsMapFac.end(); ++it) {
             anABAQUS_Output << "** Face elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it->first << ", ELSET=Efaces" << std::endl;
-            for (NodesMap::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
-                anABAQUS_Output << jt->first;
-                for (std::vector<int>::iterator kt = jt->second.begin(); kt != jt->second.end(); ++kt) {
-                    anABAQUS_Output << ", " << *kt;
+            const NodesList& elements = it->second;
+            writeLines(anABAQUS_Output, elements.size(), [&elements](std::size_t i, std::string& str) {
+                appendInt(str, elements[i].first);
+                for (std::vector<int>::const_iterator kt = elements[i].second.begin(); kt != elements[i].second.end(); ++kt) {
+                    str += ", ";
+                    appendInt(str, *kt);
                 }
-                anABAQUS_Output << std::endl;
-            }
+                str += '\n';
+            });
         }
         if (elsetname == "")
             elsetname += "Efaces";
@@ -2165,13 +2915,15 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
         for (ElementsMap::iterator it = elementsMapEdg.begin(); it != elementsMapEdg.end(); ++it) {
             anABAQUS_Output << "** Edge elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it->first << ", ELSET=Eedges" << std::endl;
-            for (NodesMap::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
-                anABAQUS_Output << jt->first;
-                for (std::vector<int>::iterator kt = jt->second.begin(); kt != jt->second.end(); ++kt) {
-                    anABAQUS_Output << ", " << *kt;
+            const NodesList& elements = it->second;
+            writeLines(anABAQUS_Output, elements.size(), [&elements](std::size_t i, std::string& str) {
+                appendInt(str, elements[i].first);
+                for (std::vector<int>::const_iterator kt = elements[i].second.begin(); kt != elements[i].second.end(); ++kt) {
+                    str += ", ";
+                    appendInt(str, *kt);
                 }
-                anABAQUS_Output << std::endl;
-            }
+                str += '\n';
+            });
         }
         if (elsetname == "")
             elsetname += "Eedges";
@@ -2321,7 +3073,22 @@ void FemMesh::write(const char *FileName) const
 
 unsigned int FemMesh::getMemSize (void) const
 {
-    return 0;
+    const SMESHDS_Mesh* data = myMesh->GetMeshDS();
+    if (!data)
+        return 0;
+
+    // the coordinates and the connectivity are kept in a VTK grid, the nodes
+    // and elements are objects referencing it that are looked up by their id
+    std::uint64_t size = 0;
+    vtkUnstructuredGrid* grid = const_cast<SMESHDS_Mesh*>(data)->getGrid();
+    if (grid)
+        size += static_cast<std::uint64_t>(grid->GetActualMemorySize()) * 1024;
+    std::uint64_t nodes = data->NbNodes();
+    std::uint64_t elements = data->Nb0DElements() + data->NbBalls() + data->NbEdges()
+                           + data->NbFaces() + data->NbVolumes();
+    size += nodes * (sizeof(SMDS_MeshNode) + sizeof(void*));
+    size += elements * (sizeof(SMDS_MeshCell) + sizeof(void*));
+    return clampMemSize(size);
 }
 
 void FemMesh::Save (Base::Writer &writer) const
@@ -112,6 +112,15 @@ public:
     std::set<int> getEdgesOnly(void) const;
     /// retrieving IDs of faces not belonging to any volume
     std::set<int> getFacesOnly(void) const;
+    /// retrieving volume IDs and face numbers of the volume faces not shared by two volumes
+    std::vector<std::pair<int, int> > getVolumeBoundaryFaces(void) const;
+    /** Find the faces that occur twice in a list of element faces, i.e. the inner faces.
+     *  Face i has the node IDs faceNodes[faceOffsets[i]] to faceNodes[faceOffsets[i+1]-1]
+     *  in any order. Returns a flag for each face, set if it is an inner face.
+     *  The faces are hashed and sorted in parallel, no spatial search is needed.
+     */
+    static std::vector<char> findInnerFaces(const std::vector<int>& faceNodes,
+                                            const std::vector<int>& faceOffsets);
      //@}
 
     /** @name Placement control */
@@ -788,6 +788,29 @@ PyObject* FemMeshPy::getccxVolumesByFace(PyObject *args)
     }
 }
 
+PyObject* FemMeshPy::getVolumeBoundaryFaces(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    try {
+        Py::List ret;
+        std::vector<std::pair<int, int> > resultSet = getFemMeshPtr()->getVolumeBoundaryFaces();
+        for (std::vector<std::pair<int, int> >::const_iterator it = resultSet.begin(); it != resultSet.end(); ++it) {
+            Py::Tuple vol_face(2);
+            vol_face.setItem(0, Py::Long(it->first));
+            vol_face.setItem(1, Py::Long(it->second));
+            ret.append(vol_face);
+        }
+
+        return Py::new_reference_to(ret);
+    }
+    catch (const std::exception& e) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, e.what());
+        return 0;
+    }
+}
+
 PyObject* FemMeshPy::getNodeById(PyObject *args)
 {
     int id;
@@ -24,6 +24,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <cstring>
 #endif
 
 #include "FemResultObject.h"
@@ -58,6 +59,29 @@ short FemResultObject::mustExecute(void) const
     return 0;
 }
 
+const App::PropertyFloatList* FemResultObject::getScalarField(const char* name) const
+{
+    return dynamic_cast<const App::PropertyFloatList*>(getPropertyByName(name));
+}
+
+const App::PropertyVectorList* FemResultObject::getVectorField(const char* name) const
+{
+    return dynamic_cast<const App::PropertyVectorList*>(getPropertyByName(name));
+}
+
+void FemResultObject::handleChangedPropertyType(Base::XMLReader &reader, const char *TypeName, App::Property *prop)
+{
+    // node numbers were saved as an XML integer list in older versions
+    if (prop == &NodeNumbers && strcmp(TypeName, "App::PropertyIntegerList") == 0) {
+        App::PropertyIntegerList numbers;
+        numbers.Restore(reader);
+        NodeNumbers.setValues(numbers.getValues());
+    }
+    else {
+        App::DocumentObject::handleChangedPropertyType(reader, TypeName, prop);
+    }
+}
+
 PyObject *FemResultObject::getPyObject()
 {
     if (PythonObject.is(Py::_None())){
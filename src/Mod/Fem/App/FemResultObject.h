@@ -27,8 +27,9 @@
 #include <App/DocumentObject.h>
 #include <App/PropertyUnits.h>
 #include <App/PropertyStandard.h>
+#include <App/PropertyGeo.h>
 #include <App/FeaturePython.h>
-#include "FemResultObject.h"
+#include "FemResultProperty.h"
 
 namespace Fem
 {
@@ -42,7 +43,7 @@ public:
     FemResultObject(void);
     virtual ~FemResultObject();
 
-    App::PropertyIntegerList NodeNumbers;
+    PropertyNodeNumberList NodeNumbers;
     /// Link to the corresponding mesh
     App::PropertyLink Mesh;
     /// Stats of analysis
@@ -63,6 +64,18 @@ public:
     virtual short mustExecute(void) const;
     virtual PyObject *getPyObject(void);
 
+    /** @name Result columns
+     * Direct access to the per node result lists of this object (including the ones
+     * added by Python subclasses), no copy of the values is made.
+     * nullptr is returned if there is no list of the requested type with this name.
+     */
+    //@{
+    const App::PropertyFloatList* getScalarField(const char* name) const;
+    const App::PropertyVectorList* getVectorField(const char* name) const;
+    //@}
+
+protected:
+    virtual void handleChangedPropertyType(Base::XMLReader &reader, const char *TypeName, App::Property *prop);
 
 };
 
@@ -0,0 +1,117 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <vector>
+#endif
+
+#include <Base/Reader.h>
+#include <Base/Stream.h>
+#include <Base/Writer.h>
+
+#include "FemResultProperty.h"
+
+using namespace Fem;
+
+TYPESYSTEM_SOURCE(Fem::PropertyNodeNumberList, App::PropertyIntegerList)
+
+PropertyNodeNumberList::PropertyNodeNumberList()
+{
+}
+
+PropertyNodeNumberList::~PropertyNodeNumberList()
+{
+}
+
+void PropertyNodeNumberList::Save (Base::Writer &writer) const
+{
+    if (writer.isForceXML()) {
+        App::PropertyIntegerList::Save(writer);
+    }
+    else {
+        writer.Stream() << writer.ind() << "<IntegerList file=\"" <<
+            (getSize() ? writer.addFile(getName(), this) : "") << "\"/>" << std::endl;
+    }
+}
+
+void PropertyNodeNumberList::Restore(Base::XMLReader &reader)
+{
+    reader.readElement("IntegerList");
+    if (reader.hasAttribute("file")) {
+        std::string file (reader.getAttribute("file"));
+        if (!file.empty()) {
+            // initiate a file read
+            reader.addFile(file.c_str(),this);
+        }
+        else {
+            setValues(std::vector<long>());
+        }
+        return;
+    }
+
+    // written with forced XML
+    int count = reader.getAttributeAsInteger("count");
+    std::vector<long> values(count);
+    for (int i = 0; i < count; i++) {
+        reader.readElement("I");
+        values[i] = reader.getAttributeAsInteger("v");
+    }
+    reader.readEndElement("IntegerList");
+    setValues(values);
+}
+
+void PropertyNodeNumberList::SaveDocFile (Base::Writer &writer) const
+{
+    Base::OutputStream str(writer.Stream());
+    const std::vector<long>& values = getValues();
+    uint32_t uCt = (uint32_t)values.size();
+    str << uCt;
+    for (std::vector<long>::const_iterator it = values.begin(); it != values.end(); ++it) {
+        int32_t v = (int32_t)*it;
+        str << v;
+    }
+}
+
+void PropertyNodeNumberList::RestoreDocFile(Base::Reader &reader)
+{
+    Base::InputStream str(reader);
+    uint32_t uCt=0;
+    str >> uCt;
+    std::vector<long> values(uCt);
+    for (std::vector<long>::iterator it = values.begin(); it != values.end(); ++it) {
+        int32_t v;
+        str >> v;
+        *it = v;
+    }
+    setValues(values);
+}
+
+App::Property *PropertyNodeNumberList::Copy() const
+{
+    PropertyNodeNumberList *p= new PropertyNodeNumberList();
+    p->setValues(getValues());
+    return p;
+}
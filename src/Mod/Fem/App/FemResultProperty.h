@@ -0,0 +1,60 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef Fem_FemResultProperty_H
+#define Fem_FemResultProperty_H
+
+#include <App/PropertyStandard.h>
+
+namespace Fem
+{
+
+/** Node numbers of a result.
+ * Behaves like App::PropertyIntegerList but is saved as a binary file in the
+ * document archive instead of one XML element per node, so results with millions
+ * of nodes can be saved and loaded quickly.
+ */
+class AppFemExport PropertyNodeNumberList : public App::PropertyIntegerList
+{
+    TYPESYSTEM_HEADER_WITH_OVERRIDE();
+
+public:
+    PropertyNodeNumberList();
+    virtual ~PropertyNodeNumberList();
+
+    /** @name Save/restore */
+    //@{
+    virtual void Save (Base::Writer &writer) const override;
+    virtual void Restore(Base::XMLReader &reader) override;
+    virtual void SaveDocFile (Base::Writer &writer) const override;
+    virtual void RestoreDocFile(Base::Reader &reader) override;
+
+    virtual App::Property *Copy(void) const override;
+    //@}
+};
+
+} //namespace Fem
+
+
+#endif // Fem_FemResultProperty_H
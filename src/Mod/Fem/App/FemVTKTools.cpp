@@ -28,6 +28,7 @@
 # include <Python.h>
 # include <cstdlib>
 # include <memory>
+# include <algorithm>
 # include <cmath>
 # include <map>
 
@@ -60,6 +61,7 @@
 # include <vtkCellArray.h>
 # include <vtkDataArray.h>
 # include <vtkDoubleArray.h>
+# include <vtkFloatArray.h>
 # include <vtkIdList.h>
 # include <vtkCellTypes.h>
 # include <vtkTriangle.h>
@@ -725,6 +727,29 @@ std::map<std::string, std::string> _getFreeCADMechResultScalarProperties() {
 }
 
 
+// copy the tuples of a vtk array into a flat array of doubles, reading the raw
+// memory of the common double and float arrays instead of calling GetTuple() per tuple
+void copyVtkTuples(vtkDataArray* array, vtkIdType nTuples, double* dest)
+{
+    const vtkIdType nComp = array->GetNumberOfComponents();
+    nTuples = std::min(nTuples, array->GetNumberOfTuples());
+    if (vtkDoubleArray* da = vtkDoubleArray::SafeDownCast(array)) {
+        const double* src = da->GetPointer(0);
+        std::copy(src, src + nTuples * nComp, dest);
+    }
+    else if (vtkFloatArray* fa = vtkFloatArray::SafeDownCast(array)) {
+        const float* src = fa->GetPointer(0);
+        std::copy(src, src + nTuples * nComp, dest);
+    }
+    else {
+        for (vtkIdType i = 0; i < nTuples; ++i) {
+            double* tuple = array->GetTuple(i);
+            std::copy(tuple, tuple + nComp, dest + i * nComp);
+        }
+    }
+}
+
+
 void FemVTKTools::importFreeCADResult(vtkSmartPointer<vtkDataSet> dataset, App::DocumentObject* result) {
     Base::Console().Log("Start: import vtk result file data into a FreeCAD result object.\n");
 
@@ -757,10 +782,11 @@ void FemVTKTools::importFreeCADResult(vtkSmartPointer<vtkDataSet> dataset, App::
         if(vector_field && vector_field->GetNumberOfComponents() == dim) {
             App::PropertyVectorList* vector_list = static_cast<App::PropertyVectorList*>(result->getPropertyByName(it->first.c_str()));
             if(vector_list) {
+                std::vector<double> flat(3 * nPoints, 0.0);
+                copyVtkTuples(vector_field, nPoints, flat.data());
                 std::vector<Base::Vector3d> vec(nPoints);
                 for(vtkIdType i=0; i<nPoints; ++i) {
-                    double *p = vector_field->GetTuple(i); // both vtkFloatArray and vtkDoubleArray return double* for GetTuple(i)
-                    vec[i] = (Base::Vector3d(p[0], p[1], p[2]));
+                    vec[i] = Base::Vector3d(flat[3*i], flat[3*i+1], flat[3*i+2]);
                 }
                 // PropertyVectorList will not show up in PropertyEditor
                 vector_list->setValues(vec);
@@ -785,15 +811,8 @@ void FemVTKTools::importFreeCADResult(vtkSmartPointer<vtkDataSet> dataset, App::
                 continue;
             }
 
-            double vmin=1.0e100, vmean=0.0, vmax=-1.0e100;
             std::vector<double> values(nPoints, 0.0);
-            for(vtkIdType i = 0; i < vec->GetNumberOfTuples(); i++) {
-                double v = *(vec->GetTuple(i));
-                values[i] = v;
-                vmean += v;
-                if(v > vmax) vmax = v;
-                if(v < vmin) vmin = v;
-            }
+            copyVtkTuples(vec, nPoints, values.data());
             field->setValues(values);
             Base::Console().Log("    A PropertyFloatList has been filled with vales: %s\n", it->first.c_str());
         }
@@ -827,13 +846,21 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
     SMESH_Mesh* smesh = const_cast<SMESH_Mesh*>(static_cast<FemMeshObject*>(meshObj)->FemMesh.getValue().getSMesh());
     SMESHDS_Mesh* meshDS = smesh->GetMeshDS();
 
+    // the i-th result value belongs to the i-th node of the mesh, look up the vtk
+    // point of each node once instead of iterating the mesh for every result list
+    std::vector<vtkIdType> pointIds;
+    pointIds.reserve(meshDS->NbNodes());
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
+    while (aNodeIter->more()) {
+        const SMDS_MeshNode* node = aNodeIter->next();
+        pointIds.push_back(node->GetID()-1);
+    }
+
     // vectors
     for (std::map<std::string, std::string>::iterator it = vectors.begin(); it != vectors.end(); ++it) {
         const int dim=3;  //Fixme, detect dim, but FreeCAD PropertyVectorList ATM only has DIM of 3
-        App::PropertyVectorList* field = nullptr;
-        if (res->getPropertyByName(it->first.c_str()))
-            field = static_cast<App::PropertyVectorList*>(res->getPropertyByName(it->first.c_str()));
-        else
+        const App::PropertyVectorList* field = res->getVectorField(it->first.c_str());
+        if (!field)
             Base::Console().Error("    PropertyVectorList not found: %s\n", it->first.c_str());
 
         if (field && field->getSize() > 0) {
@@ -845,20 +872,20 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
             data->SetNumberOfTuples(nPoints);
             data->SetName(it->second.c_str());
 
+            double* tuples = data->GetPointer(0);
+
             //we need to set values for the unused points.
             //TODO: ensure that the result bar does not include the used 0 if it is not part of the result (e.g. does the result bar show 0 as smallest value?)
             if (nPoints != field->getSize()) {
-                double tuple[] = {0,0,0};
-                for (vtkIdType i=0; i<nPoints; ++i) {
-                    data->SetTuple(i, tuple);
-                }
+                std::fill(tuples, tuples + dim * nPoints, 0.0);
             }
 
-            SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-            for (std::vector<Base::Vector3d>::const_iterator jt=vel.begin(); jt!=vel.end(); ++jt) {
-                const SMDS_MeshNode* node = aNodeIter->next();
-                double tuple[] = {jt->x, jt->y, jt->z};
-                data->SetTuple(node->GetID()-1, tuple);
+            std::size_t count = std::min(vel.size(), pointIds.size());
+            for (std::size_t i=0; i<count; ++i) {
+                double* tuple = tuples + dim * pointIds[i];
+                tuple[0] = vel[i].x;
+                tuple[1] = vel[i].y;
+                tuple[2] = vel[i].z;
             }
             grid->GetPointData()->AddArray(data);
             Base::Console().Log("    The PropertyVectorList %s was exported to VTK vector list: %s\n", it->first.c_str(), it->second.c_str());
@@ -870,10 +897,8 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
 
     // scalars
     for (std::map<std::string, std::string>::iterator it = scalars.begin(); it != scalars.end(); ++it) {
-        App::PropertyFloatList* field = nullptr;
-        if (res->getPropertyByName(it->first.c_str()))
-            field = static_cast<App::PropertyFloatList*>(res->getPropertyByName(it->first.c_str()));
-        else
+        const App::PropertyFloatList* field = res->getScalarField(it->first.c_str());
+        if (!field)
             Base::Console().Error("PropertyFloatList %s not found \n", it->first.c_str());
 
         if (field && field->getSize() > 0) {
@@ -884,18 +909,17 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
             data->SetNumberOfValues(nPoints);
             data->SetName(it->second.c_str());
 
+            double* values = data->GetPointer(0);
+
             //we need to set values for the unused points.
             //TODO: ensure that the result bar does not include the used 0 if it is not part of the result (e.g. does the result bar show 0 as smallest value?)
             if (nPoints != field->getSize()) {
-                for (vtkIdType i=0; i<nPoints; ++i) {
-                    data->SetValue(i, 0);
-                }
-             }
+                std::fill(values, values + nPoints, 0.0);
+            }
 
-            SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-            for (size_t i=0; i<vec.size(); ++i) {
-                const SMDS_MeshNode* node = aNodeIter->next();
-                data->SetValue(node->GetID()-1, vec[i]);
+            std::size_t count = std::min(vec.size(), pointIds.size());
+            for (std::size_t i=0; i<count; ++i) {
+                values[pointIds[i]] = vec[i];
             }
 
             grid->GetPointData()->AddArray(data);
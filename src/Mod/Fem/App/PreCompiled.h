@@ -56,7 +56,9 @@
 #include <vector>
 #include <set>
 #include <bitset>
+#include <cctype>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <cmath>
 
@@ -70,13 +72,16 @@
 // Boost
 #include <boost/assign/list_of.hpp>
 #include <boost/tokenizer.hpp>
+#include <boost/algorithm/string.hpp>
 
 // Salomesh
 #include <SMESH_Version.h>
 #include <SMESH_Gen.hxx>
 #include <SMESH_Group.hxx>
 #include <SMESHDS_Mesh.hxx>
+#include <SMDS_MeshCell.hxx>
 #include <SMDS_MeshNode.hxx>
+#include <SMDS_UnstructuredGrid.hxx>
 #include <StdMeshers_MaxLength.hxx>
 #include <StdMeshers_LocalLength.hxx>
 #include <StdMeshers_NumberOfSegments.hxx>
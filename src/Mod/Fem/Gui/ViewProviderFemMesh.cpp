@@ -51,7 +51,9 @@
 
 # include <QFile>
 
+# include <algorithm>
 # include <sstream>
+# include <unordered_map>
 
 # include <SMESH_Mesh.hxx>
 # include <SMESHDS_Mesh.hxx>
@@ -91,7 +93,6 @@ struct FemFace
         const SMDS_MeshNode* n1,const SMDS_MeshNode* n2,const SMDS_MeshNode* n3,const SMDS_MeshNode* n4=0,
         const SMDS_MeshNode* n5=0,const SMDS_MeshNode* n6=0,const SMDS_MeshNode* n7=0,const SMDS_MeshNode* n8=0);
 
-    bool isSameFace (FemFace &face);
 };
 
 Base::Vector3d FemFace::set(short size,const SMDS_MeshElement* element,unsigned short id,short faceNo,
@@ -135,35 +136,6 @@ Base::Vector3d FemFace::set(short size,const SMDS_MeshElement* element,unsigned
     return Base::Vector3d(Nodes[0]->X(),Nodes[0]->Y(),Nodes[0]->Z());
 }
 
-class FemFaceGridItem : public std::vector<FemFace*>{
-public:
-    //FemFaceGridItem(void){reserve(200);}
-};
-
-bool FemFace::isSameFace (FemFace &face)
-{
-    // the same element can not have the same face
-    if(face.ElementNumber == ElementNumber)
-        return false;
-    if(face.Size != Size)
-        return false;
-    // if the same face size just compare if the sorted nodes are the same
-    if( Nodes[0] == face.Nodes[0] &&
-        Nodes[1] == face.Nodes[1] &&
-        Nodes[2] == face.Nodes[2] &&
-        Nodes[3] == face.Nodes[3] &&
-        Nodes[4] == face.Nodes[4] &&
-        Nodes[5] == face.Nodes[5] &&
-        Nodes[6] == face.Nodes[6] &&
-        Nodes[7] == face.Nodes[7] ){
-            hide = true;
-            face.hide = true;
-            return true;
-    }
-
-    return false;
-}
-
 // ----------------------------------------------------------------------------
 
 class ViewProviderFemMesh::Private
@@ -710,13 +682,10 @@ void ViewProviderFEMMeshBuilder::buildNodes(const App::Property* prop, std::vect
     }
 }
 
-inline void insEdgeVec(std::map<int,std::set<int> > &map, int n1, int n2)
+inline void insEdgeVec(std::vector<std::pair<int,int> > &edges, int n1, int n2)
 {
-    //FIXME: The if-else distinction doesn't make sense
-    //if (n1<n2)
-    //    map[n2].insert(n1);
-    //else
-        map[n2].insert(n1);
+    // collected unsorted, double edges are removed once all faces are processed
+    edges.emplace_back(n2, n1);
 }
 
 inline unsigned long ElemFold(unsigned long Element,unsigned long FaceNbr)
@@ -939,91 +908,33 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
     }
     int FaceSize = facesHelper.size();
 
+    // small meshes may show their inner faces, large ones always hide them
+    if (!ShowInner || FaceSize >= MaxFacesShowInner) {
+        Base::Console().Log("    %f: Start eliminate internal faces\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 
-    if( FaceSize < MaxFacesShowInner){
-        Base::Console().Log("    %f: Start eliminate internal faces SIMPLE\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
-
-        // search for double (inside) faces and hide them
-        if(!ShowInner){
-            for(int l=0; l< FaceSize;l++){
-                if(! facesHelper[l].hide){
-                    for(int i=l+1; i<FaceSize; i++){
-                        if(facesHelper[l].isSameFace(facesHelper[i]) ){
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-    }else{
-        Base::Console().Log("    %f: Start eliminate internal faces GRID\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
-        BndBox.Enlarge(BndBox.CalcDiagonalLength()/10000.0);
-        // calculate grid properties
-        double edge = pow(FaceSize,1.0/3.0);
-        double edgeL = BndBox.LengthX() + BndBox.LengthY() + BndBox.LengthZ();
-        double gridFactor = 5.0;
-        double size = ( edgeL /(3*edge) )*gridFactor;
-
-        unsigned int NbrX = (unsigned int)(BndBox.LengthX()/size)+1;
-        unsigned int NbrY = (unsigned int)(BndBox.LengthY()/size)+1;
-        unsigned int NbrZ = (unsigned int)(BndBox.LengthZ()/size)+1;
-        Base::Console().Log("      Size:F:%f,  X:%i  ,Y:%i  ,Z:%i\n",gridFactor,NbrX,NbrY,NbrZ);
-
-        double Xmin = BndBox.MinX;
-        double Ymin = BndBox.MinY;
-        double Zmin = BndBox.MinZ;
-        double Xln  = BndBox.LengthX() / NbrX;
-        double Yln  = BndBox.LengthY() / NbrY;
-        double Zln  = BndBox.LengthZ() / NbrZ;
-
-        std::vector<FemFaceGridItem> Grid(NbrX*NbrY*NbrZ);
-
-
-        unsigned int iX = 0;
-        unsigned int iY = 0;
-        unsigned int iZ = 0;
-
-        for(int l=0; l< FaceSize;l++){
-            Base::Vector3d point(facesHelper[l].getFirstNodePoint());
-            double x = (point.x - Xmin) / Xln;
-            double y = (point.y - Ymin) / Yln;
-            double z = (point.z - Zmin) / Zln;
-
-            iX = x;
-            iY = y;
-            iZ = z;
-
-            if(iX >= NbrX || iY >= NbrY || iZ >= NbrZ)
-                Base::Console().Log("      Outof range!\n");
-
-            Grid[iX + iY*NbrX + iZ*NbrX*NbrY].push_back(&facesHelper[l]);
+        // flat list of the face nodes, the search for double (inside) faces is done in App
+        std::vector<int> faceNodes;
+        std::vector<int> faceOffsets;
+        faceNodes.reserve(FaceSize * 3);
+        faceOffsets.reserve(FaceSize + 1);
+        faceOffsets.push_back(0);
+        for (int l = 0; l < FaceSize; l++) {
+            for (int i = 0; i < facesHelper[l].Size; i++)
+                faceNodes.push_back(facesHelper[l].Nodes[i]->GetID());
+            faceOffsets.push_back(static_cast<int>(faceNodes.size()));
         }
 
-        unsigned int max =0, avg = 0;
-        for(std::vector<FemFaceGridItem>::iterator it=Grid.begin();it!=Grid.end();++it){
-            for(unsigned int l=0; l< it->size();l++){
-                if(! it->operator[](l)->hide){
-                    for(unsigned int i=l+1; i<it->size(); i++){
-                        if(it->operator[](l)->isSameFace(*(it->operator[](i))) ){
-                            break;
-                        }
-                    }
-                }
-            }
-            if(it->size() > max)max=it->size();
-            avg += it->size();
+        std::vector<char> inner = Fem::FemMesh::findInnerFaces(faceNodes, faceOffsets);
+        for (int l = 0; l < FaceSize; l++) {
+            if (inner[l])
+                facesHelper[l].hide = true;
         }
-        avg = avg/Grid.size();
-
-        Base::Console().Log("      VoxelSize: Max:%i ,Average:%i\n",max,avg);
-
-    } //if( FaceSize < 1000)
-
+    }
 
     Base::Console().Log("    %f: Start build up node map\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 
     // sort out double nodes and build up index map
-    std::map<const SMDS_MeshNode*, int> mapNodeIndex;
+    std::vector<const SMDS_MeshNode*> vecNodes;
 
     // handling the corner case beams only, means no faces/triangles only nodes and edges
     if (onlyEdges){
@@ -1033,7 +944,7 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
             const SMDS_MeshEdge* aEdge = aEdgeIte->next();
             int num = aEdge->NbNodes();
             for (int i = 0; i < num; i++) {
-                mapNodeIndex[aEdge->GetNode(i)] = 0;
+                vecNodes.push_back(aEdge->GetNode(i));
 
             }
         }
@@ -1043,25 +954,31 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
             if (!facesHelper[l].hide) {
                 for (int i = 0; i < 8; i++) {
                     if (facesHelper[l].Nodes[i])
-                        mapNodeIndex[facesHelper[l].Nodes[i]] = 0;
+                        vecNodes.push_back(facesHelper[l].Nodes[i]);
                     else
                         break;
                 }
             }
         }
     }
+    // same point order as an ordered map over the node pointers
+    std::sort(vecNodes.begin(), vecNodes.end());
+    vecNodes.erase(std::unique(vecNodes.begin(), vecNodes.end()), vecNodes.end());
+
     Base::Console().Log("    %f: Start set point vector\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
 
     // set the point coordinates
-    coords->point.setNum(mapNodeIndex.size());
-    vNodeElementIdx.resize(mapNodeIndex.size() );
-    std::map<const SMDS_MeshNode*, int>::iterator it=  mapNodeIndex.begin();
+    std::unordered_map<const SMDS_MeshNode*, int> mapNodeIndex;
+    mapNodeIndex.reserve(vecNodes.size());
+    coords->point.setNum(vecNodes.size());
+    vNodeElementIdx.resize(vecNodes.size());
     SbVec3f* verts = coords->point.startEditing();
-    for (int i=0;it != mapNodeIndex.end() ;++it,i++) {
-        verts[i].setValue((float)it->first->X(),(float)it->first->Y(),(float)it->first->Z());
-        it->second = i;
+    for (std::size_t i = 0; i < vecNodes.size(); i++) {
+        const SMDS_MeshNode* node = vecNodes[i];
+        verts[i].setValue((float)node->X(),(float)node->Y(),(float)node->Z());
+        mapNodeIndex[node] = static_cast<int>(i);
         // set selection idx
-        vNodeElementIdx[i] = it->first->GetID();
+        vNodeElementIdx[i] = node->GetID();
     }
     coords->point.finishEditing();
 
@@ -1082,7 +999,8 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
     }
     Base::Console().Log("    NumTriangles:%i\n",triangleCount);
     // edge map collect and sort edges of the faces to be shown.
-    std::map<int,std::set<int> > EdgeMap;
+    std::vector<std::pair<int,int> > EdgeMap;
+    EdgeMap.reserve(triangleCount * 3);
 
     // handling the corner case beams only, means no faces/triangles only nodes and edges
     if (onlyEdges){
@@ -2461,23 +2379,20 @@ void ViewProviderFEMMeshBuilder::createMesh(const App::Property* prop,
     faces->coordIndex.finishEditing();
 
     Base::Console().Log("    %f: Start build up edge vector\n",Base::TimeInfo::diffTimeF(Start,Base::TimeInfo()));
-    // std::map<int,std::set<int> > EdgeMap;
-    // count edges
-    int EdgeSize = 0;
-    for(std::map<int,std::set<int> >::const_iterator it= EdgeMap.begin();it!= EdgeMap.end();++it)
-        EdgeSize += it->second.size();
+    // sort out double edges, the order is the same as of the former map of sets
+    std::sort(EdgeMap.begin(), EdgeMap.end());
+    EdgeMap.erase(std::unique(EdgeMap.begin(), EdgeMap.end()), EdgeMap.end());
+    int EdgeSize = static_cast<int>(EdgeMap.size());
 
     // set the triangle face indices
     lines->coordIndex.setNum(3*EdgeSize);
     index=0;
     indices = lines->coordIndex.startEditing();
 
-    for(std::map<int,std::set<int> >::const_iterator it= EdgeMap.begin();it!= EdgeMap.end();++it){
-        for(std::set<int>::const_iterator it2=it->second.begin();it2!=it->second.end();++it2){
-            indices[index++] = it->first;
-            indices[index++] = *it2;
-            indices[index++] = -1;
-        }
+    for (std::vector<std::pair<int,int> >::const_iterator it = EdgeMap.begin(); it != EdgeMap.end(); ++it) {
+        indices[index++] = it->first;
+        indices[index++] = it->second;
+        indices[index++] = -1;
     }
 
     lines->coordIndex.finishEditing();
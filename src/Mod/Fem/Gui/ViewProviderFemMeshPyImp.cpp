@@ -106,6 +106,91 @@ PyObject* ViewProviderFemMeshPy::setNodeColorByScalars(PyObject *args)
 }
 
 
+PyObject* ViewProviderFemMeshPy::setNodeColorByResult(PyObject *args)
+{
+    PyObject *result_py;
+    const char *name;
+    double limit = 0.0;
+    if (!PyArg_ParseTuple(args, "O!s|d", &(App::DocumentObjectPy::Type), &result_py, &name, &limit))
+        return 0;
+
+    App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(result_py)->getDocumentObjectPtr();
+    if (!obj || !obj->isDerivedFrom(Fem::FemResultObject::getClassTypeId())) {
+        PyErr_SetString(PyExc_TypeError, "Object is not a FEM result");
+        return 0;
+    }
+
+    Fem::FemResultObject* result = static_cast<Fem::FemResultObject*>(obj);
+    const App::PropertyFloatList* field = result->getScalarField(name);
+    if (!field) {
+        PyErr_Format(PyExc_AttributeError, "Result has no float list %s", name);
+        return 0;
+    }
+
+    const std::vector<long>& ids = result->NodeNumbers.getValues();
+    const std::vector<double>& values = field->getValues();
+    if (ids.empty() || ids.size() != values.size()) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, "Number of values does not match the number of result nodes");
+        return 0;
+    }
+
+    double max = -1e12;
+    double min = +1e12;
+    for (double val : values) {
+        if (limit != 0.0 && val > limit)
+            val = limit;
+        if (val > max)
+            max = val;
+        if (val < min)
+            min = val;
+    }
+
+    std::vector<App::Color> node_colors(values.size());
+    for (std::size_t i = 0; i < values.size(); i++) {
+        double val = values[i];
+        if (limit != 0.0 && val > limit)
+            val = limit;
+        node_colors[i] = calcColor(val, min, max);
+    }
+    this->getViewProviderFemMeshPtr()->setColorByNodeId(ids, node_colors);
+
+    Py_Return;
+}
+
+
+PyObject* ViewProviderFemMeshPy::setNodeDisplacementByResult(PyObject *args)
+{
+    PyObject *result_py;
+    const char *name = "DisplacementVectors";
+    if (!PyArg_ParseTuple(args, "O!|s", &(App::DocumentObjectPy::Type), &result_py, &name))
+        return 0;
+
+    App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(result_py)->getDocumentObjectPtr();
+    if (!obj || !obj->isDerivedFrom(Fem::FemResultObject::getClassTypeId())) {
+        PyErr_SetString(PyExc_TypeError, "Object is not a FEM result");
+        return 0;
+    }
+
+    Fem::FemResultObject* result = static_cast<Fem::FemResultObject*>(obj);
+    const App::PropertyVectorList* field = result->getVectorField(name);
+    if (!field) {
+        PyErr_Format(PyExc_AttributeError, "Result has no vector list %s", name);
+        return 0;
+    }
+
+    const std::vector<long>& ids = result->NodeNumbers.getValues();
+    const std::vector<Base::Vector3d>& vectors = field->getValues();
+    if (ids.empty() || ids.size() != vectors.size()) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, "Number of vectors does not match the number of result nodes");
+        return 0;
+    }
+
+    this->getViewProviderFemMeshPtr()->setDisplacementByNodeId(ids, vectors);
+
+    Py_Return;
+}
+
+
 PyObject* ViewProviderFemMeshPy::resetNodeColor(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
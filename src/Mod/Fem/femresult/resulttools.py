@@ -105,9 +105,8 @@ def show_displacement(resultobj, displacement_factor=0.0):
     if FreeCAD.GuiUp:
         if resultobj.Mesh.ViewObject.Visibility is False:
             resultobj.Mesh.ViewObject.Visibility = True
-        resultobj.Mesh.ViewObject.setNodeDisplacementByVectors(
-            resultobj.NodeNumbers, resultobj.DisplacementVectors
-        )
+        # the vectors are read directly by the view provider, no Python lists are made
+        resultobj.Mesh.ViewObject.setNodeDisplacementByResult(resultobj, "DisplacementVectors")
         resultobj.Mesh.ViewObject.applyDisplacement(displacement_factor)
 
 
@@ -133,10 +132,14 @@ def show_result(resultobj, result_type="Sabs", limit=None):
         reset_mesh_color(resultobj.Mesh)
         return
     if resultobj:
-        if result_type == "Sabs":
-            values = resultobj.vonMises
-        elif result_type == "Uabs":
-            values = resultobj.DisplacementLengths
+        if result_type in ("Sabs", "Uabs"):
+            # the values are read directly by the view provider, no Python lists are made
+            name = "vonMises" if result_type == "Sabs" else "DisplacementLengths"
+            if FreeCAD.GuiUp:
+                if resultobj.Mesh.ViewObject.Visibility is False:
+                    resultobj.Mesh.ViewObject.Visibility = True
+                resultobj.Mesh.ViewObject.setNodeColorByResult(resultobj, name, limit or 0.0)
+            return
         # TODO: the result object does have more result types to show, implement them
         else:
             match = {"U1": 0, "U2": 1, "U3": 2}
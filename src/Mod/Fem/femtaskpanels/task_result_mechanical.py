@@ -528,9 +528,9 @@ class _TaskPanel:
                 self.update_displacement()
         FreeCAD.FEM_dialog["result_obj"] = self.result_obj
         if self.suitable_results:
-            self.mesh_obj.ViewObject.setNodeDisplacementByVectors(
-                self.result_obj.NodeNumbers,
-                self.result_obj.DisplacementVectors
+            self.mesh_obj.ViewObject.setNodeDisplacementByResult(
+                self.result_obj,
+                "DisplacementVectors"
             )
         self.update_displacement()
         QtGui.QApplication.restoreOverrideCursor()
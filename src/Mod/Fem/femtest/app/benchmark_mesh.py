@@ -0,0 +1,139 @@
+# ***************************************************************************
+# *   This file is part of the FreeCAD CAx development system.              *
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+__title__ = "Mesh FEM benchmarks"
+__url__ = "https://www.freecadweb.org"
+
+## \addtogroup FEM
+#  @{
+
+# run it from the FreeCAD Python console or with FreeCADCmd:
+# import femtest.app.benchmark_mesh as bm
+# bm.run_surface_extraction(40)
+# bm.run_read_write(30)
+
+import time
+from os.path import join
+
+import Fem
+from .support_utils import fcc_print
+from .support_utils import get_fem_test_tmp_dir
+
+
+def make_tetra_grid(
+    cells
+):
+    # a cube of cells x cells x cells hexahedra, each split into six tetras
+    mesh = Fem.FemMesh()
+    n = cells + 1
+
+    def node_id(i, j, k):
+        return 1 + i + n * (j + n * k)
+
+    for k in range(n):
+        for j in range(n):
+            for i in range(n):
+                mesh.addNode(float(i), float(j), float(k), node_id(i, j, k))
+
+    # Kuhn subdivision, conforming between neighbouring cells
+    paths = [(0, 1, 2), (0, 2, 1), (1, 0, 2), (1, 2, 0), (2, 0, 1), (2, 1, 0)]
+    for k in range(cells):
+        for j in range(cells):
+            for i in range(cells):
+                for path in paths:
+                    corner = [i, j, k]
+                    ids = [node_id(*corner)]
+                    for axis in path:
+                        corner[axis] += 1
+                        ids.append(node_id(*corner))
+                    mesh.addVolume(ids)
+    return mesh
+
+
+def run_surface_extraction(
+    cells=40,
+    repeat=3
+):
+    mesh = make_tetra_grid(cells)
+    faces = 4 * mesh.VolumeCount
+    best = None
+    for r in range(repeat):
+        start = time.time()
+        boundary = mesh.getVolumeBoundaryFaces()
+        elapsed = time.time() - start
+        best = elapsed if best is None else min(best, elapsed)
+
+    fcc_print(
+        "surface extraction: {} volumes, {} faces, {} boundary faces, "
+        "best of {}: {:.3f} s ({:.0f} faces/s)".format(
+            mesh.VolumeCount,
+            faces,
+            len(boundary),
+            repeat,
+            best,
+            faces / best if best > 0 else 0.0
+        )
+    )
+    return best
+
+
+def run_read_write(
+    cells=30,
+    repeat=3
+):
+    # the elements/s of the Abaqus writer and of the Abaqus and Z88 readers
+    mesh = make_tetra_grid(cells)
+    elements = mesh.VolumeCount
+    tmp_dir = get_fem_test_tmp_dir("benchmark_mesh")
+    results = {}
+
+    def best_of(func):
+        best = None
+        for r in range(repeat):
+            start = time.time()
+            func()
+            elapsed = time.time() - start
+            best = elapsed if best is None else min(best, elapsed)
+        return best
+
+    inp_file = join(tmp_dir, "benchmark_mesh.inp")
+    z88_file = join(tmp_dir, "benchmark_mesh.z88")
+    results["write inp"] = best_of(lambda: mesh.writeABAQUS(inp_file, 1, False))
+    mesh.write(z88_file)
+    for name, file_name in (("read inp", inp_file), ("read z88", z88_file)):
+        read_mesh = Fem.FemMesh()
+        results[name] = best_of(lambda: read_mesh.read(file_name))
+        if read_mesh.VolumeCount != elements:
+            fcc_print("{}: {} of {} volumes read".format(name, read_mesh.VolumeCount, elements))
+
+    for name, best in results.items():
+        fcc_print(
+            "{}: {} volumes, best of {}: {:.3f} s ({:.0f} elements/s)".format(
+                name,
+                elements,
+                repeat,
+                best,
+                elements / best if best > 0 else 0.0
+            )
+        )
+    return results
+
+##  @}
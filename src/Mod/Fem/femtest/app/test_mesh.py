@@ -179,6 +179,49 @@ class TestMeshCommon(unittest.TestCase):
             "Nodes order of quadratic volume element is unexpected"
         )
 
+    # ********************************************************************************************
+    def test_volume_boundary_faces(
+        self
+    ):
+        # two tetras sharing the face 1, 2, 3, the shared face is not on the boundary
+        tetras = Fem.FemMesh()
+        tetras.addNode(0, 0, 0, 1)
+        tetras.addNode(1, 0, 0, 2)
+        tetras.addNode(0, 1, 0, 3)
+        tetras.addNode(0, 0, 1, 4)
+        tetras.addNode(0, 0, -1, 5)
+        tetras.addVolume([1, 2, 3, 4], 11)
+        tetras.addVolume([1, 3, 2, 5], 12)
+
+        boundary = tetras.getVolumeBoundaryFaces()
+        self.assertEqual(
+            len(boundary),
+            6,
+            "Number of boundary faces of two tetras is unexpected"
+        )
+        self.assertEqual(
+            sorted(boundary),
+            [(11, 2), (11, 3), (11, 4), (12, 2), (12, 3), (12, 4)],
+            "Boundary faces of two tetras are unexpected"
+        )
+
+        # a single hexa has all its faces on the boundary
+        hexa = Fem.FemMesh()
+        hexa.addNode(0, 0, 0, 1)
+        hexa.addNode(1, 0, 0, 2)
+        hexa.addNode(1, 1, 0, 3)
+        hexa.addNode(0, 1, 0, 4)
+        hexa.addNode(0, 0, 1, 5)
+        hexa.addNode(1, 0, 1, 6)
+        hexa.addNode(1, 1, 1, 7)
+        hexa.addNode(0, 1, 1, 8)
+        hexa.addVolume([1, 2, 3, 4, 5, 6, 7, 8], 1)
+        self.assertEqual(
+            sorted(hexa.getVolumeBoundaryFaces()),
+            [(1, 1), (1, 2), (1, 3), (1, 4), (1, 5), (1, 6)],
+            "Boundary faces of a hexa are unexpected"
+        )
+
     # ********************************************************************************************
     def test_writeAbaqus_precision(
         self
@@ -460,3 +460,60 @@ class TestResult(unittest.TestCase):
             expected_dispabs,
             "Calculated displacement abs are not the expected values."
         )
+
+    # ********************************************************************************************
+    def test_result_arrays(
+        self
+    ):
+        import array
+        import Fem
+        import ObjectsFem
+        res = ObjectsFem.makeResultMechanical(self.document)
+        res.NodeNumbers = [1, 2, 3]
+        res.vonMises = [1.5, 2.5, 3.5]
+        res.DisplacementVectors = [
+            FreeCAD.Vector(1, 2, 3),
+            FreeCAD.Vector(4, 5, 6),
+            FreeCAD.Vector(7, 8, 9)
+        ]
+
+        # get the lists as raw bytes
+        self.assertEqual(
+            array.array("q", Fem.getResultArray(res, "NodeNumbers")).tolist(),
+            [1, 2, 3],
+            "NodeNumbers bytes are unexpected"
+        )
+        self.assertEqual(
+            array.array("d", Fem.getResultArray(res, "vonMises")).tolist(),
+            [1.5, 2.5, 3.5],
+            "vonMises bytes are unexpected"
+        )
+        self.assertEqual(
+            array.array("d", Fem.getResultArray(res, "DisplacementVectors")).tolist(),
+            [1, 2, 3, 4, 5, 6, 7, 8, 9],
+            "DisplacementVectors bytes are unexpected"
+        )
+
+        # set the lists from buffers
+        Fem.setResultArray(res, "NodeNumbers", array.array("i", [4, 5]))
+        Fem.setResultArray(res, "vonMises", array.array("d", [0.5, 0.25]))
+        Fem.setResultArray(res, "DisplacementVectors", array.array("d", [1, 0, 0, 0, 1, 0]))
+        self.assertEqual(res.NodeNumbers, [4, 5], "NodeNumbers set from buffer are unexpected")
+        self.assertEqual(res.vonMises, [0.5, 0.25], "vonMises set from buffer are unexpected")
+        self.assertEqual(
+            res.DisplacementVectors,
+            [FreeCAD.Vector(1, 0, 0), FreeCAD.Vector(0, 1, 0)],
+            "DisplacementVectors set from buffer are unexpected"
+        )
+
+        # node numbers are saved in binary form and restored
+        save_fc_file = join(testtools.get_fem_test_tmp_dir("result_arrays"), "result_arrays.FCStd")
+        res_name = res.Name
+        self.document.saveAs(save_fc_file)
+        FreeCAD.closeDocument(self.document.Name)
+        self.document = FreeCAD.open(save_fc_file)
+        self.assertEqual(
+            self.document.getObject(res_name).NodeNumbers,
+            [4, 5],
+            "Restored NodeNumbers are unexpected"
+        )
@@ -24,10 +24,13 @@
 #include "PreCompiled.h"
 #include <numeric>
 #include <gp_Pnt.hxx>
+#include <Bnd_Box.hxx>
+#include <BRepBndLib.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepGProp_Face.hxx>
+#include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Vertex.hxx>
 
@@ -52,7 +55,7 @@
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Points/App/PointsFeature.h>
-#include <Mod/Points/App/PointsGrid.h>
+#include <Mod/Points/App/PointsKDTree.h>
 #include <Mod/Part/App/PartFeature.h>
 
 #include "InspectionFeature.h"
@@ -403,71 +406,158 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
-InspectNominalPoints::InspectNominalPoints(const Points::PointKernel& Kernel, float /*offset*/)
-  : _rKernel(Kernel)
+InspectNominalPoints::InspectNominalPoints(const Points::PointKernel& Kernel, float offset)
+  : _fOffset(offset)
 {
-    int uGridPerAxis = 50; // totally 125.000 grid elements 
-    this->_pGrid = new Points::PointsGrid (Kernel, uGridPerAxis);
+    this->_pTree = new Points::PointsKDTree(Kernel);
 }
 
 InspectNominalPoints::~InspectNominalPoints()
 {
-    delete this->_pGrid;
+    delete this->_pTree;
 }
 
 float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 {
-    //TODO: Make faster
-    std::set<unsigned long> indices;
-    unsigned long x,y,z;
+    unsigned long index;
+    double fMinDist;
     Base::Vector3d pointd(point.x,point.y,point.z);
-    _pGrid->Position(pointd, x, y, z);
-    _pGrid->GetElements(x,y,z,indices);
-
-    double fMinDist=DBL_MAX;
-    for (std::set<unsigned long>::iterator it = indices.begin(); it != indices.end(); ++it) {
-        Base::Vector3d pt = _rKernel.getPoint(*it);
-        double fDist = Base::Distance(pointd, pt);
-        if (fDist < fMinDist) {
-            fMinDist = fDist;
-        }
-    }
+    if (!_pTree->FindNearest(pointd, _fOffset, index, fMinDist))
+        return FLT_MAX;
 
     return (float)fMinDist;
 }
 
 // ----------------------------------------------------------------
 
-InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
+/**
+ * A distance solver for the surface of the shape that is used by one thread at a
+ * time, the classifier checks if a point is inside a solid.
+ */
+class InspectNominalShape::Solver
+{
+public:
+    Solver(const TopoDS_Shape& shape, const TopoDS_Shape& surface, bool isSolid)
+    {
+        distss.LoadS1(surface);
+        if (isSolid)
+            classifier.reset(new BRepClass3d_SolidClassifier(shape));
+    }
+
+    BRepExtrema_DistShapeShape distss;
+    std::unique_ptr<BRepClass3d_SolidClassifier> classifier;
+};
+
+InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float radius)
     : _rShape(shape)
+    , _surface(new TopoDS_Shape(shape))
     , isSolid(false)
+    , radius(radius)
 {
-    distss = new BRepExtrema_DistShapeShape();
-    distss->LoadS1(_rShape);
-
     // When having a solid then use its shell because otherwise the distance
     // for inner points will always be zero
     if (!_rShape.IsNull() && _rShape.ShapeType() == TopAbs_SOLID) {
         TopExp_Explorer xp;
         xp.Init(_rShape, TopAbs_SHELL);
         if (xp.More()) {
-           distss->LoadS1(xp.Current());
+           *_surface = xp.Current();
            isSolid = true;
         }
 
     }
-    //distss->SetDeflection(radius);
+
+    // the bounding boxes to cull points that are out of the search radius
+    if (!_surface->IsNull()) {
+        auto addBox = [this](const TopoDS_Shape& sub) {
+            Bnd_Box bnd;
+            BRepBndLib::Add(sub, bnd);
+            if (bnd.IsVoid())
+                return;
+            Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+            bnd.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+            boxes.emplace_back(xMin, yMin, zMin, xMax, yMax, zMax);
+        };
+        addBox(*_surface);
+        if (!boxes.empty()) {
+            TopExp_Explorer xp;
+            for (xp.Init(*_surface, TopAbs_FACE); xp.More(); xp.Next())
+                addBox(xp.Current());
+            for (xp.Init(*_surface, TopAbs_EDGE, TopAbs_FACE); xp.More(); xp.Next())
+                addBox(xp.Current());
+            for (xp.Init(*_surface, TopAbs_VERTEX, TopAbs_EDGE); xp.More(); xp.Next())
+                addBox(xp.Current());
+        }
+    }
 }
 
 InspectNominalShape::~InspectNominalShape()
 {
-    delete distss;
+}
+
+InspectNominalShape::Solver* InspectNominalShape::acquireSolver() const
+{
+    std::lock_guard<std::mutex> lock(solverMutex);
+    if (idleSolvers.empty()) {
+        solvers.emplace_back(new Solver(_rShape, *_surface, isSolid));
+        return solvers.back().get();
+    }
+
+    Solver* solver = idleSolvers.back();
+    idleSolvers.pop_back();
+    return solver;
+}
+
+void InspectNominalShape::releaseSolver(Solver* solver) const
+{
+    std::lock_guard<std::mutex> lock(solverMutex);
+    idleSolvers.push_back(solver);
+}
+
+float InspectNominalShape::getLowerBound(const Base::Vector3f& point) const
+{
+    // the distance to the nearest box, or zero if the overall box isn't farther
+    // away than the search radius
+    auto distance = [&point](const Base::BoundBox3d& box) {
+        double dx = std::max(std::max(box.MinX - point.x, point.x - box.MaxX), 0.0);
+        double dy = std::max(std::max(box.MinY - point.y, point.y - box.MaxY), 0.0);
+        double dz = std::max(std::max(box.MinZ - point.z, point.z - box.MaxZ), 0.0);
+        return sqrt(dx * dx + dy * dy + dz * dz);
+    };
+
+    if (boxes.size() < 2)
+        return 0.0f;
+    double minDist = distance(boxes.front());
+    if (minDist <= radius) {
+        minDist = DBL_MAX;
+        for (std::size_t i = 1; i < boxes.size(); i++) {
+            minDist = std::min(minDist, distance(boxes[i]));
+            if (minDist <= radius)
+                return 0.0f;
+        }
+    }
+    return static_cast<float>(minDist);
 }
 
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
 {
     gp_Pnt pnt3d(point.x,point.y,point.z);
+
+    // The lower bound only rejects points of a solid that are out of the search
+    // radius, they only need the side. All other points get the exact distance.
+    // The sign of other shapes depends on the normal of the nearest face, so
+    // they are never rejected.
+    if (isSolid && getLowerBound(point) > radius) {
+        Solver* solver = acquireSolver();
+        const Standard_Real tol = 0.001;
+        solver->classifier->Perform(pnt3d, tol);
+        bool inside = solver->classifier->State() == TopAbs_IN;
+        releaseSolver(solver);
+        return inside ? -FLT_MAX : FLT_MAX;
+    }
+
     BRepBuilderAPI_MakeVertex mkVert(pnt3d);
+    Solver* solver = acquireSolver();
+    BRepExtrema_DistShapeShape* distss = &solver->distss;
     distss->LoadS2(mkVert.Vertex());
 
     float fMinDist=FLT_MAX;
@@ -476,9 +566,8 @@ float InspectNominalShape::getDistance(const Base::Vector3f& point) const
         // the shape is a solid, check if the vertex is inside
         if (isSolid) {
             const Standard_Real tol = 0.001;
-            BRepClass3d_SolidClassifier classifier(_rShape);
-            classifier.Perform(pnt3d, tol);
-            if (classifier.State() == TopAbs_IN) {
+            solver->classifier->Perform(pnt3d, tol);
+            if (solver->classifier->State() == TopAbs_IN) {
                 fMinDist = -fMinDist;
             }
 
@@ -505,6 +594,7 @@ float InspectNominalShape::getDistance(const Base::Vector3f& point) const
             }
         }
     }
+    releaseSolver(solver);
     return fMinDist;
 }
 
@@ -754,7 +844,6 @@ App::DocumentObjectExecReturn* Feature::execute(void)
         actual = new InspectActualPoints(pts->Points.getValue());
     }
     else if (pcActual->getTypeId().isDerivedFrom(Part::Feature::getClassTypeId())) {
-        useMultithreading = false;
         Part::Feature* part = static_cast<Part::Feature*>(pcActual);
         actual = new InspectActualShape(part->Shape.getShape());
     }
@@ -776,7 +865,6 @@ App::DocumentObjectExecReturn* Feature::execute(void)
             nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
         }
         else if ((*it)->getTypeId().isDerivedFrom(Part::Feature::getClassTypeId())) {
-            useMultithreading = false;
             Part::Feature* part = static_cast<Part::Feature*>(*it);
             nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
         }
@@ -24,15 +24,19 @@
 #ifndef INSPECTION_FEATURE_H
 #define INSPECTION_FEATURE_H
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <App/DocumentObject.h>
 #include <App/PropertyLinks.h>
 #include <App/DocumentObjectGroup.h>
+#include <Base/BoundBox.h>
 
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Points/App/Points.h>
 
 class TopoDS_Shape;
-class BRepExtrema_DistShapeShape;
 
 namespace MeshCore {
 class MeshKernel;
@@ -40,7 +44,7 @@ class MeshGrid;
 }
 
 namespace Mesh   { class MeshObject; }
-namespace Points { class PointsGrid; }
+namespace Points { class PointsKDTree; }
 namespace Part   { class TopoShape;  }
 
 namespace Inspection
@@ -134,6 +138,9 @@ protected:
     Base::Matrix4D _clTrf;
 };
 
+/** Calculates the distance to the nearest point of a point cloud inside the
+ * search radius. getDistance() may be called from several threads.
+ */
 class InspectionExport InspectNominalPoints : public InspectNominalGeometry
 {
 public:
@@ -142,10 +149,16 @@ public:
     virtual float getDistance(const Base::Vector3f&) const;
 
 private:
-    const Points::PointKernel& _rKernel;
-    Points::PointsGrid* _pGrid;
+    Points::PointsKDTree* _pTree;
+    float _fOffset;
 };
 
+/** Calculates the distance to a shape. getDistance() may be called from several
+ * threads, each call uses its own distance solver of a pool. Points that are
+ * farther away from the bounding boxes of all sub-shapes than the search radius
+ * are culled without computing their exact distance, for them +/-FLT_MAX is
+ * returned.
+ */
 class InspectionExport InspectNominalShape : public InspectNominalGeometry
 {
 public:
@@ -154,9 +167,22 @@ public:
     virtual float getDistance(const Base::Vector3f&) const;
 
 private:
-    BRepExtrema_DistShapeShape* distss;
+    class Solver;
+    Solver* acquireSolver() const;
+    void releaseSolver(Solver*) const;
+    float getLowerBound(const Base::Vector3f&) const;
+
+private:
     const TopoDS_Shape& _rShape;
+    std::unique_ptr<TopoDS_Shape> _surface;
     bool isSolid;
+    float radius;
+    // the overall box followed by the boxes of the faces and of the free edges and vertices
+    std::vector<Base::BoundBox3d> boxes;
+
+    mutable std::mutex solverMutex;
+    mutable std::vector<std::unique_ptr<Solver> > solvers;
+    mutable std::vector<Solver*> idleSolvers;
 };
 
 class InspectionExport PropertyDistanceList: public App::PropertyLists
@@ -27,6 +27,8 @@
 # include <map>
 #endif
 
+#include <QThreadPool>
+
 #include <CXX/Extensions.hxx>
 #include <CXX/Objects.hxx>
 
@@ -126,6 +128,16 @@ public:
             "tuple of seven items:\n"
             "    center, u, v, w directions and the lengths of the three vectors.\n"
         );
+        add_varargs_method("setMaxThreadCount",&Module::setMaxThreadCount,
+            "setMaxThreadCount(int) -- Sets the maximum number of threads used by\n"
+            "the parallel mesh algorithms. The results don't depend on it.\n"
+            "The mesh algorithms run in Qt's global thread pool, so this limits\n"
+            "all other users of that pool in the process, too."
+        );
+        add_varargs_method("getMaxThreadCount",&Module::getMaxThreadCount,
+            "getMaxThreadCount() -- Returns the maximum number of threads of Qt's\n"
+            "global thread pool, which the parallel mesh algorithms use."
+        );
         initialize("The functions in this module allow working with mesh objects.\n"
                    "A set of functions are provided for reading in registered mesh\n"
                    "file formats to either a new or existing document.\n"
@@ -588,6 +600,24 @@ private:
 
         return result;
     }
+    Py::Object setMaxThreadCount(const Py::Tuple& args)
+    {
+        int count;
+        if (!PyArg_ParseTuple(args.ptr(), "i",&count))
+            throw Py::Exception();
+        if (count < 1)
+            throw Py::ValueError("Number of threads must be positive");
+
+        QThreadPool::globalInstance()->setMaxThreadCount(count);
+        return Py::None();
+    }
+    Py::Object getMaxThreadCount(const Py::Tuple& args)
+    {
+        if (!PyArg_ParseTuple(args.ptr(), ""))
+            throw Py::Exception();
+
+        return Py::Long(QThreadPool::globalInstance()->maxThreadCount());
+    }
 };
 
 PyObject* initModule()
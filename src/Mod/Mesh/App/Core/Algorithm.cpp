@@ -27,6 +27,9 @@
 # include <algorithm>
 #endif
 
+#include <QThreadPool>
+#include <QtConcurrentMap>
+
 #include "Algorithm.h"
 #include "Approximation.h"
 #include "Elements.h"
@@ -1947,6 +1950,94 @@ void MeshRefPointToPoints::RemoveNeighbour(PointIndex pos, PointIndex facet)
 
 //----------------------------------------------------------------------------
 
+void MeshPointAdjacency::ForEachRange(std::size_t count, const std::function<void (std::size_t, std::size_t)>& func)
+{
+    // a few parts per thread of the pool to balance the load, the pool may
+    // be limited to a single thread
+    int numThreads = std::max(QThreadPool::globalInstance()->maxThreadCount(), 1);
+    std::size_t numParts = numThreads > 1 ? 4 * static_cast<std::size_t>(numThreads) : 1;
+    numParts = std::max<std::size_t>(1, std::min(numParts, count / 1024));
+    std::vector<std::pair<std::size_t, std::size_t> > parts;
+    for (std::size_t i = 0; i < numParts; i++)
+        parts.emplace_back(i * count / numParts, (i + 1) * count / numParts);
+
+    if (parts.size() == 1) {
+        func(parts[0].first, parts[0].second);
+        return;
+    }
+
+    QtConcurrent::blockingMap(parts, [&func](const std::pair<std::size_t, std::size_t>& part) {
+        func(part.first, part.second);
+    });
+}
+
+void MeshPointAdjacency::Rebuild ()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::size_t numPoints = _rclMesh.CountPoints();
+
+    // the facets of each point in the order of the facets, a degenerated
+    // facet is added only once
+    _facetStart.assign(numPoints + 1, 0);
+    for (const MeshFacet& f : rFacets) {
+        for (int i=0; i<3; i++) {
+            if ((i > 0 && f._aulPoints[i] == f._aulPoints[0]) ||
+                (i > 1 && f._aulPoints[i] == f._aulPoints[1]))
+                continue;
+            _facetStart[f._aulPoints[i] + 1]++;
+        }
+    }
+    for (std::size_t i = 0; i < numPoints; i++)
+        _facetStart[i + 1] += _facetStart[i];
+
+    _facets.resize(_facetStart[numPoints]);
+    std::vector<std::size_t> pos(_facetStart.begin(), _facetStart.end() - 1);
+    FacetIndex index = 0;
+    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it, ++index) {
+        for (int i=0; i<3; i++) {
+            if ((i > 0 && it->_aulPoints[i] == it->_aulPoints[0]) ||
+                (i > 1 && it->_aulPoints[i] == it->_aulPoints[1]))
+                continue;
+            _facets[pos[it->_aulPoints[i]]++] = index;
+        }
+    }
+
+    // the neighbours of a point are the other corners of its facets
+    std::vector<PointIndex> candidates(2 * _facets.size());
+    std::vector<std::size_t> counts(numPoints, 0);
+    ForEachRange(numPoints, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t p = begin; p < end; p++) {
+            PointIndex* first = candidates.data() + 2 * _facetStart[p];
+            PointIndex* last = first;
+            for (std::size_t j = _facetStart[p]; j < _facetStart[p + 1]; j++) {
+                const MeshFacet& f = rFacets[_facets[j]];
+                for (int i=0; i<3; i++) {
+                    if (f._aulPoints[i] == p) {
+                        *last++ = f._aulPoints[(i+1)%3];
+                        *last++ = f._aulPoints[(i+2)%3];
+                        break;
+                    }
+                }
+            }
+            std::sort(first, last);
+            counts[p] = std::unique(first, last) - first;
+        }
+    });
+
+    _pointStart.assign(numPoints + 1, 0);
+    for (std::size_t i = 0; i < numPoints; i++)
+        _pointStart[i + 1] = _pointStart[i] + counts[i];
+    _points.resize(_pointStart[numPoints]);
+    ForEachRange(numPoints, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t p = begin; p < end; p++) {
+            std::copy_n(candidates.begin() + 2 * _facetStart[p], counts[p],
+                        _points.begin() + _pointStart[p]);
+        }
+    });
+}
+
+//----------------------------------------------------------------------------
+
 void MeshRefEdgeToFacets::Rebuild ()
 {
     _map.clear();
@@ -24,6 +24,7 @@
 #ifndef MESHALGORITHM_H
 #define MESHALGORITHM_H
 
+#include <functional>
 #include <set>
 #include <vector>
 #include <map>
@@ -468,6 +469,70 @@ protected:
     std::vector<std::set<PointIndex> > _map;
 };
 
+/**
+ * The MeshPointAdjacency class stores the neighbour points and the facets of
+ * all points in two compressed arrays (CSR format), so it needs much less
+ * memory than MeshRefPointToPoints and MeshRefPointToFacets and the neighbours
+ * of a point lie next to each other in memory.
+ * The neighbour points and the facets of a point are sorted by their index.
+ * So algorithms that compute a value for each point from the values of its
+ * neighbours (Jacobi style) give the same result however they are split
+ * into parallel tasks.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshPointAdjacency
+{
+public:
+    /// A range of indices in the arrays
+    template <typename T>
+    class Range
+    {
+    public:
+        Range(const T* b, const T* e) : _begin(b), _end(e) {}
+        const T* begin() const { return _begin; }
+        const T* end() const { return _end; }
+        std::size_t size() const { return _end - _begin; }
+
+    private:
+        const T* _begin;
+        const T* _end;
+    };
+
+    /// Construction
+    MeshPointAdjacency (const MeshKernel &rclM) : _rclMesh(rclM)
+    { Rebuild(); }
+    /// Destruction
+    ~MeshPointAdjacency ()
+    { }
+
+    /// Rebuilds up data structure
+    void Rebuild ();
+    PointIndex CountPoints() const
+    { return _pointStart.empty() ? 0 : static_cast<PointIndex>(_pointStart.size() - 1); }
+    /// The neighbour points of a point
+    Range<PointIndex> GetPoints(PointIndex pos) const
+    { return Range<PointIndex>(_points.data() + _pointStart[pos], _points.data() + _pointStart[pos + 1]); }
+    /// The facets of a point
+    Range<FacetIndex> GetFacets(PointIndex pos) const
+    { return Range<FacetIndex>(_facets.data() + _facetStart[pos], _facets.data() + _facetStart[pos + 1]); }
+    /// A point is at the border if the number of its neighbours and facets differ
+    bool IsBorder(PointIndex pos) const
+    { return GetPoints(pos).size() != GetFacets(pos).size(); }
+
+    /** Splits the range [0, count) into parts of similar size and calls
+     * \a func(begin, end) for each part in parallel.
+     */
+    static void ForEachRange(std::size_t count, const std::function<void (std::size_t, std::size_t)>& func);
+
+protected:
+    const MeshKernel  &_rclMesh; /**< The mesh kernel. */
+    std::vector<std::size_t> _pointStart;
+    std::vector<PointIndex> _points;
+    std::vector<std::size_t> _facetStart;
+    std::vector<FacetIndex> _facets;
+};
+
 /**
  * The MeshRefEdgeToFacets builds up a structure to have access to all facets 
  * of an edge. On a manifold mesh an edge has one or two facets associated.
@@ -0,0 +1,321 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
+#endif
+
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include "BVH.h"
+#include "MeshKernel.h"
+
+using namespace MeshCore;
+
+namespace {
+// the maximum number of facets in a leaf
+const std::size_t MaxLeafSize = 4;
+}
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& kernel)
+{
+    Build(kernel);
+}
+
+MeshFacetBVH::~MeshFacetBVH()
+{
+}
+
+void MeshFacetBVH::Build(const MeshKernel& kernel)
+{
+    const MeshFacetArray& rFacets = kernel.GetFacets();
+    const MeshPointArray& rPoints = kernel.GetPoints();
+    std::size_t numFacets = rFacets.size();
+
+    std::vector<Base::Vector3f> centers(numFacets);
+    _boxes.resize(numFacets);
+    _facets.resize(numFacets);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        const MeshFacet& rFacet = rFacets[i];
+        Base::BoundBox3f& box = _boxes[i];
+        for (int j = 0; j < 3; j++)
+            box.Add(rPoints[rFacet._aulPoints[j]]);
+        centers[i] = box.GetCenter();
+        _facets[i] = i;
+    }
+
+    if (numFacets == 0)
+        return;
+
+    // Split the facets at the median of their centers along the longest axis
+    // until a node holds only a few facets. The nodes are stored depth first,
+    // the two children of a node are stored one after another.
+    _nodes.reserve(2 * numFacets / MaxLeafSize + 1);
+    _nodes.push_back(Node());
+    _nodes.back().first = 0;
+    _nodes.back().count = numFacets;
+
+    std::vector<std::size_t> todo;
+    todo.push_back(0);
+    while (!todo.empty()) {
+        std::size_t index = todo.back();
+        todo.pop_back();
+        std::size_t first = _nodes[index].first;
+        std::size_t count = _nodes[index].count;
+
+        Base::BoundBox3f box, centerBox;
+        for (std::size_t i = first; i < first + count; i++) {
+            box.Add(_boxes[_facets[i]]);
+            centerBox.Add(centers[_facets[i]]);
+        }
+        _nodes[index].box = box;
+        if (count <= MaxLeafSize)
+            continue;
+
+        int axis = 0;
+        float length = centerBox.LengthX();
+        if (centerBox.LengthY() > length) {
+            axis = 1;
+            length = centerBox.LengthY();
+        }
+        if (centerBox.LengthZ() > length) {
+            axis = 2;
+            length = centerBox.LengthZ();
+        }
+        if (length <= 0.0f)
+            continue; // all centers are equal, keep a larger leaf
+
+        std::size_t mid = first + count / 2;
+        std::nth_element(_facets.begin() + first, _facets.begin() + mid, _facets.begin() + first + count,
+                         [&centers, axis](FacetIndex a, FacetIndex b) {
+            return centers[a][axis] < centers[b][axis];
+        });
+
+        std::size_t left = _nodes.size();
+        _nodes.push_back(Node());
+        _nodes.back().first = first;
+        _nodes.back().count = mid - first;
+        _nodes.push_back(Node());
+        _nodes.back().first = mid;
+        _nodes.back().count = first + count - mid;
+        _nodes[index].first = left;
+        _nodes[index].count = 0;
+        todo.push_back(left);
+        todo.push_back(left + 1);
+    }
+}
+
+const Base::BoundBox3f& MeshFacetBVH::GetBoundBox() const
+{
+    static Base::BoundBox3f empty;
+    return _nodes.empty() ? empty : _nodes.front().box;
+}
+
+std::size_t MeshFacetBVH::CountNodes() const
+{
+    return _nodes.size();
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * Dual tree traversal of two trees, or of a tree with itself. The node pairs
+ * near the root are split into tasks that are traversed in parallel.
+ */
+class MeshFacetBVH::Traversal
+{
+public:
+    Traversal(const MeshFacetBVH& bvh1, const MeshFacetBVH& bvh2, bool self,
+              const PairPredicate& pred, bool firstOnly)
+      : bvh1(bvh1), bvh2(bvh2), self(self), pred(pred), firstOnly(firstOnly), stop(false)
+    {
+    }
+
+    // adds the child tasks of a task, returns false if the task can't be split
+    bool Split(const Task& task, std::vector<Task>& tasks) const
+    {
+        const Node& node1 = bvh1._nodes[task.node1];
+        const Node& node2 = bvh2._nodes[task.node2];
+        if (self && task.node1 == task.node2) {
+            if (node1.isLeaf())
+                return false;
+            tasks.push_back({node1.first, node1.first});
+            tasks.push_back({node1.first + 1, node1.first + 1});
+            tasks.push_back({node1.first, node1.first + 1});
+            return true;
+        }
+        if (!(node1.box && node2.box))
+            return true; // nothing to do
+        if (node1.isLeaf() && node2.isLeaf())
+            return false;
+        if (SplitFirst(node1, node2)) {
+            tasks.push_back({node1.first, task.node2});
+            tasks.push_back({node1.first + 1, task.node2});
+        }
+        else {
+            tasks.push_back({task.node1, node2.first});
+            tasks.push_back({task.node1, node2.first + 1});
+        }
+        return true;
+    }
+
+    void Run(const Task& task, PairList& pairs)
+    {
+        Visit(task.node1, task.node2, pairs);
+    }
+
+private:
+    // splits the larger one of two inner nodes
+    static bool SplitFirst(const Node& node1, const Node& node2)
+    {
+        if (node2.isLeaf())
+            return true;
+        if (node1.isLeaf())
+            return false;
+        return node1.box.CalcDiagonalLength() >= node2.box.CalcDiagonalLength();
+    }
+
+    void Visit(std::size_t index1, std::size_t index2, PairList& pairs)
+    {
+        if (stop)
+            return;
+
+        const Node& node1 = bvh1._nodes[index1];
+        const Node& node2 = bvh2._nodes[index2];
+        if (self && index1 == index2) {
+            if (node1.isLeaf()) {
+                TestLeaves(node1, node2, true, pairs);
+            }
+            else {
+                Visit(node1.first, node1.first, pairs);
+                Visit(node1.first + 1, node1.first + 1, pairs);
+                Visit(node1.first, node1.first + 1, pairs);
+            }
+            return;
+        }
+
+        if (!(node1.box && node2.box))
+            return;
+        if (node1.isLeaf() && node2.isLeaf()) {
+            TestLeaves(node1, node2, false, pairs);
+        }
+        else if (SplitFirst(node1, node2)) {
+            Visit(node1.first, index2, pairs);
+            Visit(node1.first + 1, index2, pairs);
+        }
+        else {
+            Visit(index1, node2.first, pairs);
+            Visit(index1, node2.first + 1, pairs);
+        }
+    }
+
+    void TestLeaves(const Node& node1, const Node& node2, bool sameLeaf, PairList& pairs)
+    {
+        for (std::size_t i = node1.first; i < node1.first + node1.count; i++) {
+            FacetIndex facet1 = bvh1._facets[i];
+            const Base::BoundBox3f& box1 = bvh1._boxes[facet1];
+            std::size_t j = sameLeaf ? i + 1 : node2.first;
+            for (; j < node2.first + node2.count; j++) {
+                FacetIndex facet2 = bvh2._facets[j];
+                if (!(box1 && bvh2._boxes[facet2]))
+                    continue;
+                std::pair<FacetIndex, FacetIndex> pair(facet1, facet2);
+                if (self && facet2 < facet1)
+                    std::swap(pair.first, pair.second);
+                if (pred(pair.first, pair.second)) {
+                    pairs.push_back(pair);
+                    if (firstOnly) {
+                        stop = true;
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    const MeshFacetBVH& bvh1;
+    const MeshFacetBVH& bvh2;
+    bool self;
+    const PairPredicate& pred;
+    bool firstOnly;
+    std::atomic<bool> stop;
+};
+
+MeshFacetBVH::PairList MeshFacetBVH::Traverse(const MeshFacetBVH& other, bool self,
+                                              const PairPredicate& pred, bool firstOnly) const
+{
+    PairList pairs;
+    if (_nodes.empty() || other._nodes.empty())
+        return pairs;
+
+    Traversal traversal(*this, other, self, pred, firstOnly);
+
+    // a few tasks per thread to balance the load
+    std::vector<Task> tasks;
+    tasks.push_back({0, 0});
+    std::size_t numTasks = 16 * static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1));
+    bool split = true;
+    while (split && tasks.size() < numTasks) {
+        split = false;
+        std::vector<Task> next;
+        for (const Task& task : tasks) {
+            if (traversal.Split(task, next))
+                split = true;
+            else
+                next.push_back(task);
+        }
+        tasks.swap(next);
+    }
+
+    std::vector<PairList> results(tasks.size());
+    QtConcurrent::blockingMap(tasks, [&](const Task& task) {
+        traversal.Run(task, results[&task - tasks.data()]);
+    });
+
+    std::size_t numPairs = 0;
+    for (const PairList& it : results)
+        numPairs += it.size();
+    pairs.reserve(numPairs);
+    for (const PairList& it : results)
+        pairs.insert(pairs.end(), it.begin(), it.end());
+    std::sort(pairs.begin(), pairs.end());
+    if (firstOnly && pairs.size() > 1)
+        pairs.resize(1);
+    return pairs;
+}
+
+MeshFacetBVH::PairList MeshFacetBVH::FindSelfPairs(const PairPredicate& pred, bool firstOnly) const
+{
+    return Traverse(*this, true, pred, firstOnly);
+}
+
+MeshFacetBVH::PairList MeshFacetBVH::FindPairs(const MeshFacetBVH& other, const PairPredicate& pred,
+                                               bool firstOnly) const
+{
+    return Traverse(other, false, pred, firstOnly);
+}
@@ -0,0 +1,102 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <functional>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include "Definitions.h"
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy of the facets of a mesh.
+ * It is used to find the pairs of facets with overlapping bounding boxes by a
+ * dual tree traversal that runs in several threads.
+ * The tree must be rebuilt if the mesh is modified.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /// Tests a candidate pair of facets, it is called from several threads at once
+    typedef std::function<bool (FacetIndex, FacetIndex)> PairPredicate;
+    typedef std::vector<std::pair<FacetIndex, FacetIndex> > PairList;
+
+    MeshFacetBVH(const MeshKernel&);
+    ~MeshFacetBVH();
+
+    /** Returns all pairs of different facets whose bounding boxes overlap and
+     * that fulfil the predicate. The pairs are sorted and the first index of
+     * a pair is always lower than the second.
+     * If \a firstOnly is true the search stops after the first pair is found.
+     */
+    PairList FindSelfPairs(const PairPredicate&, bool firstOnly = false) const;
+    /** Returns all pairs of a facet of this mesh and a facet of the mesh of
+     * \a other whose bounding boxes overlap and that fulfil the predicate. The
+     * first index of a pair refers to this mesh, the pairs are sorted.
+     */
+    PairList FindPairs(const MeshFacetBVH& other, const PairPredicate&, bool firstOnly = false) const;
+
+    const Base::BoundBox3f& GetBoundBox() const;
+    std::size_t CountNodes() const;
+
+private:
+    struct Node
+    {
+        Base::BoundBox3f box;
+        // a leaf refers to the facets [first, first + count) of the sorted
+        // facet list, the children of an inner node are first and first + 1
+        std::size_t first;
+        std::size_t count;
+        bool isLeaf() const { return count > 0; }
+    };
+    // a pair of nodes to traverse, both are the same for the pairs inside a node
+    struct Task
+    {
+        std::size_t node1;
+        std::size_t node2;
+    };
+    class Traversal;
+
+    void Build(const MeshKernel&);
+    PairList Traverse(const MeshFacetBVH& other, bool self, const PairPredicate&, bool firstOnly) const;
+
+private:
+    std::vector<Node> _nodes;
+    std::vector<FacetIndex> _facets;
+    std::vector<Base::BoundBox3f> _boxes;
+
+    MeshFacetBVH(const MeshFacetBVH&);
+    void operator= (const MeshFacetBVH&);
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_BVH_H
@@ -34,6 +34,7 @@
 #ifdef OPTIMIZE_CURVATURE
 #include <Eigen/Eigenvalues>
 #else
+#include <Mod/Mesh/App/WildMagic4/Wm4Vector2.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
 #endif
@@ -293,47 +294,149 @@ void MeshCurvature::ComputePerVertex()
 {
     myCurvature.clear();
 
-    // get all points
-    std::vector< Wm4::Vector3<double> > aPnts;
-    aPnts.reserve(myKernel.CountPoints());
-    MeshPointIterator cPIt(myKernel);
-    for (cPIt.Init(); cPIt.More(); cPIt.Next()) {
-        Wm4::Vector3<double> cP(cPIt->x, cPIt->y, cPIt->z);
-        aPnts.push_back(cP);
-    }
-
-    // get all point connections
-    std::vector<int> aIdx;
-    aIdx.reserve(3*myKernel.CountFacets());
-    const MeshFacetArray& raFts = myKernel.GetFacets();
-    for (MeshFacetArray::const_iterator jt = raFts.begin(); jt != raFts.end(); ++jt) {
-        for (int i=0; i<3; i++) {
-            aIdx.push_back((int)jt->_aulPoints[i]);
-        }
-    }
-
     // in case of an empty mesh no curvature can be calculated
     if (myKernel.CountPoints() == 0 || myKernel.CountFacets() == 0)
         return;
 
-    // compute vertex based curvatures
-    Wm4::MeshCurvature<double> meshCurv(myKernel.CountPoints(), &(aPnts[0]), myKernel.CountFacets(), &(aIdx[0]));
+    // This is the estimation of Wm4::MeshCurvature, but instead of adding the
+    // terms of a facet to its points the terms of a point are collected from
+    // its facets in the same order. So the points are handled in parallel and
+    // the result is the same for any number of threads.
+    typedef Wm4::Vector3<double> Vector3;
+    const MeshPointArray& rPoints = myKernel.GetPoints();
+    const MeshFacetArray& rFacets = myKernel.GetFacets();
+    MeshPointAdjacency adjacency(myKernel);
+    std::size_t numPoints = rPoints.size();
+
+    std::vector<Vector3> akVertex(numPoints);
+    MeshPointAdjacency::ForEachRange(numPoints, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            akVertex[i] = Vector3(rPoints[i].x, rPoints[i].y, rPoints[i].z);
+    });
+
+    // the normal of a facet, its length provides a weighted sum
+    std::vector<Vector3> akFacetNormal(rFacets.size());
+    MeshPointAdjacency::ForEachRange(rFacets.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const PointIndex* aiV = rFacets[i]._aulPoints;
+            Vector3 kEdge1 = akVertex[aiV[1]] - akVertex[aiV[0]];
+            Vector3 kEdge2 = akVertex[aiV[2]] - akVertex[aiV[0]];
+            akFacetNormal[i] = kEdge1.Cross(kEdge2);
+        }
+    });
+
+    // a degenerated facet adds its terms for each corner at the point
+    std::vector<Vector3> akNormal(numPoints);
+    MeshPointAdjacency::ForEachRange(numPoints, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            Vector3 kNormal(0,0,0);
+            for (FacetIndex f : adjacency.GetFacets(i)) {
+                for (int j = 0; j < 3; j++) {
+                    if (rFacets[f]._aulPoints[j] == i)
+                        kNormal += akFacetNormal[f];
+                }
+            }
+            kNormal.Normalize();
+            akNormal[i] = kNormal;
+        }
+    });
+    std::vector<Vector3>().swap(akFacetNormal);
+
+    myCurvature.resize(numPoints);
+    MeshPointAdjacency::ForEachRange(numPoints, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            // compute the matrix of normal derivatives
+            Wm4::Matrix3<double> akWWTrn(0,0,0,0,0,0,0,0,0);
+            Wm4::Matrix3<double> akDWTrn(0,0,0,0,0,0,0,0,0);
+            for (FacetIndex f : adjacency.GetFacets(i)) {
+                const PointIndex* aiV = rFacets[f]._aulPoints;
+                for (int j = 0; j < 3; j++) {
+                    if (aiV[j] != i)
+                        continue;
+                    PointIndex iV0 = aiV[j];
+                    PointIndex iV1 = aiV[(j+1)%3];
+                    PointIndex iV2 = aiV[(j+2)%3];
+
+                    // Compute edges from V0 to V1 and V2, project to tangent plane
+                    // of vertex, and compute difference of adjacent normals.
+                    for (PointIndex iV : {iV1, iV2}) {
+                        Vector3 kE = akVertex[iV] - akVertex[iV0];
+                        Vector3 kW = kE - (kE.Dot(akNormal[iV0]))*akNormal[iV0];
+                        Vector3 kD = akNormal[iV] - akNormal[iV0];
+                        for (int iRow = 0; iRow < 3; iRow++) {
+                            for (int iCol = 0; iCol < 3; iCol++) {
+                                akWWTrn[iRow][iCol] += kW[iRow]*kW[iCol];
+                                akDWTrn[iRow][iCol] += kD[iRow]*kW[iCol];
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Add in N*N^T to W*W^T for numerical stability.
+            for (int iRow = 0; iRow < 3; iRow++) {
+                for (int iCol = 0; iCol < 3; iCol++) {
+                    akWWTrn[iRow][iCol] = 0.5*akWWTrn[iRow][iCol] +
+                        akNormal[i][iRow]*akNormal[i][iCol];
+                    akDWTrn[iRow][iCol] *= 0.5;
+                }
+            }
 
-    // get curvature information now
-    const Wm4::Vector3<double>* aMaxCurvDir = meshCurv.GetMaxDirections();
-    const Wm4::Vector3<double>* aMinCurvDir = meshCurv.GetMinDirections();
-    const double* aMaxCurv = meshCurv.GetMaxCurvatures();
-    const double* aMinCurv = meshCurv.GetMinCurvatures();
+            Wm4::Matrix3<double> akDNormal = akDWTrn*akWWTrn.Inverse();
+
+            // compute U and V given N, see Wm4::MeshCurvature for the
+            // computation of the shape matrix S = J^T * dN/dX * J
+            Vector3 kU, kV;
+            Vector3::GenerateComplementBasis(kU,kV,akNormal[i]);
+
+            double fS01 = kU.Dot(akDNormal*kV);
+            double fS10 = kV.Dot(akDNormal*kU);
+            double fSAvr = 0.5*(fS01+fS10);
+            Wm4::Matrix2<double> kS
+            (
+                kU.Dot(akDNormal*kU), fSAvr,
+                fSAvr, kV.Dot(akDNormal*kV)
+            );
+
+            // compute the eigenvalues of S (min and max curvatures)
+            double fTrace = kS[0][0] + kS[1][1];
+            double fDet = kS[0][0]*kS[1][1] - kS[0][1]*kS[1][0];
+            double fDiscr = fTrace*fTrace - 4.0*fDet;
+            double fRootDiscr = Wm4::Math<double>::Sqrt(Wm4::Math<double>::FAbs(fDiscr));
+            double fMinCurvature = 0.5*(fTrace - fRootDiscr);
+            double fMaxCurvature = 0.5*(fTrace + fRootDiscr);
+
+            // compute the eigenvectors of S
+            Vector3 kMinDirection, kMaxDirection;
+            Wm4::Vector2<double> kW0(kS[0][1],fMinCurvature-kS[0][0]);
+            Wm4::Vector2<double> kW1(fMinCurvature-kS[1][1],kS[1][0]);
+            if (kW0.SquaredLength() >= kW1.SquaredLength()) {
+                kW0.Normalize();
+                kMinDirection = kW0.X()*kU + kW0.Y()*kV;
+            }
+            else {
+                kW1.Normalize();
+                kMinDirection = kW1.X()*kU + kW1.Y()*kV;
+            }
 
-    myCurvature.reserve(myKernel.CountPoints());
-    for (unsigned long i=0; i<myKernel.CountPoints(); i++) {
-        CurvatureInfo ci;
-        ci.cMaxCurvDir = Base::Vector3f((float)aMaxCurvDir[i].X(), (float)aMaxCurvDir[i].Y(), (float)aMaxCurvDir[i].Z());
-        ci.cMinCurvDir = Base::Vector3f((float)aMinCurvDir[i].X(), (float)aMinCurvDir[i].Y(), (float)aMinCurvDir[i].Z());
-        ci.fMaxCurvature = (float)aMaxCurv[i];
-        ci.fMinCurvature = (float)aMinCurv[i];
-        myCurvature.push_back(ci);
-    }
+            kW0 = Wm4::Vector2<double>(kS[0][1],fMaxCurvature-kS[0][0]);
+            kW1 = Wm4::Vector2<double>(fMaxCurvature-kS[1][1],kS[1][0]);
+            if (kW0.SquaredLength() >= kW1.SquaredLength()) {
+                kW0.Normalize();
+                kMaxDirection = kW0.X()*kU + kW0.Y()*kV;
+            }
+            else {
+                kW1.Normalize();
+                kMaxDirection = kW1.X()*kU + kW1.Y()*kV;
+            }
+
+            CurvatureInfo& ci = myCurvature[i];
+            ci.cMaxCurvDir = Base::Vector3f((float)kMaxDirection.X(), (float)kMaxDirection.Y(), (float)kMaxDirection.Z());
+            ci.cMinCurvDir = Base::Vector3f((float)kMinDirection.X(), (float)kMinDirection.Y(), (float)kMinDirection.Z());
+            ci.fMaxCurvature = (float)fMaxCurvature;
+            ci.fMinCurvature = (float)fMinCurvature;
+        }
+    });
 }
 #endif // OPTIMIZE_CURVATURE
 
@@ -23,11 +23,20 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <unordered_map>
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <Base/Exception.h>
+
 #include "Decimation.h"
 #include "MeshKernel.h"
 #include "Algorithm.h"
+#include "Grid.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
 #include <Base/Tools.h>
@@ -36,117 +45,210 @@
 
 using namespace MeshCore;
 
-MeshSimplify::MeshSimplify(MeshKernel& mesh)
-  : myKernel(mesh)
-{
-}
-
-MeshSimplify::~MeshSimplify()
-{
-}
-
-void MeshSimplify::simplify(float tolerance, float reduction)
+namespace {
+// the minimum number of facets of a chunk simplified in parallel
+const std::size_t MinChunkFacets = 50000;
+
+/*
+ * Simplifies the triangles \a tria given as triples of point indices. The
+ * locked points are not moved, the positions and attributes of the other
+ * points are updated in place. Afterwards \a tria holds the remaining triangles.
+ */
+void simplifyTriangles(std::vector<PointIndex>& tria, int targetSize, double tolerance,
+                       const std::vector<char>& locked, MeshPointArray& points,
+                       std::vector<float>* attributes, int count)
 {
     Simplify alg;
-
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
-    }
-
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
+    std::unordered_map<PointIndex, int> local;
+    std::vector<PointIndex> global;
+    local.reserve(tria.size() / 2);
+    alg.triangles.reserve(tria.size() / 3);
+    for (std::size_t i = 0; i < tria.size(); i += 3) {
         Simplify::Triangle t;
         for (int j = 0; j < 4; j++)
             t.err[j] = 0.0;
-        for (int j = 0; j < 3; j++)
-            t.v[j] = facets[i]._aulPoints[j];
+        for (int j = 0; j < 3; j++) {
+            auto it = local.emplace(tria[i + j], static_cast<int>(global.size()));
+            if (it.second)
+                global.push_back(tria[i + j]);
+            t.v[j] = it.first->second;
+        }
         alg.triangles.push_back(t);
     }
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0f-reduction));
+    alg.vertices.resize(global.size());
+    for (std::size_t i = 0; i < global.size(); i++) {
+        Simplify::Vertex& v = alg.vertices[i];
+        v.tstart = 0;
+        v.p = points[global[i]];
+        v.locked = locked[global[i]];
+    }
+    if (attributes && count > 0) {
+        alg.attribute_count = count;
+        alg.attributes.resize(global.size() * count);
+        for (std::size_t i = 0; i < global.size(); i++) {
+            std::copy_n(attributes->begin() + global[i] * count, count,
+                        alg.attributes.begin() + i * count);
+        }
+    }
 
-    // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
+    // the points are still needed to map them back
+    alg.simplify_mesh(targetSize, tolerance, 7, false);
 
-    // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (std::size_t i = 0; i < alg.vertices.size(); i++) {
-        new_points.push_back(alg.vertices[i].p);
+    for (std::size_t i = 0; i < global.size(); i++) {
+        if (locked[global[i]])
+            continue;
+        static_cast<Base::Vector3f&>(points[global[i]]) = alg.vertices[i].p;
+        if (alg.attribute_count > 0) {
+            std::copy_n(alg.attributes.begin() + i * count, count,
+                        attributes->begin() + global[i] * count);
+        }
     }
 
-    std::size_t numFacets = 0;
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted)
-            numFacets++;
-    }
-    MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = alg.triangles[i].v[0];
-            face._aulPoints[1] = alg.triangles[i].v[1];
-            face._aulPoints[2] = alg.triangles[i].v[2];
-            new_facets.push_back(face);
-        }
+    tria.clear();
+    for (const Simplify::Triangle& t : alg.triangles) {
+        if (t.deleted)
+            continue;
+        for (int j = 0; j < 3; j++)
+            tria.push_back(global[t.v[j]]);
     }
+}
+}
 
-    myKernel.Adopt(new_points, new_facets, true);
+MeshSimplify::MeshSimplify(MeshKernel& mesh)
+  : myKernel(mesh)
+  , myAttributes(nullptr)
+  , myAttributeCount(0)
+{
 }
 
-void MeshSimplify::simplify(int targetSize)
+MeshSimplify::~MeshSimplify()
 {
-    Simplify alg;
+}
 
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
-    }
+void MeshSimplify::setPointAttributes(std::vector<float>* values, int count)
+{
+    myAttributes = values;
+    myAttributeCount = values ? count : 0;
+}
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        for (int j = 0; j < 4; j++)
-            t.err[j] = 0.0;
-        for (int j = 0; j < 3; j++)
-            t.v[j] = facets[i]._aulPoints[j];
-        alg.triangles.push_back(t);
-    }
+void MeshSimplify::simplify(float tolerance, float reduction)
+{
+    std::size_t numFacets = myKernel.CountFacets();
+    int targetSize = static_cast<int>(static_cast<float>(numFacets) * (1.0f-reduction));
+    simplifyChunks(targetSize, tolerance);
+}
 
-    // Simplification starts
-    alg.simplify_mesh(targetSize, FLT_MAX);
+void MeshSimplify::simplify(int targetSize)
+{
+    simplifyChunks(targetSize, FLT_MAX);
+}
 
-    // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (std::size_t i = 0; i < alg.vertices.size(); i++) {
-        new_points.push_back(alg.vertices[i].p);
+void MeshSimplify::simplifyChunks(int targetSize, double tolerance)
+{
+    std::size_t numFacets = myKernel.CountFacets();
+    if (numFacets == 0)
+        return;
+    if (myAttributes && myAttributes->size() != myKernel.CountPoints() * myAttributeCount)
+        throw Base::ValueError("Number of point attributes doesn't match with number of points");
+
+    double ratio = std::max(0.0, std::min(1.0, static_cast<double>(targetSize) / numFacets));
+
+    // sort the facets along a Morton curve, so that each chunk covers a
+    // compact region of the mesh
+    std::size_t numChunks = std::max<std::size_t>(1, numFacets / MinChunkFacets);
+    numChunks = std::min(numChunks, 4 * static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1)));
+    std::vector<FacetIndex> order = SortFacetsAlongMortonCurve(myKernel);
+
+    // work on the arrays of the kernel, they are given back at the end
+    MeshPointArray points;
+    MeshFacetArray facets;
+    myKernel.Adopt(points, facets, false);
+
+    // the points used by several chunks must not be moved
+    std::vector<int> owner(points.size(), -1);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        int chunk = static_cast<int>(i * numChunks / numFacets);
+        for (int j = 0; j < 3; j++) {
+            int& o = owner[facets[order[i]]._aulPoints[j]];
+            if (o == -1)
+                o = chunk;
+            else if (o != chunk)
+                o = -2;
+        }
+    }
+    std::vector<char> locked(points.size(), 0);
+    for (std::size_t i = 0; i < points.size(); i++)
+        locked[i] = owner[i] == -2 ? 1 : 0;
+    std::vector<int>().swap(owner);
+
+    std::vector<std::vector<PointIndex> > chunks(numChunks);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        std::vector<PointIndex>& tria = chunks[i * numChunks / numFacets];
+        const MeshFacet& f = facets[order[i]];
+        tria.insert(tria.end(), f._aulPoints, f._aulPoints + 3);
     }
+    std::vector<FacetIndex>().swap(order);
+    MeshFacetArray().swap(facets);
+
+    QtConcurrent::blockingMap(chunks, [&](std::vector<PointIndex>& tria) {
+        int target = static_cast<int>(std::lround(ratio * static_cast<double>(tria.size() / 3)));
+        simplifyTriangles(tria, target, tolerance, locked, points, myAttributes, myAttributeCount);
+    });
+
+    // Seam pass: simplify the facets around the locked points where
+    // only the points used by the other facets are locked
+    std::vector<PointIndex> result;
+    if (numChunks > 1) {
+        std::vector<PointIndex> seam;
+        std::vector<char> used(points.size(), 0);
+        for (std::vector<PointIndex>& tria : chunks) {
+            for (std::size_t i = 0; i < tria.size(); i += 3) {
+                if (locked[tria[i]] || locked[tria[i + 1]] || locked[tria[i + 2]]) {
+                    seam.insert(seam.end(), tria.begin() + i, tria.begin() + i + 3);
+                }
+                else {
+                    result.insert(result.end(), tria.begin() + i, tria.begin() + i + 3);
+                    used[tria[i]] = used[tria[i + 1]] = used[tria[i + 2]] = 1;
+                }
+            }
+            std::vector<PointIndex>().swap(tria);
+        }
 
-    std::size_t numFacets = 0;
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted)
-            numFacets++;
+        long restSize = static_cast<long>(result.size() / 3);
+        long seamSize = static_cast<long>(seam.size() / 3);
+        long target = std::max(static_cast<long>(targetSize) - restSize,
+                               static_cast<long>(std::lround(ratio * seamSize)));
+        simplifyTriangles(seam, static_cast<int>(target), tolerance, used, points, myAttributes, myAttributeCount);
+        result.insert(result.end(), seam.begin(), seam.end());
+    }
+    else {
+        result.swap(chunks.front());
     }
-    MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = alg.triangles[i].v[0];
-            face._aulPoints[1] = alg.triangles[i].v[1];
-            face._aulPoints[2] = alg.triangles[i].v[2];
-            new_facets.push_back(face);
+
+    // remove the unused points
+    std::vector<PointIndex> remap(points.size(), POINT_INDEX_MAX);
+    for (PointIndex index : result)
+        remap[index] = 0;
+    PointIndex numPoints = 0;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (remap[i] == POINT_INDEX_MAX)
+            continue;
+        remap[i] = numPoints;
+        points[numPoints] = MeshPoint(static_cast<const Base::Vector3f&>(points[i]));
+        if (myAttributes) {
+            std::copy_n(myAttributes->begin() + i * myAttributeCount, myAttributeCount,
+                        myAttributes->begin() + numPoints * myAttributeCount);
         }
+        numPoints++;
     }
+    points.resize(numPoints);
+    if (myAttributes)
+        myAttributes->resize(numPoints * myAttributeCount);
+
+    facets.reserve(result.size() / 3);
+    for (std::size_t i = 0; i < result.size(); i += 3)
+        facets.push_back(MeshFacet(remap[result[i]], remap[result[i + 1]], remap[result[i + 2]]));
 
-    myKernel.Adopt(new_points, new_facets, true);
+    myKernel.Adopt(points, facets, true);
 }
@@ -24,21 +24,38 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <vector>
 
 namespace MeshCore
 {
 class MeshKernel;
 
+/**
+ * The MeshSimplify class reduces the number of facets of a mesh by collapsing
+ * edges with the smallest quadric error. Large meshes are split into spatial
+ * chunks that are simplified in parallel. The points shared by several chunks
+ * are locked and the facets around them are simplified afterwards.
+ */
 class MeshExport MeshSimplify
 {
 public:
     MeshSimplify(MeshKernel&);
     ~MeshSimplify();
+    /** Sets \a count values per point that are interpolated when two points
+     * are merged and removed together with their points. The array must have
+     * \a count times the number of points values.
+     */
+    void setPointAttributes(std::vector<float>* values, int count);
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
 
+private:
+    void simplifyChunks(int targetSize, double tolerance);
+
 private:
     MeshKernel& myKernel;
+    std::vector<float>* myAttributes;
+    int myAttributeCount;
 };
 
 } // namespace MeshCore
@@ -40,6 +40,7 @@
 #include "Grid.h"
 #include "TopoAlgorithm.h"
 #include "Functional.h"
+#include "BVH.h"
 #include <Base/Matrix.h>
 
 #include <Base/Sequencer.h>
@@ -594,76 +595,45 @@ bool MeshFixSingleFacet::Fixup ()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate ()
+namespace {
+// The test of a candidate pair of facets for the search with MeshFacetBVH
+class SelfIntersectionTest
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+public:
+    SelfIntersectionTest(const MeshKernel& mesh) : rMesh(mesh), rFaces(mesh.GetFacets())
+    {
     }
+    bool operator()(FacetIndex index1, FacetIndex index2) const
+    {
+        // If the facets share a common vertex we do not check for self-intersections because they
+        // could but usually do not intersect each other and the algorithm below would detect false-positives,
+        // otherwise
+        const MeshFacet& rface1 = rFaces[index1];
+        const MeshFacet& rface2 = rFaces[index2];
+        for (int i = 0; i < 3; i++) {
+            if (rface1._aulPoints[i] == rface2._aulPoints[0] ||
+                rface1._aulPoints[i] == rface2._aulPoints[1] ||
+                rface1._aulPoints[i] == rface2._aulPoints[2])
+                return false; // ignore facets sharing a common vertex
+        }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.size()==0)
-            continue;
-
-        MeshGeomFacet facet1, facet2;
         Base::Vector3f pt1, pt2;
-        for (std::vector<FacetIndex>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<FacetIndex>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
-                    }
-                }
-            }
-        }
+        MeshGeomFacet facet1 = rMesh.GetFacet(rface1);
+        MeshGeomFacet facet2 = rMesh.GetFacet(rface2);
+        return facet1.IntersectWithFacet(facet2, pt1, pt2) == 2;
     }
 
-    return true;
+private:
+    const MeshKernel& rMesh;
+    const MeshFacetArray& rFaces;
+};
+}
+
+bool MeshEvalSelfIntersection::Evaluate ()
+{
+    // abort after the first detected self-intersection
+    MeshFacetBVH bvh(_rclMesh);
+    return bvh.FindSelfPairs(SelfIntersectionTest(_rclMesh), true).empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<FacetIndex, FacetIndex> >& indices,
@@ -691,6 +661,13 @@ void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<Face
 }
 
 void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex> >& intersection) const
+{
+    MeshFacetBVH bvh(_rclMesh);
+    MeshFacetBVH::PairList pairs = bvh.FindSelfPairs(SelfIntersectionTest(_rclMesh));
+    intersection.insert(intersection.end(), pairs.begin(), pairs.end());
+}
+
+void MeshEvalSelfIntersection::GetIntersectionsByGrid(std::vector<std::pair<FacetIndex, FacetIndex> >& intersection) const
 {
     // Contains bounding boxes for every facet 
     std::vector<Base::BoundBox3f> boxes;
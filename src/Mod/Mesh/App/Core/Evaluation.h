@@ -283,6 +283,8 @@ protected:
 
 /**
  * The MeshEvalSelfIntersection class checks the mesh for self intersection.
+ * The candidate pairs of facets are found with a MeshFacetBVH and tested in
+ * several threads, the pairs are sorted by index.
  * @author Werner Mayer
  */
 class MeshExport MeshEvalSelfIntersection : public MeshEvaluation
@@ -297,6 +299,11 @@ public:
         std::vector<std::pair<Base::Vector3f, Base::Vector3f> >&) const;
     /// collect the index of all facets with self intersections
     void GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex> >&) const;
+    /** The former search of GetIntersections() that tests the facets in the
+     * cells of a grid, kept for comparison. A pair may be reported for every
+     * cell both facets are in.
+     */
+    void GetIntersectionsByGrid(std::vector<std::pair<FacetIndex, FacetIndex> >&) const;
 };
 
 /**
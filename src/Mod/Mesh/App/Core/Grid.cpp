@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <cstdint>
 #endif
 
 #include "Grid.h"
@@ -1250,3 +1251,51 @@ bool MeshGridIterator::NextOnRay (std::vector<ElementIndex> &raulElements)
 
   return _bValidRay;
 }
+
+// -------------------------------------------------------------------------
+
+namespace {
+// the bits per axis of the cells used to sort the facets along a Morton curve
+const int MortonBits = 5;
+
+uint32_t mortonCode(const Base::Vector3f& pnt, const Base::BoundBox3f& box)
+{
+    const uint32_t cells = 1 << MortonBits;
+    float len[3] = {box.LengthX(), box.LengthY(), box.LengthZ()};
+    float pos[3] = {pnt.x - box.MinX, pnt.y - box.MinY, pnt.z - box.MinZ};
+    uint32_t code = 0;
+    for (int i = 0; i < 3; i++) {
+        uint32_t cell = 0;
+        if (len[i] > 0)
+            cell = std::min(cells - 1, static_cast<uint32_t>(std::max(0.0f, pos[i] / len[i]) * cells));
+        for (int b = 0; b < MortonBits; b++)
+            code |= ((cell >> b) & 1) << (3 * b + i);
+    }
+    return code;
+}
+}
+
+std::vector<FacetIndex> MeshCore::SortFacetsAlongMortonCurve (const MeshKernel &rclM)
+{
+    const MeshPointArray& rPAry = rclM.GetPoints();
+    const MeshFacetArray& rFAry = rclM.GetFacets();
+    std::size_t numFacets = rFAry.size();
+    Base::BoundBox3f box = rclM.GetBoundBox();
+
+    // a counting sort by the cell of the center of each facet
+    std::vector<uint32_t> codes(numFacets);
+    std::vector<std::size_t> cellStart((1 << (3 * MortonBits)) + 1, 0);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        const MeshFacet& f = rFAry[i];
+        Base::Vector3f center = (rPAry[f._aulPoints[0]] + rPAry[f._aulPoints[1]] + rPAry[f._aulPoints[2]]) / 3.0f;
+        codes[i] = mortonCode(center, box);
+        cellStart[codes[i] + 1]++;
+    }
+    for (std::size_t i = 1; i < cellStart.size(); i++)
+        cellStart[i] += cellStart[i - 1];
+
+    std::vector<FacetIndex> order(numFacets);
+    for (std::size_t i = 0; i < numFacets; i++)
+        order[cellStart[codes[i]]++] = i;
+    return order;
+}
@@ -25,6 +25,7 @@
 #define MESH_GRID_H
 
 #include <set>
+#include <vector>
 
 #include "MeshKernel.h"
 #include <Base/Vector3D.h>
@@ -280,6 +281,15 @@ protected:
   virtual void RebuildGrid ();
 };
 
+/**
+ * Returns the indices of the facets sorted along a Morton curve through the
+ * cells of a regular grid over the bounding box of the mesh, so that facets
+ * next to each other in the list are close in space. Facets of the same cell
+ * keep their order. It's used to split a mesh into compact chunks that are
+ * processed in parallel.
+ */
+MeshExport std::vector<FacetIndex> SortFacetsAlongMortonCurve (const MeshKernel &rclM);
+
 /**
  * The MeshGridIterator class provides an interface to walk through
  * all grid elements of a mesh grid.
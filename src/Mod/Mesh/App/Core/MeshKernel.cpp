@@ -838,19 +838,34 @@ void MeshKernel::Write (std::ostream &rclOut) const
     // write the number of points and facets
     str << static_cast<uint32_t>(CountPoints()) << static_cast<uint32_t>(CountFacets());
 
-    // write the data
+    // write the data in blocks to need only a few calls of the stream
+    const std::size_t blockSize = 4096;
+    std::vector<float> points;
+    points.reserve(3 * blockSize);
     for (MeshPointArray::_TConstIterator it = _aclPointArray.begin(); it != _aclPointArray.end(); ++it) {
-        str << it->x << it->y << it->z;
+        points.push_back(it->x);
+        points.push_back(it->y);
+        points.push_back(it->z);
+        if (points.size() == 3 * blockSize) {
+            str.write(points.data(), points.size());
+            points.clear();
+        }
     }
+    str.write(points.data(), points.size());
 
+    std::vector<uint32_t> facets;
+    facets.reserve(6 * blockSize);
     for (MeshFacetArray::_TConstIterator it = _aclFacetArray.begin(); it != _aclFacetArray.end(); ++it) {
-        str << static_cast<uint32_t>(it->_aulPoints[0])
-            << static_cast<uint32_t>(it->_aulPoints[1])
-            << static_cast<uint32_t>(it->_aulPoints[2]);
-        str << static_cast<uint32_t>(it->_aulNeighbours[0])
-            << static_cast<uint32_t>(it->_aulNeighbours[1])
-            << static_cast<uint32_t>(it->_aulNeighbours[2]);
+        for (int i = 0; i < 3; i++)
+            facets.push_back(static_cast<uint32_t>(it->_aulPoints[i]));
+        for (int i = 0; i < 3; i++)
+            facets.push_back(static_cast<uint32_t>(it->_aulNeighbours[i]));
+        if (facets.size() == 6 * blockSize) {
+            str.write(facets.data(), facets.size());
+            facets.clear();
+        }
     }
+    str.write(facets.data(), facets.size());
 
     str << _clBoundBox.MinX << _clBoundBox.MaxX;
     str << _clBoundBox.MinY << _clBoundBox.MaxY;
@@ -891,19 +906,35 @@ void MeshKernel::Read (std::istream &rclIn)
         str >> uCtPts >> uCtFts;
 
         try {
-            // read the data
+            // read the data in blocks
+            const std::size_t blockSize = 4096;
             MeshPointArray pointArray;
             pointArray.resize(uCtPts);
-            for (MeshPointArray::_TIterator it = pointArray.begin(); it != pointArray.end(); ++it) {
-                str >> it->x >> it->y >> it->z;
+            std::vector<float> points;
+            for (std::size_t i = 0; i < uCtPts; i += blockSize) {
+                std::size_t num = std::min<std::size_t>(blockSize, uCtPts - i);
+                points.resize(3 * num);
+                str.read(points.data(), points.size());
+                for (std::size_t j = 0; j < num; j++)
+                    pointArray[i + j].Set(points[3 * j], points[3 * j + 1], points[3 * j + 2]);
             }
           
             MeshFacetArray facetArray;
             facetArray.resize(uCtFts);
 
+            std::vector<uint32_t> facets;
+            const uint32_t* data = nullptr;
             uint32_t v1, v2, v3;
-            for (MeshFacetArray::_TIterator it = facetArray.begin(); it != facetArray.end(); ++it) {
-                str >> v1 >> v2 >> v3;
+            for (std::size_t i = 0; i < uCtFts; i++) {
+                if (i % blockSize == 0) {
+                    std::size_t num = std::min<std::size_t>(blockSize, uCtFts - i);
+                    facets.resize(6 * num);
+                    str.read(facets.data(), facets.size());
+                    data = facets.data();
+                }
+
+                MeshFacetArray::_TIterator it = facetArray.begin() + i;
+                v1 = *data++; v2 = *data++; v3 = *data++;
 
                 // make sure to have valid indices
                 if (v1 >= uCtPts || v2 >= uCtPts || v3 >= uCtPts)
@@ -917,7 +948,7 @@ void MeshKernel::Read (std::istream &rclIn)
                 // the empty neighbour must be explicitly set to 'FACET_INDEX_MAX'
                 // because in algorithms this value is always used to check
                 // for open edges.
-                str >> v1 >> v2 >> v3;
+                v1 = *data++; v2 = *data++; v3 = *data++;
 
                 // make sure to have valid indices
                 if (v1 >= uCtFts && v1 < open_edge)
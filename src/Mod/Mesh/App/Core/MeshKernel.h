@@ -90,9 +90,9 @@ public:
     unsigned long CountPoints () const
     { return static_cast<unsigned long>(_aclPointArray.size()); }
     /// Returns the number of required memory in bytes
-    unsigned int GetMemSize () const
-    { return static_cast<unsigned int>(_aclPointArray.size() * sizeof(MeshPoint) +
-                                       _aclFacetArray.size() * sizeof(MeshFacet)); }
+    std::size_t GetMemSize () const
+    { return _aclPointArray.capacity() * sizeof(MeshPoint) +
+             _aclFacetArray.capacity() * sizeof(MeshFacet); }
     /// Determines the bounding box
     const Base::BoundBox3f& GetBoundBox () const
     { return _clBoundBox; }
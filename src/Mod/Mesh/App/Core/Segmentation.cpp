@@ -23,14 +23,25 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <iterator>
+#include <numeric>
 #endif
 
+#include <QtConcurrentMap>
+
 #include "Segmentation.h"
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Grid.h"
 
 using namespace MeshCore;
 
+namespace {
+// the minimum number of facets of a chunk grown in parallel
+const std::size_t MinChunkFacets = 20000;
+const std::size_t MaxChunks = 256;
+}
+
 void MeshSurfaceSegment::Initialize(FacetIndex)
 {
 }
@@ -44,6 +55,11 @@ void MeshSurfaceSegment::AddFacet(const MeshFacet&)
 {
 }
 
+MeshSurfaceSegment* MeshSurfaceSegment::Clone() const
+{
+    return nullptr;
+}
+
 void MeshSurfaceSegment::AddSegment(const std::vector<FacetIndex>& segm)
 {
     if (segm.size() >= minFacets) {
@@ -104,6 +120,11 @@ void MeshDistancePlanarSegment::AddFacet(const MeshFacet& face)
     fitter->AddPoint(triangle.GetGravityPoint());
 }
 
+MeshSurfaceSegment* MeshDistancePlanarSegment::Clone() const
+{
+    return new MeshDistancePlanarSegment(kernel, minFacets, tolerance);
+}
+
 // --------------------------------------------------------
 
 PlaneSurfaceFit::PlaneSurfaceFit()
@@ -192,6 +213,13 @@ std::vector<float> PlaneSurfaceFit::Parameters() const
     return c;
 }
 
+AbstractSurfaceFit* PlaneSurfaceFit::Clone() const
+{
+    if (fitter)
+        return new PlaneSurfaceFit();
+    return new PlaneSurfaceFit(basepoint, normal);
+}
+
 // --------------------------------------------------------
 
 CylinderSurfaceFit::CylinderSurfaceFit()
@@ -300,6 +328,13 @@ std::vector<float> CylinderSurfaceFit::Parameters() const
     return c;
 }
 
+AbstractSurfaceFit* CylinderSurfaceFit::Clone() const
+{
+    if (fitter)
+        return new CylinderSurfaceFit();
+    return new CylinderSurfaceFit(basepoint, axis, radius);
+}
+
 // --------------------------------------------------------
 
 SphereSurfaceFit::SphereSurfaceFit()
@@ -392,6 +427,13 @@ std::vector<float> SphereSurfaceFit::Parameters() const
     return c;
 }
 
+AbstractSurfaceFit* SphereSurfaceFit::Clone() const
+{
+    if (fitter)
+        return new SphereSurfaceFit();
+    return new SphereSurfaceFit(center, radius);
+}
+
 // --------------------------------------------------------
 
 MeshDistanceGenericSurfaceFitSegment::MeshDistanceGenericSurfaceFitSegment(AbstractSurfaceFit* fit,
@@ -448,6 +490,14 @@ std::vector<float> MeshDistanceGenericSurfaceFitSegment::Parameters() const
     return fitter->Parameters();
 }
 
+MeshSurfaceSegment* MeshDistanceGenericSurfaceFitSegment::Clone() const
+{
+    AbstractSurfaceFit* fit = fitter->Clone();
+    if (!fit)
+        return nullptr;
+    return new MeshDistanceGenericSurfaceFitSegment(fit, kernel, minFacets, tolerance);
+}
+
 // --------------------------------------------------------
 
 bool MeshCurvaturePlanarSegment::TestFacet (const MeshFacet &rclFacet) const
@@ -592,3 +642,180 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         }
     }
 }
+
+void MeshSegmentAlgorithm::FindSegmentsParallel(std::vector<MeshSurfaceSegmentPtr>& segm)
+{
+    std::size_t numFacets = myKernel.CountFacets();
+
+    // the number of chunks doesn't depend on the number of threads, so that
+    // the result is the same on every machine
+    std::size_t numChunks = std::min(MaxChunks, numFacets / MinChunkFacets);
+    bool canClone = std::all_of(segm.begin(), segm.end(), [](const MeshSurfaceSegmentPtr& it) {
+        std::unique_ptr<MeshSurfaceSegment> clone(it->Clone());
+        return clone != nullptr;
+    });
+    if (numChunks < 2 || !canClone) {
+        FindSegments(segm);
+        return;
+    }
+
+    // sort the facets along a Morton curve, so that each chunk covers a
+    // compact region of the mesh
+    std::vector<FacetIndex> order = SortFacetsAlongMortonCurve(myKernel);
+    std::vector<int> chunkOf(numFacets);
+    for (std::size_t i = 0; i < numFacets; i++)
+        chunkOf[order[i]] = static_cast<int>(i * numChunks / numFacets);
+    std::vector<FacetIndex>().swap(order);
+
+    // the facets used by a segment are not used by the following segment types
+    std::vector<char> visited(numFacets, 0);
+    for (std::vector<MeshSurfaceSegmentPtr>::iterator it = segm.begin(); it != segm.end(); ++it) {
+        GrowSegments(**it, chunkOf, numChunks, visited);
+    }
+}
+
+void MeshSegmentAlgorithm::GrowSegments(MeshSurfaceSegment& segm, const std::vector<int>& chunkOf,
+                                        std::size_t numChunks, std::vector<char>& visited)
+{
+    const MeshFacetArray& rFAry = myKernel.GetFacets();
+    std::size_t numFacets = rFAry.size();
+
+    struct Chunk {
+        int id;
+        std::vector<FacetIndex> facets;
+        std::unique_ptr<MeshSurfaceSegment> segm;
+        std::vector<MeshSegment> regions;
+        std::vector<FacetIndex> released;
+    };
+    std::vector<Chunk> chunks(numChunks);
+    for (std::size_t i = 0; i < numChunks; i++) {
+        chunks[i].id = static_cast<int>(i);
+        chunks[i].segm.reset(segm.Clone());
+    }
+    for (std::size_t i = 0; i < numFacets; i++)
+        chunks[chunkOf[i]].facets.push_back(i);
+
+    // grow the regions of each chunk the same way as FindSegments does but
+    // without leaving the chunk, so a chunk only sets the flags of its facets
+    QtConcurrent::blockingMap(chunks, [&](Chunk& chunk) {
+        MeshSurfaceSegment& surf = *chunk.segm;
+        std::vector<FacetIndex> level, next;
+        for (FacetIndex startFacet : chunk.facets) {
+            if (visited[startFacet])
+                continue;
+
+            std::vector<FacetIndex> indices;
+            surf.Initialize(startFacet);
+            if (surf.TestInitialFacet(startFacet))
+                indices.push_back(startFacet);
+            visited[startFacet] = 1;
+
+            level.assign(1, startFacet);
+            while (!level.empty()) {
+                for (FacetIndex cur : level) {
+                    for (int i = 0; i < 3; i++) {
+                        FacetIndex j = rFAry[cur]._aulNeighbours[i];
+                        if (j >= numFacets || chunkOf[j] != chunk.id || visited[j])
+                            continue;
+                        if (!surf.TestFacet(rFAry[j]))
+                            continue;
+                        visited[j] = 1;
+                        next.push_back(j);
+                        indices.push_back(j);
+                        surf.AddFacet(rFAry[j]);
+                    }
+                }
+                level.swap(next);
+                next.clear();
+            }
+
+            if (indices.size() <= 1)
+                chunk.released.push_back(startFacet);
+            else
+                chunk.regions.push_back(std::move(indices));
+        }
+    });
+
+    std::vector<MeshSegment> regions;
+    for (Chunk& chunk : chunks) {
+        std::move(chunk.regions.begin(), chunk.regions.end(), std::back_inserter(regions));
+        for (FacetIndex index : chunk.released)
+            visited[index] = 0;
+    }
+    chunks.clear();
+
+    std::vector<int> regionOf(numFacets, -1);
+    for (std::size_t i = 0; i < regions.size(); i++) {
+        for (FacetIndex index : regions[i])
+            regionOf[index] = static_cast<int>(i);
+    }
+
+    // the pairs of neighbouring regions of different chunks
+    std::vector<std::pair<int, int> > pairs;
+    for (std::size_t i = 0; i < regions.size(); i++) {
+        for (FacetIndex index : regions[i]) {
+            for (int k = 0; k < 3; k++) {
+                FacetIndex j = rFAry[index]._aulNeighbours[k];
+                if (j < numFacets && regionOf[j] > static_cast<int>(i) && chunkOf[j] != chunkOf[index])
+                    pairs.emplace_back(static_cast<int>(i), regionOf[j]);
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    // merge two regions if the facets of the smaller one fit to the surface
+    // of the larger one as if it had been grown over the chunk border
+    std::vector<int> parent(regions.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto findRoot = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    // the surface of a region is fitted once when it's first needed and
+    // then updated with the facets of the regions merged into it
+    std::vector<std::unique_ptr<MeshSurfaceSegment> > surfaces(regions.size());
+    auto surfaceOf = [&](int i) -> MeshSurfaceSegment& {
+        if (!surfaces[i]) {
+            const MeshSegment& region = regions[i];
+            surfaces[i].reset(segm.Clone());
+            surfaces[i]->Initialize(region.front());
+            for (std::size_t j = 1; j < region.size(); j++)
+                surfaces[i]->AddFacet(rFAry[region[j]]);
+        }
+        return *surfaces[i];
+    };
+
+    for (const std::pair<int, int>& it : pairs) {
+        int a = findRoot(it.first);
+        int b = findRoot(it.second);
+        if (a == b)
+            continue;
+        if (regions[a].size() < regions[b].size())
+            std::swap(a, b);
+
+        MeshSegment& segmA = regions[a];
+        MeshSegment& segmB = regions[b];
+        MeshSurfaceSegment& surf = surfaceOf(a);
+        bool fits = std::all_of(segmB.begin(), segmB.end(), [&](FacetIndex index) {
+            return surf.TestFacet(rFAry[index]);
+        });
+        if (fits) {
+            for (FacetIndex index : segmB)
+                surf.AddFacet(rFAry[index]);
+            segmA.insert(segmA.end(), segmB.begin(), segmB.end());
+            MeshSegment().swap(segmB);
+            surfaces[b].reset();
+            parent[b] = a;
+        }
+    }
+
+    for (std::size_t i = 0; i < regions.size(); i++) {
+        if (parent[i] == static_cast<int>(i))
+            segm.AddSegment(regions[i]);
+    }
+}
@@ -48,6 +48,10 @@ public:
     virtual void Initialize(FacetIndex);
     virtual bool TestInitialFacet(FacetIndex) const;
     virtual void AddFacet(const MeshFacet& rclFacet);
+    /** Returns a new segment with the same settings but without any found
+     * segments, or null if the segment type can't be grown in parallel.
+     */
+    virtual MeshSurfaceSegment* Clone() const;
     void AddSegment(const std::vector<FacetIndex>&);
     const std::vector<MeshSegment>& GetSegments() const { return segments; }
     MeshSegment FindSegment(FacetIndex) const;
@@ -80,6 +84,7 @@ public:
     const char* GetType() const { return "Plane"; }
     void Initialize(FacetIndex);
     void AddFacet(const MeshFacet& rclFacet);
+    MeshSurfaceSegment* Clone() const;
 
 protected:
     Base::Vector3f basepoint;
@@ -100,6 +105,8 @@ public:
     virtual float Fit() = 0;
     virtual float GetDistanceToSurface(const Base::Vector3f&) const = 0;
     virtual std::vector<float> Parameters() const = 0;
+    /// Returns a new fit of the same kind, or null if this isn't supported
+    virtual AbstractSurfaceFit* Clone() const { return nullptr; }
 };
 
 class MeshExport PlaneSurfaceFit : public AbstractSurfaceFit
@@ -116,6 +123,7 @@ public:
     float Fit();
     float GetDistanceToSurface(const Base::Vector3f&) const;
     std::vector<float> Parameters() const;
+    AbstractSurfaceFit* Clone() const;
 
 private:
     Base::Vector3f basepoint;
@@ -137,6 +145,7 @@ public:
     float Fit();
     float GetDistanceToSurface(const Base::Vector3f&) const;
     std::vector<float> Parameters() const;
+    AbstractSurfaceFit* Clone() const;
 
 private:
     Base::Vector3f basepoint;
@@ -159,6 +168,7 @@ public:
     float Fit();
     float GetDistanceToSurface(const Base::Vector3f&) const;
     std::vector<float> Parameters() const;
+    AbstractSurfaceFit* Clone() const;
 
 private:
     Base::Vector3f center;
@@ -178,6 +188,7 @@ public:
     bool TestInitialFacet(FacetIndex) const;
     void AddFacet(const MeshFacet& rclFacet);
     std::vector<float> Parameters() const;
+    MeshSurfaceSegment* Clone() const;
 
 protected:
     AbstractSurfaceFit* fitter;
@@ -202,6 +213,8 @@ public:
         : MeshCurvatureSurfaceSegment(ci, minFacets), tolerance(tol) {}
     virtual bool TestFacet (const MeshFacet &rclFacet) const;
     virtual const char* GetType() const { return "Plane"; }
+    virtual MeshSurfaceSegment* Clone() const
+    { return new MeshCurvaturePlanarSegment(info, minFacets, tolerance); }
 
 private:
     float tolerance;
@@ -215,6 +228,8 @@ public:
         : MeshCurvatureSurfaceSegment(ci, minFacets), toleranceMin(tolMin), toleranceMax(tolMax) { curvature = curv;}
     virtual bool TestFacet (const MeshFacet &rclFacet) const;
     virtual const char* GetType() const { return "Cylinder"; }
+    virtual MeshSurfaceSegment* Clone() const
+    { return new MeshCurvatureCylindricalSegment(info, minFacets, toleranceMin, toleranceMax, curvature); }
 
 private:
     float curvature;
@@ -229,6 +244,8 @@ public:
         : MeshCurvatureSurfaceSegment(ci, minFacets), tolerance(tol) { curvature = curv;}
     virtual bool TestFacet (const MeshFacet &rclFacet) const;
     virtual const char* GetType() const { return "Sphere"; }
+    virtual MeshSurfaceSegment* Clone() const
+    { return new MeshCurvatureSphericalSegment(info, minFacets, tolerance, curvature); }
 
 private:
     float curvature;
@@ -244,6 +261,8 @@ public:
           toleranceMin(tolMin), toleranceMax(tolMax) {}
     virtual bool TestFacet (const MeshFacet &rclFacet) const;
     virtual const char* GetType() const { return "Freeform"; }
+    virtual MeshSurfaceSegment* Clone() const
+    { return new MeshCurvatureFreeformSegment(info, minFacets, toleranceMin, toleranceMax, c1, c2); }
 
 private:
     float c1, c2;
@@ -271,8 +290,19 @@ class MeshExport MeshSegmentAlgorithm
 public:
     MeshSegmentAlgorithm(const MeshKernel& kernel) : myKernel(kernel) {}
     void FindSegments(std::vector<MeshSurfaceSegmentPtr>&);
+    /** Does the same as FindSegments but grows the segments in spatial chunks
+     * of the mesh in parallel. Afterwards neighbouring segments of different
+     * chunks are merged if the facets of the one fit to the surface of the
+     * other. So the segments may slightly differ from those of FindSegments
+     * at the chunk borders. Small meshes and segment types that can't be
+     * cloned are handled by FindSegments.
+     */
+    void FindSegmentsParallel(std::vector<MeshSurfaceSegmentPtr>&);
 
 private:
+    void GrowSegments(MeshSurfaceSegment&, const std::vector<int>& chunkOf,
+                      std::size_t numChunks, std::vector<char>& visited);
+
     const MeshKernel& myKernel;
 };
 
@@ -25,12 +25,14 @@
 
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <ios>
 #endif
 
 #include <fstream>
 #include "SetOperations.h"
 #include "Algorithm.h"
+#include "BVH.h"
 #include "Elements.h"
 #include "Iterator.h"
 #include "Grid.h"
@@ -49,6 +51,83 @@
 using namespace Base;
 using namespace MeshCore;
 
+namespace {
+// Computes the cut line of two facets, if an end point is close to a corner
+// point of one of the facets it's moved to this point.
+// Returns false if the facets don't intersect.
+bool CutFacets (const MeshGeomFacet& f1, const MeshGeomFacet& f2, float minDistanceToPoint,
+                MeshPoint& mp0, MeshPoint& mp1)
+{
+  MeshPoint p0, p1;
+
+  int isect = f1.IntersectWithFacet(f2, p0, p1);
+  if (isect <= 0)
+    return false;
+
+  // optimize cut line if distance to nearest point is too small
+  float minDist1 = minDistanceToPoint, minDist2 = minDistanceToPoint;
+  MeshPoint np0 = p0, np1 = p1;
+  int i;
+  for (i = 0; i < 3; i++)
+  {
+    float d1 = (f1._aclPoints[i] - p0).Length();
+    float d2 = (f1._aclPoints[i] - p1).Length();
+    if (d1 < minDist1)
+    {
+      minDist1 = d1;
+      np0 = f1._aclPoints[i];
+    }
+    if (d2 < minDist2)
+    {
+      minDist2 = d2;
+      p1 = f1._aclPoints[i];
+    }
+  } // for (int i = 0; i < 3; i++)
+
+  // optimize cut line if distance to nearest point is too small
+  for (i = 0; i < 3; i++)
+  {
+    float d1 = (f2._aclPoints[i] - p0).Length();
+    float d2 = (f2._aclPoints[i] - p1).Length();
+    if (d1 < minDist1)
+    {
+      minDist1 = d1;
+      np0 = f2._aclPoints[i];
+    }
+    if (d2 < minDist2)
+    {
+      minDist2 = d2;
+      np1 = f2._aclPoints[i];
+    }
+  } // for (int i = 0; i < 3; i++)
+
+  mp0 = np0;
+  mp1 = np1;
+  return true;
+}
+
+// Checks with a ray whether the point is inside the closed mesh, the facets
+// are tested in parallel
+bool IsPointInside (const MeshKernel& mesh, const Base::Vector3f& point)
+{
+  // an arbitrary direction that is unlikely to be parallel to a facet
+  Base::Vector3f dir(0.5773f, 0.5779f, 0.5767f);
+  const MeshFacetArray& rFacets = mesh.GetFacets();
+  std::vector<int> hits(rFacets.size(), 0);
+  MeshPointAdjacency::ForEachRange(rFacets.size(), [&](std::size_t begin, std::size_t end) {
+    Base::Vector3f res;
+    for (std::size_t i = begin; i < end; i++)
+    {
+      MeshGeomFacet facet = mesh.GetFacet(rFacets[i]);
+      if (facet.Foraminate(point, dir, res) && (res - point) * dir > 0.0f)
+        hits[i] = 1;
+    }
+  });
+
+  return std::count(hits.begin(), hits.end(), 1) % 2 == 1;
+}
+}
+
 
 SetOperations::SetOperations (const MeshKernel &cutMesh1, const MeshKernel &cutMesh2, MeshKernel &result, OperationType opType, float minDistanceToPoint)
 : _cutMesh0(cutMesh1),
@@ -172,244 +251,201 @@ void SetOperations::Do ()
 
 void SetOperations::Cut (std::set<FacetIndex>& facetsCuttingEdge0, std::set<FacetIndex>& facetsCuttingEdge1)
 {
-  MeshFacetGrid grid1(_cutMesh0, 20);
-  MeshFacetGrid grid2(_cutMesh1, 20);
-
-  unsigned long ctGx1, ctGy1, ctGz1;
-  grid1.GetCtGrids(ctGx1, ctGy1, ctGz1);
+  // The pairs of facets with overlapping boxes are searched in several threads
+  // with a BVH of each mesh. The cut lines are computed in parallel and added
+  // in the order of the pairs, so that the result doesn't depend on the threads.
+  MeshFacetBVH bvh0(_cutMesh0);
+  MeshFacetBVH bvh1(_cutMesh1);
+  MeshFacetBVH::PairList pairs = bvh0.FindPairs(bvh1, [](FacetIndex, FacetIndex) {
+    return true;
+  });
 
-  unsigned long gx1;
-  for (gx1 = 0; gx1 < ctGx1; gx1++)  
-  {
-    unsigned long gy1;
-    for (gy1 = 0; gy1 < ctGy1; gy1++)
+  std::vector<std::pair<MeshPoint, MeshPoint> > cutLines(pairs.size());
+  std::vector<char> cuts(pairs.size(), 0);
+  MeshPointAdjacency::ForEachRange(pairs.size(), [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i++)
     {
-      unsigned long gz1;
-      for (gz1 = 0; gz1 < ctGz1; gz1++)
-      {
-        if (grid1.GetCtElements(gx1, gy1, gz1) > 0)
-        {
-          std::vector<FacetIndex> vecFacets2;
-          grid2.Inside(grid1.GetBoundBox(gx1, gy1, gz1), vecFacets2);
-      
-          if (vecFacets2.size() > 0)
-          {
-            std::set<FacetIndex> vecFacets1;
-            grid1.GetElements(gx1, gy1, gz1, vecFacets1);
-            
-            std::set<FacetIndex>::iterator it1;
-            for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1)
-            {
-              FacetIndex fidx1 = *it1;
-              MeshGeomFacet f1 = _cutMesh0.GetFacet(*it1);
-              
-              std::vector<FacetIndex>::iterator it2;
-              for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2)
-              {
-                FacetIndex fidx2 = *it2;
-                MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
-
-                MeshPoint p0, p1;
-
-                int isect = f1.IntersectWithFacet(f2, p0, p1);
-                if (isect > 0)
-                { 
-                   // optimize cut line if distance to nearest point is too small
-                  float minDist1 = _minDistanceToPoint, minDist2 = _minDistanceToPoint;
-                  MeshPoint np0 = p0, np1 = p1;
-                  int i;
-                  for (i = 0; i < 3; i++)
-                  {
-                    float d1 = (f1._aclPoints[i] - p0).Length();
-                    float d2 = (f1._aclPoints[i] - p1).Length();
-                    if (d1 < minDist1)
-                    {
-                      minDist1 = d1;
-                      np0 = f1._aclPoints[i];
-                    }
-                    if (d2 < minDist2)
-                    {
-                      minDist2 = d2;
-                      p1 = f1._aclPoints[i];
-                    }
-                  } // for (int i = 0; i < 3; i++)
-
-                  // optimize cut line if distance to nearest point is too small
-                  for (i = 0; i < 3; i++)
-                  {
-                    float d1 = (f2._aclPoints[i] - p0).Length();
-                    float d2 = (f2._aclPoints[i] - p1).Length();
-                    if (d1 < minDist1)
-                    {
-                      minDist1 = d1;
-                      np0 = f2._aclPoints[i];
-                    }
-                    if (d2 < minDist2)
-                    {
-                      minDist2 = d2;
-                      np1 = f2._aclPoints[i];
-                    }
-                  } // for (int i = 0; i < 3; i++)
-
-                  MeshPoint mp0 = np0;
-                  MeshPoint mp1 = np1;
-
-                  if (mp0 != mp1)
-                  {
-                    facetsCuttingEdge0.insert(fidx1);
-                    facetsCuttingEdge1.insert(fidx2);
-
-                    _cutPoints.insert(mp0);
-                    _cutPoints.insert(mp1);
-
-                    std::pair<std::set<MeshPoint>::iterator, bool> pit0 = _cutPoints.insert(mp0);
-                    std::pair<std::set<MeshPoint>::iterator, bool> pit1 = _cutPoints.insert(mp1);
-
-                    _edges[Edge(mp0, mp1)] = EdgeInfo();
-
-                    _facet2points[0][fidx1].push_back(pit0.first);
-                    _facet2points[0][fidx1].push_back(pit1.first);
-                    _facet2points[1][fidx2].push_back(pit0.first);
-                    _facet2points[1][fidx2].push_back(pit1.first);
-
-                  }
-                  else
-                  {
-                    std::pair<std::set<MeshPoint>::iterator, bool> pit = _cutPoints.insert(mp0);
-
-                    // do not insert a facet when only one corner point cuts the edge
-                    // if (!((mp0 == f1._aclPoints[0]) || (mp0 == f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
-                    {
-                      facetsCuttingEdge0.insert(fidx1);
-                      _facet2points[0][fidx1].push_back(pit.first);
-                    }
-
-                    // if (!((mp0 == f2._aclPoints[0]) || (mp0 == f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
-                    {
-                      facetsCuttingEdge1.insert(fidx2);
-                      _facet2points[1][fidx2].push_back(pit.first);
-                    }
-                  }
-
-                 } // if (f1.IntersectWithFacet(f2, p0, p1))
-              } // for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2)
-            } // for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1)
-          } // if (vecFacets2.size() > 0)
-        } // if (grid1.GetCtElements(gx1, gy1, gz1) > 0)
-      } // for (gz1 = 0; gz1 < ctGz1; gz1++)
-    } // for (gy1 = 0; gy1 < ctGy1; gy1++)
-  } // for (gx1 = 0; gx1 < ctGx1; gx1++)  
-}
+      MeshGeomFacet f1 = _cutMesh0.GetFacet(pairs[i].first);
+      MeshGeomFacet f2 = _cutMesh1.GetFacet(pairs[i].second);
+      cuts[i] = CutFacets(f1, f2, _minDistanceToPoint, cutLines[i].first, cutLines[i].second);
+    }
+  });
 
-void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
-{
-  // Triangulate Mesh 
-  std::map<FacetIndex, std::list<std::set<MeshPoint>::iterator> >::iterator it1;
-  for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1)
+  for (std::size_t i = 0; i < pairs.size(); i++)
   {
-    std::vector<Vector3f> points;
-    std::set<MeshPoint>   pointsSet;
+    if (!cuts[i])
+      continue;
 
-    FacetIndex fidx = it1->first;
-    MeshGeomFacet f = cutMesh.GetFacet(fidx);
+    FacetIndex fidx1 = pairs[i].first;
+    FacetIndex fidx2 = pairs[i].second;
+    const MeshPoint& mp0 = cutLines[i].first;
+    const MeshPoint& mp1 = cutLines[i].second;
 
-    //if (side == 1)
-    //    _builder.addSingleTriangle(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], 3, 0, 1, 1);
-
-     // facet corner points
-    //const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
-    int i;
-    for (i = 0; i < 3; i++)
+    if (mp0 != mp1)
     {
-      pointsSet.insert(f._aclPoints[i]);
-      points.push_back(f._aclPoints[i]);
+      facetsCuttingEdge0.insert(fidx1);
+      facetsCuttingEdge1.insert(fidx2);
+
+      std::pair<std::set<MeshPoint>::iterator, bool> pit0 = _cutPoints.insert(mp0);
+      std::pair<std::set<MeshPoint>::iterator, bool> pit1 = _cutPoints.insert(mp1);
+
+      _edges[Edge(mp0, mp1)] = EdgeInfo();
+
+      _facet2points[0][fidx1].push_back(pit0.first);
+      _facet2points[0][fidx1].push_back(pit1.first);
+      _facet2points[1][fidx2].push_back(pit0.first);
+      _facet2points[1][fidx2].push_back(pit1.first);
     }
-    
-    // triangulated facets
-    std::list<std::set<MeshPoint>::iterator>::iterator it2;
-    for (it2 = it1->second.begin(); it2 != it1->second.end(); ++it2)
+    else
     {
-      if (pointsSet.find(*(*it2)) == pointsSet.end())
+      std::pair<std::set<MeshPoint>::iterator, bool> pit = _cutPoints.insert(mp0);
+
+      // do not insert a facet when only one corner point cuts the edge
+      // if (!((mp0 == f1._aclPoints[0]) || (mp0 == f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
       {
-        pointsSet.insert(*(*it2));
-        points.push_back(*(*it2));
+        facetsCuttingEdge0.insert(fidx1);
+        _facet2points[0][fidx1].push_back(pit.first);
       }
 
+      // if (!((mp0 == f2._aclPoints[0]) || (mp0 == f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
+      {
+        facetsCuttingEdge1.insert(fidx2);
+        _facet2points[1][fidx2].push_back(pit.first);
+      }
     }
+  }
+}
 
-    Vector3f normal = f.GetNormal();
-    Vector3f base = points[0];
-    Vector3f dirX = points[1] - points[0];
-    dirX.Normalize();
-    Vector3f dirY = dirX % normal;
-
-    // project points to 2D plane
-    std::vector<Vector3f>::iterator it;
-    std::vector<Vector3f> vertices;
-    for (it = points.begin(); it != points.end(); ++it)
+void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
+{
+  // Triangulate Mesh, the facets are triangulated in parallel and afterwards
+  // the new facets are assigned to the cut edges in the order of the facets
+  typedef std::map<FacetIndex, std::list<std::set<MeshPoint>::iterator> >::iterator FacetPointsIterator;
+  std::vector<FacetPointsIterator> cutFacets;
+  for (FacetPointsIterator it = _facet2points[side].begin(); it != _facet2points[side].end(); ++it)
+    cutFacets.push_back(it);
+
+  std::vector<std::vector<MeshGeomFacet> > triangulations(cutFacets.size());
+  MeshPointAdjacency::ForEachRange(cutFacets.size(), [&](std::size_t begin, std::size_t end) {
+    for (std::size_t index = begin; index < end; index++)
     {
-      Vector3f pv = *it;
-      pv.TransformToCoordinateSystem(base, dirX, dirY);
-      vertices.push_back(pv);
-    }
+      FacetPointsIterator it1 = cutFacets[index];
+      std::vector<MeshGeomFacet>& newFacets = triangulations[index];
+      std::vector<Vector3f> points;
+      std::set<MeshPoint>   pointsSet;
 
-    DelaunayTriangulator tria;
-    tria.SetPolygon(vertices);
-    tria.TriangulatePolygon();
-
-    std::vector<MeshFacet> facets = tria.GetFacets();
-    for (std::vector<MeshFacet>::iterator it = facets.begin(); it != facets.end(); ++it)
-    {
-      if ((it->_aulPoints[0] == it->_aulPoints[1]) ||
-          (it->_aulPoints[1] == it->_aulPoints[2]) ||
-          (it->_aulPoints[2] == it->_aulPoints[0]))
-      { // two same triangle corner points
-        continue;
-      }
-  
-      MeshGeomFacet facet(points[it->_aulPoints[0]],
-                          points[it->_aulPoints[1]],
-                          points[it->_aulPoints[2]]);
+      FacetIndex fidx = it1->first;
+      MeshGeomFacet f = cutMesh.GetFacet(fidx);
 
       //if (side == 1)
-      // _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1], facet._aclPoints[2], true, 3, 0, 1, 1);
-
-      //if (facet.Area() < 0.0001f)
-      //{ // too small facet
-      //  continue;
-      //}
-
-      float dist0 = facet._aclPoints[0].DistanceToLine
-          (facet._aclPoints[1],facet._aclPoints[1] - facet._aclPoints[2]);
-      float dist1 = facet._aclPoints[1].DistanceToLine
-          (facet._aclPoints[0],facet._aclPoints[0] - facet._aclPoints[2]);
-      float dist2 = facet._aclPoints[2].DistanceToLine
-          (facet._aclPoints[0],facet._aclPoints[0] - facet._aclPoints[1]);
-
-      if ((dist0 < _minDistanceToPoint) ||
-          (dist1 < _minDistanceToPoint) ||
-          (dist2 < _minDistanceToPoint))
+      //    _builder.addSingleTriangle(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], 3, 0, 1, 1);
+
+       // facet corner points
+      //const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
+      int i;
+      for (i = 0; i < 3; i++)
       {
-        continue;
+        pointsSet.insert(f._aclPoints[i]);
+        points.push_back(f._aclPoints[i]);
       }
+    
+      // triangulated facets
+      std::list<std::set<MeshPoint>::iterator>::iterator it2;
+      for (it2 = it1->second.begin(); it2 != it1->second.end(); ++it2)
+      {
+        if (pointsSet.find(*(*it2)) == pointsSet.end())
+        {
+          pointsSet.insert(*(*it2));
+          points.push_back(*(*it2));
+        }
 
-      //dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
-      //dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
-      //dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+      }
 
-      //if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 < _minDistanceToPoint))
-      //{
-      //  continue;
-      //}
+      Vector3f normal = f.GetNormal();
+      Vector3f base = points[0];
+      Vector3f dirX = points[1] - points[0];
+      dirX.Normalize();
+      Vector3f dirY = dirX % normal;
 
-      facet.CalcNormal();
-      if ((facet.GetNormal() * f.GetNormal()) < 0.0f)
-      { // adjust normal
-         std::swap(facet._aclPoints[0], facet._aclPoints[1]);
-         facet.CalcNormal();
+      // project points to 2D plane
+      std::vector<Vector3f>::iterator it;
+      std::vector<Vector3f> vertices;
+      for (it = points.begin(); it != points.end(); ++it)
+      {
+        Vector3f pv = *it;
+        pv.TransformToCoordinateSystem(base, dirX, dirY);
+        vertices.push_back(pv);
       }
 
+      DelaunayTriangulator tria;
+      tria.SetPolygon(vertices);
+      tria.TriangulatePolygon();
 
+      std::vector<MeshFacet> facets = tria.GetFacets();
+      for (std::vector<MeshFacet>::iterator it = facets.begin(); it != facets.end(); ++it)
+      {
+        if ((it->_aulPoints[0] == it->_aulPoints[1]) ||
+            (it->_aulPoints[1] == it->_aulPoints[2]) ||
+            (it->_aulPoints[2] == it->_aulPoints[0]))
+        { // two same triangle corner points
+          continue;
+        }
+  
+        MeshGeomFacet facet(points[it->_aulPoints[0]],
+                            points[it->_aulPoints[1]],
+                            points[it->_aulPoints[2]]);
+
+        //if (side == 1)
+        // _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1], facet._aclPoints[2], true, 3, 0, 1, 1);
+
+        //if (facet.Area() < 0.0001f)
+        //{ // too small facet
+        //  continue;
+        //}
+
+        float dist0 = facet._aclPoints[0].DistanceToLine
+            (facet._aclPoints[1],facet._aclPoints[1] - facet._aclPoints[2]);
+        float dist1 = facet._aclPoints[1].DistanceToLine
+            (facet._aclPoints[0],facet._aclPoints[0] - facet._aclPoints[2]);
+        float dist2 = facet._aclPoints[2].DistanceToLine
+            (facet._aclPoints[0],facet._aclPoints[0] - facet._aclPoints[1]);
+
+        if ((dist0 < _minDistanceToPoint) ||
+            (dist1 < _minDistanceToPoint) ||
+            (dist2 < _minDistanceToPoint))
+        {
+          continue;
+        }
+
+        //dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
+        //dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
+        //dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+
+        //if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 < _minDistanceToPoint))
+        //{
+        //  continue;
+        //}
+
+        facet.CalcNormal();
+        if ((facet.GetNormal() * f.GetNormal()) < 0.0f)
+        { // adjust normal
+           std::swap(facet._aclPoints[0], facet._aclPoints[1]);
+           facet.CalcNormal();
+        }
+
+
+        newFacets.push_back(facet);
+      } // for (std::vector<MeshFacet>::iterator it = facets.begin(); it != facets.end(); ++it)
+    }
+  });
+
+  for (std::size_t index = 0; index < cutFacets.size(); index++)
+  {
+    FacetIndex fidx = cutFacets[index]->first;
+    std::vector<MeshGeomFacet>& newFacets = triangulations[index];
+    for (std::vector<MeshGeomFacet>::iterator it = newFacets.begin(); it != newFacets.end(); ++it)
+    {
+      MeshGeomFacet& facet = *it;
       int j;
       for (j = 0; j < 3; j++)
       {
@@ -433,9 +469,8 @@ void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
       }
 
       _newMeshFacets[side].push_back(facet);
-
-    } // for (i = 0; i < (out->numberoftriangles * 3); i += 3)
-  } // for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1)
+    }
+  }
 }
 
 void SetOperations::CollectFacets (int side, float mult)
@@ -472,8 +507,16 @@ void SetOperations::CollectFacets (int side, float mult)
       facets.push_back(itf - rFacets.begin()); // add seed facet
       CollectFacetVisitor visitor(mesh, facets, _edges, side, mult, _builder); 
       mesh.VisitNeighbourFacets(visitor, itf - rFacets.begin());
-      
-      if (visitor._addFacets == 0)
+
+      int addFacets = visitor._addFacets;
+      if (addFacets == -1 && mult != 0.0f)
+      { // the region doesn't touch the cut line, so check if it lies inside the other mesh
+        const MeshKernel& other = (side == 0) ? _cutMesh1 : _cutMesh0;
+        bool inside = IsPointInside(other, mesh.GetFacet(*itf).GetGravityPoint());
+        addFacets = ((mult > 0.0f) == inside) ? 0 : 1;
+      }
+
+      if (addFacets == 0)
       { // mark all facets to add it to the result
         algo.SetFacetsFlag(facets, MeshFacet::TMP0);
       }
@@ -9,6 +9,9 @@
 // * Comment out printf statements
 // * Fix compiler warnings
 // * Remove macros loop,i,j,k
+// * Add locked vertices that are never moved, used to simplify parts of a mesh in parallel
+// * Add optional per-vertex attributes that are interpolated along collapsed edges
+// * Make compacting the mesh at the end optional
 
 #include <vector>
 #include <Base/Vector3D.h>
@@ -84,13 +87,16 @@ class Simplify
 {
 public:
     struct Triangle { int v[3];double err[4];int deleted,dirty;vec3f n; };
-    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;};
+    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;int locked=0;};
     struct Ref { int tid,tvertex; }; 
     std::vector<Triangle> triangles;
     std::vector<Vertex> vertices;
     std::vector<Ref> refs;
+    // attribute_count values per vertex
+    std::vector<float> attributes;
+    int attribute_count=0;
 
-    void simplify_mesh(int target_count, double tolerance, double aggressiveness=7);
+    void simplify_mesh(int target_count, double tolerance, double aggressiveness=7, bool compact=true);
 
 private:
     // Helper functions
@@ -100,6 +106,7 @@ private:
     bool flipped(vec3f p,int i0,int i1,Vertex &v0,Vertex &v1,std::vector<int> &deleted);
     void update_triangles(int i0,Vertex &v,std::vector<int> &deleted,int &deleted_triangles);
     void update_mesh(int iteration);
+    void interpolate_attributes(int i0, int i1, const vec3f& p);
     void compact_mesh();
 };
 
@@ -116,7 +123,7 @@ private:
 // the tolerance the algorithm will stop at this point. The number of the
 // remaining triangles usually will be higher than \a target_count
 //
-void Simplify::simplify_mesh(int target_count, double tolerance, double aggressiveness)
+void Simplify::simplify_mesh(int target_count, double tolerance, double aggressiveness, bool compact)
 {
     // init
     //printf("%s - start\n",__FUNCTION__);
@@ -197,6 +204,8 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
                     // Border check
                     if (v0.border != v1.border)
                         continue;
+                    if (v0.locked || v1.locked)
+                        continue;
 
                     // Compute vertex to collapse to
                     vec3f p;
@@ -212,6 +221,7 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
                         continue;
 
                     // not flipped, so remove edge
+                    interpolate_attributes(i0,i1,p);
                     v0.p=p;
                     v0.q=v1.q+v0.q;
                     int tstart=refs.size();
@@ -245,7 +255,8 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
     }
 
     // clean up mesh
-    compact_mesh();
+    if (compact)
+        compact_mesh();
 
     // ready
     //int timeEnd=timeGetTime();
@@ -480,6 +491,8 @@ void Simplify::compact_mesh()
         {
             vertices[i].tstart=dst;
             vertices[dst].p=vertices[i].p;
+            for (int k=0;k<attribute_count;++k)
+                attributes[dst*attribute_count+k]=attributes[i*attribute_count+k];
             dst++;
         }
     }
@@ -490,6 +503,24 @@ void Simplify::compact_mesh()
             t.v[j]=vertices[t.v[j]].tstart;
     }
     vertices.resize(dst);
+    attributes.resize(dst*attribute_count);
+}
+
+// Move the attributes of the first vertex to the collapsed position
+// on the edge
+
+void Simplify::interpolate_attributes(int i0, int i1, const vec3f& p)
+{
+    if (attribute_count<=0)
+        return;
+    vec3f d=vertices[i1].p-vertices[i0].p;
+    float len=d.Sqr();
+    float t=len>0 ? (p-vertices[i0].p).Dot(d)/len : 0.0f;
+    t=std::max(0.0f,std::min(1.0f,t));
+    float *a0=&attributes[i0*attribute_count];
+    const float *a1=&attributes[i1*attribute_count];
+    for (int k=0;k<attribute_count;++k)
+        a0[k]+=t*(a1[k]-a0[k]);
 }
 
 // Error between vertex and Quadric
@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 #endif
 
 #include "Smoothing.h"
@@ -54,6 +55,91 @@ void AbstractSmoothing::initialize(Component comp, Continuity cont)
     this->continuity = cont;
 }
 
+namespace {
+/*
+ * Computes the new positions of the points from the current positions in
+ * parallel and then moves them. If \a indices is null all points are moved.
+ */
+template <typename Func>
+void moveAllPoints(MeshKernel& kernel, const std::vector<PointIndex>* indices, Func compute)
+{
+    std::size_t count = indices ? indices->size() : kernel.CountPoints();
+    std::vector<Base::Vector3f> result(count);
+    MeshPointAdjacency::ForEachRange(count, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            result[i] = compute(indices ? (*indices)[i] : static_cast<PointIndex>(i));
+    });
+
+    for (std::size_t i = 0; i < count; i++)
+        kernel.SetPoint(indices ? (*indices)[i] : static_cast<PointIndex>(i), result[i]);
+}
+
+Base::Vector3f planeFitPoint(const MeshPointArray& points, const MeshPointAdjacency& adjacency,
+                             PointIndex pos, float tolerance)
+{
+    const Base::Vector3f& pnt = points[pos];
+    MeshPointAdjacency::Range<PointIndex> cv = adjacency.GetPoints(pos);
+    if (cv.size() < 3)
+        return pnt;
+
+    MeshCore::PlaneFit pf;
+    pf.AddPoint(pnt);
+    Base::Vector3f center = pnt;
+    for (PointIndex it : cv) {
+        pf.AddPoint(points[it]);
+        center += points[it];
+    }
+
+    float scale = 1.0f/(static_cast<float>(cv.size())+1.0f);
+    center.Scale(scale,scale,scale);
+
+    // get the mean plane of the current vertex with the surrounding vertices
+    pf.Fit();
+    Base::Vector3f N = pf.GetNormal();
+    N.Normalize();
+
+    // look in which direction we should move the vertex
+    Base::Vector3f L = pnt - center;
+    if (N*L < 0.0f)
+        N.Scale(-1.0, -1.0, -1.0);
+
+    // maximum value to move is distance to mean plane
+    float d = std::min<float>(fabs(tolerance),fabs(N*L));
+    N.Scale(d,d,d);
+
+    return pnt - N;
+}
+
+Base::Vector3f umbrellaPoint(const MeshPointArray& points, const MeshPointAdjacency& adjacency,
+                             PointIndex pos, double stepsize)
+{
+    const Base::Vector3f& pnt = points[pos];
+    MeshPointAdjacency::Range<PointIndex> cv = adjacency.GetPoints(pos);
+    if (cv.size() < 3)
+        return pnt;
+    if (adjacency.IsBorder(pos)) {
+        // do nothing for border points
+        return pnt;
+    }
+
+    size_t n_count = cv.size();
+    double w;
+    w=1.0/double(n_count);
+
+    double delx=0.0,dely=0.0,delz=0.0;
+    for (PointIndex it : cv) {
+        delx += w*static_cast<double>(points[it].x-pnt.x);
+        dely += w*static_cast<double>(points[it].y-pnt.y);
+        delz += w*static_cast<double>(points[it].z-pnt.z);
+    }
+
+    float x = static_cast<float>(static_cast<double>(pnt.x)+stepsize*delx);
+    float y = static_cast<float>(static_cast<double>(pnt.y)+stepsize*dely);
+    float z = static_cast<float>(static_cast<double>(pnt.z)+stepsize*delz);
+    return Base::Vector3f(x,y,z);
+}
+}
+
 PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
   : AbstractSmoothing(m)
 {
@@ -65,108 +151,25 @@ PlaneFitSmoothing::~PlaneFitSmoothing()
 
 void PlaneFitSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    MeshCore::MeshPointAdjacency adjacency(kernel);
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
 
     for (unsigned int i=0; i<iterations; i++) {
-        Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3)
-                continue;
-
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
-
-            float scale = 1.0f/(static_cast<float>(cv.size())+1.0f);
-            center.Scale(scale,scale,scale);
-
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
-
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N*L < 0.0f)
-                N.Scale(-1.0, -1.0, -1.0);
-
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(fabs(this->tolerance),fabs(N*L));
-            N.Scale(d,d,d);
-
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
-
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
+        moveAllPoints(kernel, nullptr, [&](PointIndex pos) {
+            return planeFitPoint(points, adjacency, pos, this->tolerance);
+        });
     }
 }
 
 void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    MeshCore::MeshPointAdjacency adjacency(kernel);
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
 
     for (unsigned int i=0; i<iterations; i++) {
-        Base::Vector3f N, L;
-        for (std::vector<PointIndex>::const_iterator it = point_indices.begin(); it != point_indices.end(); ++it) {
-            v_it.Set(*it);
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3)
-                continue;
-
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
-
-            float scale = 1.0f/(static_cast<float>(cv.size())+1.0f);
-            center.Scale(scale,scale,scale);
-
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
-
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N*L < 0.0f)
-                N.Scale(-1.0, -1.0, -1.0);
-
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(fabs(this->tolerance),fabs(N*L));
-            N.Scale(d,d,d);
-
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
-
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
+        moveAllPoints(kernel, &point_indices, [&](PointIndex pos) {
+            return planeFitPoint(points, adjacency, pos, this->tolerance);
+        });
     }
 }
 
@@ -179,94 +182,38 @@ LaplaceSmoothing::~LaplaceSmoothing()
 {
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize)
+void LaplaceSmoothing::Umbrella(const MeshPointAdjacency& adjacency, double stepsize)
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it,
-    v_beg = points.begin(), v_end = points.end();
-
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it,++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-v_it->x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-v_it->y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-v_it->z);
-        }
-
-        float x = static_cast<float>(static_cast<double>(v_it->x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z)+stepsize*delz);
-        kernel.SetPoint(pos,x,y,z);
-    }
+    moveAllPoints(kernel, nullptr, [&](PointIndex pos) {
+        return umbrellaPoint(points, adjacency, pos, stepsize);
+    });
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize,
+void LaplaceSmoothing::Umbrella(const MeshPointAdjacency& adjacency, double stepsize,
                                 const std::vector<PointIndex>& point_indices)
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
-
-    for (std::vector<PointIndex>::const_iterator pos = point_indices.begin(); pos != point_indices.end(); ++pos) {
-        const std::set<PointIndex>& cv = vv_it[*pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[*pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-(v_beg[*pos]).x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-(v_beg[*pos]).y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-(v_beg[*pos]).z);
-        }
-
-        float x = static_cast<float>(static_cast<double>((v_beg[*pos]).x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[*pos]).y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[*pos]).z)+stepsize*delz);
-        kernel.SetPoint(*pos,x,y,z);
-    }
+    moveAllPoints(kernel, &point_indices, [&](PointIndex pos) {
+        return umbrellaPoint(points, adjacency, pos, stepsize);
+    });
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshPointAdjacency adjacency(kernel);
 
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
+        Umbrella(adjacency, lambda);
     }
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshPointAdjacency adjacency(kernel);
 
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
+        Umbrella(adjacency, lambda, point_indices);
     }
 }
 
@@ -281,26 +228,24 @@ TaubinSmoothing::~TaubinSmoothing()
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshPointAdjacency adjacency(kernel);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-        Umbrella(vv_it, vf_it, -(lambda+micro));
+        Umbrella(adjacency, lambda);
+        Umbrella(adjacency, -(lambda+micro));
     }
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshPointAdjacency adjacency(kernel);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-        Umbrella(vv_it, vf_it, -(lambda+micro), point_indices);
+        Umbrella(adjacency, lambda, point_indices);
+        Umbrella(adjacency, -(lambda+micro), point_indices);
     }
 }
@@ -30,10 +30,13 @@
 namespace MeshCore
 {
 class MeshKernel;
-class MeshRefPointToPoints;
-class MeshRefPointToFacets;
+class MeshPointAdjacency;
 
-/** Base class for smoothing algorithms. */
+/** Base class for smoothing algorithms.
+ * All points are moved at once based on the positions of the previous
+ * iteration (Jacobi style) in parallel, so the result doesn't depend on the
+ * order of the points or the number of threads.
+ */
 class MeshExport AbstractSmoothing
 {
 public:
@@ -84,10 +87,8 @@ public:
     void SetLambda(double l) { lambda = l;}
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double,
+    void Umbrella(const MeshPointAdjacency&, double);
+    void Umbrella(const MeshPointAdjacency&, double,
                   const std::vector<PointIndex>&);
 
 protected:
@@ -359,7 +359,12 @@ void MeshObject::getFaces(std::vector<Base::Vector3d> &Points,std::vector<Facet>
 
 unsigned int MeshObject::getMemSize () const
 {
-    return _kernel.GetMemSize();
+    // the kernel and the facet indices of the segments
+    std::uint64_t size = _kernel.GetMemSize();
+    size += _segments.capacity() * sizeof(Segment);
+    for (const auto& segm : _segments)
+        size += segm.getIndices().capacity() * sizeof(FacetIndex);
+    return clampMemSize(size);
 }
 
 void MeshObject::Save (Base::Writer &/*writer*/) const
@@ -1912,7 +1917,8 @@ MeshObject* MeshObject::meshFromSegment(const std::vector<FacetIndex>& indices)
 }
 
 std::vector<Segment> MeshObject::getSegmentsOfType(MeshObject::GeometryType type,
-                                                   float dev, unsigned long minFacets) const
+                                                   float dev, unsigned long minFacets,
+                                                   bool parallel) const
 {
     std::vector<Segment> segm;
     if (this->_kernel.CountFacets() == 0)
@@ -1941,7 +1947,10 @@ std::vector<Segment> MeshObject::getSegmentsOfType(MeshObject::GeometryType type
     if (surf.get()) {
         std::vector<MeshCore::MeshSurfaceSegmentPtr> surfaces;
         surfaces.push_back(surf);
-        finder.FindSegments(surfaces);
+        if (parallel)
+            finder.FindSegmentsParallel(surfaces);
+        else
+            finder.FindSegments(surfaces);
 
         const std::vector<MeshCore::MeshSegment>& data = surf->GetSegments();
         for (std::vector<MeshCore::MeshSegment>::const_iterator it = data.begin(); it != data.end(); ++it) {
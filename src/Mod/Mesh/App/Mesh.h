@@ -325,7 +325,8 @@ public:
     const Segment& getSegment(unsigned long) const;
     Segment& getSegment(unsigned long);
     MeshObject* meshFromSegment(const std::vector<FacetIndex>&) const;
-    std::vector<Segment> getSegmentsOfType(GeometryType, float dev, unsigned long minFacets) const;
+    std::vector<Segment> getSegmentsOfType(GeometryType, float dev, unsigned long minFacets,
+                                           bool parallel = false) const;
     //@}
 
     /** @name Primitives */
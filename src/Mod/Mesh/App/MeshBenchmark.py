@@ -0,0 +1,187 @@
+# -*- coding: utf-8 -*-
+
+#  Copyright (c) 2021 FreeCAD Developers
+#  LGPL
+
+# Benchmarks of the mesh algorithms, run them from the FreeCAD Python console
+# or with FreeCADCmd:
+# import MeshBenchmark
+# MeshBenchmark.run_self_intersection(200)
+# MeshBenchmark.run_decimate(10000000, 1000000)
+# MeshBenchmark.run_smoothing(1000)
+# MeshBenchmark.run_curvature(1000)
+# MeshBenchmark.run_boolean(700)
+# MeshBenchmark.run_segmentation(700)
+# MeshBenchmark.run_persistence(1000, 5000000)
+
+import math
+import os
+import tempfile
+import time
+import FreeCAD
+import Mesh
+
+
+def best_of(func, repeat):
+    best = None
+    result = None
+    for r in range(repeat):
+        start = time.time()
+        result = func()
+        elapsed = time.time() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best, result
+
+
+def make_intersecting_spheres(sampling):
+    # two overlapping spheres with 2 * sampling * sampling facets each
+    mesh = Mesh.createSphere(1.0, sampling)
+    other = Mesh.createSphere(1.0, sampling)
+    other.translate(0.5, 0.3, 0.1)
+    mesh.addMesh(other)
+    return mesh
+
+
+def run_self_intersection(sampling=200, repeat=3):
+    mesh = make_intersecting_spheres(sampling)
+    print("self-intersection: {} facets".format(mesh.CountFacets))
+
+    for name, grid in (("bvh", False), ("grid", True)):
+        best, pairs = best_of(lambda: mesh.getSelfIntersections(grid), repeat)
+        unique = len(set((i[0], i[1]) for i in pairs))
+        print("  {}: {} pairs, best of {}: {:.3f} s ({:.0f} pairs/s, {:.0f} facets/s)".format(
+            name, unique, repeat, best,
+            unique / best if best > 0 else 0.0,
+            mesh.CountFacets / best if best > 0 else 0.0))
+
+
+def run_decimate(count=10000000, target=1000000, repeat=1):
+    # a sphere has about 2 * sampling * sampling facets
+    sampling = int(math.sqrt(count / 2.0))
+    mesh = Mesh.createSphere(1.0, sampling)
+    print("decimation: {} facets to {}".format(mesh.CountFacets, target))
+
+    def decimate():
+        copy = mesh.copy()
+        start = time.time()
+        copy.decimate(target)
+        return time.time() - start, copy
+
+    best = None
+    result = None
+    for r in range(repeat):
+        elapsed, result = decimate()
+        best = elapsed if best is None else min(best, elapsed)
+    dist = max(abs(p.Vector.Length - 1.0) for p in result.Points)
+    print("  best of {}: {:.3f} s ({:.0f} facets/s), {} facets, solid: {}, max. deviation {:.6f}".format(
+        repeat, best, mesh.CountFacets / best if best > 0 else 0.0,
+        result.CountFacets, result.isSolid(), dist))
+
+
+def run_smoothing(sampling=1000, iterations=10, repeat=1):
+    mesh = Mesh.createSphere(1.0, sampling)
+    print("smoothing: {} points, {} iterations".format(mesh.CountPoints, iterations))
+
+    for method in ("Laplace", "Taubin", "PlaneFit"):
+        def smooth():
+            copy = mesh.copy()
+            start = time.time()
+            copy.smooth(Method=method, Iteration=iterations)
+            return time.time() - start
+
+        best = min(smooth() for r in range(repeat))
+        print("  {}: best of {}: {:.3f} s ({:.0f} points/s)".format(
+            method, repeat, best,
+            mesh.CountPoints * iterations / best if best > 0 else 0.0))
+
+
+def run_curvature(sampling=1000, repeat=3):
+    mesh = Mesh.createSphere(1.0, sampling)
+    print("curvature: {} points".format(mesh.CountPoints))
+
+    best, curv = best_of(mesh.getCurvaturePerVertex, repeat)
+    dev = max(max(abs(c[0] - 1.0), abs(c[1] - 1.0)) for c in curv)
+    print("  best of {}: {:.3f} s ({:.0f} points/s), max. deviation {:.6f}".format(
+        repeat, best, mesh.CountPoints / best if best > 0 else 0.0, dev))
+
+
+def run_boolean(sampling=700, repeat=1):
+    # two overlapping spheres with 2 * sampling * sampling facets each
+    mesh1 = Mesh.createSphere(1.0, sampling)
+    mesh2 = Mesh.createSphere(1.0, sampling)
+    mesh2.translate(0.5, 0.3, 0.1)
+    print("boolean: {} and {} facets".format(mesh1.CountFacets, mesh2.CountFacets))
+
+    for name in ("unite", "intersect", "difference"):
+        func = getattr(mesh1, name)
+        best, result = best_of(lambda: func(mesh2), repeat)
+        print("  {}: best of {}: {:.3f} s ({:.0f} facets/s), {} facets, volume {:.6f}".format(
+            name, repeat, best,
+            (mesh1.CountFacets + mesh2.CountFacets) / best if best > 0 else 0.0,
+            result.CountFacets, result.Volume))
+
+
+def run_segmentation(sampling=700, repeat=1):
+    # a sphere and a closed cylinder with about 2 * sampling * sampling facets each
+    mesh = Mesh.createSphere(1.0, sampling)
+    cylinder = Mesh.createCylinder(1.0, 4.0, True, 4.0 / sampling, sampling)
+    cylinder.translate(3.0, 0.0, 0.0)
+    mesh.addMesh(cylinder)
+    print("segmentation: {} facets".format(mesh.CountFacets))
+
+    func = [(1.0, 1.0, 0.1, 0.1, 100), (1.0, 0.0, 0.1, 0.1, 100), (0.0, 0.0, 0.1, 0.1, 100)]
+    for parallel in (False, True):
+        best, segm = best_of(lambda: mesh.getSegmentsByCurvature(func, parallel), repeat)
+        print("  curvature, parallel={}: best of {}: {:.3f} s ({:.0f} facets/s), {} segments".format(
+            parallel, repeat, best, mesh.CountFacets / best if best > 0 else 0.0, len(segm)))
+
+    for name in ("Plane", "Cylinder", "Sphere"):
+        for parallel in (False, True):
+            best, segm = best_of(lambda: mesh.getSegmentsOfType(name, 0.01, 100, parallel), repeat)
+            print("  {}, parallel={}: best of {}: {:.3f} s ({:.0f} facets/s), {} segments".format(
+                name, parallel, repeat, best, mesh.CountFacets / best if best > 0 else 0.0, len(segm)))
+
+
+def run_persistence(sampling=1000, count=5000000, repeat=3):
+    # saves and restores a document with a mesh of 2 * sampling * sampling
+    # facets and a float and a vector list property with count entries each
+    doc = FreeCAD.newDocument("MeshBenchmark")
+    mesh = doc.addObject("Mesh::Feature", "Mesh")
+    mesh.Mesh = Mesh.createSphere(1.0, sampling)
+    lists = doc.addObject("App::FeaturePython", "Lists")
+    lists.addProperty("App::PropertyFloatList", "Floats")
+    lists.addProperty("App::PropertyVectorList", "Vectors")
+    lists.Floats = [0.5 * i for i in range(count)]
+    lists.Vectors = [FreeCAD.Vector(i, 0.5 * i, 0.25 * i) for i in range(count)]
+
+    # the number of bytes of the binary data
+    size = 4 * 3 * mesh.Mesh.CountPoints + 4 * 6 * mesh.Mesh.CountFacets + 8 * count + 8 * 3 * count
+    print("persistence: {} facets, {} floats, {} vectors, {:.1f} MB".format(
+        mesh.Mesh.CountFacets, count, count, size / 1e6))
+
+    path = os.path.join(tempfile.gettempdir(), "MeshBenchmark.FCStd")
+    doc.saveAs(path)
+    best, result = best_of(doc.save, repeat)
+    print("  save: best of {}: {:.3f} s ({:.1f} MB/s)".format(
+        repeat, best, size / best / 1e6 if best > 0 else 0.0))
+    FreeCAD.closeDocument(doc.Name)
+
+    def load():
+        doc = FreeCAD.openDocument(path)
+        name = doc.Name
+        FreeCAD.closeDocument(name)
+    best, result = best_of(load, repeat)
+    print("  load: best of {}: {:.3f} s ({:.1f} MB/s)".format(
+        repeat, best, size / best / 1e6 if best > 0 else 0.0))
+
+    # the time to only write the same amount of data to a file for comparison
+    data = bytes(size)
+    raw = path + ".raw"
+    def write():
+        with open(raw, "wb") as f:
+            f.write(data)
+    best, result = best_of(write, repeat)
+    print("  raw write: best of {}: {:.3f} s ({:.1f} MB/s)".format(
+        repeat, best, size / best / 1e6 if best > 0 else 0.0))
+    os.remove(raw)
+    os.remove(path)
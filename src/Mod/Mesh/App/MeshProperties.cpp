@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 #endif
 
 #include <CXX/Objects.hxx>
@@ -452,34 +453,37 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
     Base::Reference<MeshObject> tmp(_meshObject);
     aboutToSetValue();
     _meshObject = mesh;
+    _shareToken.reset();
+    if (meshPyObject)
+        meshPyObject->setTwinPointer(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
     aboutToSetValue();
-    *_meshObject = mesh;
+    *unshareMesh(false) = mesh;
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
-    _meshObject->setKernel(mesh);
+    unshareMesh(false)->setKernel(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
     aboutToSetValue();
-    _meshObject->swap(mesh);
+    unshareMesh(true)->swap(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
-    _meshObject->swap(mesh);
+    unshareMesh(true)->swap(mesh);
     hasSetValue();
 }
 
@@ -514,7 +518,7 @@ unsigned int PropertyMeshKernel::getMemSize (void) const
 MeshObject* PropertyMeshKernel::startEditing()
 {
     aboutToSetValue();
-    return (MeshObject*)_meshObject;
+    return unshareMesh(true);
 }
 
 void PropertyMeshKernel::finishEditing()
@@ -525,14 +529,19 @@ void PropertyMeshKernel::finishEditing()
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     aboutToSetValue();
-    _meshObject->transformGeometry(rclMat);
+    unshareMesh(true)->transformGeometry(rclMat);
     hasSetValue();
 }
 
+void PropertyMeshKernel::setTransform(const Base::Matrix4D &rclTrf)
+{
+    unshareMesh(true)->setTransform(rclTrf);
+}
+
 void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<PointIndex, Base::Vector3f> >& inds)
 {
     aboutToSetValue();
-    MeshCore::MeshKernel& kernel = _meshObject->getKernel();
+    MeshCore::MeshKernel& kernel = unshareMesh(true)->getKernel();
     for (std::vector<std::pair<PointIndex, Base::Vector3f> >::const_iterator it = inds.begin(); it != inds.end(); ++it)
         kernel.SetPoint(it->first, it->second);
     hasSetValue();
@@ -603,7 +612,7 @@ void PropertyMeshKernel::Restore(Base::XMLReader &reader)
         kernel.Adopt(points, facets);
 
         aboutToSetValue();
-        _meshObject->getKernel().Adopt(points, facets);
+        unshareMesh(false)->getKernel().Adopt(points, facets);
         hasSetValue();
     } 
     else {
@@ -620,7 +629,7 @@ void PropertyMeshKernel::SaveDocFile (Base::Writer &writer) const
 void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
 {
     aboutToSetValue();
-    _meshObject->load(reader);
+    unshareMesh(false)->load(reader);
     hasSetValue();
 }
 
@@ -632,11 +641,60 @@ App::Property *PropertyMeshKernel::Copy(void) const
     return prop;
 }
 
+App::Property *PropertyMeshKernel::copyForUndo(void) const
+{
+    // Note: The copy references the same mesh object until one of them is modified
+    PropertyMeshKernel *prop = new PropertyMeshKernel();
+    prop->shareMesh(*this);
+    return prop;
+}
+
 void PropertyMeshKernel::Paste(const App::Property &from)
 {
-    // Note: Copy the content, do NOT reference the same mesh object
     aboutToSetValue();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
-    *(this->_meshObject) = *(prop._meshObject);
+    shareMesh(prop);
     hasSetValue();
 }
+
+unsigned int PropertyMeshKernel::getUndoMemSize (void) const
+{
+    // a shared mesh is divided between the properties referencing it
+    long count = std::max<long>(1, _shareToken.use_count());
+    return getMemSize() / static_cast<unsigned int>(count);
+}
+
+bool PropertyMeshKernel::isShared() const
+{
+    return _shareToken.use_count() > 1;
+}
+
+MeshObject* PropertyMeshKernel::unshareMesh(bool keepData)
+{
+    if (isShared()) {
+        MeshObject* mesh;
+        if (keepData) {
+            mesh = new MeshObject(*_meshObject);
+        }
+        else {
+            mesh = new MeshObject();
+            mesh->setTransform(_meshObject->getTransform());
+        }
+        _meshObject = mesh;
+        if (meshPyObject)
+            meshPyObject->setTwinPointer(mesh);
+    }
+
+    _shareToken.reset();
+    return (MeshObject*)_meshObject;
+}
+
+void PropertyMeshKernel::shareMesh(const PropertyMeshKernel& prop)
+{
+    if (!prop._shareToken)
+        prop._shareToken = std::make_shared<int>(0);
+    _meshObject = prop._meshObject;
+    _shareToken = prop._shareToken;
+    if (meshPyObject)
+        meshPyObject->setTwinPointer((MeshObject*)_meshObject);
+}
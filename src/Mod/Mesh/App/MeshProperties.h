@@ -26,6 +26,7 @@
 
 #include <vector>
 #include <list>
+#include <memory>
 #include <set>
 #include <string>
 #include <map>
@@ -215,6 +216,8 @@ public:
     void finishEditing();
     /// Transform the real mesh data
     void transformGeometry(const Base::Matrix4D &rclMat);
+    /// Set the placement of the mesh without notifying the container
+    void setTransform(const Base::Matrix4D &rclTrf);
     void setPointIndices( const std::vector<std::pair<PointIndex, Base::Vector3f> >& );
     //@}
 
@@ -246,11 +249,28 @@ public:
     void RestoreDocFile(Base::Reader &reader);
 
     App::Property *Copy(void) const;
+    /** The undo copy shares the mesh object with this property. The first of
+     * them that gets modified afterwards works on its own copy of the mesh,
+     * so that a copy for Undo/Redo costs nothing until the mesh changes.
+     */
+    App::Property *copyForUndo(void) const;
     void Paste(const App::Property &from);
+    unsigned int getUndoMemSize (void) const;
     //@}
 
+private:
+    bool isShared() const;
+    /** Makes sure that the mesh object isn't shared with a copy of this property
+     * before it gets modified. If \a keepData is false the content of a
+     * shared mesh isn't copied because it will be replaced anyway.
+     */
+    MeshObject* unshareMesh(bool keepData);
+    void shareMesh(const PropertyMeshKernel&);
+
 private:
     Base::Reference<MeshObject> _meshObject;
+    /// All copies sharing the mesh object hold the same token
+    mutable std::shared_ptr<int> _shareToken;
     MeshPy* meshPyObject;
 };
 
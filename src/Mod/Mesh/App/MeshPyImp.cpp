@@ -1042,13 +1042,17 @@ PyObject*  MeshPy::hasSelfIntersections(PyObject *args)
 
 PyObject*  MeshPy::getSelfIntersections(PyObject *args)
 {
-    if (!PyArg_ParseTuple(args, ""))
+    PyObject* grid = Py_False;
+    if (!PyArg_ParseTuple(args, "|O!", &PyBool_Type, &grid))
         return NULL;
 
     std::vector<std::pair<FacetIndex, FacetIndex> > selfIndices;
     std::vector<std::pair<Base::Vector3f, Base::Vector3f> > selfPoints;
     MeshCore::MeshEvalSelfIntersection eval(getMeshObjectPtr()->getKernel());
-    eval.GetIntersections(selfIndices);
+    if (PyObject_IsTrue(grid))
+        eval.GetIntersectionsByGrid(selfIndices);
+    else
+        eval.GetIntersections(selfIndices);
     eval.GetIntersections(selfIndices, selfPoints);
 
     Py::Tuple tuple(selfIndices.size());
@@ -1918,7 +1922,8 @@ PyObject*  MeshPy::getSegmentsOfType(PyObject *args)
     char* type;
     float dev;
     unsigned long minFacets=0;
-    if (!PyArg_ParseTuple(args, "sf|k",&type,&dev,&minFacets))
+    PyObject* parallel=Py_False;
+    if (!PyArg_ParseTuple(args, "sf|kO!",&type,&dev,&minFacets,&PyBool_Type,&parallel))
         return NULL;
 
     Mesh::MeshObject::GeometryType geoType;
@@ -1938,7 +1943,7 @@ PyObject*  MeshPy::getSegmentsOfType(PyObject *args)
 
     Mesh::MeshObject* mesh = getMeshObjectPtr();
     std::vector<Mesh::Segment> segments = mesh->getSegmentsOfType
-        (geoType, dev, minFacets);
+        (geoType, dev, minFacets, PyObject_IsTrue(parallel) ? true : false);
 
     Py::List s;
     for (std::vector<Mesh::Segment>::iterator it = segments.begin(); it != segments.end(); ++it) {
@@ -1956,7 +1961,8 @@ PyObject*  MeshPy::getSegmentsOfType(PyObject *args)
 PyObject*  MeshPy::getSegmentsByCurvature(PyObject *args)
 {
     PyObject* l;
-    if (!PyArg_ParseTuple(args, "O",&l))
+    PyObject* parallel=Py_False;
+    if (!PyArg_ParseTuple(args, "O|O!",&l,&PyBool_Type,&parallel))
         return NULL;
 
     const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
@@ -1976,7 +1982,10 @@ PyObject*  MeshPy::getSegmentsByCurvature(PyObject *args)
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureFreeformSegment>(meshCurv.GetCurvature(), num, tol1, tol2, c1, c2));
     }
 
-    finder.FindSegments(segm);
+    if (PyObject_IsTrue(parallel))
+        finder.FindSegmentsParallel(segm);
+    else
+        finder.FindSegments(segm);
 
     Py::List list;
     for (std::vector<MeshCore::MeshSurfaceSegmentPtr>::iterator segmIt = segm.begin(); segmIt != segm.end(); ++segmIt) {
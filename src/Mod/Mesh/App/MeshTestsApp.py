@@ -407,6 +407,22 @@ endsolid Simple"""
         mesh.read(Stream=data, Format="AST")
         self.assertTrue(mesh.hasSelfIntersections())
 
+    def testSelfIntersectionPairs(self):
+        mesh = Mesh.createSphere(1.0, 30)
+        other = Mesh.createSphere(1.0, 30)
+        other.translate(0.5, 0.3, 0.1)
+        mesh.addMesh(other)
+        self.assertTrue(mesh.hasSelfIntersections())
+
+        pairs = [(i[0], i[1]) for i in mesh.getSelfIntersections()]
+        self.assertTrue(len(pairs) > 0)
+        self.assertEqual(pairs, sorted(set(pairs)))
+        grid = set((i[0], i[1]) for i in mesh.getSelfIntersections(True))
+        self.assertEqual(set(pairs), grid)
+
+        mesh.fixSelfIntersections()
+        self.assertFalse(mesh.hasSelfIntersections())
+
 
 class PivyTestCases(unittest.TestCase):
     def setUp(self):
@@ -501,6 +517,210 @@ class LoadMeshInThreadsCases(unittest.TestCase):
         pass
 
 
+class MeshDecimationCases(unittest.TestCase):
+    def setUp(self):
+        # large enough to be split into several chunks
+        self.mesh = Mesh.createSphere(1.0, 300)
+
+    def testDecimateToTargetSize(self):
+        count = self.mesh.CountFacets
+        self.mesh.decimate(count // 10)
+        self.assertGreater(self.mesh.CountFacets, 0)
+        self.assertLess(self.mesh.CountFacets, count // 5)
+        self.assertTrue(self.mesh.isSolid())
+        self.assertFalse(self.mesh.hasNonManifolds())
+        dist = max(abs(p.Vector.Length - 1.0) for p in self.mesh.Points)
+        self.assertLess(dist, 0.05)
+
+    def testDecimateWithTolerance(self):
+        count = self.mesh.CountFacets
+        self.mesh.decimate(0.1, 0.9)
+        self.assertLess(self.mesh.CountFacets, count)
+        self.assertTrue(self.mesh.isSolid())
+        self.assertFalse(self.mesh.hasNonManifolds())
+
+
+class MeshSmoothingCases(unittest.TestCase):
+    def setUp(self):
+        self.mesh = Mesh.createSphere(1.0, 100)
+
+    def testReproducible(self):
+        for method in ("Laplace", "Taubin", "PlaneFit"):
+            mesh1 = self.mesh.copy()
+            mesh2 = self.mesh.copy()
+            mesh1.smooth(Method=method, Iteration=5)
+            mesh2.smooth(Method=method, Iteration=5)
+            self.assertEqual(mesh1.Topology[0], mesh2.Topology[0])
+
+    def testThreadCount(self):
+        # the result must not depend on how the points are split up
+        threads = Mesh.getMaxThreadCount()
+        try:
+            for method in ("Laplace", "Taubin", "PlaneFit"):
+                results = []
+                for count in (1, max(threads, 4)):
+                    Mesh.setMaxThreadCount(count)
+                    mesh = self.mesh.copy()
+                    mesh.smooth(Method=method, Iteration=5)
+                    results.append(mesh.Topology[0])
+                self.assertEqual(results[0], results[1])
+        finally:
+            Mesh.setMaxThreadCount(threads)
+
+    def testCurvatureOfSphere(self):
+        curv = self.mesh.getCurvaturePerVertex()
+        self.assertEqual(len(curv), self.mesh.CountPoints)
+        for c in curv:
+            self.assertAlmostEqual(c[0], 1.0, delta=0.05)
+            self.assertAlmostEqual(c[1], 1.0, delta=0.05)
+
+
+class MeshSetOperationsCases(unittest.TestCase):
+    def setUp(self):
+        self.mesh1 = Mesh.createSphere(1.0, 50)
+        self.mesh2 = Mesh.createSphere(1.0, 50)
+        self.mesh2.translate(1.0, 0.1, 0.05)
+        # volume of the lens shaped intersection of two unit spheres
+        d = math.sqrt(1.0 + 0.01 + 0.0025)
+        self.lens = math.pi / 12.0 * (4.0 + d) * (2.0 - d) ** 2
+        self.sphere = self.mesh1.Volume
+
+    def testUnion(self):
+        res = self.mesh1.unite(self.mesh2)
+        self.assertAlmostEqual(res.Volume, 2 * self.sphere - self.lens, delta=0.05)
+
+    def testIntersection(self):
+        res = self.mesh1.intersect(self.mesh2)
+        self.assertAlmostEqual(res.Volume, self.lens, delta=0.05)
+
+    def testDifference(self):
+        res = self.mesh1.difference(self.mesh2)
+        self.assertAlmostEqual(res.Volume, self.sphere - self.lens, delta=0.05)
+
+    def testSeparateShell(self):
+        # a shell of a mesh that isn't cut by the other mesh must be kept
+        other = Mesh.createSphere(1.0, 50)
+        other.translate(10.0, 0.0, 0.0)
+        self.mesh1.addMesh(other)
+        res = self.mesh1.unite(self.mesh2)
+        self.assertAlmostEqual(res.Volume, 3 * self.sphere - self.lens, delta=0.05)
+
+    def testNoIntersection(self):
+        self.mesh2.translate(5.0, 0.0, 0.0)
+        res = self.mesh1.unite(self.mesh2)
+        self.assertEqual(res.CountFacets, self.mesh1.CountFacets + self.mesh2.CountFacets)
+        res = self.mesh1.intersect(self.mesh2)
+        self.assertEqual(res.CountFacets, 0)
+
+    def testThreadCount(self):
+        # a run with a single thread is the reference for the parallel run
+        box = Mesh.createBox(1.2, 1.2, 1.2)
+        box.translate(-0.3, -0.4, -0.5)
+        cylinder = Mesh.createCylinder(0.5, 3.0, 1, 0.5, 40)
+        cylinder.translate(-1.0, 0.1, 0.2)
+        pairs = [(self.mesh1, self.mesh2), (self.mesh1, box), (box, cylinder)]
+        threads = Mesh.getMaxThreadCount()
+        try:
+            for mesh1, mesh2 in pairs:
+                for op in ("unite", "intersect", "difference"):
+                    results = []
+                    for count in (1, max(threads, 4)):
+                        Mesh.setMaxThreadCount(count)
+                        results.append(getattr(mesh1, op)(mesh2))
+                    self.assertEqual(results[0].CountFacets, results[1].CountFacets)
+                    self.assertEqual(results[0].Topology, results[1].Topology)
+                    self.assertGreater(results[0].CountFacets, 0)
+        finally:
+            Mesh.setMaxThreadCount(threads)
+
+
+class MeshSegmentationCases(unittest.TestCase):
+    def setUp(self):
+        # large enough to be split into several chunks
+        self.mesh = Mesh.createSphere(1.0, 150)
+
+    def testParallelCurvatureSegments(self):
+        func = [(1.0, 1.0, 0.3, 0.3, 100)]
+        serial = self.mesh.getSegmentsByCurvature(func)
+        parallel = self.mesh.getSegmentsByCurvature(func, True)
+        self.assertEqual(len(serial), 1)
+        self.assertEqual(len(parallel), 1)
+        self.assertEqual(len(parallel[0]), self.mesh.CountFacets)
+        self.assertEqual(sorted(serial[0]), sorted(parallel[0]))
+
+    def testParallelMultipleSegments(self):
+        # two disjoint spheres of different curvature
+        other = Mesh.createSphere(2.0, 150)
+        other.translate(5.0, 0.0, 0.0)
+        self.mesh.addMesh(other)
+        func = [(1.0, 1.0, 0.3, 0.3, 100), (0.5, 0.5, 0.2, 0.2, 100)]
+        serial = self.mesh.getSegmentsByCurvature(func)
+        parallel = self.mesh.getSegmentsByCurvature(func, True)
+        self.assertEqual(len(serial), 2)
+        self.assertEqual(len(parallel), len(serial))
+        serial = sorted(sorted(s) for s in serial)
+        parallel = sorted(sorted(s) for s in parallel)
+        self.assertEqual(serial, parallel)
+        self.assertEqual(sum(len(s) for s in parallel), self.mesh.CountFacets)
+
+
+class MeshUndoCases(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("MeshUndoTest")
+        self.doc.UndoMode = 1
+        self.feature = self.doc.addObject("Mesh::Feature", "Mesh")
+        self.feature.Mesh = Mesh.createSphere(1.0, 50)
+
+    def translate(self, x):
+        self.doc.openTransaction("Translate")
+        mesh = self.feature.Mesh.copy()
+        mesh.translate(x, 0, 0)
+        self.feature.Mesh = mesh
+        self.doc.commitTransaction()
+
+    def testUndoRedo(self):
+        xmin = self.feature.Mesh.BoundBox.XMin
+        self.translate(1.0)
+        self.translate(2.0)
+        self.assertGreater(self.doc.UndoRedoMemSize, 0)
+        self.assertAlmostEqual(self.feature.Mesh.BoundBox.XMin, xmin + 3.0)
+        self.doc.undo()
+        self.assertAlmostEqual(self.feature.Mesh.BoundBox.XMin, xmin + 1.0)
+        self.doc.undo()
+        self.assertAlmostEqual(self.feature.Mesh.BoundBox.XMin, xmin)
+        self.doc.redo()
+        self.doc.redo()
+        self.assertAlmostEqual(self.feature.Mesh.BoundBox.XMin, xmin + 3.0)
+
+    def testUndoPlacement(self):
+        xmin = self.feature.Mesh.BoundBox.XMin
+        self.translate(1.0)
+        self.doc.openTransaction("Placement")
+        self.feature.Placement.Base = FreeCAD.Vector(10, 0, 0)
+        self.doc.commitTransaction()
+        self.assertAlmostEqual(self.feature.Mesh.BoundBox.XMin, xmin + 11.0)
+        self.doc.undo()
+        self.assertEqual(self.feature.Placement, FreeCAD.Placement())
+        self.assertEqual(self.feature.Mesh.Placement, FreeCAD.Placement())
+        self.assertAlmostEqual(self.feature.Mesh.BoundBox.XMin, xmin + 1.0)
+        self.doc.undo()
+        self.assertAlmostEqual(self.feature.Mesh.BoundBox.XMin, xmin)
+        self.doc.redo()
+        self.doc.redo()
+        self.assertEqual(self.feature.Mesh.Placement, self.feature.Placement)
+        self.assertAlmostEqual(self.feature.Mesh.BoundBox.XMin, xmin + 11.0)
+
+    def testUndoMemLimit(self):
+        self.doc.UndoMemLimit = 1
+        for i in range(3):
+            self.translate(1.0)
+        self.assertEqual(self.doc.UndoCount, 1)
+        self.assertEqual(self.doc.UndoMemLimit, 1)
+
+    def tearDown(self):
+        FreeCAD.closeDocument("MeshUndoTest")
+
+
 class PolynomialFitCases(unittest.TestCase):
     def setUp(self):
         pass
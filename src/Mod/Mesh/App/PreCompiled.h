@@ -59,6 +59,7 @@
 #endif
 // STL
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <iostream>
 #include <iomanip>
@@ -69,6 +70,7 @@
 #include <sstream>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // FIXME: Causes problem with boost/numeric/bindings/lapack/syev.hpp(117)
@@ -33,6 +33,7 @@
 #include "modelRefine.h"
 #include <App/Application.h>
 #include <Base/Parameter.h>
+#include <Base/Trace.h>
 
 
 using namespace Part;
@@ -69,6 +70,7 @@ short Boolean::mustExecute() const
 
 App::DocumentObjectExecReturn *Boolean::execute(void)
 {
+    FC_TRACE_SCOPE("Part", "boolean", getNameInDocument());
     try {
 #if defined(__GNUC__) && defined (FC_OS_LINUX)
         Base::SignalException se;
@@ -177,6 +177,13 @@ App::Property *PropertyPartShape::Copy(void) const
     return prop;
 }
 
+App::Property *PropertyPartShape::copyForUndo(void) const
+{
+    PropertyPartShape *prop = new PropertyPartShape();
+    prop->_Shape = this->_Shape;
+    return prop;
+}
+
 void PropertyPartShape::Paste(const App::Property &from)
 {
     aboutToSetValue();
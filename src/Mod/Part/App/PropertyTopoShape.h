@@ -84,6 +84,8 @@ public:
     void RestoreDocFile(Base::Reader &reader);
 
     App::Property *Copy(void) const;
+    /// The undo copy shares the shape with this property
+    App::Property *copyForUndo(void) const;
     void Paste(const App::Property &from);
     unsigned int getMemSize (void) const;
     //@}
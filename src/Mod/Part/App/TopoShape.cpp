@@ -28,6 +28,7 @@
 # include <array>
 # include <cmath>
 # include <cstdlib>
+# include <set>
 # include <sstream>
 # include <QString>
 
@@ -199,6 +200,7 @@
 #include <Base/Exception.h>
 #include <Base/Tools.h>
 #include <Base/Console.h>
+#include <Base/Trace.h>
 #include <App/Material.h>
 
 #include "PartPyCXX.h"
@@ -1256,11 +1258,28 @@ unsigned int TopoShape_RefCountShapes(const TopoDS_Shape& aShape)
     return size;
 }
 
+static std::uint64_t TopoShape_TriangulationSize(const Handle(Poly_Triangulation)& tri)
+{
+    std::uint64_t size = sizeof(Poly_Triangulation);
+    size += static_cast<std::uint64_t>(tri->NbNodes()) * sizeof(gp_Pnt);
+    size += static_cast<std::uint64_t>(tri->NbTriangles()) * sizeof(Poly_Triangle);
+    if (tri->HasUVNodes())
+        size += static_cast<std::uint64_t>(tri->NbNodes()) * sizeof(gp_Pnt2d);
+#if OCC_VERSION_HEX >= 0x070000
+    if (tri->HasNormals())
+        size += static_cast<std::uint64_t>(tri->NbNodes()) * 3 * sizeof(Standard_ShortReal);
+#endif
+    return size;
+}
+
 unsigned int TopoShape::getMemSize (void) const
 {
     if (!_Shape.IsNull()) {
         // Count total amount of references of TopoDS_Shape objects
-        unsigned int memsize = (sizeof(TopoDS_Shape)+sizeof(TopoDS_TShape)) * TopoShape_RefCountShapes(_Shape);
+        std::uint64_t memsize = (sizeof(TopoDS_Shape)+sizeof(TopoDS_TShape)) * TopoShape_RefCountShapes(_Shape);
+
+        // the triangulations and polygons of the tessellation, they can be shared
+        std::set<const Standard_Transient*> meshes;
 
         // Now get a map of TopoDS_Shape objects without duplicates
         TopTools_IndexedMapOfShape M;
@@ -1281,6 +1300,12 @@ unsigned int TopoShape::getMemSize (void) const
                     // first, last, tolerance
                     memsize += 5*sizeof(Standard_Real);
                     const TopoDS_Face& face = TopoDS::Face(shape);
+
+                    TopLoc_Location loc;
+                    const Handle(Poly_Triangulation)& tri = BRep_Tool::Triangulation(face, loc);
+                    if (!tri.IsNull() && meshes.insert(tri.operator->()).second)
+                        memsize += TopoShape_TriangulationSize(tri);
+
                     // if no geometry is attached to a face an exception is raised
                     BRepAdaptor_Surface surface;
                     try {
@@ -1308,15 +1333,17 @@ unsigned int TopoShape::getMemSize (void) const
                         memsize += sizeof(Geom_ToroidalSurface);
                         break;
                     case GeomAbs_BezierSurface:
+                        // poles and weights
                         memsize += sizeof(Geom_BezierSurface);
                         memsize += (surface.NbUPoles()*surface.NbVPoles()) * sizeof(Standard_Real);
-                        memsize += (surface.NbUPoles()*surface.NbVPoles()) * sizeof(Geom_CartesianPoint);
+                        memsize += (surface.NbUPoles()*surface.NbVPoles()) * sizeof(gp_Pnt);
                         break;
                     case GeomAbs_BSplineSurface:
+                        // knots, multiplicities, poles and weights
                         memsize += sizeof(Geom_BSplineSurface);
-                        memsize += (surface.NbUKnots()+surface.NbVKnots()) * sizeof(Standard_Real);
+                        memsize += (surface.NbUKnots()+surface.NbVKnots()) * (sizeof(Standard_Real)+sizeof(Standard_Integer));
                         memsize += (surface.NbUPoles()*surface.NbVPoles()) * sizeof(Standard_Real);
-                        memsize += (surface.NbUPoles()*surface.NbVPoles()) * sizeof(Geom_CartesianPoint);
+                        memsize += (surface.NbUPoles()*surface.NbVPoles()) * sizeof(gp_Pnt);
                         break;
                     case GeomAbs_SurfaceOfRevolution:
                         memsize += sizeof(Geom_SurfaceOfRevolution);
@@ -1337,6 +1364,29 @@ unsigned int TopoShape::getMemSize (void) const
                     // first, last, tolerance
                     memsize += 3*sizeof(Standard_Real);
                     const TopoDS_Edge& edge = TopoDS::Edge(shape);
+
+                    // the polygon of a tessellated edge and its node indices on
+                    // the triangulations of the adjacent faces
+                    TopLoc_Location loc;
+                    const Handle(Poly_Polygon3D)& polygon = BRep_Tool::Polygon3D(edge, loc);
+                    if (!polygon.IsNull() && meshes.insert(polygon.operator->()).second) {
+                        memsize += sizeof(Poly_Polygon3D) + polygon->NbNodes() * sizeof(gp_Pnt);
+                        if (polygon->HasParameters())
+                            memsize += polygon->NbNodes() * sizeof(Standard_Real);
+                    }
+                    for (int index = 1; ; index++) {
+                        Handle(Poly_PolygonOnTriangulation) poly;
+                        Handle(Poly_Triangulation) tri;
+                        BRep_Tool::PolygonOnTriangulation(edge, poly, tri, loc, index);
+                        if (poly.IsNull())
+                            break;
+                        if (meshes.insert(poly.operator->()).second) {
+                            memsize += sizeof(Poly_PolygonOnTriangulation) + poly->NbNodes() * sizeof(Standard_Integer);
+                            if (poly->HasParameters())
+                                memsize += poly->NbNodes() * sizeof(Standard_Real);
+                        }
+                    }
+
                     // if no geometry is attached to an edge an exception is raised
                     BRepAdaptor_Curve curve;
                     try {
@@ -1364,15 +1414,17 @@ unsigned int TopoShape::getMemSize (void) const
                         memsize += sizeof(Geom_Parabola);
                         break;
                     case GeomAbs_BezierCurve:
+                        // poles and weights
                         memsize += sizeof(Geom_BezierCurve);
                         memsize += curve.NbPoles() * sizeof(Standard_Real);
-                        memsize += curve.NbPoles() * sizeof(Geom_CartesianPoint);
+                        memsize += curve.NbPoles() * sizeof(gp_Pnt);
                         break;
                     case GeomAbs_BSplineCurve:
+                        // knots, multiplicities, poles and weights
                         memsize += sizeof(Geom_BSplineCurve);
-                        memsize += curve.NbKnots() * sizeof(Standard_Real);
+                        memsize += curve.NbKnots() * (sizeof(Standard_Real)+sizeof(Standard_Integer));
                         memsize += curve.NbPoles() * sizeof(Standard_Real);
-                        memsize += curve.NbPoles() * sizeof(Geom_CartesianPoint);
+                        memsize += curve.NbPoles() * sizeof(gp_Pnt);
                         break;
                     case GeomAbs_OtherCurve:
                         // What kind of curve should this be?
@@ -1394,7 +1446,7 @@ unsigned int TopoShape::getMemSize (void) const
         }
 
         // estimated memory usage
-        return memsize;
+        return clampMemSize(memsize);
     }
 
     // in case the shape is invalid
@@ -1732,6 +1784,7 @@ bool TopoShape::isClosed() const
 
 TopoDS_Shape TopoShape::cut(TopoDS_Shape shape) const
 {
+    FC_TRACE_SCOPE("Part", "cut");
     if (this->_Shape.IsNull())
         return this->_Shape;
     if (shape.IsNull())
@@ -1742,6 +1795,7 @@ TopoDS_Shape TopoShape::cut(TopoDS_Shape shape) const
 
 TopoDS_Shape TopoShape::cut(const std::vector<TopoDS_Shape>& shapes, Standard_Real tolerance) const
 {
+    FC_TRACE_SCOPE("Part", "cut");
     if (this->_Shape.IsNull())
         return this->_Shape;
 #if OCC_VERSION_HEX < 0x060900
@@ -1778,6 +1832,7 @@ TopoDS_Shape TopoShape::cut(const std::vector<TopoDS_Shape>& shapes, Standard_Re
 
 TopoDS_Shape TopoShape::common(TopoDS_Shape shape) const
 {
+    FC_TRACE_SCOPE("Part", "common");
     if (this->_Shape.IsNull())
         return this->_Shape;
     if (shape.IsNull())
@@ -1788,6 +1843,7 @@ TopoDS_Shape TopoShape::common(TopoDS_Shape shape) const
 
 TopoDS_Shape TopoShape::common(const std::vector<TopoDS_Shape>& shapes, Standard_Real tolerance) const
 {
+    FC_TRACE_SCOPE("Part", "common");
     if (this->_Shape.IsNull())
         return this->_Shape;
 #if OCC_VERSION_HEX < 0x060900
@@ -1824,6 +1880,7 @@ TopoDS_Shape TopoShape::common(const std::vector<TopoDS_Shape>& shapes, Standard
 
 TopoDS_Shape TopoShape::fuse(TopoDS_Shape shape) const
 {
+    FC_TRACE_SCOPE("Part", "fuse");
     if (this->_Shape.IsNull())
         return shape;
     if (shape.IsNull())
@@ -1834,6 +1891,7 @@ TopoDS_Shape TopoShape::fuse(TopoDS_Shape shape) const
 
 TopoDS_Shape TopoShape::fuse(const std::vector<TopoDS_Shape>& shapes, Standard_Real tolerance) const
 {
+    FC_TRACE_SCOPE("Part", "fuse");
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
 #if OCC_VERSION_HEX <= 0x060800
@@ -1989,6 +2047,7 @@ TopoDS_Compound TopoShape::slices(const Base::Vector3d& dir, const std::vector<d
 TopoDS_Shape TopoShape::generalFuse(const std::vector<TopoDS_Shape> &sOthers, Standard_Real tolerance,
                                     std::vector<TopTools_ListOfShape>* mapInOut) const
 {
+    FC_TRACE_SCOPE("Part", "generalFuse");
     if (this->_Shape.IsNull())
         Standard_Failure::Raise("Base shape is null");
 #if OCC_VERSION_HEX < 0x060900
@@ -3451,6 +3510,7 @@ void TopoShape::getFaces(std::vector<Base::Vector3d> &aPoints,
                          std::vector<Facet> &aTopo,
                          float accuracy, uint16_t /*flags*/) const
 {
+    FC_TRACE_SCOPE("Part", "tessellate");
     if (this->_Shape.IsNull())
         return;
 
@@ -105,6 +105,7 @@
 #include <Base/Exception.h>
 #include <Base/TimeInfo.h>
 #include <Base/Tools.h>
+#include <Base/Trace.h>
 
 #include <App/Application.h>
 #include <App/Document.h>
@@ -932,6 +933,7 @@ void ViewProviderPartExt::unsetEdit(int ModNum)
 
 void ViewProviderPartExt::updateVisual()
 {
+    FC_TRACE_SCOPE("Gui", "tessellate", getObject() ? getObject()->getNameInDocument() : nullptr);
     Gui::SoUpdateVBOAction action;
     action.apply(this->faceset);
 
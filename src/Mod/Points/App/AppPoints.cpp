@@ -34,6 +34,7 @@
 #include "Properties.h"
 #include "PropertyPointKernel.h"
 #include "Structured.h"
+#include "Tiled.h"
 
 namespace Points {
     extern PyObject* initModule();
@@ -58,8 +59,10 @@ PyMOD_INIT_FUNC(Points)
     // add data types
     Points::Feature               ::init();
     Points::Structured            ::init();
+    Points::Tiled                 ::init();
     Points::FeatureCustom         ::init();
     Points::StructuredCustom      ::init();
+    Points::TiledCustom           ::init();
     Points::FeaturePython         ::init();
     PyMOD_Return(pointsModule);
 }
@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <cstring>
 # include <memory>
 #endif
 
@@ -43,6 +44,7 @@
 #include "Points.h"
 #include "PointsPy.h"
 #include "PointsAlgos.h"
+#include "PointsOctree.h"
 #include "Structured.h"
 #include "Properties.h"
 
@@ -61,6 +63,12 @@ public:
         add_varargs_method("show",&Module::show,
             "show(points,[string]) -- Add the points to the active document or create one if no document exists."
         );
+        add_varargs_method("buildOctree",&Module::buildOctree,
+            "buildOctree(source,string,[int]) -- Write the points to an octree file for a Points::Tiled object.\n"
+            "source is a Points object or an iterable of Points objects or float32 buffers\n"
+            "with x,y,z triples, e.g. numpy arrays. The optional int is the maximum number\n"
+            "of points of an octree node."
+        );
         initialize("This module is the Points module."); // register with Python
     }
 
@@ -392,6 +400,70 @@ private:
 
         return Py::None();
     }
+
+    Py::Object buildOctree(const Py::Tuple& args)
+    {
+        PyObject *source;
+        char* Name;
+        int maxNodePoints = 65536;
+        if (!PyArg_ParseTuple(args.ptr(), "Oet|i", &source, "utf-8", &Name, &maxNodePoints))
+            throw Py::Exception();
+        std::string EncodedName = std::string(Name);
+        PyMem_Free(Name);
+        if (maxNodePoints < 1)
+            throw Py::ValueError("Maximum number of node points must be positive");
+
+        try {
+            if (PyObject_TypeCheck(source, &(PointsPy::Type))) {
+                const PointKernel* kernel = static_cast<PointsPy*>(source)->getPointKernelPtr();
+                PointsOctree::Build(*kernel, EncodedName, maxNodePoints);
+                return Py::None();
+            }
+
+            PyObject* it = PyObject_GetIter(source);
+            if (!it)
+                throw Py::Exception();
+            Py::Object iter(it, true);
+
+            // the points are read one item at a time, so that the source
+            // doesn't need to fit into memory
+            PointsOctree::Build([&iter](std::vector<Base::Vector3f>& chunk) {
+                PyObject* next = PyIter_Next(iter.ptr());
+                if (!next) {
+                    if (PyErr_Occurred())
+                        throw Py::Exception();
+                    return false;
+                }
+
+                Py::Object item(next, true);
+                if (PyObject_TypeCheck(next, &(PointsPy::Type))) {
+                    const std::vector<PointKernel::value_type>& pnts =
+                        static_cast<PointsPy*>(next)->getPointKernelPtr()->getBasicPoints();
+                    chunk.assign(pnts.begin(), pnts.end());
+                    return true;
+                }
+
+                Py_buffer view;
+                if (PyObject_GetBuffer(next, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) != 0)
+                    throw Py::Exception();
+                std::size_t len = view.format ? std::strlen(view.format) : 0;
+                bool isFloat = view.itemsize == 4 && len > 0 && view.format[len - 1] == 'f';
+                if (!isFloat || view.len % (3 * sizeof(float)) != 0) {
+                    PyBuffer_Release(&view);
+                    throw Py::TypeError("Expect a Points object or a float32 buffer of x,y,z triples");
+                }
+                chunk.resize(static_cast<std::size_t>(view.len) / (3 * sizeof(float)));
+                std::memcpy(chunk.data(), view.buf, static_cast<std::size_t>(view.len));
+                PyBuffer_Release(&view);
+                return true;
+            }, EncodedName, maxNodePoints);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
 };
 
 PyObject* initModule()
@@ -133,7 +133,7 @@ void PointKernel::operator = (const PointKernel& Kernel)
 
 unsigned int PointKernel::getMemSize (void) const
 {
-    return _Points.size() * sizeof(value_type);
+    return clampMemSize(static_cast<std::uint64_t>(_Points.capacity()) * sizeof(value_type));
 }
 
 PointKernel::size_type PointKernel::countValid(void) const
@@ -179,9 +179,8 @@ void PointKernel::SaveDocFile (Base::Writer &writer) const
     uint32_t uCt = (uint32_t)size();
     str << uCt;
     // store the data without transforming it
-    for (std::vector<value_type>::const_iterator it = _Points.begin(); it != _Points.end(); ++it) {
-        str << it->x << it->y << it->z;
-    }
+    static_assert(sizeof(value_type) == 3 * sizeof(float_type), "points must be stored without padding");
+    str.write(reinterpret_cast<const float_type*>(_Points.data()), 3 * _Points.size());
 }
 
 void PointKernel::Restore(Base::XMLReader &reader)
@@ -207,10 +206,9 @@ void PointKernel::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt = 0;
     str >> uCt;
     _Points.resize(uCt);
-    for (unsigned long i=0; i < uCt; i++) {
-        float x, y, z;
-        str >> x >> y >> z;
-        _Points[i].Set(x,y,z);
+    if (!str.read(reinterpret_cast<float_type*>(_Points.data()), 3 * _Points.size())) {
+        _Points.clear();
+        throw Base::BadFormatError("Reading points failed");
     }
 }
 
@@ -26,9 +26,14 @@
 #ifdef FC_OS_LINUX
 # include <unistd.h>
 #endif
+# include <atomic>
+# include <cstring>
 # include <sstream>
 #endif
 
+#include <QFile>
+#include <QThread>
+#include <QtConcurrentMap>
 
 #include "PointsAlgos.h"
 #include "Points.h"
@@ -37,17 +42,253 @@
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
 #include <Base/Console.h>
-#include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 
 #include <memory>
-#include <boost/regex.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 
 using namespace Points;
 
+namespace {
+typedef std::pair<std::size_t, std::size_t> Range;
+
+// runs func(first, last) on ranges of [0, count) in parallel
+template <typename Func>
+void parallelFor(std::size_t count, std::size_t minSize, Func func)
+{
+    std::vector<Range> ranges;
+    std::size_t numRanges = 4 * static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1));
+    std::size_t size = std::max(minSize, (count + numRanges - 1) / numRanges);
+    for (std::size_t i = 0; i < count; i += size)
+        ranges.emplace_back(i, std::min(i + size, count));
+    QtConcurrent::blockingMap(ranges, [&func](const Range& range) {
+        func(range.first, range.second);
+    });
+}
+
+typedef std::pair<const char*, const char*> TextLine;
+
+// Reads the rest of a stream into memory and splits it into lines without
+// the line end. The text ends with a null character, so that strtod()
+// stops at the end of the last line.
+void readLines(std::istream& in, std::vector<char>& text, std::vector<TextLine>& lines)
+{
+    std::streamoff pos = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streamoff end = in.tellg();
+    in.seekg(pos, std::ios::beg);
+    text.resize(static_cast<std::size_t>(std::max<std::streamoff>(end - pos, 0)));
+    if (!text.empty())
+        in.read(&text[0], text.size());
+    text.resize(static_cast<std::size_t>(std::max<std::streamsize>(in.gcount(), 0)));
+    text.push_back('\0');
+
+    const char* begin = text.data();
+    const char* last = begin + text.size() - 1;
+    while (begin < last) {
+        const char* eol = static_cast<const char*>(std::memchr(begin, '\n', last - begin));
+        if (!eol)
+            eol = last;
+        const char* next = eol < last ? eol + 1 : last;
+        if (eol > begin && *(eol - 1) == '\r')
+            --eol;
+        lines.emplace_back(begin, eol);
+        begin = next;
+    }
+}
+
+inline bool isBlank(const TextLine& line)
+{
+    for (const char* pos = line.first; pos < line.second; ++pos) {
+        if (!isspace(static_cast<unsigned char>(*pos)))
+            return false;
+    }
+    return true;
+}
+
+// Parses up to maxCount numbers separated by white space. Returns the number
+// of values read or -1 if a word isn't a number.
+int parseNumbers(const TextLine& line, double* values, int maxCount)
+{
+    const char* pos = line.first;
+    int count = 0;
+    while (count < maxCount) {
+        while (pos < line.second && isspace(static_cast<unsigned char>(*pos)))
+            ++pos;
+        if (pos == line.second)
+            break;
+        char* next;
+        values[count] = strtod(pos, &next);
+        if (next == pos || (next < line.second && !isspace(static_cast<unsigned char>(*next))))
+            return -1;
+        pos = next;
+        ++count;
+    }
+    return count;
+}
+
+// Fills the rows of the matrix from the text lines in parallel, the lines
+// must not be blank
+void parseRows(const std::vector<TextLine>& lines, Eigen::MatrixXd& data)
+{
+    std::size_t numRows = std::min<std::size_t>(lines.size(), data.rows());
+    int numFields = static_cast<int>(data.cols());
+    std::atomic<bool> failed(false);
+    parallelFor(numRows, 1024, [&](std::size_t first, std::size_t last) {
+        std::vector<double> values(numFields);
+        for (std::size_t row = first; row < last; row++) {
+            int count = parseNumbers(lines[row], values.data(), numFields);
+            if (count < 0) {
+                failed = true;
+                return;
+            }
+            for (int col = 0; col < count; col++)
+                data(row, col) = values[col];
+        }
+    });
+
+    if (failed)
+        throw Base::BadFormatError("Invalid number");
+}
+
+enum NumberType {
+    Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64
+};
+
+int sizeOf(NumberType type)
+{
+    switch (type) {
+    case Int8:
+    case UInt8:
+        return 1;
+    case Int16:
+    case UInt16:
+        return 2;
+    case Int32:
+    case UInt32:
+    case Float32:
+        return 4;
+    default:
+        return 8;
+    }
+}
+
+template <typename T>
+inline double decode(const char* data, bool swapByteOrder)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, data, sizeof(T));
+    if (swapByteOrder)
+        Base::SwapEndianArray(bytes, 1, sizeof(T));
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return static_cast<double>(value);
+}
+
+inline double decode(NumberType type, const char* data, bool swapByteOrder)
+{
+    switch (type) {
+    case Int8:
+        return decode<int8_t>(data, false);
+    case UInt8:
+        return decode<uint8_t>(data, false);
+    case Int16:
+        return decode<int16_t>(data, swapByteOrder);
+    case UInt16:
+        return decode<uint16_t>(data, swapByteOrder);
+    case Int32:
+        return decode<int32_t>(data, swapByteOrder);
+    case UInt32:
+        return decode<uint32_t>(data, swapByteOrder);
+    case Float32:
+        return decode<float>(data, swapByteOrder);
+    default:
+        return decode<double>(data, swapByteOrder);
+    }
+}
+
+// Decodes binary records in parallel. The fields of a point follow each
+// other, or if transposed all values of the first field come first.
+void decodeRecords(const char* buffer, const std::vector<NumberType>& types,
+                   bool swapByteOrder, bool transposed, Eigen::MatrixXd& data)
+{
+    std::size_t numPoints = data.rows();
+    std::size_t numFields = types.size();
+    std::vector<std::size_t> offsets(numFields);
+    std::size_t recordSize = 0;
+    for (std::size_t j = 0; j < numFields; j++) {
+        offsets[j] = recordSize;
+        recordSize += sizeOf(types[j]);
+    }
+
+    parallelFor(numPoints, 4096, [&](std::size_t first, std::size_t last) {
+        for (std::size_t j = 0; j < numFields; j++) {
+            std::size_t size = sizeOf(types[j]);
+            for (std::size_t i = first; i < last; i++) {
+                const char* value = transposed
+                    ? buffer + offsets[j] * numPoints + i * size
+                    : buffer + i * recordSize + offsets[j];
+                data(i, j) = decode(types[j], value, swapByteOrder);
+            }
+        }
+    });
+}
+
+std::size_t recordSize(const std::vector<NumberType>& types)
+{
+    std::size_t size = 0;
+    for (NumberType type : types)
+        size += sizeOf(type);
+    return size;
+}
+
+// The binary part of a file from the current position of the stream on. The
+// file is mapped into memory if possible, otherwise it is read at once.
+class BinaryData
+{
+public:
+    BinaryData(const std::string& filename, std::istream& inp, std::size_t size)
+      : mapped(nullptr)
+    {
+        std::streamoff pos = inp.tellg();
+        inp.seekg(0, std::ios::end);
+        std::streamoff end = inp.tellg();
+        inp.seekg(pos, std::ios::beg);
+        if (pos < 0 || pos + static_cast<std::streamoff>(size) > end)
+            throw Base::BadFormatError("File expects too many elements");
+        if (size == 0)
+            return;
+
+        file.setFileName(QString::fromUtf8(filename.c_str()));
+        if (file.open(QIODevice::ReadOnly))
+            mapped = file.map(static_cast<qint64>(pos), static_cast<qint64>(size));
+        if (!mapped) {
+            buffer.resize(size);
+            inp.read(&buffer[0], size);
+            if (static_cast<std::size_t>(inp.gcount()) != size)
+                throw Base::BadFormatError("Failed to read binary data");
+        }
+    }
+    ~BinaryData()
+    {
+        if (mapped)
+            file.unmap(mapped);
+    }
+    const char* data() const
+    {
+        return mapped ? reinterpret_cast<const char*>(mapped) : buffer.data();
+    }
+
+private:
+    QFile file;
+    uchar* mapped;
+    std::vector<char> buffer;
+};
+}
+
 void PointsAlgos::Load(PointKernel &points, const char *FileName)
 {
     Base::FileInfo File(FileName);
@@ -64,57 +305,33 @@ void PointsAlgos::Load(PointKernel &points, const char *FileName)
 
 void PointsAlgos::LoadAscii(PointKernel &points, const char *FileName)
 {
-    boost::regex rx("^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                     "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                     "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    //boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
-    //boost::regex rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
-
-    Base::Vector3d pt;
-    int LineCnt=0;
-    std::string line;
     Base::FileInfo fi(FileName);
-
-    Base::ifstream tmp_str(fi, std::ios::in);
-
-    // estimating size
-    while (std::getline(tmp_str,line))
-        LineCnt++;
-
-    // resize the PointKernel
-    points.resize(LineCnt);
-
-    Base::SequencerLauncher seq( "Loading points...", LineCnt );
-
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
-
-    try {
-        // read file
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
-
-                points.setPoint(LineCnt,pt);
-                seq.next();
-                LineCnt++;
+    Base::ifstream file(fi, std::ios::in | std::ios::binary);
+
+    std::vector<char> text;
+    std::vector<TextLine> lines;
+    readLines(file, text, lines);
+
+    // a line must hold exactly three numbers, other lines are ignored
+    std::vector<Base::Vector3d> pts(lines.size());
+    std::vector<char> valid(lines.size(), 0);
+    parallelFor(lines.size(), 1024, [&](std::size_t first, std::size_t last) {
+        double values[4];
+        for (std::size_t i = first; i < last; i++) {
+            if (parseNumbers(lines[i], values, 4) == 3) {
+                pts[i].Set(values[0], values[1], values[2]);
+                valid[i] = 1;
             }
         }
-    }
-    catch (...) {
-        points.clear();
-        throw Base::BadFormatError("Reading in points failed.");
-    }
+    });
 
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size())
-        points.erase(LineCnt, points.size());
+    std::size_t count = std::count(valid.begin(), valid.end(), 1);
+    points.resize(count);
+    std::size_t index = 0;
+    for (std::size_t i = 0; i < lines.size(); i++) {
+        if (valid[i])
+            points.setPoint(static_cast<int>(index++), pts[i]);
+    }
 }
 
 // ----------------------------------------------------------------------------
@@ -214,8 +431,6 @@ public:
     virtual ~Converter() {
     }
     virtual std::string toString(float) const = 0;
-    virtual double toDouble(Base::InputStream&) const = 0;
-    virtual int getSizeOf() const = 0;
 };
 template <typename T>
 class ConverterT : public Converter {
@@ -228,85 +443,10 @@ public:
         oss << c;
         return oss.str();
     }
-    virtual double toDouble(Base::InputStream& str) const {
-        T c;
-        str >> c;
-        return static_cast<double>(c);
-    }
-    virtual int getSizeOf() const {
-        return sizeof(T);
-    }
 };
 
 typedef std::shared_ptr<Converter> ConverterPtr;
 
-class DataStreambuf : public std::streambuf
-{
-public:
-    explicit DataStreambuf(const std::vector<char>& data) : _buffer(data) {
-        _beg = 0;
-        _end = data.size();
-        _cur = 0;
-    }
-    ~DataStreambuf() {
-    }
-
-protected:
-    virtual int_type uflow() {
-        if (_cur == _end)
-            return traits_type::eof();
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur++]) & 0x000000ff;
-    }
-    virtual int_type underflow() {
-        if (_cur == _end)
-            return traits_type::eof();
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur]) & 0x000000ff;
-    }
-    virtual int_type pbackfail(int_type ch) {
-        if (_cur == _beg || (ch != traits_type::eof() && ch != _buffer[_cur-1]))
-            return traits_type::eof();
-
-        return static_cast<DataStreambuf::int_type>(_buffer[--_cur]) & 0x000000ff;
-    }
-    virtual std::streamsize showmanyc() {
-        return _end - _cur;
-    }
-    virtual pos_type seekoff(std::streambuf::off_type off,
-        std::ios_base::seekdir way,
-        std::ios_base::openmode = 
-            std::ios::in | std::ios::out) {
-        int p_pos=-1;
-        if (way == std::ios_base::beg)
-            p_pos = _beg;
-        else if (way == std::ios_base::end)
-            p_pos = _end;
-        else if (way == std::ios_base::cur)
-            p_pos = _cur;
-
-        if (p_pos > _end)
-            return traits_type::eof();
-
-        if (((p_pos + off) > _end) || ((p_pos + off) < _beg))
-            return traits_type::eof();
-
-        _cur = p_pos+ off;
-
-        return ((p_pos+off) - _beg);
-    }
-    virtual pos_type seekpos(std::streambuf::pos_type pos,
-        std::ios_base::openmode which =
-        std::ios::in | std::ios::out) {
-        (void)which;
-        return seekoff(pos, std::ios_base::beg);
-    }
-
-private:
-    const std::vector<char>& _buffer;
-    int _beg, _end, _cur;
-};
-
 //Taken from https://github.com/PointCloudLibrary/pcl/blob/master/io/src/lzf.cpp
 unsigned int 
 lzfDecompress (const void *const in_data,  unsigned int in_len,
@@ -522,10 +662,10 @@ void PlyReader::read(const std::string& filename)
         readAscii(inp, offset, data);
     }
     else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
+        readBinary(false, filename, inp, offset, types, sizes, data);
     }
     else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
+        readBinary(true, filename, inp, offset, types, sizes, data);
     }
 
     std::vector<std::string>::iterator it;
@@ -823,117 +963,81 @@ std::size_t PlyReader::readHeader(std::istream& in,
 
 void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
 {
-    std::string line;
-    std::size_t row = 0;
-    std::size_t numPoints = data.rows();
-    std::size_t numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty())
+    std::vector<char> text;
+    std::vector<TextLine> lines;
+    readLines(inp, text, lines);
+
+    // skip the lines of the elements before the vertices
+    std::vector<TextLine> rows;
+    rows.reserve(data.rows());
+    for (std::vector<TextLine>::iterator it = lines.begin(); it != lines.end(); ++it) {
+        if (rows.size() == static_cast<std::size_t>(data.rows()))
+            break;
+        if (isBlank(*it))
             continue;
-
         if (offset > 0) {
             offset--;
             continue;
         }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        for (std::size_t col = 0; col < list.size() && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
+        rows.push_back(*it);
     }
+
+    parseRows(rows, data);
 }
 
 void PlyReader::readBinary(bool swapByteOrder,
+                           const std::string& filename,
                            std::istream& inp,
                            std::size_t offset,
                            const std::vector<std::string>& types,
                            const std::vector<int>& sizes,
                            Eigen::MatrixXd& data)
 {
-    std::size_t numPoints = data.rows();
     std::size_t numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
+    std::vector<NumberType> numberTypes;
     for (std::size_t j=0; j<numFields; j++) {
         std::string t = types[j];
         switch (sizes[j]) {
         case 1:
             if (t == "char" || t == "int8")
-                converters.push_back(convert_int8);
+                numberTypes.push_back(Int8);
             else if (t == "uchar" || t == "uint8")
-                converters.push_back(convert_uint8);
+                numberTypes.push_back(UInt8);
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 2:
             if (t == "short" || t == "int16")
-                converters.push_back(convert_int16);
+                numberTypes.push_back(Int16);
             else if (t == "ushort" || t == "uint16")
-                converters.push_back(convert_uint16);
+                numberTypes.push_back(UInt16);
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 4:
             if (t == "int" || t == "int32")
-                converters.push_back(convert_int32);
+                numberTypes.push_back(Int32);
             else if (t == "uint" || t == "uint32")
-                converters.push_back(convert_uint32);
+                numberTypes.push_back(UInt32);
             else if (t == "float" || t == "float32")
-                converters.push_back(convert_float32);
+                numberTypes.push_back(Float32);
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 8:
             if (t == "double" || t == "float64")
-                converters.push_back(convert_float64);
+                numberTypes.push_back(Float64);
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         default:
             throw Base::BadFormatError("Unexpected type");
         }
-
-        neededSize += converters.back()->getSizeOf();
     }
 
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize*static_cast<std::streamoff>(numPoints) > ulSize)
-            throw Base::BadFormatError("File expects too many elements");
-    }
-
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (std::size_t i=0; i<numPoints; i++) {
-        for (std::size_t j=0; j<numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
+    inp.seekg(static_cast<std::streamoff>(offset), std::ios::cur);
+    BinaryData binary(filename, inp, data.rows() * recordSize(numberTypes));
+    decodeRecords(binary.data(), numberTypes, swapByteOrder, false, data);
 }
 
 // ----------------------------------------------------------------------------
@@ -966,21 +1070,27 @@ void PcdReader::read(const std::string& filename)
         readAscii(inp, data);
     }
     else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
+        std::size_t size = 0;
+        for (std::vector<int>::iterator it = sizes.begin(); it != sizes.end(); ++it)
+            size += static_cast<std::size_t>(std::max(*it, 0));
+        BinaryData binary(filename, inp, numPoints * size);
+        readBinary(false, binary.data(), types, sizes, data);
     }
     else if (format == "binary_compressed") {
         unsigned int c, u;
         Base::InputStream str(inp);
         str >> c >> u;
 
-        std::vector<char> compressed(c);
-        inp.read(&compressed[0], c);
+        std::size_t size = 0;
+        for (std::vector<int>::iterator it = sizes.begin(); it != sizes.end(); ++it)
+            size += static_cast<std::size_t>(std::max(*it, 0));
+        if (u < numPoints * size)
+            throw Base::BadFormatError("File expects too many elements");
+
+        BinaryData compressed(filename, inp, c);
         std::vector<char> uncompressed(u);
-        if (lzfDecompress(&compressed[0], c, &uncompressed[0], u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(0);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
+        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
+            readBinary(true, uncompressed.data(), types, sizes, data);
         }
         else {
             throw Base::BadFormatError("Failed to decompress binary data");
@@ -1185,120 +1295,71 @@ std::size_t PcdReader::readHeader(std::istream& in,
 
 void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
 {
-    std::string line;
-    std::size_t row = 0;
-    std::size_t numPoints = data.rows();
-    std::size_t numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty())
-            continue;
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        for (std::size_t col = 0; col < list.size() && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
+    std::vector<char> text;
+    std::vector<TextLine> lines;
+    readLines(inp, text, lines);
+
+    std::vector<TextLine> rows;
+    rows.reserve(data.rows());
+    for (std::vector<TextLine>::iterator it = lines.begin(); it != lines.end(); ++it) {
+        if (rows.size() == static_cast<std::size_t>(data.rows()))
+            break;
+        if (!isBlank(*it))
+            rows.push_back(*it);
     }
+
+    parseRows(rows, data);
 }
 
 void PcdReader::readBinary(bool transpose,
-                           std::istream& inp,
+                           const char* buffer,
                            const std::vector<std::string>& types,
                            const std::vector<int>& sizes,
                            Eigen::MatrixXd& data)
 {
-    std::size_t numPoints = data.rows();
     std::size_t numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
+    std::vector<NumberType> numberTypes;
     for (std::size_t j=0; j<numFields; j++) {
         char t = types[j][0];
         switch (sizes[j]) {
         case 1:
             if (t == 'I')
-                converters.push_back(convert_int8);
+                numberTypes.push_back(Int8);
             else if (t == 'U')
-                converters.push_back(convert_uint8);
+                numberTypes.push_back(UInt8);
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 2:
             if (t == 'I')
-                converters.push_back(convert_int16);
+                numberTypes.push_back(Int16);
             else if (t == 'U')
-                converters.push_back(convert_uint16);
+                numberTypes.push_back(UInt16);
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 4:
             if (t == 'I')
-                converters.push_back(convert_int32);
+                numberTypes.push_back(Int32);
             else if (t == 'U')
-                converters.push_back(convert_uint32);
+                numberTypes.push_back(UInt32);
             else if (t == 'F')
-                converters.push_back(convert_float32);
+                numberTypes.push_back(Float32);
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         case 8:
             if (t == 'F')
-                converters.push_back(convert_float64);
+                numberTypes.push_back(Float64);
             else
                 throw Base::BadFormatError("Unexpected type");
             break;
         default:
             throw Base::BadFormatError("Unexpected type");
         }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize*static_cast<std::streamoff>(numPoints) > ulSize)
-            throw Base::BadFormatError("File expects too many elements");
     }
 
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (std::size_t j=0; j<numFields; j++) {
-            for (std::size_t i=0; i<numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (std::size_t i=0; i<numPoints; i++) {
-            for (std::size_t j=0; j<numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
+    decodeRecords(buffer, numberTypes, false, transpose, data);
 }
 
 // ----------------------------------------------------------------------------
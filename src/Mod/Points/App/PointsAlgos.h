@@ -92,7 +92,7 @@ private:
         std::vector<std::string>& fields, std::vector<std::string>& types,
         std::vector<int>& sizes);
     void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
-    void readBinary(bool swapByteOrder, std::istream&, std::size_t offset,
+    void readBinary(bool swapByteOrder, const std::string& filename, std::istream&, std::size_t offset,
         const std::vector<std::string>& types,
         const std::vector<int>& sizes,
         Eigen::MatrixXd& data);
@@ -109,7 +109,7 @@ private:
     std::size_t readHeader(std::istream&, std::string& format, std::vector<std::string>& fields,
         std::vector<std::string>& types, std::vector<int>& sizes);
     void readAscii(std::istream&, Eigen::MatrixXd& data);
-    void readBinary(bool transpose, std::istream&,
+    void readBinary(bool transpose, const char* buffer,
         const std::vector<std::string>& types,
         const std::vector<int>& sizes,
         Eigen::MatrixXd& data);
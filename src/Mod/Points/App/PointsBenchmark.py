@@ -0,0 +1,222 @@
+# -*- coding: utf-8 -*-
+
+#  Copyright (c) 2021 FreeCAD Developers
+#  LGPL
+
+# Benchmarks of the point cloud algorithms, run them from the FreeCAD Python
+# console or with FreeCADCmd:
+# import PointsBenchmark
+# PointsBenchmark.run_nearest(1000000, 100000)
+# PointsBenchmark.run_io(5000000)
+# PointsBenchmark.run_lod(500000000)
+
+import os
+import random
+import sys
+import tempfile
+import time
+import FreeCAD
+import Points
+
+
+def best_of(func, repeat):
+    best = None
+    result = None
+    for r in range(repeat):
+        start = time.time()
+        result = func()
+        elapsed = time.time() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best, result
+
+
+def make_random_points(count, seed=1):
+    rnd = random.Random(seed)
+    return [FreeCAD.Vector(rnd.uniform(0, 100), rnd.uniform(0, 100), rnd.uniform(0, 10))
+            for i in range(count)]
+
+
+def run_nearest(count=1000000, queries=100000, repeat=3):
+    points = Points.Points(make_random_points(count))
+    pnts = make_random_points(queries, seed=2)
+    print("nearest point: {} points, {} queries".format(count, queries))
+
+    results = {}
+    for name, grid in (("kd-tree", False), ("grid", True)):
+        best, result = best_of(lambda: points.findNearest(pnts, 5.0, grid), repeat)
+        results[name] = result
+        print("  {}: best of {}: {:.3f} s ({:.0f} queries/s)".format(
+            name, repeat, best, queries / best if best > 0 else 0.0))
+
+    # the grid only searches the cells next to the point
+    same = sum(1 for a, b in zip(results["kd-tree"], results["grid"])
+               if a is not None and b is not None and abs(a[1] - b[1]) < 1e-9)
+    print("  same distance: {} of {}".format(same, queries))
+
+
+def run_neighbours(count=1000000, queries=100000, k=8, radius=0.5, repeat=3):
+    points = Points.Points(make_random_points(count))
+    pnts = make_random_points(queries, seed=2)
+    print("neighbours: {} points, {} queries".format(count, queries))
+
+    best, result = best_of(lambda: points.findKNearest(pnts, k), repeat)
+    print("  {} nearest: best of {}: {:.3f} s ({:.0f} queries/s)".format(
+        k, repeat, best, queries / best if best > 0 else 0.0))
+
+    best, result = best_of(lambda: points.findInRadius(pnts, radius), repeat)
+    found = sum(len(i) for i in result)
+    print("  radius {}: {} points, best of {}: {:.3f} s ({:.0f} queries/s)".format(
+        radius, found, repeat, best, queries / best if best > 0 else 0.0))
+
+
+def run_io(count=5000000, repeat=3):
+    doc = FreeCAD.newDocument("PointsBenchmark")
+    feature = doc.addObject("Points::Feature", "Points")
+    feature.Points = Points.Points(make_random_points(count))
+    print("point I/O: {} points".format(count))
+
+    tmp = tempfile.mkdtemp()
+    try:
+        for ext in ("asc", "ply", "pcd"):
+            name = os.path.join(tmp, "points." + ext)
+            Points.export([feature], name)
+
+            def read():
+                Points.insert(name, doc.Name)
+                obj = doc.ActiveObject
+                size = obj.Points.CountPoints
+                doc.removeObject(obj.Name)
+                return size
+
+            best, size = best_of(read, repeat)
+            print("  read {}: {} points, best of {}: {:.3f} s ({:.0f} points/s)".format(
+                ext, size, repeat, best, size / best if best > 0 else 0.0))
+
+        name = os.path.join(tmp, "points.FCStd")
+        best, result = best_of(lambda: doc.saveAs(name), repeat)
+        print("  save document: best of {}: {:.3f} s ({:.0f} points/s)".format(
+            repeat, best, count / best if best > 0 else 0.0))
+        FreeCAD.closeDocument(doc.Name)
+        doc = None
+
+        def restore():
+            other = FreeCAD.openDocument(name)
+            size = other.getObject("Points").Points.CountPoints
+            FreeCAD.closeDocument(other.Name)
+            return size
+
+        best, size = best_of(restore, repeat)
+        print("  open document: {} points, best of {}: {:.3f} s ({:.0f} points/s)".format(
+            size, repeat, best, size / best if best > 0 else 0.0))
+    finally:
+        if doc is not None:
+            FreeCAD.closeDocument(doc.Name)
+        for f in os.listdir(tmp):
+            os.remove(os.path.join(tmp, f))
+        os.rmdir(tmp)
+
+
+def peak_memory():
+    """Returns the peak resident set size of the process in MB"""
+    try:
+        import resource
+    except ImportError:
+        return 0.0
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # bytes on macOS, kilobytes on Linux
+    return rss / (1024.0 * 1024.0) if sys.platform == "darwin" else rss / 1024.0
+
+
+def make_terrain_chunks(count, chunk=10000000, seed=1):
+    """Yields float32 arrays of x,y,z triples of a synthetic terrain"""
+    import numpy
+    rnd = numpy.random.RandomState(seed)
+    done = 0
+    while done < count:
+        num = min(chunk, count - done)
+        xyz = numpy.empty((num, 3), dtype=numpy.float32)
+        xyz[:, 0] = rnd.uniform(0, 1000, num)
+        xyz[:, 1] = rnd.uniform(0, 1000, num)
+        xyz[:, 2] = 20 * numpy.sin(xyz[:, 0] / 50) * numpy.cos(xyz[:, 1] / 70) + rnd.normal(0, 0.1, num)
+        done += num
+        yield xyz
+
+
+def run_lod(count=500000000, budget=5000000, width=1280, height=720, max_node_points=65536):
+    """Builds an octree file of a synthetic cloud, shows it with a Points::Tiled
+    object and measures the frame times of offscreen renderings. Without the GUI
+    only the build and the loading of the sample are measured."""
+    tmp = tempfile.mkdtemp()
+    name = os.path.join(tmp, "cloud.oct")
+    doc = None
+    print("level of detail: {} points, budget {}".format(count, budget))
+    try:
+        start = time.time()
+        Points.buildOctree(make_terrain_chunks(count), name, max_node_points)
+        elapsed = time.time() - start
+        print("  build octree: {:.3f} s ({:.0f} points/s), file {:.0f} MB, peak memory {:.0f} MB".format(
+            elapsed, count / elapsed if elapsed > 0 else 0.0,
+            os.path.getsize(name) / (1024.0 * 1024.0), peak_memory()))
+
+        doc = FreeCAD.newDocument("PointsBenchmark")
+        obj = doc.addObject("Points::Tiled", "Cloud")
+        obj.File = name
+        start = time.time()
+        doc.recompute()
+        elapsed = time.time() - start
+        print("  load sample: {} of {} points, {:.3f} s, peak memory {:.0f} MB".format(
+            obj.Points.CountPoints, obj.TotalPoints, elapsed, peak_memory()))
+
+        if not FreeCAD.GuiUp:
+            return
+
+        import FreeCADGui
+        obj.ViewObject.PointBudget = budget
+        view = FreeCADGui.getDocument(doc.Name).ActiveView
+        image = os.path.join(tmp, "frame.png")
+        views = ["viewIsometric", "viewTop", "viewFront", "viewRight", "viewAxonometric"]
+
+        def render():
+            start = time.time()
+            view.saveImage(image, width, height, "Current")
+            return time.time() - start
+
+        def refine():
+            # the points are read after a rendering, a part at a time
+            start = time.time()
+            shown = -1
+            frames = 0
+            while shown != obj.ViewObject.ShownPoints:
+                shown = obj.ViewObject.ShownPoints
+                FreeCADGui.updateGui()
+                render()
+                frames += 1
+            return time.time() - start, frames
+
+        for view_name in views:
+            getattr(view, view_name)()
+            view.fitAll()
+            FreeCADGui.updateGui()
+            first = render()
+            full, frames = refine()
+            again = render()
+            print("  {}: first frame {:.3f} s, full detail after {:.3f} s ({} frames), "
+                  "frame {:.3f} s, {} points, peak memory {:.0f} MB".format(
+                      view_name, first, full, frames, again,
+                      obj.ViewObject.ShownPoints, peak_memory()))
+
+        # zoom into the cloud to force the loading of finer nodes
+        for i in range(5):
+            view.zoomIn()
+            FreeCADGui.updateGui()
+            first = render()
+            full, frames = refine()
+            print("  zoom {}: first frame {:.3f} s, full detail after {:.3f} s ({} frames), "
+                  "{} points, peak memory {:.0f} MB".format(
+                      i + 1, first, full, frames, obj.ViewObject.ShownPoints, peak_memory()))
+    finally:
+        if doc is not None:
+            FreeCAD.closeDocument(doc.Name)
+        for f in os.listdir(tmp):
+            os.remove(os.path.join(tmp, f))
+        os.rmdir(tmp)
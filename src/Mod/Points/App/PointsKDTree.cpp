@@ -0,0 +1,377 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <limits>
+#endif
+
+#include <QThread>
+#include <QtConcurrentMap>
+#include <boost/math/special_functions/fpclassify.hpp>
+
+#include "PointsKDTree.h"
+
+using namespace Points;
+
+namespace {
+// ranges with at most this number of points are searched linearly
+const std::size_t LeafSize = 8;
+
+typedef std::pair<std::size_t, std::size_t> Range;
+
+// splits [0, count) into ranges for the worker threads
+std::vector<Range> splitRange(std::size_t count, std::size_t minSize)
+{
+    std::vector<Range> ranges;
+    std::size_t numRanges = 4 * static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1));
+    std::size_t size = std::max(minSize, (count + numRanges - 1) / numRanges);
+    for (std::size_t i = 0; i < count; i += size)
+        ranges.emplace_back(i, std::min(i + size, count));
+    return ranges;
+}
+
+inline double distance2(const Base::Vector3d& a, const Base::Vector3d& b)
+{
+    return Base::DistanceP2(a, b);
+}
+
+// The queries walk the subtree of the range [first, last) whose node is at
+// its middle. The far side of a node is only visited if the sphere around the
+// point with the current bound reaches across the split plane.
+class TreeSearch
+{
+public:
+    TreeSearch(const std::vector<Base::Vector3d>& points, const std::vector<unsigned char>& axes)
+        : points(points), axes(axes)
+    {
+    }
+
+    void nearest(std::size_t first, std::size_t last, const Base::Vector3d& pnt,
+                 double& bestDist2, std::size_t& bestPos) const
+    {
+        if (last - first <= LeafSize) {
+            for (std::size_t i = first; i < last; i++) {
+                double dist2 = distance2(pnt, points[i]);
+                if (dist2 < bestDist2) {
+                    bestDist2 = dist2;
+                    bestPos = i;
+                }
+            }
+            return;
+        }
+
+        std::size_t mid = first + (last - first) / 2;
+        double dist2 = distance2(pnt, points[mid]);
+        if (dist2 < bestDist2) {
+            bestDist2 = dist2;
+            bestPos = mid;
+        }
+
+        double diff = pnt[axes[mid]] - points[mid][axes[mid]];
+        if (diff < 0) {
+            nearest(first, mid, pnt, bestDist2, bestPos);
+            if (diff * diff < bestDist2)
+                nearest(mid + 1, last, pnt, bestDist2, bestPos);
+        }
+        else {
+            nearest(mid + 1, last, pnt, bestDist2, bestPos);
+            if (diff * diff < bestDist2)
+                nearest(first, mid, pnt, bestDist2, bestPos);
+        }
+    }
+
+    // the heap holds the k nearest points found so far, the farthest on top
+    void kNearest(std::size_t first, std::size_t last, const Base::Vector3d& pnt, std::size_t k,
+                  std::vector<std::pair<double, std::size_t> >& heap) const
+    {
+        if (last - first <= LeafSize) {
+            for (std::size_t i = first; i < last; i++)
+                addCandidate(distance2(pnt, points[i]), i, k, heap);
+            return;
+        }
+
+        std::size_t mid = first + (last - first) / 2;
+        addCandidate(distance2(pnt, points[mid]), mid, k, heap);
+
+        double diff = pnt[axes[mid]] - points[mid][axes[mid]];
+        std::size_t nearFirst = diff < 0 ? first : mid + 1;
+        std::size_t nearLast = diff < 0 ? mid : last;
+        std::size_t farFirst = diff < 0 ? mid + 1 : first;
+        std::size_t farLast = diff < 0 ? last : mid;
+        kNearest(nearFirst, nearLast, pnt, k, heap);
+        if (heap.size() < k || diff * diff < heap.front().first)
+            kNearest(farFirst, farLast, pnt, k, heap);
+    }
+
+    void inRange(std::size_t first, std::size_t last, const Base::Vector3d& pnt, double radius2,
+                 std::vector<std::size_t>& positions) const
+    {
+        if (last - first <= LeafSize) {
+            for (std::size_t i = first; i < last; i++) {
+                if (distance2(pnt, points[i]) <= radius2)
+                    positions.push_back(i);
+            }
+            return;
+        }
+
+        std::size_t mid = first + (last - first) / 2;
+        if (distance2(pnt, points[mid]) <= radius2)
+            positions.push_back(mid);
+
+        double diff = pnt[axes[mid]] - points[mid][axes[mid]];
+        if (diff <= 0 || diff * diff <= radius2)
+            inRange(first, mid, pnt, radius2, positions);
+        if (diff >= 0 || diff * diff <= radius2)
+            inRange(mid + 1, last, pnt, radius2, positions);
+    }
+
+private:
+    static void addCandidate(double dist2, std::size_t pos, std::size_t k,
+                             std::vector<std::pair<double, std::size_t> >& heap)
+    {
+        if (heap.size() < k) {
+            heap.emplace_back(dist2, pos);
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (dist2 < heap.front().first) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = std::make_pair(dist2, pos);
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+private:
+    const std::vector<Base::Vector3d>& points;
+    const std::vector<unsigned char>& axes;
+};
+}
+
+PointsKDTree::PointsKDTree(const PointKernel& kernel)
+{
+    _points.reserve(kernel.size());
+    _indices.reserve(kernel.size());
+    for (std::size_t i = 0; i < kernel.size(); i++) {
+        Base::Vector3d pnt = kernel.getPoint(static_cast<int>(i));
+        if (!boost::math::isnan(pnt.x) && !boost::math::isnan(pnt.y) && !boost::math::isnan(pnt.z)) {
+            _points.push_back(pnt);
+            _indices.push_back(i);
+        }
+    }
+    Build();
+}
+
+PointsKDTree::PointsKDTree(const std::vector<Base::Vector3d>& points)
+{
+    _points.reserve(points.size());
+    _indices.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        const Base::Vector3d& pnt = points[i];
+        if (!boost::math::isnan(pnt.x) && !boost::math::isnan(pnt.y) && !boost::math::isnan(pnt.z)) {
+            _points.push_back(pnt);
+            _indices.push_back(i);
+        }
+    }
+    Build();
+}
+
+PointsKDTree::~PointsKDTree()
+{
+}
+
+void PointsKDTree::Build()
+{
+    std::size_t count = _points.size();
+    _axes.resize(count, 0);
+
+    // the positions of the points in the sorted order
+    std::vector<std::size_t> order(count);
+    for (std::size_t i = 0; i < count; i++)
+        order[i] = i;
+
+    const std::vector<Base::Vector3d>& points = _points;
+    auto split = [&](const Range& range, std::vector<Range>& subRanges) {
+        std::size_t first = range.first;
+        std::size_t last = range.second;
+        if (last - first <= LeafSize)
+            return;
+
+        // split at the median along the axis of the largest extent
+        Base::Vector3d minPnt = points[order[first]];
+        Base::Vector3d maxPnt = minPnt;
+        for (std::size_t i = first + 1; i < last; i++) {
+            const Base::Vector3d& pnt = points[order[i]];
+            for (unsigned short j = 0; j < 3; j++) {
+                minPnt[j] = std::min(minPnt[j], pnt[j]);
+                maxPnt[j] = std::max(maxPnt[j], pnt[j]);
+            }
+        }
+        Base::Vector3d extent = maxPnt - minPnt;
+        unsigned char axis = 0;
+        if (extent.y > extent[axis])
+            axis = 1;
+        if (extent.z > extent[axis])
+            axis = 2;
+
+        std::size_t mid = first + (last - first) / 2;
+        std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + last,
+                         [&points, axis](std::size_t a, std::size_t b) {
+            return points[a][axis] < points[b][axis];
+        });
+        _axes[mid] = axis;
+        subRanges.emplace_back(first, mid);
+        subRanges.emplace_back(mid + 1, last);
+    };
+
+    // the upper levels are split one after another, then the subtrees are
+    // built in parallel
+    std::vector<Range> ranges;
+    ranges.emplace_back(0, count);
+    std::size_t numRanges = 4 * static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1));
+    while (ranges.size() < numRanges) {
+        std::vector<Range> next;
+        for (const Range& range : ranges)
+            split(range, next);
+        if (next.empty())
+            break;
+        ranges.swap(next);
+    }
+
+    QtConcurrent::blockingMap(ranges, [&split](const Range& range) {
+        std::vector<Range> todo;
+        todo.push_back(range);
+        while (!todo.empty()) {
+            Range current = todo.back();
+            todo.pop_back();
+            split(current, todo);
+        }
+    });
+
+    // store the points in tree order
+    std::vector<Base::Vector3d> sortedPoints(count);
+    std::vector<unsigned long> sortedIndices(count);
+    for (std::size_t i = 0; i < count; i++) {
+        sortedPoints[i] = _points[order[i]];
+        sortedIndices[i] = _indices[order[i]];
+    }
+    _points.swap(sortedPoints);
+    _indices.swap(sortedIndices);
+}
+
+std::size_t PointsKDTree::size() const
+{
+    return _points.size();
+}
+
+bool PointsKDTree::FindNearest(const Base::Vector3d& pnt, double maxDist, unsigned long& index, double& dist) const
+{
+    if (maxDist < 0)
+        return false;
+
+    // a point exactly at the maximum distance is accepted, too
+    double bestDist2 = std::numeric_limits<double>::max();
+    if (maxDist < std::sqrt(bestDist2))
+        bestDist2 = std::nextafter(maxDist * maxDist, bestDist2);
+    std::size_t bestPos = _points.size();
+    TreeSearch search(_points, _axes);
+    search.nearest(0, _points.size(), pnt, bestDist2, bestPos);
+    if (bestPos == _points.size())
+        return false;
+
+    index = _indices[bestPos];
+    dist = std::sqrt(distance2(pnt, _points[bestPos]));
+    return true;
+}
+
+void PointsKDTree::FindKNearest(const Base::Vector3d& pnt, std::size_t k, std::vector<unsigned long>& indices) const
+{
+    indices.clear();
+    if (k == 0)
+        return;
+
+    std::vector<std::pair<double, std::size_t> > heap;
+    heap.reserve(k + 1);
+    TreeSearch search(_points, _axes);
+    search.kNearest(0, _points.size(), pnt, k, heap);
+    std::sort_heap(heap.begin(), heap.end());
+    indices.reserve(heap.size());
+    for (const auto& it : heap)
+        indices.push_back(_indices[it.second]);
+}
+
+void PointsKDTree::FindInRange(const Base::Vector3d& pnt, double radius, std::vector<unsigned long>& indices) const
+{
+    indices.clear();
+    if (radius < 0)
+        return;
+
+    std::vector<std::size_t> positions;
+    TreeSearch search(_points, _axes);
+    search.inRange(0, _points.size(), pnt, radius * radius, positions);
+    indices.reserve(positions.size());
+    for (std::size_t pos : positions)
+        indices.push_back(_indices[pos]);
+    std::sort(indices.begin(), indices.end());
+}
+
+void PointsKDTree::FindNearest(const std::vector<Base::Vector3d>& pnts, double maxDist,
+                               std::vector<long>& indices, std::vector<double>& dists) const
+{
+    indices.resize(pnts.size());
+    dists.resize(pnts.size());
+    std::vector<Range> ranges = splitRange(pnts.size(), 1024);
+    QtConcurrent::blockingMap(ranges, [&](const Range& range) {
+        for (std::size_t i = range.first; i < range.second; i++) {
+            unsigned long index;
+            if (FindNearest(pnts[i], maxDist, index, dists[i]))
+                indices[i] = static_cast<long>(index);
+            else
+                indices[i] = -1;
+        }
+    });
+}
+
+void PointsKDTree::FindKNearest(const std::vector<Base::Vector3d>& pnts, std::size_t k,
+                                std::vector<std::vector<unsigned long> >& indices) const
+{
+    indices.resize(pnts.size());
+    std::vector<Range> ranges = splitRange(pnts.size(), 256);
+    QtConcurrent::blockingMap(ranges, [&](const Range& range) {
+        for (std::size_t i = range.first; i < range.second; i++)
+            FindKNearest(pnts[i], k, indices[i]);
+    });
+}
+
+void PointsKDTree::FindInRange(const std::vector<Base::Vector3d>& pnts, double radius,
+                               std::vector<std::vector<unsigned long> >& indices) const
+{
+    indices.resize(pnts.size());
+    std::vector<Range> ranges = splitRange(pnts.size(), 256);
+    QtConcurrent::blockingMap(ranges, [&](const Range& range) {
+        for (std::size_t i = range.first; i < range.second; i++)
+            FindInRange(pnts[i], radius, indices[i]);
+    });
+}
@@ -0,0 +1,91 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef POINTS_KDTREE_H
+#define POINTS_KDTREE_H
+
+#include <vector>
+
+#include "Points.h"
+#include <Base/Vector3D.h>
+
+namespace Points {
+
+/**
+ * The PointsKDTree is a balanced kd-tree of a point cloud stored in flat arrays.
+ * The points are sorted so that the point of a node is in the middle of the range
+ * of its subtree, therefore no child pointers are needed. Invalid (NaN) points are
+ * not added to the tree.
+ *
+ * All queries are const and can be called from several threads at once; the
+ * methods taking a list of points run the queries in parallel.
+ * The indices returned are the indices of the points in the point cloud.
+ */
+class PointsExport PointsKDTree
+{
+public:
+    /// Builds the tree of the transformed points of the kernel
+    PointsKDTree(const PointKernel&);
+    PointsKDTree(const std::vector<Base::Vector3d>&);
+    ~PointsKDTree();
+
+    /// Number of points in the tree
+    std::size_t size() const;
+
+    /** @name Single queries */
+    //@{
+    /** Finds the nearest point not farther away than \a maxDist.
+     * Returns false if there is no such point.
+     */
+    bool FindNearest(const Base::Vector3d& pnt, double maxDist, unsigned long& index, double& dist) const;
+    /// Finds up to \a k nearest points, sorted by their distance
+    void FindKNearest(const Base::Vector3d& pnt, std::size_t k, std::vector<unsigned long>& indices) const;
+    /// Finds all points inside the sphere, sorted by their index
+    void FindInRange(const Base::Vector3d& pnt, double radius, std::vector<unsigned long>& indices) const;
+    //@}
+
+    /** @name Batched queries */
+    //@{
+    /** Finds the nearest point of each point. The index is -1 if no point is
+     * closer than \a maxDist, its distance is then undefined.
+     */
+    void FindNearest(const std::vector<Base::Vector3d>& pnts, double maxDist,
+                     std::vector<long>& indices, std::vector<double>& dists) const;
+    void FindKNearest(const std::vector<Base::Vector3d>& pnts, std::size_t k,
+                      std::vector<std::vector<unsigned long> >& indices) const;
+    void FindInRange(const std::vector<Base::Vector3d>& pnts, double radius,
+                     std::vector<std::vector<unsigned long> >& indices) const;
+    //@}
+
+private:
+    void Build();
+
+private:
+    std::vector<Base::Vector3d> _points;   /**< The points in tree order. */
+    std::vector<unsigned long> _indices;   /**< The original index of each point. */
+    std::vector<unsigned char> _axes;      /**< The split axis of the node at each position. */
+};
+
+} // namespace Points
+
+#endif // POINTS_KDTREE_H
@@ -0,0 +1,719 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cfloat>
+# include <cmath>
+# include <cstring>
+# include <queue>
+# include <unordered_set>
+#endif
+
+#include <QThread>
+#include <QtConcurrentMap>
+#include <boost/math/special_functions/fpclassify.hpp>
+
+#include <Base/Exception.h>
+#include <Base/Stream.h>
+
+#include "Points.h"
+#include "PointsOctree.h"
+
+using namespace Points;
+
+namespace {
+const char Magic[8] = {'F', 'C', 'P', 'O', 'C', 'T', 'R', 'E'};
+const uint32_t Version = 1;
+// the size of the header: magic, version, max. node points, number of points,
+// number of nodes, root, table offset and bounding box
+const std::streamoff HeaderSize = 8 + 4 + 4 + 8 + 4 + 4 + 8 + 6 * 4;
+// the average number of points of a tile that is built in memory
+const uint64_t TileSize = 4000000;
+const int MaxTileDepth = 4;
+// below this size of a node the float precision doesn't allow to split it
+const int MaxDepth = 21;
+const std::size_t ChunkSize = 1 << 20;
+
+typedef PointsOctree::Node Node;
+typedef std::vector<Base::Vector3f> PointList;
+
+Node makeNode(const Base::BoundBox3f& box)
+{
+    Node node;
+    node.box = box;
+    node.offset = 0;
+    node.count = 0;
+    std::fill(node.children, node.children + 8, -1);
+    return node;
+}
+
+inline int octant(const Base::Vector3f& pnt, const Base::Vector3f& center)
+{
+    return (pnt.x >= center.x ? 1 : 0) | (pnt.y >= center.y ? 2 : 0) | (pnt.z >= center.z ? 4 : 0);
+}
+
+Base::BoundBox3f childBox(const Base::BoundBox3f& box, int index)
+{
+    Base::Vector3f center = box.GetCenter();
+    Base::BoundBox3f child = box;
+    (index & 1 ? child.MinX : child.MaxX) = center.x;
+    (index & 2 ? child.MinY : child.MaxY) = center.y;
+    (index & 4 ? child.MinZ : child.MaxZ) = center.z;
+    return child;
+}
+
+// Keeps the first point of each cell of a grid laid over the box, and thins
+// the rest out evenly if there are still too many. The grid has about as many
+// cells on a surface through the box as points are wanted.
+void samplePoints(const PointList& input, const Base::BoundBox3f& box, std::size_t maxPoints, PointList& output)
+{
+    output.clear();
+    if (input.size() <= maxPoints) {
+        output = input;
+        return;
+    }
+
+    // an even resolution, so that no cell overlaps two children
+    uint64_t res = std::max<uint64_t>(2, 2 * static_cast<uint64_t>(std::sqrt(static_cast<double>(maxPoints)) / 2));
+    float lenX = std::max(box.LengthX(), FLT_MIN);
+    float lenY = std::max(box.LengthY(), FLT_MIN);
+    float lenZ = std::max(box.LengthZ(), FLT_MIN);
+    std::unordered_set<uint64_t> cells;
+    cells.reserve(2 * maxPoints);
+    PointList candidates;
+    for (const Base::Vector3f& pnt : input) {
+        uint64_t x = std::min<uint64_t>(res - 1, static_cast<uint64_t>(std::max(0.0f, (pnt.x - box.MinX) / lenX) * res));
+        uint64_t y = std::min<uint64_t>(res - 1, static_cast<uint64_t>(std::max(0.0f, (pnt.y - box.MinY) / lenY) * res));
+        uint64_t z = std::min<uint64_t>(res - 1, static_cast<uint64_t>(std::max(0.0f, (pnt.z - box.MinZ) / lenZ) * res));
+        if (cells.insert(x + res * (y + res * z)).second)
+            candidates.push_back(pnt);
+    }
+
+    if (candidates.size() <= maxPoints) {
+        output.swap(candidates);
+    }
+    else {
+        output.reserve(maxPoints);
+        for (std::size_t i = 0; i < maxPoints; i++)
+            output.push_back(candidates[i * candidates.size() / maxPoints]);
+    }
+}
+
+// The nodes of a subtree with their points, the points of a node are freed
+// once they are written to the file
+struct SubTree
+{
+    std::vector<Node> nodes;
+    std::vector<PointList> points;
+
+    int32_t build(PointList& pnts, const Base::BoundBox3f& box, std::size_t maxNodePoints, int depth)
+    {
+        int32_t index = static_cast<int32_t>(nodes.size());
+        nodes.push_back(makeNode(box));
+        points.emplace_back();
+        if (pnts.size() <= maxNodePoints || depth >= MaxDepth) {
+            nodes[index].count = static_cast<uint32_t>(pnts.size());
+            points[index].swap(pnts);
+            return index;
+        }
+
+        Base::Vector3f center = box.GetCenter();
+        PointList parts[8];
+        std::size_t counts[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        for (const Base::Vector3f& pnt : pnts)
+            counts[octant(pnt, center)]++;
+        for (int i = 0; i < 8; i++)
+            parts[i].reserve(counts[i]);
+        for (const Base::Vector3f& pnt : pnts)
+            parts[octant(pnt, center)].push_back(pnt);
+        PointList().swap(pnts);
+
+        PointList candidates;
+        for (int i = 0; i < 8; i++) {
+            if (parts[i].empty())
+                continue;
+            int32_t child = build(parts[i], childBox(box, i), maxNodePoints, depth + 1);
+            nodes[index].children[i] = child;
+            candidates.insert(candidates.end(), points[child].begin(), points[child].end());
+        }
+
+        samplePoints(candidates, box, maxNodePoints, points[index]);
+        nodes[index].count = static_cast<uint32_t>(points[index].size());
+        return index;
+    }
+};
+
+// Writes the points of nodes to the octree file and collects the node table
+class OctreeWriter
+{
+public:
+    explicit OctreeWriter(const std::string& fileName)
+      : file(fileName)
+      , out(file, std::ios::out | std::ios::binary)
+    {
+        if (!out)
+            throw Base::FileException("Cannot write octree file", file);
+        // the header is written at the end
+        std::vector<char> header(HeaderSize, 0);
+        out.write(header.data(), HeaderSize);
+    }
+
+    int32_t addNode(Node node, const PointList& pnts)
+    {
+        node.offset = static_cast<uint64_t>(out.tellp());
+        node.count = static_cast<uint32_t>(pnts.size());
+        Base::OutputStream str(out);
+        str.write(reinterpret_cast<const float*>(pnts.data()), 3 * pnts.size());
+        nodes.push_back(node);
+        return static_cast<int32_t>(nodes.size() - 1);
+    }
+
+    // adds the nodes of a subtree, returns the index of its root
+    int32_t addSubTree(SubTree& tree)
+    {
+        int32_t base = static_cast<int32_t>(nodes.size());
+        for (std::size_t i = 0; i < tree.nodes.size(); i++) {
+            Node node = tree.nodes[i];
+            for (int j = 0; j < 8; j++) {
+                if (node.children[j] >= 0)
+                    node.children[j] += base;
+            }
+            addNode(node, tree.points[i]);
+            PointList().swap(tree.points[i]);
+        }
+        return base;
+    }
+
+    void finish(int32_t root, uint64_t numPoints, std::size_t maxNodePoints, const Base::BoundBox3f& box)
+    {
+        uint64_t tableOffset = static_cast<uint64_t>(out.tellp());
+        Base::OutputStream str(out);
+        for (const Node& node : nodes) {
+            str << node.box.MinX << node.box.MinY << node.box.MinZ
+                << node.box.MaxX << node.box.MaxY << node.box.MaxZ;
+            str << node.offset << node.count;
+            for (int j = 0; j < 8; j++)
+                str << node.children[j];
+        }
+
+        out.seekp(0, std::ios::beg);
+        out.write(Magic, 8);
+        str << Version << static_cast<uint32_t>(maxNodePoints) << numPoints
+            << static_cast<uint32_t>(nodes.size()) << root << tableOffset;
+        str << box.MinX << box.MinY << box.MinZ << box.MaxX << box.MaxY << box.MaxZ;
+        out.close();
+        if (out.fail())
+            throw Base::FileException("Failed to write octree file", file);
+    }
+
+private:
+    Base::FileInfo file;
+    Base::ofstream out;
+    std::vector<Node> nodes;
+};
+
+// the temporary files of the build are removed when it's finished or failed
+class TempFile
+{
+public:
+    explicit TempFile(const std::string& fileName) : file(fileName)
+    {
+    }
+    ~TempFile()
+    {
+        if (file.exists())
+            file.deleteFile();
+    }
+    const Base::FileInfo& info() const
+    {
+        return file;
+    }
+
+private:
+    Base::FileInfo file;
+};
+
+// the upper levels of the tree above the tiles are built from the tile roots
+struct UpperLevels
+{
+    int tileDepth;
+    std::vector<int32_t> tileRoots;
+    std::vector<PointList> tileSamples;
+    std::size_t maxNodePoints;
+    OctreeWriter* writer;
+
+    int32_t build(const Base::BoundBox3f& box, int depth, uint64_t x, uint64_t y, uint64_t z, PointList& sample)
+    {
+        uint64_t numTiles = uint64_t(1) << tileDepth;
+        if (depth == tileDepth) {
+            std::size_t tile = static_cast<std::size_t>(x + numTiles * (y + numTiles * z));
+            sample.swap(tileSamples[tile]);
+            return tileRoots[tile];
+        }
+
+        Node node = makeNode(box);
+        PointList candidates;
+        for (int i = 0; i < 8; i++) {
+            PointList childSample;
+            int32_t child = build(childBox(box, i), depth + 1,
+                                  2 * x + (i & 1 ? 1 : 0),
+                                  2 * y + (i & 2 ? 1 : 0),
+                                  2 * z + (i & 4 ? 1 : 0), childSample);
+            node.children[i] = child;
+            candidates.insert(candidates.end(), childSample.begin(), childSample.end());
+        }
+
+        bool empty = std::all_of(node.children, node.children + 8, [](int32_t c) { return c < 0; });
+        if (empty)
+            return -1;
+
+        PointList pnts;
+        samplePoints(candidates, box, maxNodePoints, pnts);
+        int32_t index = writer->addNode(node, pnts);
+        // pass on a part of the sample to the parent
+        sample.clear();
+        std::size_t maxSample = std::max<std::size_t>(1, maxNodePoints / 4);
+        for (std::size_t i = 0; i < std::min(maxSample, pnts.size()); i++)
+            sample.push_back(pnts[i * pnts.size() / std::min(maxSample, pnts.size())]);
+        return index;
+    }
+};
+}
+
+// ----------------------------------------------------------------------------
+
+bool PointsOctree::Node::isLeaf() const
+{
+    for (int i = 0; i < 8; i++) {
+        if (children[i] >= 0)
+            return false;
+    }
+    return true;
+}
+
+PointsOctree::PointsOctree()
+  : _root(-1)
+  , _numPoints(0)
+{
+}
+
+PointsOctree::~PointsOctree()
+{
+}
+
+void PointsOctree::Build(const PointKernel& kernel, const std::string& fileName, std::size_t maxNodePoints)
+{
+    // the points are stored in the local coordinate system of the kernel
+    const std::vector<PointKernel::value_type>& pnts = kernel.getBasicPoints();
+    std::size_t pos = 0;
+    Build([&pnts, &pos](PointList& chunk) {
+        std::size_t num = std::min(ChunkSize, pnts.size() - pos);
+        chunk.assign(pnts.begin() + pos, pnts.begin() + pos + num);
+        pos += num;
+        return num > 0;
+    }, fileName, maxNodePoints);
+}
+
+void PointsOctree::Build(const ChunkReader& reader, const std::string& fileName, std::size_t maxNodePoints)
+{
+    maxNodePoints = std::max<std::size_t>(maxNodePoints, 1);
+
+    // spool the valid points to disk and get the bounding box
+    TempFile spoolFile(fileName + ".spool");
+    uint64_t numPoints = 0;
+    Base::BoundBox3f bbox;
+    {
+        Base::ofstream spool(spoolFile.info(), std::ios::out | std::ios::binary);
+        if (!spool)
+            throw Base::FileException("Cannot write temporary file", spoolFile.info());
+        PointList chunk;
+        while (true) {
+            chunk.clear();
+            bool more = reader(chunk);
+            chunk.erase(std::remove_if(chunk.begin(), chunk.end(), [](const Base::Vector3f& p) {
+                return boost::math::isnan(p.x) || boost::math::isnan(p.y) || boost::math::isnan(p.z);
+            }), chunk.end());
+            for (const Base::Vector3f& pnt : chunk)
+                bbox.Add(pnt);
+            Base::OutputStream str(spool);
+            str.write(reinterpret_cast<const float*>(chunk.data()), 3 * chunk.size());
+            numPoints += chunk.size();
+            if (!more)
+                break;
+        }
+        spool.close();
+        if (spool.fail())
+            throw Base::FileException("Failed to write temporary file", spoolFile.info());
+    }
+
+    OctreeWriter writer(fileName);
+    if (numPoints == 0) {
+        writer.finish(-1, 0, maxNodePoints, bbox);
+        return;
+    }
+
+    // make a cube, so that the nodes have the same size in each direction
+    Base::Vector3f center = bbox.GetCenter();
+    float half = 0.5f * std::max(std::max(bbox.LengthX(), bbox.LengthY()), bbox.LengthZ());
+    half = std::max(half * 1.0001f, FLT_MIN);
+    Base::BoundBox3f cube(center.x - half, center.y - half, center.z - half,
+                          center.x + half, center.y + half, center.z + half);
+
+    int tileDepth = 0;
+    while (tileDepth < MaxTileDepth && (numPoints >> (3 * tileDepth)) > TileSize)
+        tileDepth++;
+    uint64_t tilesPerAxis = uint64_t(1) << tileDepth;
+    std::size_t numTiles = static_cast<std::size_t>(tilesPerAxis * tilesPerAxis * tilesPerAxis);
+    auto tileOf = [&cube, tilesPerAxis](const Base::Vector3f& pnt) {
+        float size = cube.LengthX();
+        uint64_t x = std::min<uint64_t>(tilesPerAxis - 1, static_cast<uint64_t>(std::max(0.0f, (pnt.x - cube.MinX) / size) * tilesPerAxis));
+        uint64_t y = std::min<uint64_t>(tilesPerAxis - 1, static_cast<uint64_t>(std::max(0.0f, (pnt.y - cube.MinY) / size) * tilesPerAxis));
+        uint64_t z = std::min<uint64_t>(tilesPerAxis - 1, static_cast<uint64_t>(std::max(0.0f, (pnt.z - cube.MinZ) / size) * tilesPerAxis));
+        return static_cast<std::size_t>(x + tilesPerAxis * (y + tilesPerAxis * z));
+    };
+    auto readSpool = [&spoolFile](const std::function<void (const PointList&)>& func) {
+        Base::ifstream spool(spoolFile.info(), std::ios::in | std::ios::binary);
+        PointList chunk(ChunkSize);
+        while (true) {
+            spool.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(ChunkSize * sizeof(Base::Vector3f)));
+            std::size_t num = static_cast<std::size_t>(spool.gcount()) / sizeof(Base::Vector3f);
+            if (num == 0)
+                break;
+            chunk.resize(num);
+            func(chunk);
+            chunk.resize(ChunkSize);
+        }
+    };
+
+    // sort the points into the tiles on disk, each tile is a contiguous block
+    std::vector<uint64_t> tileCounts(numTiles, 0);
+    readSpool([&](const PointList& chunk) {
+        for (const Base::Vector3f& pnt : chunk)
+            tileCounts[tileOf(pnt)]++;
+    });
+
+    std::vector<uint64_t> tileOffsets(numTiles, 0);
+    for (std::size_t i = 1; i < numTiles; i++)
+        tileOffsets[i] = tileOffsets[i - 1] + tileCounts[i - 1];
+
+    TempFile tileFile(fileName + ".tiles");
+    {
+        std::fstream tiles;
+        tiles.open(tileFile.info().filePath().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        tiles.close();
+        tiles.open(tileFile.info().filePath().c_str(), std::ios::in | std::ios::out | std::ios::binary);
+        if (!tiles)
+            throw Base::FileException("Cannot write temporary file", tileFile.info());
+
+        std::size_t bufferSize = std::max<std::size_t>(256, (32 * ChunkSize) / numTiles);
+        std::vector<PointList> buffers(numTiles);
+        std::vector<uint64_t> written(numTiles, 0);
+        auto flush = [&](std::size_t tile) {
+            PointList& buffer = buffers[tile];
+            tiles.seekp(static_cast<std::streamoff>((tileOffsets[tile] + written[tile]) * sizeof(Base::Vector3f)));
+            Base::OutputStream str(tiles);
+            str.write(reinterpret_cast<const float*>(buffer.data()), 3 * buffer.size());
+            written[tile] += buffer.size();
+            buffer.clear();
+        };
+        readSpool([&](const PointList& chunk) {
+            for (const Base::Vector3f& pnt : chunk) {
+                std::size_t tile = tileOf(pnt);
+                buffers[tile].push_back(pnt);
+                if (buffers[tile].size() >= bufferSize)
+                    flush(tile);
+            }
+        });
+        for (std::size_t i = 0; i < numTiles; i++) {
+            if (!buffers[i].empty())
+                flush(i);
+        }
+        tiles.close();
+        if (tiles.fail())
+            throw Base::FileException("Failed to write temporary file", tileFile.info());
+    }
+    spoolFile.info().deleteFile();
+
+    // build the subtrees of the tiles, a few at a time
+    UpperLevels upper;
+    upper.tileDepth = tileDepth;
+    upper.tileRoots.resize(numTiles, -1);
+    upper.tileSamples.resize(numTiles);
+    upper.maxNodePoints = maxNodePoints;
+    upper.writer = &writer;
+
+    std::size_t batchSize = static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1));
+    for (std::size_t first = 0; first < numTiles; first += batchSize) {
+        std::vector<std::size_t> batch;
+        for (std::size_t i = first; i < std::min(first + batchSize, numTiles); i++) {
+            if (tileCounts[i] > 0)
+                batch.push_back(i);
+        }
+
+        std::vector<SubTree> trees(batch.size());
+        std::vector<std::string> errors(batch.size());
+        QtConcurrent::blockingMap(batch, [&](const std::size_t& tile) {
+            std::size_t index = &tile - batch.data();
+            try {
+                Base::ifstream tiles(tileFile.info(), std::ios::in | std::ios::binary);
+                tiles.seekg(static_cast<std::streamoff>(tileOffsets[tile] * sizeof(Base::Vector3f)));
+                PointList pnts(static_cast<std::size_t>(tileCounts[tile]));
+                Base::InputStream str(tiles);
+                if (!str.read(reinterpret_cast<float*>(pnts.data()), 3 * pnts.size()))
+                    throw Base::FileException("Failed to read temporary file", tileFile.info());
+
+                uint64_t x = tile % tilesPerAxis;
+                uint64_t y = (tile / tilesPerAxis) % tilesPerAxis;
+                uint64_t z = tile / (tilesPerAxis * tilesPerAxis);
+                float size = cube.LengthX() / tilesPerAxis;
+                Base::BoundBox3f box(cube.MinX + x * size, cube.MinY + y * size, cube.MinZ + z * size,
+                                     cube.MinX + (x + 1) * size, cube.MinY + (y + 1) * size, cube.MinZ + (z + 1) * size);
+                if (x == tilesPerAxis - 1)
+                    box.MaxX = cube.MaxX;
+                if (y == tilesPerAxis - 1)
+                    box.MaxY = cube.MaxY;
+                if (z == tilesPerAxis - 1)
+                    box.MaxZ = cube.MaxZ;
+                trees[index].build(pnts, box, maxNodePoints, tileDepth);
+            }
+            catch (const Base::Exception& e) {
+                errors[index] = e.what();
+            }
+            catch (const std::exception& e) {
+                errors[index] = e.what();
+            }
+        });
+
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            if (!errors[i].empty())
+                throw Base::RuntimeError(errors[i]);
+
+            // keep a part of the root sample for the levels above
+            const PointList& rootPoints = trees[i].points.front();
+            PointList& sample = upper.tileSamples[batch[i]];
+            std::size_t maxSample = std::min(rootPoints.size(), std::max<std::size_t>(1, maxNodePoints / 4));
+            for (std::size_t j = 0; j < maxSample; j++)
+                sample.push_back(rootPoints[j * rootPoints.size() / maxSample]);
+            upper.tileRoots[batch[i]] = writer.addSubTree(trees[i]);
+        }
+    }
+
+    PointList rootSample;
+    int32_t root = upper.build(cube, 0, 0, 0, 0, rootSample);
+    writer.finish(root, numPoints, maxNodePoints, cube);
+}
+
+void PointsOctree::Open(const std::string& fileName)
+{
+    Close();
+
+    Base::FileInfo file(fileName);
+    std::unique_ptr<std::istream> in(new Base::ifstream(file, std::ios::in | std::ios::binary));
+    if (!*in)
+        throw Base::FileException("Cannot open octree file", file);
+
+    char magic[8];
+    in->read(magic, 8);
+    if (in->gcount() != 8 || std::memcmp(magic, Magic, 8) != 0)
+        throw Base::BadFormatError("Not an octree file");
+
+    Base::InputStream str(*in);
+    uint32_t version = 0, maxNodePoints = 0, numNodes = 0;
+    int32_t root = -1;
+    uint64_t numPoints = 0, tableOffset = 0;
+    str >> version;
+    if (version != Version)
+        throw Base::BadFormatError("Unsupported octree file version");
+    str >> maxNodePoints >> numPoints >> numNodes >> root >> tableOffset;
+    Base::BoundBox3f box;
+    str >> box.MinX >> box.MinY >> box.MinZ >> box.MaxX >> box.MaxY >> box.MaxZ;
+    if (!*in || root >= static_cast<int32_t>(numNodes))
+        throw Base::BadFormatError("Invalid octree file");
+
+    std::vector<Node> nodes(numNodes);
+    in->seekg(static_cast<std::streamoff>(tableOffset), std::ios::beg);
+    for (Node& node : nodes) {
+        str >> node.box.MinX >> node.box.MinY >> node.box.MinZ
+            >> node.box.MaxX >> node.box.MaxY >> node.box.MaxZ;
+        str >> node.offset >> node.count;
+        for (int j = 0; j < 8; j++) {
+            str >> node.children[j];
+            if (node.children[j] >= static_cast<int32_t>(numNodes))
+                throw Base::BadFormatError("Invalid octree file");
+        }
+    }
+    if (!*in)
+        throw Base::BadFormatError("Invalid octree file");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _nodes.swap(nodes);
+    _root = numNodes > 0 ? root : -1;
+    _numPoints = numPoints;
+    _box = box;
+    _file = file;
+    _stream = std::move(in);
+}
+
+bool PointsOctree::IsOpen() const
+{
+    return _stream.get() != nullptr;
+}
+
+void PointsOctree::Close()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stream.reset();
+    _nodes.clear();
+    _root = -1;
+    _numPoints = 0;
+    _box = Base::BoundBox3f();
+}
+
+uint64_t PointsOctree::CountPoints() const
+{
+    return _numPoints;
+}
+
+const Base::BoundBox3f& PointsOctree::GetBoundBox() const
+{
+    return _box;
+}
+
+const std::vector<PointsOctree::Node>& PointsOctree::GetNodes() const
+{
+    return _nodes;
+}
+
+int32_t PointsOctree::GetRoot() const
+{
+    return _root;
+}
+
+void PointsOctree::ReadNode(std::size_t index, std::vector<Base::Vector3f>& points) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_stream || index >= _nodes.size())
+        throw Base::IndexError("Invalid octree node");
+
+    const Node& node = _nodes[index];
+    points.resize(node.count);
+    _stream->clear();
+    _stream->seekg(static_cast<std::streamoff>(node.offset), std::ios::beg);
+    Base::InputStream str(*_stream);
+    if (!str.read(reinterpret_cast<float*>(points.data()), 3 * points.size())) {
+        points.clear();
+        throw Base::FileException("Failed to read octree file", _file);
+    }
+}
+
+void PointsOctree::SelectNodes(const ProjectedSize& size, uint64_t budget, float minSpacing,
+                               std::vector<std::size_t>& nodes) const
+{
+    nodes.clear();
+    if (_root < 0)
+        return;
+
+    // the root is selected even if it has more points than the budget, the
+    // caller then shows a subsample of it, see Subsample()
+    const Node& root = _nodes[_root];
+    float rootSize = size(root.box);
+    if (rootSize < 0)
+        return;
+
+    // the spacing of the points of a node on the screen, assuming that they
+    // are spread over a surface
+    auto spacing = [](const Node& node, float pixels) {
+        return pixels / std::sqrt(static_cast<float>(std::max<uint32_t>(node.count, 1)));
+    };
+
+    enum State { None, Selected, Refined };
+    std::vector<char> state(_nodes.size(), None);
+    std::priority_queue<std::pair<float, std::size_t> > candidates;
+    state[_root] = Selected;
+    if (!root.isLeaf())
+        candidates.emplace(spacing(root, rootSize), _root);
+    uint64_t total = root.count;
+
+    std::vector<std::pair<std::size_t, float> > children;
+    while (!candidates.empty()) {
+        std::pair<float, std::size_t> top = candidates.top();
+        candidates.pop();
+        if (top.first < minSpacing)
+            break;
+
+        const Node& node = _nodes[top.second];
+        children.clear();
+        uint64_t childCount = 0;
+        for (int i = 0; i < 8; i++) {
+            if (node.children[i] < 0)
+                continue;
+            const Node& child = _nodes[node.children[i]];
+            float pixels = size(child.box);
+            if (pixels < 0)
+                continue;
+            children.emplace_back(node.children[i], pixels);
+            childCount += child.count;
+        }
+
+        // a coarser node elsewhere may still fit into the budget
+        if (total - node.count + childCount > budget)
+            continue;
+
+        total = total - node.count + childCount;
+        state[top.second] = Refined;
+        for (const auto& it : children) {
+            const Node& child = _nodes[it.first];
+            state[it.first] = Selected;
+            if (!child.isLeaf())
+                candidates.emplace(spacing(child, it.second), it.first);
+        }
+    }
+
+    for (std::size_t i = 0; i < state.size(); i++) {
+        if (state[i] == Selected)
+            nodes.push_back(i);
+    }
+}
+
+void PointsOctree::SelectNodes(uint64_t budget, std::vector<std::size_t>& nodes) const
+{
+    SelectNodes([](const Base::BoundBox3f& box) {
+        return box.CalcDiagonalLength();
+    }, budget, 0.0f, nodes);
+}
+
+void PointsOctree::Subsample(std::vector<Base::Vector3f>& points, uint64_t maxPoints)
+{
+    std::size_t count = points.size();
+    if (count <= maxPoints)
+        return;
+
+    // take points evenly spread over the list
+    std::size_t num = static_cast<std::size_t>(maxPoints);
+    for (std::size_t i = 0; i < num; i++)
+        points[i] = points[static_cast<std::size_t>(static_cast<uint64_t>(i) * count / num)];
+    points.resize(num);
+}
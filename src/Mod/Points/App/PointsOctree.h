@@ -0,0 +1,132 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef POINTS_OCTREE_H
+#define POINTS_OCTREE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/FileInfo.h>
+#include <Base/Vector3D.h>
+#include <Mod/Points/PointsGlobal.h>
+
+namespace Points {
+
+class PointKernel;
+
+/**
+ * The PointsOctree class gives access to a point cloud stored out of core in
+ * an octree file. Every node holds a subset of at most MaxNodePoints points
+ * of its subtree, a leaf holds all of its points. So the cloud can be shown
+ * at any level of detail by reading the nodes of a cut through the tree, a
+ * node is replaced by its children where more detail is needed.
+ *
+ * The file is built from a stream of point chunks without keeping all points
+ * in memory: the points are spooled to disk, sorted into tiles and the
+ * subtree of each tile is built in memory, several tiles in parallel.
+ */
+class PointsExport PointsOctree
+{
+public:
+    struct Node
+    {
+        Base::BoundBox3f box;
+        uint64_t offset;        /**< The file position of the points. */
+        uint32_t count;         /**< The number of points of the node. */
+        int32_t children[8];    /**< The child nodes, -1 if there is none. */
+        bool isLeaf() const;
+    };
+
+    /// Fills the chunk with the next points, returns false if there are no more
+    typedef std::function<bool (std::vector<Base::Vector3f>&)> ChunkReader;
+    /** Returns the projected size of the box in pixels, or a negative value
+     * if the box isn't visible.
+     */
+    typedef std::function<float (const Base::BoundBox3f&)> ProjectedSize;
+
+    PointsOctree();
+    ~PointsOctree();
+
+    /** Builds the octree file \a fileName from the points of \a reader.
+     * Invalid (NaN) points are skipped. Throws Base::FileException if a file
+     * can't be written.
+     */
+    static void Build(const ChunkReader& reader, const std::string& fileName,
+                      std::size_t maxNodePoints = 65536);
+    static void Build(const PointKernel&, const std::string& fileName,
+                      std::size_t maxNodePoints = 65536);
+
+    /// Opens an octree file, throws Base::FileException or Base::BadFormatError
+    void Open(const std::string& fileName);
+    bool IsOpen() const;
+    void Close();
+
+    uint64_t CountPoints() const;
+    const Base::BoundBox3f& GetBoundBox() const;
+    const std::vector<Node>& GetNodes() const;
+    /// The index of the root node, or -1 for an empty tree
+    int32_t GetRoot() const;
+
+    /** Reads the points of a node from the file, it may be called from
+     * several threads.
+     */
+    void ReadNode(std::size_t index, std::vector<Base::Vector3f>& points) const;
+
+    /** Selects a cut through the tree with at most \a budget points. Starting
+     * at the root the node with the largest spacing between its points on the
+     * screen is replaced by its visible children, until no node is coarser
+     * than \a minSpacing pixels or the budget is used up. A visible root is
+     * always selected, if it alone exceeds the budget its points must be
+     * reduced with Subsample().
+     */
+    void SelectNodes(const ProjectedSize& size, uint64_t budget, float minSpacing,
+                     std::vector<std::size_t>& nodes) const;
+    /** Selects a cut with at most \a budget points refining the largest
+     * nodes first, independent of a view.
+     */
+    void SelectNodes(uint64_t budget, std::vector<std::size_t>& nodes) const;
+    /// Keeps at most \a maxPoints of the points, evenly spread over the list
+    static void Subsample(std::vector<Base::Vector3f>& points, uint64_t maxPoints);
+
+private:
+    std::vector<Node> _nodes;
+    int32_t _root;
+    uint64_t _numPoints;
+    Base::BoundBox3f _box;
+    Base::FileInfo _file;
+    mutable std::unique_ptr<std::istream> _stream;
+    mutable std::mutex _mutex;
+
+    PointsOctree(const PointsOctree&);
+    void operator= (const PointsOctree&);
+};
+
+} // namespace Points
+
+#endif // POINTS_OCTREE_H
@@ -24,6 +24,8 @@
 #include "PreCompiled.h"
 
 #include "Mod/Points/App/Points.h"
+#include "Mod/Points/App/PointsGrid.h"
+#include "Mod/Points/App/PointsKDTree.h"
 #include <Base/Builder3D.h>
 #include <Base/VectorPy.h>
 #include <Base/GeometryPyCXX.h>
@@ -35,6 +37,44 @@
 
 using namespace Points;
 
+namespace {
+// converts a list of vectors or tuples into points
+std::vector<Base::Vector3d> getPointList(PyObject* obj)
+{
+    Py::Sequence list(obj);
+    union PyType_Object pyType = {&(Base::VectorPy::Type)};
+    Py::Type vType(pyType.o);
+
+    std::vector<Base::Vector3d> pnts;
+    pnts.reserve(list.size());
+    for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+        if ((*it).isType(vType)) {
+            Py::Vector p(*it);
+            pnts.push_back(p.toVector());
+        }
+        else {
+            Py::Tuple tuple(*it);
+            pnts.emplace_back((double)Py::Float(tuple[0]),
+                              (double)Py::Float(tuple[1]),
+                              (double)Py::Float(tuple[2]));
+        }
+    }
+    return pnts;
+}
+
+Py::List getIndexLists(const std::vector<std::vector<unsigned long> >& indices)
+{
+    Py::List result(indices.size());
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        Py::List list(indices[i].size());
+        for (std::size_t j = 0; j < indices[i].size(); j++)
+            list.setItem(j, Py::Long(static_cast<long>(indices[i][j])));
+        result.setItem(i, list);
+    }
+    return result;
+}
+}
+
 // returns a string which represents the object e.g. when printed in python
 std::string PointsPy::representation(void) const
 {
@@ -217,6 +257,114 @@ PyObject* PointsPy::fromValid(PyObject * args)
     }
 }
 
+PyObject* PointsPy::findNearest(PyObject * args)
+{
+    PyObject *obj;
+    double maxDist = DBL_MAX;
+    PyObject *grid = Py_False;
+    if (!PyArg_ParseTuple(args, "O|dO!", &obj, &maxDist, &PyBool_Type, &grid))
+        return 0;
+
+    std::vector<Base::Vector3d> pnts;
+    try {
+        pnts = getPointList(obj);
+    }
+    catch (const Py::Exception&) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, "either expect\n"
+            "-- [Vector,...] \n"
+            "-- [(x,y,z),...]");
+        return 0;
+    }
+
+    const PointKernel* points = getPointKernelPtr();
+    std::vector<long> indices(pnts.size(), -1);
+    std::vector<double> dists(pnts.size(), 0.0);
+    if (PyObject_IsTrue(grid)) {
+        // search the cells around the point, used for comparison
+        if (points->size() > 0) {
+            PointsGrid cells(*points, 50);
+            for (std::size_t i = 0; i < pnts.size(); i++) {
+                std::set<unsigned long> elements;
+                cells.SearchNearestFromPoint(pnts[i], elements);
+                double minDist = DBL_MAX;
+                for (std::set<unsigned long>::iterator it = elements.begin(); it != elements.end(); ++it) {
+                    double dist = Base::Distance(pnts[i], points->getPoint(*it));
+                    if (dist < minDist && dist <= maxDist) {
+                        minDist = dist;
+                        indices[i] = static_cast<long>(*it);
+                        dists[i] = dist;
+                    }
+                }
+            }
+        }
+    }
+    else {
+        PointsKDTree tree(*points);
+        tree.FindNearest(pnts, maxDist, indices, dists);
+    }
+
+    Py::List result(pnts.size());
+    for (std::size_t i = 0; i < pnts.size(); i++) {
+        if (indices[i] < 0)
+            result.setItem(i, Py::None());
+        else
+            result.setItem(i, Py::TupleN(Py::Long(indices[i]), Py::Float(dists[i])));
+    }
+    return Py::new_reference_to(result);
+}
+
+PyObject* PointsPy::findKNearest(PyObject * args)
+{
+    PyObject *obj;
+    int k;
+    if (!PyArg_ParseTuple(args, "Oi", &obj, &k))
+        return 0;
+    if (k < 0) {
+        PyErr_SetString(PyExc_ValueError, "number of points must not be negative");
+        return 0;
+    }
+
+    std::vector<Base::Vector3d> pnts;
+    try {
+        pnts = getPointList(obj);
+    }
+    catch (const Py::Exception&) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, "either expect\n"
+            "-- [Vector,...] \n"
+            "-- [(x,y,z),...]");
+        return 0;
+    }
+
+    PointsKDTree tree(*getPointKernelPtr());
+    std::vector<std::vector<unsigned long> > indices;
+    tree.FindKNearest(pnts, static_cast<std::size_t>(k), indices);
+    return Py::new_reference_to(getIndexLists(indices));
+}
+
+PyObject* PointsPy::findInRadius(PyObject * args)
+{
+    PyObject *obj;
+    double radius;
+    if (!PyArg_ParseTuple(args, "Od", &obj, &radius))
+        return 0;
+
+    std::vector<Base::Vector3d> pnts;
+    try {
+        pnts = getPointList(obj);
+    }
+    catch (const Py::Exception&) {
+        PyErr_SetString(Base::BaseExceptionFreeCADError, "either expect\n"
+            "-- [Vector,...] \n"
+            "-- [(x,y,z),...]");
+        return 0;
+    }
+
+    PointsKDTree tree(*getPointKernelPtr());
+    std::vector<std::vector<unsigned long> > indices;
+    tree.FindInRange(pnts, radius, indices);
+    return Py::new_reference_to(getIndexLists(indices));
+}
+
 Py::Long PointsPy::getCountPoints(void) const
 {
     return Py::Long((long)getPointKernelPtr()->size());
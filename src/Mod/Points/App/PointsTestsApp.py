@@ -0,0 +1,241 @@
+# -*- coding: utf-8 -*-
+
+#***************************************************************************
+#*   Copyright (c) 2021 FreeCAD Developers                                 *
+#*                                                                         *
+#*   This file is part of the FreeCAD CAx development system.              *
+#*                                                                         *
+#*   This program is free software; you can redistribute it and/or modify  *
+#*   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#*   as published by the Free Software Foundation; either version 2 of     *
+#*   the License, or (at your option) any later version.                   *
+#*   for detail see the LICENCE text file.                                 *
+#*                                                                         *
+#*   FreeCAD is distributed in the hope that it will be useful,            *
+#*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#*   GNU Lesser General Public License for more details.                   *
+#*                                                                         *
+#*   You should have received a copy of the GNU Library General Public     *
+#*   License along with FreeCAD; if not, write to the Free Software        *
+#*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#*   USA                                                                   *
+#*                                                                         *
+#***************************************************************************/
+
+import os
+import random
+import tempfile
+import unittest
+import FreeCAD
+import Points
+from FreeCAD import Base
+
+#---------------------------------------------------------------------------
+# define the functions to test the FreeCAD points module
+#---------------------------------------------------------------------------
+
+
+class PointsKDTreeCases(unittest.TestCase):
+    def setUp(self):
+        rnd = random.Random(4711)
+        coords = [(rnd.uniform(-10, 10), rnd.uniform(-10, 10), rnd.uniform(-10, 10)) for i in range(2000)]
+        self.points = Points.Points()
+        self.points.addPoints(coords)
+        # the points are stored with single precision
+        self.coords = [(v.x, v.y, v.z) for v in self.points.Points]
+        self.queries = [(rnd.uniform(-12, 12), rnd.uniform(-12, 12), rnd.uniform(-12, 12)) for i in range(200)]
+
+    def distances(self, query):
+        q = Base.Vector(query)
+        return [(q - Base.Vector(c)).Length for c in self.coords]
+
+    def testNearest(self):
+        result = self.points.findNearest(self.queries)
+        self.assertEqual(len(result), len(self.queries))
+        for query, (index, dist) in zip(self.queries, result):
+            dists = self.distances(query)
+            self.assertAlmostEqual(dist, min(dists))
+            self.assertAlmostEqual(dists[index], dist)
+
+    def testNearestMaxDistance(self):
+        result = self.points.findNearest(self.queries, 1.0)
+        for query, item in zip(self.queries, result):
+            best = min(self.distances(query))
+            if best > 1.0:
+                self.assertIsNone(item)
+            else:
+                self.assertAlmostEqual(item[1], best)
+
+    def testNearestGrid(self):
+        # the kd-tree finds the same distances as the grid, or nearer ones
+        tree = self.points.findNearest(self.queries, 2.0)
+        grid = self.points.findNearest(self.queries, 2.0, True)
+        for t, g in zip(tree, grid):
+            if g is not None:
+                self.assertIsNotNone(t)
+                self.assertLessEqual(t[1], g[1] + 1e-9)
+
+    def testKNearest(self):
+        k = 10
+        result = self.points.findKNearest(self.queries, k)
+        for query, indices in zip(self.queries, result):
+            dists = self.distances(query)
+            self.assertEqual(len(indices), k)
+            self.assertEqual(len(set(indices)), k)
+            found = [dists[i] for i in indices]
+            self.assertEqual(found, sorted(found))
+            expected = sorted(dists)[:k]
+            for a, b in zip(found, expected):
+                self.assertAlmostEqual(a, b)
+
+    def testKNearestMoreThanPoints(self):
+        result = self.points.findKNearest(self.queries[:1], 5000)
+        self.assertEqual(sorted(result[0]), list(range(len(self.coords))))
+
+    def testInRadius(self):
+        radius = 2.5
+        result = self.points.findInRadius(self.queries, radius)
+        for query, indices in zip(self.queries, result):
+            dists = self.distances(query)
+            expected = [i for i, d in enumerate(dists) if d <= radius]
+            self.assertEqual(indices, expected)
+
+    def testEmptyCloud(self):
+        empty = Points.Points()
+        self.assertEqual(empty.findNearest(self.queries[:3]), [None, None, None])
+        self.assertEqual(empty.findKNearest(self.queries[:3], 4), [[], [], []])
+        self.assertEqual(empty.findInRadius(self.queries[:3], 100.0), [[], [], []])
+        self.assertEqual(self.points.findNearest([]), [])
+
+    def testDuplicatePoints(self):
+        # many equal points must not break the split of the tree
+        coords = [(1.0, 2.0, 3.0)] * 100 + [(float(i), 0.0, 0.0) for i in range(50)] + [(1.0, 2.0, 3.0)] * 100
+        points = Points.Points()
+        points.addPoints(coords)
+        duplicates = [i for i, c in enumerate(coords) if c == (1.0, 2.0, 3.0)]
+
+        index, dist = points.findNearest([(1.0, 2.0, 3.0)])[0]
+        self.assertIn(index, duplicates)
+        self.assertEqual(dist, 0.0)
+
+        indices = points.findKNearest([(1.0, 2.0, 3.0)], 20)[0]
+        self.assertEqual(len(indices), 20)
+        self.assertTrue(set(indices).issubset(duplicates))
+
+        self.assertEqual(points.findInRadius([(1.0, 2.0, 3.0)], 0.0)[0], duplicates)
+        self.assertEqual(points.findInRadius([(1.0, 2.0, 3.1)], 0.2)[0], duplicates)
+
+
+class PointsUndoCases(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("PointsUndoTest")
+        self.doc.UndoMode = 1
+        self.feature = self.doc.addObject("Points::Feature", "Points")
+        points = Points.Points()
+        points.addPoints([(i, 0, 0) for i in range(100)])
+        self.feature.Points = points
+
+    def testUndoPlacement(self):
+        self.doc.openTransaction("Points")
+        points = Points.Points()
+        points.addPoints([(i + 1, 0, 0) for i in range(100)])
+        self.feature.Points = points
+        self.doc.commitTransaction()
+        self.doc.openTransaction("Placement")
+        self.feature.Placement.Base = FreeCAD.Vector(10, 0, 0)
+        self.doc.commitTransaction()
+        self.assertAlmostEqual(self.feature.Points.BoundBox.XMin, 11.0)
+        self.doc.undo()
+        self.assertEqual(self.feature.Placement, FreeCAD.Placement())
+        self.assertEqual(self.feature.Points.Placement, FreeCAD.Placement())
+        self.assertAlmostEqual(self.feature.Points.BoundBox.XMin, 1.0)
+        self.doc.undo()
+        self.assertAlmostEqual(self.feature.Points.BoundBox.XMin, 0.0)
+        self.doc.redo()
+        self.doc.redo()
+        self.assertEqual(self.feature.Points.Placement, self.feature.Placement)
+        self.assertAlmostEqual(self.feature.Points.BoundBox.XMin, 11.0)
+
+    def testPythonReference(self):
+        # the wrapper must follow the points when undo replaces them
+        pts = self.feature.Points
+        self.doc.openTransaction("Points")
+        points = Points.Points()
+        points.addPoints([(i, 1, 0) for i in range(10)])
+        self.feature.Points = points
+        self.doc.commitTransaction()
+        self.assertEqual(pts.CountPoints, 10)
+        self.doc.undo()
+        self.doc.clearUndos()
+        self.assertEqual(pts.CountPoints, 100)
+        self.assertEqual(pts.CountPoints, self.feature.Points.CountPoints)
+
+    def tearDown(self):
+        FreeCAD.closeDocument("PointsUndoTest")
+
+
+class PointsOctreeCases(unittest.TestCase):
+    def setUp(self):
+        rnd = random.Random(815)
+        coords = [(rnd.uniform(0, 100), rnd.uniform(0, 100), rnd.uniform(0, 10)) for i in range(5000)]
+        self.points = Points.Points()
+        self.points.addPoints(coords)
+        self.fileName = os.path.join(tempfile.gettempdir(), "PointsOctreeTest.oct")
+        self.doc = FreeCAD.newDocument("PointsOctreeTest")
+
+    def sortedPoints(self, points):
+        return sorted((v.x, v.y, v.z) for v in points.Points)
+
+    def loadTiled(self, samplePoints):
+        obj = self.doc.addObject("Points::Tiled", "Tiled")
+        obj.File = self.fileName
+        obj.SamplePoints = samplePoints
+        self.doc.recompute()
+        return obj
+
+    def testRoundTrip(self):
+        Points.buildOctree(self.points, self.fileName, 100)
+        obj = self.loadTiled(10000)
+        self.assertEqual(obj.TotalPoints, 5000)
+        self.assertEqual(self.sortedPoints(obj.Points), self.sortedPoints(self.points))
+
+    def testBuildFromChunks(self):
+        chunks = []
+        pnts = self.points.Points
+        for i in range(0, len(pnts), 1000):
+            chunk = Points.Points()
+            chunk.addPoints(pnts[i:i + 1000])
+            chunks.append(chunk)
+        Points.buildOctree(iter(chunks), self.fileName, 100)
+        obj = self.loadTiled(10000)
+        self.assertEqual(obj.TotalPoints, 5000)
+        self.assertEqual(self.sortedPoints(obj.Points), self.sortedPoints(self.points))
+
+    def testSelectNodes(self):
+        Points.buildOctree(self.points, self.fileName, 100)
+        obj = self.loadTiled(1000)
+        self.assertEqual(obj.TotalPoints, 5000)
+        self.assertGreater(obj.Points.CountPoints, 100)
+        self.assertLessEqual(obj.Points.CountPoints, 1000)
+        # all selected points are points of the cloud
+        self.assertTrue(set(self.sortedPoints(obj.Points)).issubset(self.sortedPoints(self.points)))
+
+    def testBudgetBelowRoot(self):
+        # the root is subsampled if it alone exceeds the budget
+        Points.buildOctree(self.points, self.fileName, 100)
+        obj = self.loadTiled(10)
+        self.assertEqual(obj.Points.CountPoints, 10)
+
+    def testInvalidFile(self):
+        with open(self.fileName, "w") as f:
+            f.write("no octree")
+        obj = self.loadTiled(1000)
+        self.assertFalse(obj.isValid())
+        self.assertEqual(obj.TotalPoints, 0)
+        self.assertEqual(obj.Points.CountPoints, 0)
+
+    def tearDown(self):
+        FreeCAD.closeDocument("PointsOctreeTest")
+        if os.path.exists(self.fileName):
+            os.remove(self.fileName)
@@ -48,6 +48,8 @@
 
 // STL
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <list>
@@ -57,10 +59,12 @@
 #include <sstream>
 #include <stack>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <bitset>
 #include <float.h>
 #include <cmath>
+#include <limits>
 #include <stdlib.h>
 
 #endif //_PreComp_
@@ -158,9 +158,7 @@ void PropertyGreyValueList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (std::vector<float>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << *it;
-    }
+    str.write(_lValueList.data(), _lValueList.size());
 }
 
 void PropertyGreyValueList::RestoreDocFile(Base::Reader &reader)
@@ -169,9 +167,8 @@ void PropertyGreyValueList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<float> values(uCt);
-    for (std::vector<float>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> *it;
-    }
+    if (!str.read(values.data(), values.size()))
+        throw Base::BadFormatError("Reading grey values failed");
     setValues(values);
 }
 
@@ -332,9 +329,8 @@ void PropertyNormalList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (std::vector<Base::Vector3f>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << it->x << it->y << it->z;
-    }
+    static_assert(sizeof(Base::Vector3f) == 3 * sizeof(float), "normals must be stored without padding");
+    str.write(reinterpret_cast<const float*>(_lValueList.data()), 3 * _lValueList.size());
 }
 
 void PropertyNormalList::RestoreDocFile(Base::Reader &reader)
@@ -343,9 +339,8 @@ void PropertyNormalList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<Base::Vector3f> values(uCt);
-    for (std::vector<Base::Vector3f>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> it->x >> it->y >> it->z;
-    }
+    if (!str.read(reinterpret_cast<float*>(values.data()), 3 * values.size()))
+        throw Base::BadFormatError("Reading normals failed");
     setValues(values);
 }
 
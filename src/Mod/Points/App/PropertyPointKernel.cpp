@@ -42,19 +42,22 @@ using namespace Points;
 TYPESYSTEM_SOURCE(Points::PropertyPointKernel , App::PropertyComplexGeoData)
 
 PropertyPointKernel::PropertyPointKernel()
-    : _cPoints(new PointKernel())
+    : _cPoints(new PointKernel()), pointsPyObject(0)
 {
 
 }
 
 PropertyPointKernel::~PropertyPointKernel()
 {
+    if (pointsPyObject) {
+        Py_DECREF(pointsPyObject);
+    }
 }
 
 void PropertyPointKernel::setValue(const PointKernel& m)
 {
     aboutToSetValue();
-    *_cPoints = m;
+    *unsharePoints(false) = m;
     hasSetValue();
 }
 
@@ -75,9 +78,13 @@ Base::BoundBox3d PropertyPointKernel::getBoundingBox() const
 
 PyObject *PropertyPointKernel::getPyObject(void)
 {
-    PointsPy* points = new PointsPy(&*_cPoints);
-    points->setConst(); // set immutable
-    return points;
+    if (!pointsPyObject) {
+        pointsPyObject = new PointsPy(&*_cPoints);
+        pointsPyObject->setConst(); // set immutable
+    }
+
+    Py_INCREF(pointsPyObject);
+    return pointsPyObject;
 }
 
 void PropertyPointKernel::setPyObject(PyObject *value)
@@ -114,7 +121,7 @@ void PropertyPointKernel::Restore(Base::XMLReader &reader)
         mtrx.fromString(Matrix);
 
         aboutToSetValue();
-        _cPoints->setTransform(mtrx);
+        unsharePoints(true)->setTransform(mtrx);
         hasSetValue();
     }
 }
@@ -128,7 +135,7 @@ void PropertyPointKernel::SaveDocFile (Base::Writer &writer) const
 void PropertyPointKernel::RestoreDocFile(Base::Reader &reader)
 {
     aboutToSetValue();
-    _cPoints->RestoreDocFile(reader);
+    unsharePoints(false)->RestoreDocFile(reader);
     hasSetValue();
 }
 
@@ -139,23 +146,63 @@ App::Property *PropertyPointKernel::Copy(void) const
     return prop;
 }
 
+App::Property *PropertyPointKernel::copyForUndo(void) const 
+{
+    // the points are copied when one of the properties gets modified
+    if (!_shareToken)
+        _shareToken = std::make_shared<int>(0);
+    PropertyPointKernel* prop = new PropertyPointKernel();
+    prop->_cPoints = this->_cPoints;
+    prop->_shareToken = this->_shareToken;
+    return prop;
+}
+
 void PropertyPointKernel::Paste(const App::Property &from)
 {
     aboutToSetValue();
     const PropertyPointKernel& prop = dynamic_cast<const PropertyPointKernel&>(from);
-    *(this->_cPoints) = *(prop._cPoints);
+    if (!prop._shareToken)
+        prop._shareToken = std::make_shared<int>(0);
+    this->_cPoints = prop._cPoints;
+    this->_shareToken = prop._shareToken;
+    if (pointsPyObject)
+        pointsPyObject->setTwinPointer(&*_cPoints);
     hasSetValue();
 }
 
 unsigned int PropertyPointKernel::getMemSize (void) const
 {
-    return sizeof(Base::Vector3f) * this->_cPoints->size();
+    return _cPoints->getMemSize();
+}
+
+unsigned int PropertyPointKernel::getUndoMemSize (void) const
+{
+    // shared points are divided between the properties referencing them
+    long count = std::max<long>(1, _shareToken.use_count());
+    return getMemSize() / static_cast<unsigned int>(count);
+}
+
+PointKernel* PropertyPointKernel::unsharePoints(bool keepData)
+{
+    if (_shareToken.use_count() > 1) {
+        PointKernel* kernel = new PointKernel();
+        if (keepData)
+            *kernel = *_cPoints;
+        else
+            kernel->setTransform(_cPoints->getTransform());
+        _cPoints = kernel;
+        if (pointsPyObject)
+            pointsPyObject->setTwinPointer(kernel);
+    }
+
+    _shareToken.reset();
+    return static_cast<PointKernel*>(_cPoints);
 }
 
 PointKernel* PropertyPointKernel::startEditing()
 {
     aboutToSetValue();
-    return static_cast<PointKernel*>(_cPoints);
+    return unsharePoints(true);
 }
 
 void PropertyPointKernel::finishEditing()
@@ -194,6 +241,11 @@ void PropertyPointKernel::removeIndices( const std::vector<unsigned long>& uIndi
 void PropertyPointKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     aboutToSetValue();
-    _cPoints->transformGeometry(rclMat);
+    unsharePoints(true)->transformGeometry(rclMat);
     hasSetValue();
 }
+
+void PropertyPointKernel::setTransform(const Base::Matrix4D &rclTrf)
+{
+    unsharePoints(true)->setTransform(rclTrf);
+}
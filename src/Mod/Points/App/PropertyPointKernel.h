@@ -24,11 +24,14 @@
 #ifndef POINTS_PROPERTYPOINTKERNEL_H
 #define POINTS_PROPERTYPOINTKERNEL_H
 
+#include <memory>
 #include "Points.h"
 
 namespace Points
 {
 
+class PointsPy;
+
 /** The point kernel property
  */
 class PointsExport PropertyPointKernel : public App::PropertyComplexGeoData
@@ -64,9 +67,12 @@ public:
     //@{
     /// returns a new copy of the property (mainly for Undo/Redo and transactions)
     App::Property *Copy(void) const;
+    /// the undo copy shares the points with this property until one of them is modified
+    App::Property *copyForUndo(void) const;
     /// paste the value from the property (mainly for Undo/Redo and transactions)
     void Paste(const App::Property &from);
     unsigned int getMemSize (void) const;
+    unsigned int getUndoMemSize (void) const;
     //@}
 
     /** @name Save/restore */
@@ -83,11 +89,21 @@ public:
     void finishEditing();
     /// Transform the real 3d point kernel
     void transformGeometry(const Base::Matrix4D &rclMat);
+    /// Set the placement of the points without notifying the container
+    void setTransform(const Base::Matrix4D &rclTrf);
     void removeIndices( const std::vector<unsigned long>& );
     //@}
 
+private:
+    /// Makes sure that the points aren't shared with a copy before they get modified
+    PointKernel* unsharePoints(bool keepData);
+
 private:
     Base::Reference<PointKernel> _cPoints;
+    /// All copies sharing the points hold the same token
+    mutable std::shared_ptr<int> _shareToken;
+    /// The Python wrapper follows the points when they get replaced
+    PointsPy* pointsPyObject;
 };
 
 } // namespace Points
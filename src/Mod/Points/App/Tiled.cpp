@@ -0,0 +1,141 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <vector>
+#endif
+
+#include <Base/Exception.h>
+
+#include "Tiled.h"
+
+using namespace Points;
+
+
+//===========================================================================
+// Tiled
+//===========================================================================
+/*
+import Points
+p=Points.Points()
+p.read("cloud.pcd")
+Points.buildOctree(p, "/tmp/cloud.oct")
+doc=App.ActiveDocument
+obj=doc.addObject('Points::Tiled','Cloud')
+obj.File="/tmp/cloud.oct"
+doc.recompute()
+*/
+
+// ---------------------------------------------------------
+
+PROPERTY_SOURCE(Points::Tiled, Points::Feature)
+
+Tiled::Tiled()
+{
+    ADD_PROPERTY_TYPE(File,(""),"Tiled points", App::Prop_None, "The octree file with the points");
+    ADD_PROPERTY_TYPE(SamplePoints,(1000000),"Tiled points", App::Prop_None,
+                      "Number of points loaded into the Points property");
+    ADD_PROPERTY_TYPE(TotalPoints,(0),"Tiled points",
+                      static_cast<App::PropertyType>(App::Prop_ReadOnly | App::Prop_Output),
+                      "Number of points in the octree file");
+    File.setFilter("Points octree (*.oct)");
+    // the points are read from the file again when restoring the document
+    Points.setStatus(App::Property::Transient, true);
+}
+
+Tiled::~Tiled()
+{
+}
+
+short Tiled::mustExecute() const
+{
+    if (File.isTouched() || SamplePoints.isTouched())
+        return 1;
+    return Feature::mustExecute();
+}
+
+App::DocumentObjectExecReturn *Tiled::execute(void)
+{
+    try {
+        octree.Open(File.getValue());
+        loadSample();
+    }
+    catch (const Base::Exception& e) {
+        octree.Close();
+        TotalPoints.setValue(0);
+        Points.setValue(PointKernel());
+        return new App::DocumentObjectExecReturn(e.what());
+    }
+
+    return App::DocumentObject::StdReturn;
+}
+
+void Tiled::onDocumentRestored()
+{
+    Feature::onDocumentRestored();
+
+    try {
+        octree.Open(File.getValue());
+        loadSample();
+    }
+    catch (const Base::Exception& e) {
+        octree.Close();
+        e.ReportException();
+    }
+}
+
+void Tiled::loadSample()
+{
+    std::vector<std::size_t> nodes;
+    uint64_t budget = static_cast<uint64_t>(std::max<long>(SamplePoints.getValue(), 0));
+    octree.SelectNodes(budget, nodes);
+
+    std::vector<PointKernel::value_type> pnts;
+    std::vector<Base::Vector3f> block;
+    for (std::size_t index : nodes) {
+        octree.ReadNode(index, block);
+        pnts.insert(pnts.end(), block.begin(), block.end());
+    }
+    PointsOctree::Subsample(pnts, budget);
+
+    PointKernel kernel;
+    kernel.swap(pnts);
+    kernel.setTransform(Placement.getValue().toMatrix());
+    Points.setValue(kernel);
+    TotalPoints.setValue(static_cast<long>(octree.CountPoints()));
+}
+
+// ---------------------------------------------------------
+
+namespace App {
+/// @cond DOXERR
+PROPERTY_SOURCE_TEMPLATE(Points::TiledCustom, Points::Tiled)
+/// @endcond
+
+// explicit template instantiation
+template class PointsExport FeatureCustomT<Points::Tiled>;
+}
@@ -0,0 +1,87 @@
+/***************************************************************************
+ *   Copyright (c) 2021 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef POINTS_TILED_H
+#define POINTS_TILED_H
+
+#include <App/PropertyFile.h>
+#include "PointsFeature.h"
+#include "PointsOctree.h"
+
+
+namespace Points
+{
+
+/*! The Tiled class shows a point cloud that is stored out of core in an
+  octree file, see PointsOctree. The file is not part of the document.
+  The Points property holds a subset of the cloud with up to SamplePoints
+  points, so that it can be used by scripts like any other points feature.
+  It isn't saved with the document but read again from the file.
+  The view provider reads the parts of the cloud needed for a view itself.
+ */
+class PointsExport Tiled : public Feature
+{
+    PROPERTY_HEADER(Points::Tiled);
+
+public:
+    /// Constructor
+    Tiled(void);
+    virtual ~Tiled(void);
+
+    App::PropertyFile File; /**< The octree file. */
+    App::PropertyInteger SamplePoints; /**< The number of points of the Points property. */
+    App::PropertyInteger TotalPoints; /**< The number of points in the file. */
+
+    /** @name methods override Feature */
+    //@{
+    short mustExecute() const;
+    /// recalculate the Feature
+    virtual App::DocumentObjectExecReturn *execute(void);
+    /// returns the type name of the ViewProvider
+    virtual const char* getViewProviderName(void) const {
+        return "PointsGui::ViewProviderTiled";
+    }
+    //@}
+
+    /// The octree of the file, it is open after a successful recompute
+    const PointsOctree& getOctree() const {
+        return octree;
+    }
+
+protected:
+    void onDocumentRestored();
+
+private:
+    void loadSample();
+
+private:
+    PointsOctree octree;
+};
+
+typedef App::FeatureCustomT<Tiled> TiledCustom;
+
+} //namespace Points
+
+
+#endif // POINTS_TILED_H
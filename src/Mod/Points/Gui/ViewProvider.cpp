@@ -25,6 +25,15 @@
 
 #ifndef _PreComp_
 # include <Python.h>
+# include <algorithm>
+# include <set>
+# include <Inventor/SbBox2f.h>
+# include <Inventor/SbBox3f.h>
+# include <Inventor/actions/SoGLRenderAction.h>
+# include <Inventor/elements/SoModelMatrixElement.h>
+# include <Inventor/elements/SoViewVolumeElement.h>
+# include <Inventor/elements/SoViewportRegionElement.h>
+# include <Inventor/nodes/SoCallback.h>
 # include <Inventor/nodes/SoCamera.h>
 # include <Inventor/nodes/SoCoordinate3.h>
 # include <Inventor/nodes/SoDrawStyle.h>
@@ -35,6 +44,7 @@
 # include <Inventor/nodes/SoNormal.h>
 # include <Inventor/errors/SoDebugError.h>
 # include <Inventor/events/SoMouseButtonEvent.h>
+# include <Inventor/sensors/SoOneShotSensor.h>
 #endif
 
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -56,6 +66,7 @@
 
 #include <Gui/View3DInventorViewer.h>
 #include <Mod/Points/App/PointsFeature.h>
+#include <Mod/Points/App/Tiled.h>
 
 #include "ViewProvider.h"
 #include "../App/Properties.h"
@@ -637,6 +648,270 @@ void ViewProviderStructured::cut(const std::vector<SbVec2f>& picked, Gui::View3D
 
 // -------------------------------------------------
 
+PROPERTY_SOURCE(PointsGui::ViewProviderTiled, PointsGui::ViewProviderScattered)
+
+ViewProviderTiled::ViewProviderTiled()
+  : hasView(false)
+  , cachedPoints(0)
+  , updateCount(0)
+{
+    static const char *lodgroup = "Level of detail";
+
+    ADD_PROPERTY_TYPE(PointBudget, (5000000), lodgroup, App::Prop_None,
+                      "Maximum number of points shown");
+    ADD_PROPERTY_TYPE(PointSpacing, (1.0), lodgroup, App::Prop_None,
+                      "Spacing of the points on the screen in pixels up to which more detail is loaded");
+    ADD_PROPERTY_TYPE(ShownPoints, (0), lodgroup,
+                      static_cast<App::PropertyType>(App::Prop_ReadOnly | App::Prop_Transient),
+                      "Number of points currently shown");
+
+    pcViewCallback = new SoCallback();
+    pcViewCallback->setCallback(renderCallback, this);
+    pcViewCallback->ref();
+    pcUpdateSensor = new SoOneShotSensor(updateCallback, this);
+}
+
+ViewProviderTiled::~ViewProviderTiled()
+{
+    delete pcUpdateSensor;
+    pcViewCallback->unref();
+}
+
+void ViewProviderTiled::attach(App::DocumentObject* pcObj)
+{
+    ViewProviderScattered::attach(pcObj);
+    // the callback gets the view volume before the points are rendered
+    pcHighlight->insertChild(pcViewCallback, 0);
+}
+
+void ViewProviderTiled::onChanged(const App::Property* prop)
+{
+    if (prop == &PointBudget || prop == &PointSpacing) {
+        if (hasView)
+            pcUpdateSensor->schedule();
+    }
+    ViewProviderScattered::onChanged(prop);
+}
+
+void ViewProviderTiled::updateData(const App::Property* prop)
+{
+    // show the sample of the feature until the view is known
+    ViewProviderScattered::updateData(prop);
+    if (prop->getTypeId() == Points::PropertyPointKernel::getClassTypeId()) {
+        clearCache();
+        Points::Tiled* tiled = getTiled();
+        if (tiled && tiled->getOctree().IsOpen()) {
+            const std::vector<Points::PointsOctree::Node>& nodes = tiled->getOctree().GetNodes();
+            nodeParents.resize(nodes.size(), -1);
+            for (std::size_t i = 0; i < nodes.size(); i++) {
+                for (int j = 0; j < 8; j++) {
+                    if (nodes[i].children[j] >= 0)
+                        nodeParents[nodes[i].children[j]] = static_cast<int32_t>(i);
+                }
+            }
+            if (hasView)
+                pcUpdateSensor->schedule();
+        }
+        ShownPoints.setValue(static_cast<long>(pcPoints->numPoints.getValue()));
+    }
+}
+
+void ViewProviderTiled::cut(const std::vector<SbVec2f>&, Gui::View3DInventorViewer&)
+{
+    Base::Console().Warning("Cutting of tiled points is not supported\n");
+}
+
+Points::Tiled* ViewProviderTiled::getTiled() const
+{
+    if (pcObject && pcObject->getTypeId().isDerivedFrom(Points::Tiled::getClassTypeId()))
+        return static_cast<Points::Tiled*>(pcObject);
+    return nullptr;
+}
+
+void ViewProviderTiled::clearCache()
+{
+    nodeCache.clear();
+    nodeParents.clear();
+    cachedPoints = 0;
+}
+
+void ViewProviderTiled::renderCallback(void * ud, SoAction * action)
+{
+    if (!action->isOfType(SoGLRenderAction::getClassTypeId()))
+        return;
+
+    // The scene graph must not be changed while rendering, so the points
+    // are updated by the sensor afterwards
+    ViewProviderTiled* that = static_cast<ViewProviderTiled*>(ud);
+    SoState* state = action->getState();
+    const SbViewVolume& vv = SoViewVolumeElement::get(state);
+    const SbMatrix& mm = SoModelMatrixElement::get(state);
+    const SbViewportRegion& vp = SoViewportRegionElement::get(state);
+    if (!that->hasView || that->viewVolume.getMatrix() != vv.getMatrix() ||
+        that->modelMatrix != mm || !(that->viewport == vp)) {
+        that->hasView = true;
+        that->viewVolume = vv;
+        that->modelMatrix = mm;
+        that->viewport = vp;
+        that->pcUpdateSensor->schedule();
+    }
+}
+
+void ViewProviderTiled::updateCallback(void * ud, SoSensor *)
+{
+    ViewProviderTiled* that = static_cast<ViewProviderTiled*>(ud);
+    try {
+        that->updatePoints();
+    }
+    catch (const Base::Exception& e) {
+        e.ReportException();
+    }
+}
+
+void ViewProviderTiled::updatePoints()
+{
+    Points::Tiled* tiled = getTiled();
+    if (!tiled || !hasView)
+        return;
+    const Points::PointsOctree& octree = tiled->getOctree();
+    if (!octree.IsOpen() || nodeParents.size() != octree.GetNodes().size())
+        return;
+
+    // the points are in the coordinate system of the feature
+    SbViewVolume vv = viewVolume;
+    vv.transform(modelMatrix.inverse());
+    bool perspective = vv.getProjectionType() == SbViewVolume::PERSPECTIVE;
+    SbVec3f eye = vv.getProjectionPoint();
+    SbVec3f dir = vv.getProjectionDirection();
+    float nearDist = vv.getNearDist();
+    SbVec2s size = viewport.getViewportSizePixels();
+    float width = size[0], height = size[1];
+
+    auto projectedSize = [&](const Base::BoundBox3f& box) {
+        SbBox3f sbbox(box.MinX, box.MinY, box.MinZ, box.MaxX, box.MaxY, box.MaxZ);
+        if (!vv.intersect(sbbox))
+            return -1.0f;
+        SbBox2f screen;
+        for (int i = 0; i < 8; i++) {
+            SbVec3f corner(i & 1 ? box.MaxX : box.MinX,
+                           i & 2 ? box.MaxY : box.MinY,
+                           i & 4 ? box.MaxZ : box.MinZ);
+            // a box reaching behind the near plane covers the whole screen
+            if (perspective && (corner - eye).dot(dir) < nearDist)
+                return std::max(width, height) * 4.0f;
+            SbVec3f pos;
+            vv.projectToScreen(corner, pos);
+            screen.extendBy(SbVec2f(pos[0] * width, pos[1] * height));
+        }
+        float dx, dy;
+        screen.getSize(dx, dy);
+        return std::max(dx, dy);
+    };
+
+    std::vector<std::size_t> nodes;
+    uint64_t budget = static_cast<uint64_t>(std::max<long>(PointBudget.getValue(), 0));
+    octree.SelectNodes(projectedSize, budget, static_cast<float>(PointSpacing.getValue()), nodes);
+
+    // read a limited number of points per update to keep the view responsive,
+    // the coarse nodes first
+    std::vector<std::size_t> missing;
+    for (std::size_t index : nodes) {
+        if (nodeCache.find(index) == nodeCache.end())
+            missing.push_back(index);
+    }
+    const std::vector<Points::PointsOctree::Node>& octnodes = octree.GetNodes();
+    std::sort(missing.begin(), missing.end(), [&octnodes](std::size_t a, std::size_t b) {
+        return octnodes[a].box.CalcDiagonalLength() > octnodes[b].box.CalcDiagonalLength();
+    });
+
+    const uint64_t maxLoad = std::max<uint64_t>(budget / 4, 1);
+    uint64_t loaded = 0;
+    ++updateCount;
+    bool pending = false;
+    for (std::size_t index : missing) {
+        if (loaded >= maxLoad) {
+            pending = true;
+            break;
+        }
+        CacheEntry& entry = nodeCache[index];
+        octree.ReadNode(index, entry.points);
+        entry.lastUse = updateCount;
+        loaded += entry.points.size();
+        cachedPoints += entry.points.size();
+    }
+
+    // a node that isn't read yet is replaced by its closest cached ancestor
+    std::vector<std::size_t> shown;
+    std::set<std::size_t> added;
+    for (std::size_t index : nodes) {
+        int32_t node = static_cast<int32_t>(index);
+        while (node >= 0 && nodeCache.find(node) == nodeCache.end())
+            node = nodeParents[node];
+        if (node >= 0 && added.insert(node).second)
+            shown.push_back(node);
+    }
+
+    uint64_t numPoints = 0;
+    for (std::size_t index : shown) {
+        CacheEntry& entry = nodeCache[index];
+        entry.lastUse = updateCount;
+        numPoints += entry.points.size();
+    }
+
+    // drop the least recently used nodes if the cache is too big
+    const uint64_t maxCache = 2 * std::max(budget, numPoints);
+    if (cachedPoints > maxCache) {
+        std::vector<std::pair<uint64_t, std::size_t> > unused;
+        for (const auto& it : nodeCache) {
+            if (it.second.lastUse != updateCount)
+                unused.emplace_back(it.second.lastUse, it.first);
+        }
+        std::sort(unused.begin(), unused.end());
+        for (const auto& it : unused) {
+            if (cachedPoints <= maxCache)
+                break;
+            auto jt = nodeCache.find(it.second);
+            cachedPoints -= jt->second.points.size();
+            nodeCache.erase(jt);
+        }
+    }
+
+    // the root is shown even if it alone exceeds the budget, then only a
+    // part of its points is used
+    std::vector<Base::Vector3f> subsample;
+    bool reduced = numPoints > budget;
+    if (reduced) {
+        for (std::size_t index : shown) {
+            const std::vector<Base::Vector3f>& pnts = nodeCache[index].points;
+            subsample.insert(subsample.end(), pnts.begin(), pnts.end());
+        }
+        Points::PointsOctree::Subsample(subsample, budget);
+        numPoints = subsample.size();
+    }
+
+    pcPointsCoord->point.setNum(static_cast<int>(numPoints));
+    SbVec3f* vec = pcPointsCoord->point.startEditing();
+    std::size_t idx = 0;
+    if (reduced) {
+        for (const Base::Vector3f& pnt : subsample)
+            vec[idx++].setValue(pnt.x, pnt.y, pnt.z);
+    }
+    else {
+        for (std::size_t index : shown) {
+            for (const Base::Vector3f& pnt : nodeCache[index].points)
+                vec[idx++].setValue(pnt.x, pnt.y, pnt.z);
+        }
+    }
+    pcPointsCoord->point.finishEditing();
+    pcPoints->numPoints = static_cast<int>(numPoints);
+    ShownPoints.setValue(static_cast<long>(numPoints));
+
+    if (pending)
+        pcUpdateSensor->schedule();
+}
+
+// -------------------------------------------------
+
 namespace Gui {
 /// @cond DOXERR
 PROPERTY_SOURCE_TEMPLATE(PointsGui::ViewProviderPython, PointsGui::ViewProviderScattered)
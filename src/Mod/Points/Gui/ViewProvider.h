@@ -23,11 +23,18 @@
 #ifndef POINTSGUI_VIEWPROVIDERPOINTS_H
 #define POINTSGUI_VIEWPROVIDERPOINTS_H
 
+#include <cstdint>
+#include <map>
+#include <vector>
+
 #include <Base/Vector3D.h>
 #include <Gui/ViewProviderGeometryObject.h>
 #include <Gui/ViewProviderPythonFeature.h>
 #include <Gui/ViewProviderBuilder.h>
+#include <Inventor/SbMatrix.h>
 #include <Inventor/SbVec2f.h>
+#include <Inventor/SbViewVolume.h>
+#include <Inventor/SbViewportRegion.h>
 #include <Mod/Points/PointsGlobal.h>
 
 
@@ -38,6 +45,10 @@ class SoLocateHighlight;
 class SoCoordinate3;
 class SoNormal;
 class SoEventCallback;
+class SoCallback;
+class SoAction;
+class SoSensor;
+class SoOneShotSensor;
 
 namespace App {
     class PropertyColorList;
@@ -52,6 +63,7 @@ namespace Points {
     class PropertyNormalList;
     class PointKernel;
     class Feature;
+    class Tiled;
 }
 
 namespace PointsGui {
@@ -169,6 +181,57 @@ protected:
     SoIndexedPointSet   * pcPoints;
 };
 
+/**
+ * The ViewProviderTiled class shows the points of an octree file with a
+ * level of detail depending on the view. The nodes of the octree needed
+ * for the current view are read after the view has changed, a few at a time,
+ * and kept in a cache for the next views.
+ */
+class PointsGuiExport ViewProviderTiled : public ViewProviderScattered
+{
+    PROPERTY_HEADER(PointsGui::ViewProviderTiled);
+
+public:
+    ViewProviderTiled();
+    virtual ~ViewProviderTiled();
+
+    App::PropertyInteger PointBudget;
+    App::PropertyFloat PointSpacing;
+    App::PropertyInteger ShownPoints;
+
+    virtual void attach(App::DocumentObject *);
+    /// Update the point representation
+    virtual void updateData(const App::Property*);
+
+protected:
+    void onChanged(const App::Property* prop);
+    virtual void cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer &Viewer);
+
+private:
+    static void renderCallback(void * ud, SoAction * action);
+    static void updateCallback(void * ud, SoSensor * sensor);
+    Points::Tiled* getTiled() const;
+    void clearCache();
+    void updatePoints();
+
+private:
+    struct CacheEntry {
+        std::vector<Base::Vector3f> points;
+        uint64_t lastUse;
+    };
+
+    SoCallback          * pcViewCallback;
+    SoOneShotSensor     * pcUpdateSensor;
+    bool                  hasView;
+    SbViewVolume          viewVolume;  /**< The view volume in world coordinates. */
+    SbMatrix              modelMatrix;
+    SbViewportRegion      viewport;
+    std::map<std::size_t, CacheEntry> nodeCache;
+    std::vector<int32_t>  nodeParents;
+    uint64_t              cachedPoints;
+    uint64_t              updateCount;
+};
+
 typedef Gui::ViewProviderPythonFeatureT<ViewProviderScattered> ViewProviderPython;
 
 } // namespace PointsGui
@@ -22,25 +22,27 @@
 
 
 #include "PreCompiled.h"
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
+#ifndef _PreComp_
+# include <algorithm>
+# include <limits>
+#endif
+
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
 
-#include <QFuture>
-#include <QFutureWatcher>
+#include <QThread>
 #include <QtConcurrentMap>
-#include <boost_bind_bind.hpp>
 
 #include <Mod/Mesh/App/Core/Approximation.h>
+#include <Base/Console.h>
 #include <Base/Sequencer.h>
+#include <Base/TimeInfo.h>
 #include <Base/Tools2D.h>
 #include <Base/Tools.h>
 
 #include "ApproxSurface.h"
 
 using namespace Reen;
-namespace bp = boost::placeholders;
 
 // SplineBasisfunction
 
@@ -858,64 +860,225 @@ void BSplineParameterCorrection::SetVKnots(const std::vector<double>& afKnots)
     _clVSpline.SetKnots(_vVKnots, _vVMults, _usVOrder);
 }
 
+namespace Reen {
+/**
+ * The normal equations M^T*M*X = M^T*b of the least-squares system of the
+ * control points. The lower half of the symmetric band matrix M^T*M is stored
+ * row by row.
+ */
+class BandedNormalEquations
+{
+public:
+    BandedNormalEquations(std::size_t dim, std::size_t width)
+      : dim(dim)
+      , width(std::min(width, dim > 0 ? dim - 1 : 0))
+      , matrix(dim * (this->width + 1), 0.0)
+    {
+        for (int i=0; i<3; i++)
+            rhs[i].resize(dim, 0.0);
+    }
+    /// the element of \a row and \a col with col <= row <= col + width
+    double& operator()(std::size_t row, std::size_t col)
+    {
+        return matrix[row * (width + 1) + row - col];
+    }
+    std::size_t bandWidth() const
+    {
+        return width;
+    }
+    /// adds the terms of a point, \a index must be in ascending order
+    void addPoint(const std::size_t* index, const double* value, std::size_t num, const gp_Pnt& pnt)
+    {
+        for (std::size_t r=0; r<num; r++) {
+            double* row = &matrix[index[r] * (width + 1)];
+            for (std::size_t c=0; c<=r; c++)
+                row[index[r] - index[c]] += value[r] * value[c];
+            rhs[0][index[r]] += value[r] * pnt.X();
+            rhs[1][index[r]] += value[r] * pnt.Y();
+            rhs[2][index[r]] += value[r] * pnt.Z();
+        }
+    }
+    void add(const BandedNormalEquations& other)
+    {
+        for (std::size_t i=0; i<matrix.size(); i++)
+            matrix[i] += other.matrix[i];
+        for (int j=0; j<3; j++) {
+            for (std::size_t i=0; i<dim; i++)
+                rhs[j][i] += other.rhs[j][i];
+        }
+    }
+    /**
+     * Factorizes the matrix into L*D*L^T in place and solves the system for
+     * the x, y and z coordinates. Returns false if the matrix isn't positive
+     * definite, e.g. if a control point has no influence on any point.
+     */
+    bool solve(std::vector<double> (&x)[3])
+    {
+        BandedNormalEquations& a = *this;
+        double maxDiag = 0.0;
+        for (std::size_t i=0; i<dim; i++)
+            maxDiag = std::max(maxDiag, std::fabs(a(i,i)));
+        double eps = maxDiag * std::numeric_limits<double>::epsilon();
+
+        for (std::size_t j=0; j<dim; j++) {
+            std::size_t last = std::min(dim - 1, j + width);
+            for (std::size_t i=j; i<=last; i++) {
+                double sum = a(i,j);
+                for (std::size_t k = i > width ? i - width : 0; k<j; k++)
+                    sum -= a(i,k) * a(j,k) * a(k,k);
+                if (i == j) {
+                    if (!(sum > eps))
+                        return false;
+                    a(j,j) = sum;
+                }
+                else {
+                    a(i,j) = sum / a(j,j);
+                }
+            }
+        }
+
+        for (int c=0; c<3; c++) {
+            std::vector<double>& y = x[c];
+            y = rhs[c];
+            for (std::size_t i=0; i<dim; i++) {
+                for (std::size_t k = i > width ? i - width : 0; k<i; k++)
+                    y[i] -= a(i,k) * y[k];
+            }
+            for (std::size_t i=0; i<dim; i++)
+                y[i] /= a(i,i);
+            for (std::size_t i=dim; i-- > 0;) {
+                std::size_t last = std::min(dim - 1, i + width);
+                for (std::size_t k=i+1; k<=last; k++)
+                    y[i] -= a(k,i) * y[k];
+            }
+        }
+
+        return true;
+    }
+
+private:
+    std::size_t dim;
+    std::size_t width;
+    std::vector<double> matrix;
+    std::vector<double> rhs[3];
+};
+
+/// Splits the range [0,count) into at most \a maxParts parts of at least \a minSize elements
+static std::vector<std::pair<int, int> > splitRange(int count, int minSize, int maxParts)
+{
+    int numParts = std::max(1, std::min(maxParts, count / minSize));
+    std::vector<std::pair<int, int> > parts;
+    parts.reserve(numParts);
+    for (int i=0; i<numParts; i++) {
+        int begin = static_cast<int>(static_cast<long long>(count) * i / numParts);
+        int end = static_cast<int>(static_cast<long long>(count) * (i + 1) / numParts);
+        parts.emplace_back(begin, end);
+    }
+    return parts;
+}
+
+/**
+ * Computes the values of the basis functions at \a fParam that may be
+ * non-zero, i.e. of the poles first, ..., first+order-1. Returns the index
+ * first, the values of non-existing poles are set to zero.
+ */
+static int localBasisFunctions(BSplineBasis& basis, int numPoles, int order,
+                               double fParam, std::vector<double>& values)
+{
+    double param = std::max(0.0, std::min(1.0, fParam));
+    int first = basis.FindSpan(param) - (order - 1);
+    for (int i=0; i<order; i++) {
+        int index = first + i;
+        if (index >= 0 && index < numPoles)
+            values[i] = basis.BasisFunction(index, fParam);
+        else
+            values[i] = 0.0;
+    }
+    return first;
+}
+}
+
 void BSplineParameterCorrection::DoParameterCorrection(int iIter)
 {
     int i=0;
     double fMaxDiff=0.0, fMaxScalar=1.0;
     double fWeight = _fSmoothInfluence;
 
-    Base::SequencerLauncher seq("Calc surface...", iIter*_pvcPoints->Length());
+    Base::SequencerLauncher seq("Calc surface...", iIter);
+
+    // The points are corrected in parallel, each part with its own copy of
+    // the surface because the evaluation of a surface may not be thread-safe
+    struct CorrectionPart {
+        int begin, end;
+        double maxDiff, maxScalar;
+    };
+    std::vector<CorrectionPart> parts;
+    int lower = _pvcPoints->Lower();
+    for (const auto& it : splitRange(_pvcPoints->Length(), 1024, 4 * QThread::idealThreadCount()))
+        parts.push_back({lower + it.first, lower + it.second, 0.0, 1.0});
 
     do {
-        fMaxScalar = 1.0;
-        fMaxDiff   = 0.0;
+        Base::TimeInfo startTime;
 
         Handle(Geom_BSplineSurface) pclBSplineSurf = new Geom_BSplineSurface(_vCtrlPntsOfSurf,
                                                     _vUKnots, _vVKnots, _vUMults, _vVMults, _usUOrder-1, _usVOrder-1);
 
-        for (int ii=_pvcPoints->Lower();ii <=_pvcPoints->Upper();ii++) {
-            double fDeltaU, fDeltaV, fU, fV;
-            const gp_Pnt& pnt = (*_pvcPoints)(ii);
-            gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
-            gp_Pnt PntX;
-            gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
-            //Berechne die ersten beiden Ableitungen und Punkt an der Stelle (u,v)
-            gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
-            pclBSplineSurf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
-            gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
-            gp_Vec ErrorVec = X - P;
-
-            // Berechne Xu x Xv die Normale in X(u,v)
-            gp_Dir clNormal = Xu ^ Xv;
-
-            //Pruefe, ob X = P
-            if (!(X.IsEqual(P,0.001,0.001))) {
-                ErrorVec.Normalize();
-                if (fabs(clNormal*ErrorVec) < fMaxScalar)
-                    fMaxScalar = fabs(clNormal*ErrorVec);
-            }
+        QtConcurrent::blockingMap(parts, [&](CorrectionPart& part) {
+            Handle(Geom_BSplineSurface) surf = Handle(Geom_BSplineSurface)::DownCast(pclBSplineSurf->Copy());
+            part.maxDiff = 0.0;
+            part.maxScalar = 1.0;
+
+            for (int ii=part.begin; ii<part.end; ii++) {
+                double fDeltaU, fDeltaV, fU, fV;
+                const gp_Pnt& pnt = (*_pvcPoints)(ii);
+                gp_Vec P(pnt.X(), pnt.Y(), pnt.Z());
+                gp_Pnt PntX;
+                gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
+                //Berechne die ersten beiden Ableitungen und Punkt an der Stelle (u,v)
+                gp_Pnt2d& uvValue = (*_pvcUVParam)(ii);
+                surf->D2(uvValue.X(), uvValue.Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
+                gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
+                gp_Vec ErrorVec = X - P;
+
+                // Berechne Xu x Xv die Normale in X(u,v)
+                gp_Dir clNormal = Xu ^ Xv;
+
+                //Pruefe, ob X = P
+                if (!(X.IsEqual(P,0.001,0.001))) {
+                    ErrorVec.Normalize();
+                    if (fabs(clNormal*ErrorVec) < part.maxScalar)
+                        part.maxScalar = fabs(clNormal*ErrorVec);
+                }
 
-            fDeltaU =  ( (P-X) * Xu ) / ( (P-X)*Xuu - Xu*Xu );
-            if (fabs(fDeltaU) < Precision::Confusion())
-                fDeltaU = 0.0;
-            fDeltaV =  ( (P-X) * Xv ) / ( (P-X)*Xvv - Xv*Xv );
-            if (fabs(fDeltaV) < Precision::Confusion())
-                fDeltaV = 0.0;
-
-            //Ersetze die alten u/v-Werte durch die neuen
-            fU = uvValue.X() - fDeltaU;
-            fV = uvValue.Y() - fDeltaV;
-            if (fU <= 1.0 && fU >= 0.0 &&
-                fV <= 1.0 && fV >= 0.0) {
-                uvValue.SetX(fU);
-                uvValue.SetY(fV);
-                fMaxDiff = std::max<double>(fabs(fDeltaU), fMaxDiff);
-                fMaxDiff = std::max<double>(fabs(fDeltaV), fMaxDiff);
+                fDeltaU =  ( (P-X) * Xu ) / ( (P-X)*Xuu - Xu*Xu );
+                if (fabs(fDeltaU) < Precision::Confusion())
+                    fDeltaU = 0.0;
+                fDeltaV =  ( (P-X) * Xv ) / ( (P-X)*Xvv - Xv*Xv );
+                if (fabs(fDeltaV) < Precision::Confusion())
+                    fDeltaV = 0.0;
+
+                //Ersetze die alten u/v-Werte durch die neuen
+                fU = uvValue.X() - fDeltaU;
+                fV = uvValue.Y() - fDeltaV;
+                if (fU <= 1.0 && fU >= 0.0 &&
+                    fV <= 1.0 && fV >= 0.0) {
+                    uvValue.SetX(fU);
+                    uvValue.SetY(fV);
+                    part.maxDiff = std::max<double>(fabs(fDeltaU), part.maxDiff);
+                    part.maxDiff = std::max<double>(fabs(fDeltaV), part.maxDiff);
+                }
             }
+        });
 
-            seq.next();
+        fMaxScalar = 1.0;
+        fMaxDiff   = 0.0;
+        for (const auto& it : parts) {
+            fMaxScalar = std::min(fMaxScalar, it.maxScalar);
+            fMaxDiff = std::max(fMaxDiff, it.maxDiff);
         }
 
+        Base::TimeInfo correctTime;
+
         if (_bSmoothing) {
             fWeight *= 0.5f;
             SolveWithSmoothing(fWeight);
@@ -924,6 +1087,12 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
             SolveWithoutSmoothing();
         }
 
+        Base::Console().Log("Parameter correction %d: %d points, correction %.3f s, solving %.3f s, "
+                            "max. change %g\n", i+1, _pvcPoints->Length(),
+                            Base::TimeInfo::diffTimeF(startTime, correctTime),
+                            Base::TimeInfo::diffTimeF(correctTime), fMaxDiff);
+
+        seq.next();
         i++;
     }
     while(i<iIter && fMaxDiff > Precision::Confusion() && fMaxScalar < 0.99);
@@ -931,72 +1100,89 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
 
 bool BSplineParameterCorrection::SolveWithoutSmoothing()
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim  = _usUCtrlpoints*_usVCtrlpoints;
-    math_Matrix M  (0, ulSize-1, 0, ulDim-1);
-    math_Matrix Xx (0, ulDim-1, 0, 0);
-    math_Matrix Xy (0, ulDim-1, 0, 0);
-    math_Matrix Xz (0, ulDim-1, 0, 0);
-    math_Vector bx (0, ulSize-1);
-    math_Vector by (0, ulSize-1);
-    math_Vector bz (0, ulSize-1);
-
-    //Bestimmung der Koeffizientenmatrix des ueberbestimmten LGS
-    for (unsigned i=0; i<ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx=0;
-
-        // Vorberechnung der Werte der Basis-Funktionen
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j,fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k=0; k<_usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k,fV);
-        }
+    return SolveNormalEquations(0.0);
+}
 
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+{
+    return SolveNormalEquations(fWeight);
+}
+
+bool BSplineParameterCorrection::SolveNormalEquations(double fWeight)
+{
+    int uPoles = static_cast<int>(_usUCtrlpoints);
+    int vPoles = static_cast<int>(_usVCtrlpoints);
+    int uOrder = static_cast<int>(_usUOrder);
+    int vOrder = static_cast<int>(_usVOrder);
+    std::size_t ulDim = _usUCtrlpoints*_usVCtrlpoints;
+    std::size_t width = (uOrder-1)*vPoles + (vOrder-1);
+
+    // Each part of the points adds its terms to its own matrix, the parts are
+    // summed up in a fixed order so that the result doesn't depend on the
+    // number of threads. The number of parts is limited by the memory used.
+    struct AssemblyPart {
+        int begin, end;
+        BandedNormalEquations equations;
+    };
+    const std::size_t maxValues = std::size_t(1) << 25;
+    std::size_t bandSize = ulDim * (std::min(width, ulDim-1) + 1);
+    int maxParts = static_cast<int>(std::max<std::size_t>(1, std::min<std::size_t>(64, maxValues / bandSize)));
+
+    std::vector<AssemblyPart> parts;
+    int lower = _pvcPoints->Lower();
+    for (const auto& it : splitRange(_pvcPoints->Length(), 16384, maxParts))
+        parts.push_back({lower + it.first, lower + it.second, BandedNormalEquations(ulDim, width)});
+
+    QtConcurrent::blockingMap(parts, [&](AssemblyPart& part) {
+        std::vector<double> basisU(uOrder), basisV(vOrder);
+        std::vector<std::size_t> index(uOrder*vOrder);
+        std::vector<double> value(uOrder*vOrder);
+
+        for (int ii=part.begin; ii<part.end; ii++) {
+            const gp_Pnt2d& uvValue = _pvcUVParam->Value(ii);
+            int firstU = localBasisFunctions(_clUSpline, uPoles, uOrder, uvValue.X(), basisU);
+            int firstV = localBasisFunctions(_clVSpline, vPoles, vOrder, uvValue.Y(), basisV);
+
+            std::size_t num = 0;
+            for (int j=0; j<uOrder; j++) {
+                if (basisU[j] == 0.0)
+                    continue;
+                for (int k=0; k<vOrder; k++) {
+                    double val = basisU[j] * basisV[k];
+                    if (val != 0.0) {
+                        index[num] = (firstU+j)*vPoles + firstV+k;
+                        value[num] = val;
+                        num++;
+                    }
                 }
             }
-        }
-    }
 
-    //Bestimmen der rechten Seite
-    for (int ii=_pvcPoints->Lower(); ii<=_pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X(); by(ii) = pnt.Y(); bz(ii) = pnt.Z();
+            part.equations.addPoint(index.data(), value.data(), num, _pvcPoints->Value(ii));
+        }
+    });
+
+    BandedNormalEquations& equations = parts.front().equations;
+    for (std::size_t i=1; i<parts.size(); i++)
+        equations.add(parts[i].equations);
+
+    // the smoothing functionals only couple control points within the band
+    if (fWeight != 0.0) {
+        std::size_t band = equations.bandWidth();
+        for (std::size_t i=0; i<ulDim; i++) {
+            for (std::size_t j = i > band ? i - band : 0; j<=i; j++)
+                equations(i,j) += fWeight * _clSmoothMatrix(i,j);
+        }
     }
 
-    // Loese das ueberbest. LGS mit der Householder-Transformation
-    math_Householder hhX(M,bx);
-    math_Householder hhY(M,by);
-    math_Householder hhZ(M,bz);
-
-    if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone()))
+    std::vector<double> X[3];
+    if (!equations.solve(X))
         //LGS konnte nicht geloest werden
         return false;
-    Xx = hhX.AllValues();
-    Xy = hhY.AllValues();
-    Xz = hhZ.AllValues();
 
     unsigned ulIdx=0;
     for (unsigned j=0;j<_usUCtrlpoints;j++) {
         for (unsigned k=0;k<_usVCtrlpoints;k++) {
-            _vCtrlPntsOfSurf(j,k) = gp_Pnt(Xx(ulIdx,0),Xy(ulIdx,0),Xz(ulIdx,0));
+            _vCtrlPntsOfSurf(j,k) = gp_Pnt(X[0][ulIdx],X[1][ulIdx],X[2][ulIdx]);
             ulIdx++;
         }
     }
@@ -1005,151 +1191,67 @@ bool BSplineParameterCorrection::SolveWithoutSmoothing()
 }
 
 namespace Reen {
-class ScalarProduct
+/// A product of integrals of B-spline derivatives in u and v direction
+struct SmoothingTerm
 {
-public:
-    ScalarProduct(const math_Matrix& mat) : mat(mat)
-    {
-    }
-    std::vector<double> multiply(int col) const
-    {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n=mat.LowerCol(); n<=mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
-        }
-        return out;
-    }
-
-private:
-    const math_Matrix& mat;
+    double factor;
+    int uOrd1, uOrd2;
+    int vOrd1, vOrd2;
 };
-}
 
-bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+/**
+ * Computes the matrix of a smoothing functional. The integrals of the products
+ * of the B-splines of one direction are computed only once, the rows of the
+ * matrix are computed in parallel.
+ */
+static void calcSmoothMatrix(BSplineBasis& uSpline, BSplineBasis& vSpline,
+                             unsigned uPoles, unsigned vPoles,
+                             const std::vector<SmoothingTerm>& terms, math_Matrix& matrix)
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim  = _usUCtrlpoints*_usVCtrlpoints;
-    math_Matrix M  (0, ulSize-1, 0, ulDim-1);
-    math_Vector Xx (0, ulDim-1);
-    math_Vector Xy (0, ulDim-1);
-    math_Vector Xz (0, ulDim-1);
-    math_Vector bx (0, ulSize-1);
-    math_Vector by (0, ulSize-1);
-    math_Vector bz (0, ulSize-1);
-    math_Vector Mbx(0, ulDim-1);
-    math_Vector Mby(0, ulDim-1);
-    math_Vector Mbz(0, ulDim-1);
-
-    //Bestimmung der Koeffizientenmatrix des ueberbestimmten LGS
-    for (unsigned i=0; i<ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        int ulIdx=0;
-
-        // Vorberechnung der Werte der Basis-Funktionen
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j,fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k=0; k<_usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k,fV);
-        }
-
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = 0.0;
-                    ulIdx++;
+    typedef std::vector<double> Table;
+    auto makeTable = [](BSplineBasis& spline, int poles, int ord1, int ord2) {
+        Table table(poles * poles);
+        std::vector<int> rows(poles);
+        std::generate(rows.begin(), rows.end(), Base::iotaGen<int>(0));
+        QtConcurrent::blockingMap(rows, [&](int i) {
+            for (int k=0; k<poles; k++)
+                table[i * poles + k] = spline.GetIntegralOfProductOfBSplines(i, k, ord1, ord2);
+        });
+        return table;
+    };
+
+    std::vector<Table> uTables, vTables;
+    for (const auto& it : terms) {
+        uTables.push_back(makeTable(uSpline, uPoles, it.uOrd1, it.uOrd2));
+        vTables.push_back(makeTable(vSpline, vPoles, it.vOrd1, it.vOrd2));
+    }
+
+    std::vector<unsigned> rows(uPoles * vPoles);
+    std::generate(rows.begin(), rows.end(), Base::iotaGen<unsigned>(0));
+    QtConcurrent::blockingMap(rows, [&](unsigned m) {
+        unsigned k = m / vPoles;
+        unsigned l = m % vPoles;
+        unsigned n=0;
+
+        for (unsigned i=0; i<uPoles; i++) {
+            for (unsigned j=0; j<vPoles; j++) {
+                double value = 0.0;
+                for (std::size_t t=0; t<terms.size(); t++) {
+                    value += terms[t].factor * uTables[t][i * uPoles + k] *
+                                               vTables[t][j * vPoles + l];
                 }
+                matrix(m,n) = value;
+                n++;
             }
-            else {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = valueU * basisV[k];
-                    ulIdx++;
-                }
-            }
-        }
-    }
-
-    //Das Produkt aus ihrer Transformierten und ihr selbst ergibt die quadratische Systemmatrix (langsam)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim-1, 0, ulDim-1);
-    for (unsigned m=0; m<ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n=m; n<ulDim; n++) {
-            MTM(m,n) = MTM(n,m) = Mm * M.Col(n);
-        }
-    }
-#else // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    QFuture< std::vector<double> > future = QtConcurrent::mapped
-        (columns, boost::bind(&ScalarProduct::multiply, &scalar, bp::_1));
-    QFutureWatcher< std::vector<double> > watcher;
-    watcher.setFuture(future);
-    watcher.waitForFinished();
-
-    math_Matrix MTM(0, ulDim-1, 0, ulDim-1);
-    int rowIndex=0;
-    for (QFuture< std::vector<double> >::const_iterator it = future.begin(); it != future.end(); ++it) {
-        int colIndex=0;
-        for (std::vector<double>::const_iterator jt = it->begin(); jt != it->end(); ++jt, colIndex++)
-            MTM(rowIndex, colIndex) = *jt;
-        rowIndex++;
-    }
-#endif
-
-    //Bestimmen der rechten Seite
-    for (int ii=_pvcPoints->Lower(); ii<=_pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X(); by(ii) = pnt.Y(); bz(ii) = pnt.Z();
-    }
-    for (unsigned i=0; i<ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
-    }
-
-    // Loese das LGS mit der LU-Zerlegung
-    math_Gauss mgGaussX(MTM+fWeight*_clSmoothMatrix);
-    math_Gauss mgGaussY(MTM+fWeight*_clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM+fWeight*_clSmoothMatrix);
-
-    mgGaussX.Solve(Mbx,Xx);
-    if (!mgGaussX.IsDone())
-        return false;
-
-    mgGaussY.Solve(Mby,Xy);
-    if (!mgGaussY.IsDone())
-        return false;
-
-    mgGaussZ.Solve(Mbz,Xz);
-    if (!mgGaussZ.IsDone())
-        return false;
-
-    unsigned ulIdx=0;
-    for (unsigned j=0;j<_usUCtrlpoints;j++) {
-        for (unsigned k=0;k<_usVCtrlpoints;k++) {
-            _vCtrlPntsOfSurf(j,k) = gp_Pnt(Xx(ulIdx),Xy(ulIdx),Xz(ulIdx));
-            ulIdx++;
         }
-    }
-
-    return true;
+    });
+}
 }
 
 void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc, double fFirst, double fSecond, double fThird)
 {
     if (bRecalc) {
-        Base::SequencerLauncher seq("Initializing...", 3 * _usUCtrlpoints * _usUCtrlpoints * _usVCtrlpoints * _usVCtrlpoints);
+        Base::SequencerLauncher seq("Initializing...", 3);
         CalcFirstSmoothMatrix(seq);
         CalcSecondSmoothMatrix(seq);
         CalcThirdSmoothMatrix(seq);
@@ -1162,82 +1264,42 @@ void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc, double fFirst,
 
 void BSplineParameterCorrection::CalcFirstSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m=0;
-    for (unsigned k=0; k<_usUCtrlpoints; k++) {
-        for (unsigned l=0; l<_usVCtrlpoints; l++) {
-            unsigned n=0;
-
-            for (unsigned i=0; i<_usUCtrlpoints; i++) {
-                for (unsigned j=0; j<_usVCtrlpoints; j++) {
-                    _clFirstMatrix(m,n) =   _clUSpline.GetIntegralOfProductOfBSplines(i,k,1,1) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,0) +
-                                            _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,0) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,1);
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    std::vector<SmoothingTerm> terms = {
+        {1.0, 1,1, 0,0},
+        {1.0, 0,0, 1,1}
+    };
+
+    calcSmoothMatrix(_clUSpline, _clVSpline, _usUCtrlpoints, _usVCtrlpoints, terms, _clFirstMatrix);
+    seq.next();
 }
 
 void BSplineParameterCorrection::CalcSecondSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m=0;
-    for (unsigned k=0; k<_usUCtrlpoints; k++) {
-        for (unsigned l=0; l<_usVCtrlpoints; l++) {
-            unsigned n=0;
-
-            for (unsigned i=0; i<_usUCtrlpoints; i++) {
-                for (unsigned j=0; j<_usVCtrlpoints; j++) {
-                    _clSecondMatrix(m,n) =  _clUSpline.GetIntegralOfProductOfBSplines(i,k,2,2) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,0) +
-                                          2*_clUSpline.GetIntegralOfProductOfBSplines(i,k,1,1) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,1) +
-                                            _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,0) *
-                                            _clVSpline.GetIntegralOfProductOfBSplines(j,l,2,2);
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    std::vector<SmoothingTerm> terms = {
+        {1.0, 2,2, 0,0},
+        {2.0, 1,1, 1,1},
+        {1.0, 0,0, 2,2}
+    };
+
+    calcSmoothMatrix(_clUSpline, _clVSpline, _usUCtrlpoints, _usVCtrlpoints, terms, _clSecondMatrix);
+    seq.next();
 }
 
 void BSplineParameterCorrection::CalcThirdSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m=0;
-    for (unsigned k=0; k<_usUCtrlpoints; k++) {
-        for (unsigned l=0; l<_usVCtrlpoints; l++) {
-            unsigned n=0;
-
-            for (unsigned i=0; i<_usUCtrlpoints; i++) {
-                for (unsigned j=0; j<_usVCtrlpoints; j++) {
-                    _clThirdMatrix(m,n) = _clUSpline.GetIntegralOfProductOfBSplines(i,k,3,3) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,0) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,3,1) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,0,2) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,1,3) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,2,0) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,1,1) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,2,2) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,2,2) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,1) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,2) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,3,1) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,2,0) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,1,3) +
-                                          _clUSpline.GetIntegralOfProductOfBSplines(i,k,0,0) *
-                                          _clVSpline.GetIntegralOfProductOfBSplines(j,l,3,3) ;
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    std::vector<SmoothingTerm> terms = {
+        {1.0, 3,3, 0,0},
+        {1.0, 3,1, 0,2},
+        {1.0, 1,3, 2,0},
+        {1.0, 1,1, 2,2},
+        {1.0, 2,2, 1,1},
+        {1.0, 0,2, 3,1},
+        {1.0, 2,0, 1,3},
+        {1.0, 0,0, 3,3}
+    };
+
+    calcSmoothMatrix(_clUSpline, _clVSpline, _usUCtrlpoints, _usVCtrlpoints, terms, _clThirdMatrix);
+    seq.next();
 }
 
 void BSplineParameterCorrection::EnableSmoothing(bool bSmooth, double fSmoothInfl)
@@ -390,16 +390,25 @@ protected:
     virtual void DoParameterCorrection(int iIter);
 
     /**
-     * Loest ein ueberbestimmtes LGS mit Hilfe der Householder-Transformation
+     * Loest das ueberbestimmte LGS ueber seine Normalgleichungen
      */
     virtual bool SolveWithoutSmoothing();
 
     /**
-     * Loest ein regulaeres Gleichungssystem durch LU-Zerlegung. Es fliessen je nach Gewichtung
+     * Loest die Normalgleichungen, es fliessen je nach Gewichtung
      * Glaettungsterme mit ein
      */
     virtual bool SolveWithSmoothing(double fWeight);
 
+    /**
+     * Stellt die Normalgleichungen des Ausgleichsproblems parallel ueber die
+     * Punkte auf und loest sie mit einer LDLT-Zerlegung der Bandmatrix. Da in
+     * jedem Punkt nur uOrder*vOrder Basisfunktionen ungleich Null sind, ist die
+     * Systemmatrix eine Bandmatrix. Ist \a fWeight ungleich Null, fliessen die
+     * Glaettungsterme mit ein.
+     */
+    bool SolveNormalEquations(double fWeight);
+
 public:
     /**
      * Setzen des Knotenvektors
@@ -55,7 +55,9 @@
 #ifdef _PreComp_
 
 // standard
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <stdio.h>
 #include <assert.h>
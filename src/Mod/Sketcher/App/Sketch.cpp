@@ -39,6 +39,7 @@
 #include <Base/Reader.h>
 #include <Base/Exception.h>
 #include <Base/TimeInfo.h>
+#include <Base/Trace.h>
 #include <Base/Console.h>
 #include <Base/VectorPy.h>
 
@@ -3535,6 +3536,7 @@ bool Sketch::updateNonDrivingConstraints()
 
 int Sketch::solve(void)
 {
+    FC_TRACE_SCOPE("Sketcher", "solve");
     Base::TimeInfo start_time;
     std::string solvername;
 
@@ -27,6 +27,7 @@
 # include <sstream>
 # include <iostream>
 # include <iterator>
+# include <chrono>
 #include <Precision.hxx>
 #include <cmath>
 #endif
@@ -162,6 +163,8 @@ void DrawPage::onChanged(const App::Property* prop)
 //Page is just a container. It doesn't "do" anything.
 App::DocumentObjectExecReturn *DrawPage::execute(void)
 {
+    //our views are executed before us. collect any projections still running.
+    joinViewProjections();
     return App::DocumentObject::StdReturn;
 }
 
@@ -356,6 +359,7 @@ void DrawPage::updateAllViews()
             collect->recomputeFeature();
         }
     }
+    joinViewProjections();
     //second, make sure all the Dimensions have been executed so Measurements have References
     for(it = featViews.begin(); it != featViews.end(); ++it) {
         TechDraw::DrawViewDimension *dim = dynamic_cast<TechDraw::DrawViewDimension *>(*it);
@@ -382,6 +386,30 @@ void DrawPage::updateAllViews()
 
 }
 
+//! wait for the views whose hidden line removal is running concurrently and repaint them
+void DrawPage::joinViewProjections(void)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    int joined = 0;
+    std::vector<App::DocumentObject*> featViews = getAllViews();
+    for (auto& v: featViews) {
+        TechDraw::DrawViewPart* part = dynamic_cast<TechDraw::DrawViewPart*>(v);
+        if (part == nullptr) {
+            continue;
+        }
+        if (part->hlrPending()) {
+            joined++;
+        }
+        part->joinHlr();
+    }
+    if (joined > 0) {
+        auto end = std::chrono::high_resolution_clock::now();
+        double diffOut = std::chrono::duration<double, std::milli>(end - start).count();
+        Base::Console().Log("TIMING - %s joined %d view projections in %.3f millisecs\n",
+                            getNameInDocument(), joined, diffOut);
+    }
+}
+
 std::vector<App::DocumentObject*> DrawPage::getAllViews(void) 
 {
     auto views = Views.getValues();   //list of docObjects
@@ -94,6 +94,7 @@ public:
     bool isUnsetting(void) { return nowUnsetting; }
     void requestPaint(void);
     std::vector<App::DocumentObject*> getAllViews(void) ;
+    void joinViewProjections(void);
     DrawViewPart *balloonParent;    //could be many balloons on page? 
     
     int getNextBalloonIndex(void);
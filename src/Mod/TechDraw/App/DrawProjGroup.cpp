@@ -189,6 +189,15 @@ App::DocumentObjectExecReturn *DrawProjGroup::execute(void)
         return DrawViewCollection::execute();
     }
 
+    //our items are executed before us, but their projections may still be running.
+    //their sizes are needed to fit and position them.
+    for (auto& v: Views.getValues()) {
+        auto item = dynamic_cast<DrawProjGroupItem*>(v);
+        if (item != nullptr) {
+            item->joinHlr();
+        }
+    }
+
     if (ScaleType.isValue("Automatic")) {
         if (!checkFit()) {
             double newScale = autoScale();
@@ -145,7 +145,10 @@ App::DocumentObjectExecReturn *DrawProjGroupItem::execute(void)
     }
 
     App::DocumentObjectExecReturn* ret = DrawViewPart::execute();
-    autoPosition();
+    if (!hlrPending()) {
+        //otherwise our size is not known yet. DPG::execute positions us after the join.
+        autoPosition();
+    }
     return ret;
 }
 
@@ -77,8 +77,11 @@
 
 #include <limits>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
+#include <QtConcurrentRun>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/GroupExtension.h>
@@ -127,7 +130,13 @@ PROPERTY_SOURCE_WITH_EXTENSIONS(TechDraw::DrawViewPart,
                                 TechDraw::DrawView)
 
 DrawViewPart::DrawViewPart(void) :
-    geometryObject(0)
+    geometryObject(0),
+    m_hlrCache(nullptr),
+    m_pendingGO(nullptr),
+    m_pendingUsesCache(false),
+    m_hlrNeedsPaint(false),
+    m_hlrWaitTime(0.0),
+    m_hlrExtractTime(0.0)
 {
     static const char *group = "Projection";
     static const char *sgroup = "HLR Parameters";
@@ -176,8 +185,13 @@ DrawViewPart::DrawViewPart(void) :
 
 DrawViewPart::~DrawViewPart()
 {
+    if (m_pendingGO != nullptr) {
+        m_hlrFuture.waitForFinished();
+        delete m_pendingGO;
+    }
     removeAllReferencesFromGeom();
     delete geometryObject;
+    delete m_hlrCache;
 }
 
 std::vector<TopoDS_Shape> DrawViewPart::getSourceShape2d(void) const
@@ -290,7 +304,6 @@ App::DocumentObjectExecReturn *DrawViewPart::execute(void)
 
     m_saveShape = shape;
     partExec(shape);
-    addShapes2d();
 
     //second pass if required
     if (ScaleType.isValue("Automatic")) {
@@ -302,6 +315,13 @@ App::DocumentObjectExecReturn *DrawViewPart::execute(void)
         }
     }
 
+    if (hlrPending()) {
+        //projection is still running. the parent page joins it and asks for the repaint.
+        handleXYLock();
+        purgeTouched();
+        return App::DocumentObject::StdReturn;
+    }
+
 //#endif //#if MOD_TECHDRAW_HANDLE_FACES
     return DrawView::execute();
 }
@@ -353,6 +373,13 @@ void DrawViewPart::onChanged(const App::Property* prop)
 void DrawViewPart::partExec(TopoDS_Shape shape)
 {
 //    Base::Console().Message("DVP::partExec()\n");
+    //never have two projections of the same view in flight
+    waitForHlr();
+    if (useConcurrentHlr()) {
+        startHlr(shape);
+        return;
+    }
+
     if (geometryObject) {
         delete geometryObject;
         geometryObject = nullptr;
@@ -361,7 +388,12 @@ void DrawViewPart::partExec(TopoDS_Shape shape)
     if (geometryObject == nullptr) {
         return;
     }
+    postHlrTasks();
+}
 
+//! everything that needs the projected edges: faces, cosmetics, references, 2d shapes
+void DrawViewPart::postHlrTasks(void)
+{
 #if MOD_TECHDRAW_HANDLE_FACES
     if (handleFaces() && !geometryObject->usePolygonHLR()) {
         try {
@@ -378,6 +410,114 @@ void DrawViewPart::partExec(TopoDS_Shape shape)
     addCenterLinesToGeom();
 
     addReferencesToGeom();
+    addShapes2d();
+}
+
+//! the hidden line removal may run in a worker thread if this view is on a page and
+//! nobody needs its size during execute (automatic scaling). The polygon algo meshes
+//! the source shape in place, so it always runs in the main thread.
+bool DrawViewPart::useConcurrentHlr(void) const
+{
+    if (!Preferences::concurrentHlr() ||
+        CoarseView.getValue() ||
+        ScaleType.isValue("Automatic") ||
+        (findParentPage() == nullptr)) {
+        return false;
+    }
+    return true;
+}
+
+//! start the projection of shape in the global thread pool. The result is installed
+//! by finishHlr() when the geometry is first needed or when the page joins us.
+void DrawViewPart::startHlr(TopoDS_Shape shape)
+{
+    gp_Ax2 viewAxis;
+    m_pendingUsesCache = useHlrCache();
+    double scale = m_pendingUsesCache ? 1.0 : getScale();
+    TopoDS_Shape scaledShape = prepareShape(shape, viewAxis, scale);
+    if (m_pendingUsesCache) {
+        m_pendingKey = makeHlrCacheKey();
+        if (hlrCacheHit(m_pendingKey)) {
+            //only scale or position have changed. no need for a worker.
+            delete geometryObject;
+            geometryObject = geometryFromHlrCache();
+            postHlrTasks();
+            return;
+        }
+    }
+
+    m_pendingGO = setupGeometryObject();
+    m_pendingGO->deferReports(true);
+    m_hlrNeedsPaint = true;
+    m_hlrStart = std::chrono::high_resolution_clock::now();
+    m_hlrFuture = QtConcurrent::run(m_pendingGO, &GeometryObject::projectShape,
+                                    scaledShape, viewAxis);
+}
+
+//! wait for the worker, then extract the edges and replace the old geometry
+void DrawViewPart::finishHlr(void)
+{
+    if (m_pendingGO == nullptr) {
+        return;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    m_hlrFuture.waitForFinished();
+    auto end = std::chrono::high_resolution_clock::now();
+    m_hlrWaitTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+    //clear the pending state first. getters called below must not come back here.
+    TechDraw::GeometryObject* go = m_pendingGO;
+    m_pendingGO = nullptr;
+    go->deferReports(false);
+    go->flushReports();
+
+    start = std::chrono::high_resolution_clock::now();
+    if (m_pendingUsesCache) {
+        //go holds the unscaled projection
+        delete m_hlrCache;
+        m_hlrCache = go;
+        m_hlrCacheKey = m_pendingKey;
+        m_pendingKey = HlrCacheKey();
+        go = geometryFromHlrCache();
+    } else {
+        extractHlrEdges(go);
+    }
+    delete geometryObject;
+    geometryObject = go;
+    postHlrTasks();
+    end = std::chrono::high_resolution_clock::now();
+    m_hlrExtractTime = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void DrawViewPart::waitForHlr(void) const
+{
+    if (m_pendingGO != nullptr) {
+        const_cast<DrawViewPart*>(this)->finishHlr();
+    }
+}
+
+void DrawViewPart::joinHlr(void)
+{
+    waitForHlr();
+    if (!m_hlrNeedsPaint) {
+        return;
+    }
+    m_hlrNeedsPaint = false;
+    GeometryObject* go = geometryObject;
+    if (go != nullptr) {
+        double elapsed = std::chrono::duration<double, std::milli>(
+                             std::chrono::high_resolution_clock::now() - m_hlrStart).count();
+        Base::Console().Log("TIMING - %s HLR: %.3f toShape: %.3f main thread wait: %.3f extract: %.3f elapsed: %.3f millisecs\n",
+                            getNameInDocument(), go->getHlrTime(), go->getHlrToShapeTime(),
+                            m_hlrWaitTime, m_hlrExtractTime, elapsed);
+    }
+    requestPaint();
+}
+
+TechDraw::GeometryObject* DrawViewPart::getGeometryObject(void) const
+{
+    waitForHlr();
+    return geometryObject;
 }
 
 void DrawViewPart::addShapes2d(void)
@@ -411,11 +551,32 @@ void DrawViewPart::addShapes2d(void)
 }
 
 GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
+{
+    gp_Ax2 viewAxis;
+    if (!useHlrCache()) {
+        TopoDS_Shape scaledShape = prepareShape(shape, viewAxis, getScale());
+        GeometryObject* go =  buildGeometryObject(scaledShape,viewAxis);
+        return go;
+    }
+
+    TopoDS_Shape unscaledShape = prepareShape(shape, viewAxis, 1.0);
+    HlrCacheKey key = makeHlrCacheKey();
+    if (!hlrCacheHit(key)) {
+        delete m_hlrCache;
+        m_hlrCache = setupGeometryObject();
+        m_hlrCache->projectShape(unscaledShape, viewAxis);
+        m_hlrCacheKey = key;
+    }
+    return geometryFromHlrCache();
+}
+
+//! center, scale and rotate the source shape for projection. returns the projection CS in viewAxis.
+TopoDS_Shape DrawViewPart::prepareShape(TopoDS_Shape shape, gp_Ax2& viewAxis, double scale)
 {
     gp_Pnt inputCenter;
     Base::Vector3d stdOrg(0.0,0.0,0.0);
 
-    gp_Ax2 viewAxis = getProjectionCS(stdOrg);
+    viewAxis = getProjectionCS(stdOrg);
 
     inputCenter = TechDraw::findCentroid(shape,
                                          viewAxis);
@@ -429,26 +590,24 @@ GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
     m_saveCentroid = centroid;
     m_saveShape = centeredShape;
 
-    TopoDS_Shape scaledShape = TechDraw::scaleShape(centeredShape,
-                                                    getScale());
+    TopoDS_Shape scaledShape = centeredShape;
+    if (!DrawUtil::fpCompare(scale, 1.0)) {
+        scaledShape = TechDraw::scaleShape(centeredShape,
+                                           scale);
+    }
     if (!DrawUtil::fpCompare(Rotation.getValue(),0.0)) {
         scaledShape = TechDraw::rotateShape(scaledShape,
                                             viewAxis,
                                             Rotation.getValue());  //conventional rotation
      }
 //    BRepTools::Write(scaledShape, "DVPScaled.brep");            //debug
-    GeometryObject* go =  buildGeometryObject(scaledShape,viewAxis);
-    return go;
+    return scaledShape;
 }
 
 //note: slightly different than routine with same name in DrawProjectSplit
 TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis)
 {
-    TechDraw::GeometryObject* go = new TechDraw::GeometryObject(getNameInDocument(), this);
-    go->setIsoCount(IsoCount.getValue());
-    go->isPerspective(Perspective.getValue());
-    go->setFocus(Focus.getValue());
-    go->usePolygonHLR(CoarseView.getValue());
+    TechDraw::GeometryObject* go = setupGeometryObject();
 
     if (go->usePolygonHLR()){
         go->projectShapeWithPolygonAlgo(shape,
@@ -459,6 +618,79 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
             viewAxis);
     }
 
+    extractHlrEdges(go);
+    return go;
+}
+
+//! Orthographic exact projections are cached unscaled. Changing only the scale then
+//! reuses the HLR output. Perspective depends on the scale, and the polygon algo
+//! tessellates with an absolute deflection, so neither is cached.
+bool DrawViewPart::useHlrCache(void) const
+{
+    return !Perspective.getValue() &&
+           !CoarseView.getValue();
+}
+
+//! everything the unscaled HLR output depends on
+DrawViewPart::HlrCacheKey DrawViewPart::makeHlrCacheKey(void) const
+{
+    HlrCacheKey key;
+    //the projected shape is a fresh copy each time, but the shapes of the sources
+    //keep their TShape until the sources are recomputed
+    for (auto& l: getAllSources()) {
+        key.sources.push_back(Part::Feature::getShape(l));
+    }
+    key.direction = Direction.getValue();
+    key.xDirection = getXDirection();
+    key.rotation = Rotation.getValue();
+    key.isoCount = IsoCount.getValue();
+    return key;
+}
+
+bool DrawViewPart::hlrCacheHit(const HlrCacheKey& key) const
+{
+    if (m_hlrCache == nullptr) {
+        return false;
+    }
+    const HlrCacheKey& cached = m_hlrCacheKey;
+    if ((key.sources.size() != cached.sources.size()) ||
+        (key.isoCount != cached.isoCount) ||
+        !DrawUtil::fpCompare(key.rotation, cached.rotation) ||
+        !(key.direction == cached.direction) ||
+        !(key.xDirection == cached.xDirection)) {
+        return false;
+    }
+    for (size_t i = 0; i < key.sources.size(); i++) {
+        if (!key.sources.at(i).IsEqual(cached.sources.at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! scale the cached HLR output to the current view scale and extract the edges
+TechDraw::GeometryObject* DrawViewPart::geometryFromHlrCache(void)
+{
+    TechDraw::GeometryObject* go = setupGeometryObject();
+    go->copyHlrOutput(*m_hlrCache, getScale());
+    extractHlrEdges(go);
+    return go;
+}
+
+//! a new GeometryObject with this view's HLR settings
+TechDraw::GeometryObject* DrawViewPart::setupGeometryObject(void)
+{
+    TechDraw::GeometryObject* go = new TechDraw::GeometryObject(getNameInDocument(), this);
+    go->setIsoCount(IsoCount.getValue());
+    go->isPerspective(Perspective.getValue());
+    go->setFocus(Focus.getValue());
+    go->usePolygonHLR(CoarseView.getValue());
+    return go;
+}
+
+//! turn the HLR output of go into TechDraw geometry according to the visibility settings
+void DrawViewPart::extractHlrEdges(TechDraw::GeometryObject* go)
+{
     go->extractGeometry(TechDraw::ecHARD,                   //always show the hard&outline visible lines
                         true);
     go->extractGeometry(TechDraw::ecOUTLINE,
@@ -499,7 +731,6 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
         Base::Console().Log("DVP::buildGO - NO extracted edges!\n");
     }
     bbox = go->calcBoundingBox();
-    return go;
 }
 
 //! make faces from the existing edge geometry
@@ -691,6 +922,7 @@ std::vector<TechDraw::DrawViewBalloon*> DrawViewPart::getBalloons() const
 const std::vector<TechDraw::Vertex *> DrawViewPart::getVertexGeometry() const
 {
     std::vector<TechDraw::Vertex *> result;
+    waitForHlr();
     if (geometryObject != nullptr) {
         result = geometryObject->getVertexGeometry();
     }
@@ -700,6 +932,7 @@ const std::vector<TechDraw::Vertex *> DrawViewPart::getVertexGeometry() const
 const std::vector<TechDraw::Face *> DrawViewPart::getFaceGeometry() const
 {
     std::vector<TechDraw::Face*> result;
+    waitForHlr();
     if (geometryObject != nullptr) {
         result = geometryObject->getFaceGeometry();
     }
@@ -709,6 +942,7 @@ const std::vector<TechDraw::Face *> DrawViewPart::getFaceGeometry() const
 const std::vector<TechDraw::BaseGeom*> DrawViewPart::getEdgeGeometry() const
 {
     std::vector<TechDraw::BaseGeom  *> result;
+    waitForHlr();
     if (geometryObject != nullptr) {
         result = geometryObject->getEdgeGeometry();
     }
@@ -807,6 +1041,7 @@ std::vector<TopoDS_Wire> DrawViewPart::getWireForFace(int idx) const
 
 Base::BoundBox3d DrawViewPart::getBoundingBox() const
 {
+    waitForHlr();
     return bbox;
 }
 
@@ -871,6 +1106,7 @@ BaseGeom* DrawViewPart::projectEdge(const TopoDS_Edge& e) const
 bool DrawViewPart::hasGeometry(void) const
 {
     bool result = false;
+    waitForHlr();
     if (geometryObject == nullptr) {
         return result;
     }
@@ -957,6 +1193,7 @@ std::vector<DrawViewDetail*> DrawViewPart::getDetailRefs(void) const
 
 const std::vector<TechDraw::BaseGeom  *> DrawViewPart::getVisibleFaceEdges() const
 {
+    waitForHlr();
     return geometryObject->getVisibleFaceEdges(SmoothVisible.getValue(),SeamVisible.getValue());
 }
 
@@ -28,6 +28,10 @@
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Wire.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <chrono>
+#include <QFuture>
 
 #include <App/DocumentObject.h>
 #include <App/PropertyLinks.h>
@@ -131,7 +135,14 @@ public:
     const std::vector<TechDraw::Face*> getFaceGeometry() const;
 
     bool hasGeometry(void) const;
-    TechDraw::GeometryObject* getGeometryObject(void) const { return geometryObject; }
+    TechDraw::GeometryObject* getGeometryObject(void) const;
+
+    //! true while a projection started by execute() has not been joined yet
+    bool hlrPending(void) const { return m_pendingGO != nullptr; }
+    //! block until a concurrent projection has finished and its geometry is installed
+    void waitForHlr(void) const;
+    //! called by the parent page after recompute. joins the projection and repaints.
+    void joinHlr(void);
 
     TechDraw::BaseGeom* getGeomByIndex(int idx) const;               //get existing geom for edge idx in projection
     TechDraw::Vertex* getProjVertexByIndex(int idx) const;           //get existing geom for vertex idx in projection
@@ -217,9 +228,17 @@ protected:
 
     virtual TechDraw::GeometryObject*  buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis); //const??
     virtual TechDraw::GeometryObject*  makeGeometryForShape(TopoDS_Shape shape);   //const??
+    TopoDS_Shape prepareShape(TopoDS_Shape shape, gp_Ax2& viewAxis, double scale);
+    TechDraw::GeometryObject* setupGeometryObject(void);
+    void extractHlrEdges(TechDraw::GeometryObject* go);
     void partExec(TopoDS_Shape shape);
+    void postHlrTasks(void);
     virtual void addShapes2d(void);
 
+    bool useConcurrentHlr(void) const;
+    void startHlr(TopoDS_Shape shape);
+    void finishHlr(void);
+
     void extractFaces();
 
     Base::Vector3d shapeCentroid;
@@ -247,6 +266,30 @@ protected:
 private:
     bool nowUnsetting;
 
+    //unscaled HLR output of the last projection, reused while only scale or position change
+    struct HlrCacheKey {
+        std::vector<TopoDS_Shape> sources;
+        Base::Vector3d direction;
+        Base::Vector3d xDirection;
+        double rotation = 0.0;
+        int isoCount = 0;
+    };
+    bool useHlrCache(void) const;
+    HlrCacheKey makeHlrCacheKey(void) const;
+    bool hlrCacheHit(const HlrCacheKey& key) const;
+    TechDraw::GeometryObject* geometryFromHlrCache(void);
+    TechDraw::GeometryObject* m_hlrCache;
+    HlrCacheKey m_hlrCacheKey;
+
+    //concurrent HLR. m_pendingGO is owned by the worker until finishHlr()
+    QFuture<void> m_hlrFuture;
+    TechDraw::GeometryObject* m_pendingGO;
+    bool m_pendingUsesCache;
+    HlrCacheKey m_pendingKey;
+    bool m_hlrNeedsPaint;
+    std::chrono::high_resolution_clock::time_point m_hlrStart;
+    double m_hlrWaitTime;
+    double m_hlrExtractTime;
 };
 
 typedef App::FeaturePythonT<DrawViewPart> DrawViewPartPython;
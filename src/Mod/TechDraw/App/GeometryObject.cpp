@@ -68,6 +68,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <sstream>
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
@@ -95,8 +96,10 @@ GeometryObject::GeometryObject(const string& parent, TechDraw::DrawView* parentO
     m_isoCount(0),
     m_isPersp(false),
     m_focus(100.0),
-    m_usePolygonHLR(false)
-
+    m_usePolygonHLR(false),
+    m_deferReports(false),
+    m_hlrTime(0.0),
+    m_hlrToShapeTime(0.0)
 {
 }
 
@@ -198,18 +201,21 @@ void GeometryObject::projectShape(const TopoDS_Shape& input,
 
     }
     catch (const Standard_Failure& e) {
-        Base::Console().Error("GO::projectShape - OCC error - %s - while projecting shape\n",
-                              e.GetMessageString());
+        std::stringstream ss;
+        ss << "GO::projectShape - OCC error - " << e.GetMessageString() << " - while projecting shape\n";
+        report(true, ss.str());
         }
     catch (...) {
-        Base::Console().Error("GeometryObject::projectShape - unknown error occurred while projecting shape\n");
+        report(true, "GeometryObject::projectShape - unknown error occurred while projecting shape\n");
 //        throw Base::RuntimeError("GeometryObject::projectShape - unknown error occurred while projecting shape");
     }
 
     auto end   = chrono::high_resolution_clock::now();
     auto diff  = end - start;
-    double diffOut = chrono::duration <double, milli> (diff).count();
-    Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in HLRBRep_Algo & co\n",m_parentName.c_str(),diffOut);
+    m_hlrTime = chrono::duration <double, milli> (diff).count();
+    std::stringstream ssTime;
+    ssTime << "TIMING - " << m_parentName << " GO spent: " << m_hlrTime << " millisecs in HLRBRep_Algo & co\n";
+    report(false, ssTime.str());
 
     start = chrono::high_resolution_clock::now();
 
@@ -260,17 +266,72 @@ void GeometryObject::projectShape(const TopoDS_Shape& input,
 
     }
     catch (const Standard_Failure& e) {
-        Base::Console().Error("GO::projectShape - OCC error - %s - while extracting edges\n",
-                              e.GetMessageString());
+        std::stringstream ss;
+        ss << "GO::projectShape - OCC error - " << e.GetMessageString() << " - while extracting edges\n";
+        report(true, ss.str());
     }
     catch (...) {
-        Base::Console().Error("GO::projectShape - unknown error while extracting edges\n");
+        report(true, "GO::projectShape - unknown error while extracting edges\n");
 //        throw Base::RuntimeError("GeometryObject::projectShape - error occurred while extracting edges");
     }
     end   = chrono::high_resolution_clock::now();
     diff  = end - start;
-    diffOut = chrono::duration <double, milli> (diff).count();
-    Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in hlrToShape and BuildCurves\n",m_parentName.c_str(),diffOut);
+    m_hlrToShapeTime = chrono::duration <double, milli> (diff).count();
+    ssTime.str(std::string());
+    ssTime << "TIMING - " << m_parentName << " GO spent: " << m_hlrToShapeTime << " millisecs in hlrToShape and BuildCurves\n";
+    report(false, ssTime.str());
+}
+
+//! send a message to the console, or hold it until flushReports() if we are running
+//! in a worker thread. The console observers are not safe to call from other threads.
+void GeometryObject::report(bool isError, const std::string& msg)
+{
+    if (m_deferReports) {
+        m_reports.emplace_back(isError, msg);
+        return;
+    }
+    if (isError) {
+        Base::Console().Error("%s", msg.c_str());
+    } else {
+        Base::Console().Log("%s", msg.c_str());
+    }
+}
+
+//! print the messages collected while reporting was deferred. main thread only.
+void GeometryObject::flushReports(void)
+{
+    for (auto& r: m_reports) {
+        if (r.first) {
+            Base::Console().Error("%s", r.second.c_str());
+        } else {
+            Base::Console().Log("%s", r.second.c_str());
+        }
+    }
+    m_reports.clear();
+}
+
+//! for an orthographic projection the HLR output is linear in the input, so the
+//! projection of a scaled shape is the scaled projection of the shape.
+void GeometryObject::copyHlrOutput(const GeometryObject& source, double scale)
+{
+    clear();
+    auto scaled = [scale](const TopoDS_Shape& s) {
+        if (s.IsNull() ||
+            DrawUtil::fpCompare(scale, 1.0)) {
+            return s;
+        }
+        return scaleShape(s, scale);
+    };
+    visHard    = scaled(source.visHard);
+    visOutline = scaled(source.visOutline);
+    visSmooth  = scaled(source.visSmooth);
+    visSeam    = scaled(source.visSeam);
+    visIso     = scaled(source.visIso);
+    hidHard    = scaled(source.hidHard);
+    hidOutline = scaled(source.hidOutline);
+    hidSmooth  = scaled(source.hidSmooth);
+    hidSeam    = scaled(source.hidSeam);
+    hidIso     = scaled(source.hidIso);
 }
 
 //mirror a shape thru XZ plane for Qt's inverted Y coordinate
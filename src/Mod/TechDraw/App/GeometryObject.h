@@ -132,6 +132,16 @@ public:
     double getFocus(void) { return m_focus; }
     void pruneVertexGeom(Base::Vector3d center, double radius);
 
+    //! take over the HLR output of another projection, scaled about the origin
+    void copyHlrOutput(const GeometryObject& source, double scale);
+
+    //! hold console output while projecting outside the main thread
+    void deferReports(bool b) { m_deferReports = b; }
+    void flushReports(void);
+    //! msecs spent in the last projectShape
+    double getHlrTime(void) const { return m_hlrTime; }
+    double getHlrToShapeTime(void) const { return m_hlrToShapeTime; }
+
     //dupl mirrorShape???
     static TopoDS_Shape invertGeometry(const TopoDS_Shape s);
 
@@ -204,6 +214,12 @@ protected:
     bool m_isPersp;
     double m_focus;
     bool m_usePolygonHLR;
+
+    void report(bool isError, const std::string& msg);
+    bool m_deferReports;
+    std::vector<std::pair<bool, std::string> > m_reports;
+    double m_hlrTime;
+    double m_hlrToShapeTime;
 };
 
 } //namespace TechDraw
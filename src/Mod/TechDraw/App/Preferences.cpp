@@ -148,6 +148,16 @@ bool Preferences::keepPagesUpToDate()
     return autoUpdate;
 }
 
+//! run the hidden line removal of the views on a page in parallel
+bool Preferences::concurrentHlr()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter().
+                                         GetGroup("BaseApp")->GetGroup("Preferences")->
+                                         GetGroup("Mod/TechDraw/General");
+    bool result = hGrp->GetBool("ConcurrentHLR", true);
+    return result;
+}
+
 bool Preferences::useGlobalDecimals()
 {
     bool result = false;
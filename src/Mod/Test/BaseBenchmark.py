@@ -0,0 +1,258 @@
+# -*- coding: utf-8 -*-
+
+#  Copyright (c) 2021 FreeCAD Developers
+#  LGPL
+
+# Benchmarks of the Base classes, run them from the FreeCAD Python console
+# or with FreeCADCmd:
+# import BaseBenchmark
+# BaseBenchmark.run_parameter(1000000)
+# BaseBenchmark.run_parameter_lookups(100)
+# BaseBenchmark.run_xml_reader(10000)
+# BaseBenchmark.run_xml_reader(path="/path/to/project.FCStd")
+# BaseBenchmark.run_writer(10000)
+# BaseBenchmark.run_dependencies(20000)
+# BaseBenchmark.run_types(1000000)
+# BaseBenchmark.run_tracing(20000)
+
+import os
+import tempfile
+import time
+import FreeCAD
+
+
+def best_of(func, repeat):
+    best = None
+    result = None
+    for r in range(repeat):
+        start = time.time()
+        result = func()
+        elapsed = time.time() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best, result
+
+
+def run_parameter(count=1000000, entries=100, repeat=3):
+    # reads values of a group with a number of entries of each type, the
+    # time includes the call overhead of Python
+    grp = FreeCAD.ParamGet("User parameter:BaseApp/Benchmark/Parameter")
+    for i in range(entries):
+        name = "Value{}".format(i)
+        grp.SetBool(name, True)
+        grp.SetInt(name, i)
+        grp.SetFloat(name, 0.5 * i)
+        grp.SetString(name, name)
+    last = "Value{}".format(entries - 1)
+    print("parameter: {} lookups in a group with {} entries per type".format(count, entries))
+
+    tests = [
+        ("GetBool", lambda: grp.GetBool(last)),
+        ("GetInt", lambda: grp.GetInt(last)),
+        ("GetFloat", lambda: grp.GetFloat(last)),
+        ("GetString", lambda: grp.GetString(last)),
+        ("GetInt missing", lambda: grp.GetInt("Missing", 1)),
+    ]
+    for name, func in tests:
+        def loop():
+            for i in range(count):
+                func()
+        FreeCAD.getParameterLookups(True)
+        best, result = best_of(loop, repeat)
+        lookups, dom = FreeCAD.getParameterLookups()
+        print("  {}: best of {}: {:.3f} s ({:.0f} ns/lookup), {} of {} lookups searched the XML tree".format(
+            name, repeat, best, 1e9 * best / count if count > 0 else 0.0, dom, lookups))
+
+    FreeCAD.ParamGet("User parameter:BaseApp/Benchmark").RemGroup("Parameter")
+
+
+def run_parameter_lookups(count=100):
+    # counts the parameter lookups during a recompute and a save of a
+    # document with count Part features
+    import Part # loads the Part feature types
+    doc = FreeCAD.newDocument("BaseBenchmark")
+    for i in range(count):
+        box = doc.addObject("Part::Box", "Box")
+        box.Placement.Base = FreeCAD.Vector(i, 0, 0)
+        cyl = doc.addObject("Part::Cylinder", "Cylinder")
+        cyl.Placement.Base = FreeCAD.Vector(i, 0, 0)
+        cut = doc.addObject("Part::Cut", "Cut")
+        cut.Base = box
+        cut.Tool = cyl
+    print("parameter lookups: {} objects".format(len(doc.Objects)))
+
+    FreeCAD.getParameterLookups(True)
+    start = time.time()
+    doc.recompute()
+    elapsed = time.time() - start
+    lookups, dom = FreeCAD.getParameterLookups(True)
+    print("  recompute: {:.3f} s, {} lookups, {} searched the XML tree".format(elapsed, lookups, dom))
+
+    path = os.path.join(tempfile.gettempdir(), "BaseBenchmark.FCStd")
+    start = time.time()
+    doc.saveAs(path)
+    elapsed = time.time() - start
+    lookups, dom = FreeCAD.getParameterLookups(True)
+    print("  save: {:.3f} s, {} lookups, {} searched the XML tree".format(elapsed, lookups, dom))
+
+    FreeCAD.closeDocument(doc.Name)
+    os.remove(path)
+
+
+def run_xml_reader(count=10000, repeat=3, path=None):
+    # opens a project file with both XML parsers, if no path is given a
+    # document with count test features is created
+    temp = path is None
+    if temp:
+        doc = FreeCAD.newDocument("BaseBenchmark")
+        for i in range(count):
+            obj = doc.addObject("App::FeatureTest", "Test")
+            obj.String = "String & <{}>".format(i)
+            obj.Float = 0.5 * i
+        path = os.path.join(tempfile.gettempdir(), "BaseBenchmark.FCStd")
+        doc.saveAs(path)
+        FreeCAD.closeDocument(doc.Name)
+    print("xml reader: {} ({} bytes)".format(path, os.path.getsize(path)))
+
+    def load():
+        doc = FreeCAD.openDocument(path, True)
+        num = len(doc.Objects)
+        FreeCAD.closeDocument(doc.Name)
+        return num
+
+    parser = FreeCAD.getXMLParser()
+    try:
+        for name in ("Xerces", "Pull"):
+            FreeCAD.setXMLParser(name)
+            best, num = best_of(load, repeat)
+            print("  {}: best of {}: {:.3f} s ({} objects)".format(name, repeat, best, num))
+    finally:
+        FreeCAD.setXMLParser(parser)
+
+    if temp:
+        os.remove(path)
+
+
+def run_writer(count=10000, repeat=3):
+    # saves a document with count test features with the shortest float
+    # format and with the fixed format of older versions
+    doc = FreeCAD.newDocument("BaseBenchmark")
+    for i in range(count):
+        obj = doc.addObject("App::FeatureTest", "Test")
+        obj.Float = 0.1 * i
+        obj.Vector = FreeCAD.Vector(i / 3.0, -0.5 * i, 1e-3 * i)
+        obj.Placement.Base = obj.Vector
+        obj.Integer = i
+    path = os.path.join(tempfile.gettempdir(), "BaseBenchmark.FCStd")
+    print("writer: {} objects".format(len(doc.Objects)))
+
+    grp = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    shortest = grp.GetBool("ShortestFloats", False)
+    try:
+        for name, on in (("fixed", False), ("shortest", True)):
+            grp.SetBool("ShortestFloats", on)
+            best, result = best_of(lambda: doc.saveAs(path), repeat)
+            print("  {}: best of {}: {:.3f} s ({} bytes)".format(name, repeat, best, os.path.getsize(path)))
+    finally:
+        grp.SetBool("ShortestFloats", shortest)
+
+    FreeCAD.closeDocument(doc.Name)
+    os.remove(path)
+
+
+def run_dependencies(count=20000, repeat=3):
+    # queries the dependency graph of a document with count test features,
+    # every feature links the previous one and the first one of its group of
+    # ten, the recompute has nothing to do and measures its preparation
+    doc = FreeCAD.newDocument("BaseBenchmark")
+    objs = []
+    for i in range(count):
+        obj = doc.addObject("App::FeatureTest", "Test")
+        if objs:
+            obj.Link = objs[-1]
+            obj.LinkList = [objs[i - i % 10]]
+        objs.append(obj)
+    print("dependencies: {} objects".format(len(doc.Objects)))
+
+    start = time.time()
+    doc.recompute()
+    print("  first recompute: {:.3f} s".format(time.time() - start))
+    tests = [
+        ("recompute", lambda: doc.recompute()),
+        ("topological sort", lambda: len(doc.TopologicalSortedObjects)),
+        ("in list", lambda: len(objs[0].InListRecursive)),
+        ("out list", lambda: len(objs[-1].OutListRecursive)),
+    ]
+    for name, func in tests:
+        best, result = best_of(func, repeat)
+        print("  {}: best of {}: {:.3f} s".format(name, repeat, best))
+
+    FreeCAD.closeDocument(doc.Name)
+
+
+def run_types(count=1000000, objects=10000, repeat=3):
+    # looks up types by name and checks the derivation, the time includes
+    # the call overhead of Python, then restores a document with dynamic
+    # properties that are created by their type name
+    TypeId = FreeCAD.Base.TypeId
+    base = TypeId.fromName("App::DocumentObject")
+    print("types: {} registered types".format(TypeId.getNumTypes()))
+
+    tests = [
+        ("fromName", lambda: TypeId.fromName("App::PropertyPlacement")),
+        ("fromName missing", lambda: TypeId.fromName("App::Missing")),
+        ("isDerivedFrom", lambda: TypeId.fromName("App::FeatureTest").isDerivedFrom(base)),
+    ]
+    for name, func in tests:
+        def loop():
+            for i in range(count):
+                func()
+        best, result = best_of(loop, repeat)
+        print("  {}: best of {}: {:.3f} s ({:.0f} ns/call)".format(
+            name, repeat, best, 1e9 * best / count if count > 0 else 0.0))
+
+    doc = FreeCAD.newDocument("BaseBenchmark")
+    for i in range(objects):
+        obj = doc.addObject("App::FeatureTest", "Test")
+        obj.addProperty("App::PropertyLength", "Length")
+        obj.addProperty("App::PropertyPlacement", "Offset")
+        obj.addProperty("App::PropertyStringList", "Names")
+    path = os.path.join(tempfile.gettempdir(), "BaseBenchmark.FCStd")
+    doc.saveAs(path)
+    FreeCAD.closeDocument(doc.Name)
+
+    def load():
+        doc = FreeCAD.openDocument(path, True)
+        FreeCAD.closeDocument(doc.Name)
+    best, result = best_of(load, repeat)
+    print("  restore of {} objects: best of {}: {:.3f} s".format(objects, repeat, best))
+    os.remove(path)
+
+
+def run_tracing(objects=20000, repeat=3):
+    # recomputes a chain of objects with tracing switched off and on, the
+    # difference is the cost of recording a span per object
+    doc = FreeCAD.newDocument("BaseBenchmark")
+    prev = None
+    for i in range(objects):
+        obj = doc.addObject("App::FeatureTest", "Test")
+        obj.Link = prev
+        prev = obj
+
+    def recompute():
+        for obj in doc.Objects:
+            obj.touch()
+        return doc.recompute()
+
+    tracing = FreeCAD.getTracing()
+    try:
+        for on in (False, True):
+            FreeCAD.clearTrace()
+            FreeCAD.setTracing(on)
+            best, result = best_of(recompute, repeat)
+            print("tracing {}: recompute of {} objects: best of {}: {:.3f} s".format(
+                "on" if on else "off", result, repeat, best))
+        print("  {} spans recorded".format(len(FreeCAD.getTraceEvents())))
+    finally:
+        FreeCAD.setTracing(tracing)
+        FreeCAD.clearTrace()
+        FreeCAD.closeDocument(doc.Name)
@@ -347,6 +347,63 @@ class ParameterTestCase(unittest.TestCase):
         self.failUnless(Temp.GetFloat("ExTest") == 4711.4711,"ExportImport error")
         Temp = 0
 
+    def testCache(self):
+        # the cached values must follow all changes of the group
+        Temp = self.TestPar.GetGroup("Cache")
+        self.assertEqual(Temp.GetInt("Value", 1), 1)
+        Temp.SetInt("Value", 2)
+        self.assertEqual(Temp.GetInt("Value", 1), 2)
+        Temp.SetFloat("Value", 0.1)
+        self.assertEqual(Temp.GetFloat("Value"), 0.1)
+        Temp.SetString("Value", "abc")
+        self.assertEqual(Temp.GetString("Value"), "abc")
+        Temp.RemInt("Value")
+        self.assertEqual(Temp.GetInt("Value", 1), 1)
+        Temp.Clear()
+        self.assertEqual(Temp.GetFloat("Value", 1.5), 1.5)
+        self.assertEqual(Temp.GetString("Value", "def"), "def")
+
+        # a value read again doesn't search the XML tree
+        Temp.SetBool("Value", True)
+        FreeCAD.getParameterLookups(True)
+        for i in range(10):
+            self.assertTrue(Temp.GetBool("Value"))
+            self.assertEqual(Temp.GetUnsigned("Missing", 3), 3)
+        lookups, domLookups = FreeCAD.getParameterLookups()
+        self.assertGreaterEqual(lookups, 20)
+        self.assertLessEqual(domLookups, 1)
+
+        # changes by an import
+        Other = self.TestPar.GetGroup("CacheOther")
+        Other.SetInt("Value", 5)
+        TempPath = tempfile.gettempdir() + os.sep + "CacheTest.FCExport"
+        Other.Export(TempPath)
+        Temp.Import(TempPath)
+        self.assertEqual(Temp.GetInt("Value"), 5)
+        self.assertEqual(Temp.GetBool("Value", False), False)
+        Temp = 0
+        Other = 0
+
+    def testTypeId(self):
+        TypeId = FreeCAD.Base.TypeId
+        feature = TypeId.fromName("App::FeatureTest")
+        self.assertEqual(feature.Name, "App::FeatureTest")
+        self.assertTrue(TypeId.fromName("App::Missing").isBad())
+        self.assertTrue(TypeId.fromName("").isBad())
+        self.assertTrue(feature.isDerivedFrom(feature))
+        self.assertTrue(feature.isDerivedFrom(TypeId.fromName("App::DocumentObject")))
+        self.assertTrue(feature.isDerivedFrom(TypeId.fromName("Base::BaseClass")))
+        self.assertFalse(feature.isDerivedFrom(TypeId.fromName("App::Property")))
+        self.assertFalse(feature.isDerivedFrom(TypeId.getBadType()))
+        self.assertFalse(TypeId.fromName("App::DocumentObject").isDerivedFrom(feature))
+        parents = []
+        parent = feature
+        while not parent.isBad():
+            self.assertTrue(feature.isDerivedFrom(parent))
+            parents.append(parent)
+            parent = parent.getParent()
+        self.assertEqual(parents[-1].Name, "Base::BaseClass")
+
     def tearDown(self):
         #remove all
         TestPar = FreeCAD.ParamGet("System parameter:Test")
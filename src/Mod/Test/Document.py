@@ -490,6 +490,104 @@ class DocumentSaveRestoreCases(unittest.TestCase):
 
     FreeCAD.closeDocument("SaveRestoreExtensions")
 
+  def testListSaveRestore(self):
+    # the binary list properties are written as whole arrays
+    SaveName = self.TempPath + os.sep + "SaveRestoreLists.FCStd"
+    Doc = FreeCAD.newDocument("SaveRestoreLists")
+    obj = Doc.addObject("App::FeaturePython", "Lists")
+    obj.addProperty("App::PropertyFloatList", "Floats")
+    obj.addProperty("App::PropertyVectorList", "Vectors")
+    obj.addProperty("App::PropertyPlacementList", "Placements")
+    obj.addProperty("App::PropertyColorList", "Colors")
+    floats = [0.1 * i for i in range(10000)]
+    vectors = [FreeCAD.Vector(i, -0.5 * i, 0.25 * i) for i in range(10000)]
+    placements = [FreeCAD.Placement(FreeCAD.Vector(i, 2, 3), FreeCAD.Rotation(FreeCAD.Vector(0, 0, 1), i)) for i in range(100)]
+    colors = [(0.0, 0.2, 0.4, 0.0), (1.0, 0.6, 0.8, 0.0)] * 500
+    obj.Floats = floats
+    obj.Vectors = vectors
+    obj.Placements = placements
+    obj.Colors = colors
+
+    Doc.saveAs(SaveName)
+    FreeCAD.closeDocument("SaveRestoreLists")
+    Doc = FreeCAD.open(SaveName)
+    obj = Doc.Lists
+    self.assertListEqual(obj.Floats, floats)
+    self.assertListEqual(obj.Vectors, vectors)
+    self.assertEqual(len(obj.Placements), len(placements))
+    for i, j in zip(obj.Placements, placements):
+      self.assertEqual(i.Base, j.Base)
+      for a, b in zip(i.Rotation.Q, j.Rotation.Q):
+        self.assertAlmostEqual(a, b, 12)
+    self.assertEqual(len(obj.Colors), len(colors))
+    for i, j in zip(obj.Colors, colors):
+      for a, b in zip(i, j):
+        self.assertAlmostEqual(a, b, 2)
+    FreeCAD.closeDocument("SaveRestoreLists")
+
+  def testXMLParsers(self):
+    # both parsers must restore the same document
+    SaveName = self.TempPath + os.sep + "SaveRestoreParsers.FCStd"
+    Doc = FreeCAD.newDocument("SaveRestoreParsers")
+    text = "<a href=\"x\">'&amp;'\n\ttab\r\n\u00e4\u20ac\U0001f600</a>"
+    obj = Doc.addObject("App::FeatureTest", "Test")
+    obj.String = text
+    obj.Label = "Label & <Test>"
+    obj.StringList = [text, "", " spaces "]
+    obj.FloatList = [0.5, 1.5, 2.5]
+    grp = Doc.addObject("App::DocumentObjectGroup", "Group")
+    grp.addObject(obj)
+    Doc.saveAs(SaveName)
+    FreeCAD.closeDocument("SaveRestoreParsers")
+
+    parser = FreeCAD.getXMLParser()
+    try:
+      for name in ("Xerces", "Pull"):
+        FreeCAD.setXMLParser(name)
+        self.assertEqual(FreeCAD.getXMLParser(), name)
+        Doc = FreeCAD.open(SaveName)
+        obj = Doc.getObject("Test")
+        self.assertEqual(obj.String, text, name)
+        self.assertEqual(obj.Label, "Label & <Test>", name)
+        self.assertEqual(obj.StringList, [text, "", " spaces "], name)
+        self.assertEqual(obj.FloatList, [0.5, 1.5, 2.5], name)
+        self.assertEqual(Doc.getObject("Group").Group, [obj], name)
+        FreeCAD.closeDocument("SaveRestoreParsers")
+    finally:
+      FreeCAD.setXMLParser(parser)
+    self.assertRaises(ValueError, FreeCAD.setXMLParser, "Unknown")
+
+  def testFloatFormat(self):
+    # floats are written in the fixed format of older versions, the shortest
+    # form that reads back exactly is optional
+    SaveName = self.TempPath + os.sep + "SaveRestoreFloats.FCStd"
+    grp = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+    shortest = grp.GetBool("ShortestFloats", False)
+    try:
+      for on, value in ((True, 1e-20), (False, -2.25)):
+        grp.SetBool("ShortestFloats", on)
+        Doc = FreeCAD.newDocument("SaveRestoreFloats")
+        obj = Doc.addObject("App::FeatureTest", "Test")
+        obj.Float = value
+        obj.Vector = FreeCAD.Vector(1.0 / 3.0, -1e300, value)
+        obj.Integer = -2147483647
+        obj.IntegerList = [0, -1, 2147483647]
+        Doc.saveAs(SaveName)
+        FreeCAD.closeDocument("SaveRestoreFloats")
+
+        Doc = FreeCAD.open(SaveName)
+        obj = Doc.getObject("Test")
+        self.assertEqual(obj.Float, value)
+        self.assertEqual(obj.Vector.z, value)
+        if on:
+          self.assertEqual(obj.Vector.x, 1.0 / 3.0)
+          self.assertEqual(obj.Vector.y, -1e300)
+        self.assertEqual(obj.Integer, -2147483647)
+        self.assertEqual(obj.IntegerList, [0, -1, 2147483647])
+        FreeCAD.closeDocument("SaveRestoreFloats")
+    finally:
+      grp.SetBool("ShortestFloats", shortest)
+
   def testPersistenceContentDump(self):
     #test smallest level... property
     self.Doc.Label_1.Vector = (1,2,3)
@@ -532,6 +630,85 @@ class DocumentRecomputeCases(unittest.TestCase):
     self.L1.Link = self.L2
     self.L2.Link = self.L3
 
+  def testDependencyCache(self):
+    # the dependency order of a document recompute is cached until a link
+    # changes or an object is added or removed
+    class Observer():
+      def __init__(self):
+        self.names = []
+      def slotRecomputedObject(self, obj):
+        self.names.append(obj.Name)
+
+    def recompute():
+      for obj in self.Doc.Objects:
+        obj.enforceRecompute()
+      obs.names = []
+      self.Doc.recompute()
+      return obs.names
+
+    obs = Observer()
+    FreeCAD.addDocumentObserver(obs)
+    try:
+      self.L1.Link = self.L2
+      self.L2.Link = self.L3
+      self.assertEqual(recompute(), ["Label_3", "Label_2", "Label_1"])
+      self.assertEqual(recompute(), ["Label_3", "Label_2", "Label_1"])
+      self.assertTrue(self.L1.isValid())
+      self.assertEqual(len(self.L1.OutListRecursive), 2)
+      self.assertEqual(len(self.L3.InListRecursive), 2)
+
+      # reverse the chain
+      self.L1.Link = None
+      self.L2.Link = self.L1
+      self.L3.Link = self.L2
+      self.assertEqual(recompute(), ["Label_1", "Label_2", "Label_3"])
+
+      self.Doc.removeObject("Label_2")
+      self.assertEqual(recompute(), ["Label_1", "Label_3"])
+      L4 = self.Doc.addObject("App::FeatureTest","Label_4")
+      self.L1.LinkList = [L4]
+      self.assertEqual(recompute(), ["Label_4", "Label_1", "Label_3"])
+    finally:
+      FreeCAD.removeDocumentObserver(obs)
+
+  def testTracing(self):
+    # the recompute and the execution of every object are recorded as spans
+    import json
+    FreeCAD.clearTrace()
+    FreeCAD.setTracing(True)
+    try:
+      self.L1.Link = self.L2
+      self.L2.Link = self.L3
+      self.L1.enforceRecompute()
+      self.Doc.recompute()
+    finally:
+      FreeCAD.setTracing(False)
+    self.assertFalse(FreeCAD.getTracing())
+
+    events = FreeCAD.getTraceEvents()
+    if not events:
+      # built without tracing
+      return
+    names = [(cat, name, detail) for cat, name, detail, _, _, _ in events]
+    self.assertIn(("App", "recompute", "RecomputeTests"), names)
+    self.assertIn(("App", "execute", "Label_1"), names)
+    for _, _, _, thread, start, duration in events:
+      self.assertGreater(thread, 0)
+      self.assertGreaterEqual(start, 0.0)
+      self.assertGreaterEqual(duration, 0.0)
+
+    fileName = tempfile.gettempdir() + os.sep + "RecomputeTrace.json"
+    try:
+      self.assertEqual(FreeCAD.saveTrace(fileName), len(events))
+      with open(fileName) as f:
+        trace = json.load(f)
+      self.assertEqual(len(trace["traceEvents"]), len(events))
+      self.assertEqual(trace["traceEvents"][0]["ph"], "X")
+    finally:
+      os.remove(fileName)
+    FreeCAD.clearTrace()
+    self.assertEqual(FreeCAD.getTraceEvents(), [])
+
   def testRecompute(self):
 
     # sequence to test recompute behaviour
@@ -906,6 +1083,44 @@ class UndoRedoCases(unittest.TestCase):
     self.Doc.undo()
     self.failUnless(self.Doc.recompute() >= 0)
 
+  def testMemoryUsage(self):
+    import json
+    self.Doc.UndoMode = 1
+    usage = self.Doc.getMemoryUsage()
+    self.assertEqual(sorted(usage["Objects"].keys()), ["Base", "Del"])
+    self.assertEqual(usage["Total"], sum(usage["Objects"].values()) + usage["Properties"] + usage["UndoRedo"])
+    self.assertEqual(usage["UndoRedo"], 0)
+
+    # the transaction owns the removed object
+    self.Doc.openTransaction("Remove")
+    self.Doc.removeObject("Del")
+    self.Doc.commitTransaction()
+    usage = self.Doc.getMemoryUsage()
+    self.assertEqual(list(usage["Objects"].keys()), ["Base"])
+    self.assertGreater(usage["UndoRedo"], 0)
+
+    fileName = tempfile.gettempdir() + os.sep + "UndoTestMemory.jsonl"
+    if os.path.exists(fileName):
+      os.remove(fileName)
+    FreeCAD.setMemorySampling(0.000001, fileName)
+    try:
+      self.assertEqual(FreeCAD.getMemorySampling(), (0.000001, fileName))
+      self.Doc.openTransaction("Add")
+      self.Doc.addObject("App::FeatureTest","Add")
+      self.Doc.commitTransaction()
+      self.Doc.recompute()
+    finally:
+      FreeCAD.setMemorySampling(0)
+    self.assertIsNone(FreeCAD.getMemorySampling())
+
+    with open(fileName) as f:
+      samples = [json.loads(line) for line in f]
+    os.remove(fileName)
+    self.assertGreaterEqual(len(samples), 1)
+    docs = [d for d in samples[-1]["documents"] if d["name"] == "UndoTest"]
+    self.assertEqual(len(docs), 1)
+    self.assertEqual(docs[0]["total"], self.Doc.getMemoryUsage()["Total"])
+
   def tearDown(self):
     # closing doc
     FreeCAD.closeDocument("UndoTest")
@@ -0,0 +1,561 @@
+# -*- coding: utf-8 -*-
+
+#  Copyright (c) 2021 FreeCAD Developers
+#  LGPL
+
+# Headless benchmark suite with synthetic workloads that writes the timing
+# statistics and the peak memory of every workload to a JSON file, so the
+# results of different builds can be compared. Build the FreeCADBenchmarks
+# target or run it from FreeCADCmd:
+# import FreeCADBenchmarks
+# FreeCADBenchmarks.list_workloads()
+# FreeCADBenchmarks.run("/tmp/benchmarks.json")
+# FreeCADBenchmarks.run("/tmp/benchmarks.json", names="mesh|sketcher", repeat=10, scale=0.5)
+# FreeCADBenchmarks.run("/tmp/benchmarks.json", executable="/path/to/bin/FreeCADCmd")
+#
+# With an executable every workload runs in a process of its own, otherwise
+# the peak memory is the one of the whole session so far.
+
+import datetime
+import json
+import math
+import os
+import platform
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+import traceback
+import FreeCAD
+
+FORMAT_VERSION = 1
+
+# (name, description, function) of the registered workloads in the order they run
+WORKLOADS = []
+
+
+def workload(name, description):
+    """Registers a workload. The function gets the scale of the workload and
+    returns the function to time, a function to clean up and a dictionary of
+    parameters that describe the size of the workload."""
+    def register(func):
+        WORKLOADS.append((name, description, func))
+        return func
+    return register
+
+
+class Skipped(Exception):
+    """Raised by a workload if a module it needs isn't available"""
+    pass
+
+
+def require(name):
+    import importlib
+    try:
+        return importlib.import_module(name)
+    except ImportError as e:
+        raise Skipped("module {} is not available: {}".format(name, e))
+
+
+def peak_rss_kb():
+    """Returns the peak resident set size of the process in kB or None"""
+    try:
+        import resource
+        rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+        # bytes on macOS, kilobytes on Linux
+        return rss // 1024 if sys.platform == "darwin" else rss
+    except ImportError:
+        pass
+    if sys.platform == "win32":
+        import ctypes
+        from ctypes import wintypes
+
+        class PROCESS_MEMORY_COUNTERS(ctypes.Structure):
+            _fields_ = [("cb", wintypes.DWORD),
+                        ("PageFaultCount", wintypes.DWORD),
+                        ("PeakWorkingSetSize", ctypes.c_size_t),
+                        ("WorkingSetSize", ctypes.c_size_t),
+                        ("QuotaPeakPagedPoolUsage", ctypes.c_size_t),
+                        ("QuotaPagedPoolUsage", ctypes.c_size_t),
+                        ("QuotaPeakNonPagedPoolUsage", ctypes.c_size_t),
+                        ("QuotaNonPagedPoolUsage", ctypes.c_size_t),
+                        ("PagefileUsage", ctypes.c_size_t),
+                        ("PeakPagefileUsage", ctypes.c_size_t)]
+
+        counters = PROCESS_MEMORY_COUNTERS()
+        counters.cb = ctypes.sizeof(counters)
+        process = ctypes.windll.kernel32.GetCurrentProcess()
+        if ctypes.windll.psapi.GetProcessMemoryInfo(process, ctypes.byref(counters), counters.cb):
+            return counters.PeakWorkingSetSize // 1024
+    return None
+
+
+def scaled(count, scale, power=1.0):
+    # the size of a workload grows with count ** power
+    return max(1, int(round(count * scale ** (1.0 / power))))
+
+
+class TempDir:
+    def __init__(self):
+        self.path = tempfile.mkdtemp(prefix="FreeCADBenchmarks")
+
+    def file(self, name):
+        return os.path.join(self.path, name)
+
+    def remove(self):
+        shutil.rmtree(self.path, ignore_errors=True)
+
+
+# --------------------------------------------------------------------------
+# Workloads
+
+def mesh_import(scale, ext):
+    Mesh = require("Mesh")
+    # a sphere has about 2 * sampling * sampling facets
+    sampling = scaled(700, scale, 2.0)
+    tmp = TempDir()
+    path = tmp.file("sphere." + ext)
+    mesh = Mesh.createSphere(1.0, sampling)
+    facets = mesh.CountFacets
+    mesh.write(path)
+    del mesh
+
+    def run():
+        mesh = Mesh.Mesh(path)
+        if mesh.CountFacets != facets:
+            raise RuntimeError("{} of {} facets read".format(mesh.CountFacets, facets))
+
+    return run, tmp.remove, {"facets": facets, "bytes": os.path.getsize(path)}
+
+
+@workload("mesh.import_stl", "Reads a binary STL file of a sphere")
+def mesh_import_stl(scale):
+    return mesh_import(scale, "stl")
+
+
+@workload("mesh.import_obj", "Reads an OBJ file of a sphere")
+def mesh_import_obj(scale):
+    return mesh_import(scale, "obj")
+
+
+@workload("sketcher.solve", "Changes a dimension of a sketch of a row of rectangles "
+                            "that depend on each other and solves it")
+def sketcher_solve(scale):
+    Part = require("Part")
+    Sketcher = require("Sketcher")
+    count = scaled(100, scale)
+    doc = FreeCAD.newDocument("SketcherBenchmark")
+    sketch = doc.addObject("Sketcher::SketchObject", "Sketch")
+
+    geometry = []
+    constraints = []
+    for r in range(count):
+        i = 4 * r
+        x = 15.0 * r
+        y = 1.0 * r
+        # slightly off the solution
+        corners = [FreeCAD.Vector(x, y, 0), FreeCAD.Vector(x + 9, y + 0.5, 0),
+                   FreeCAD.Vector(x + 11, y + 6, 0), FreeCAD.Vector(x - 0.5, y + 4, 0)]
+        for j in range(4):
+            geometry.append(Part.LineSegment(corners[j], corners[(j + 1) % 4]))
+        constraints.append(Sketcher.Constraint("Coincident", i + 0, 2, i + 1, 1))
+        constraints.append(Sketcher.Constraint("Coincident", i + 1, 2, i + 2, 1))
+        constraints.append(Sketcher.Constraint("Coincident", i + 2, 2, i + 3, 1))
+        constraints.append(Sketcher.Constraint("Coincident", i + 3, 2, i + 0, 1))
+        constraints.append(Sketcher.Constraint("Horizontal", i + 0))
+        constraints.append(Sketcher.Constraint("Horizontal", i + 2))
+        constraints.append(Sketcher.Constraint("Vertical", i + 1))
+        constraints.append(Sketcher.Constraint("Vertical", i + 3))
+        if r == 0:
+            constraints.append(Sketcher.Constraint("Coincident", -1, 1, i, 1))
+            constraints.append(Sketcher.Constraint("DistanceX", i, 1, i, 2, 10.0))
+            constraints.append(Sketcher.Constraint("DistanceY", i + 1, 1, i + 1, 2, 5.0))
+        else:
+            # every rectangle has the size of the first one, a gap of 5 mm
+            # and a step of 1 mm
+            constraints.append(Sketcher.Constraint("Equal", i, i - 4))
+            constraints.append(Sketcher.Constraint("Equal", i + 1, i - 3))
+            constraints.append(Sketcher.Constraint("DistanceX", i - 4, 2, i, 1, 5.0))
+            constraints.append(Sketcher.Constraint("DistanceY", i - 4, 1, i, 1, 1.0))
+    sketch.addGeometry(geometry, False)
+    sketch.addConstraint(constraints)
+    # the width of the first rectangle
+    width = 9
+    doc.recompute()
+
+    values = [12.0, 10.0]
+    calls = [0]
+
+    def run():
+        calls[0] += 1
+        sketch.setDatum(width, FreeCAD.Units.Quantity(values[calls[0] % 2], FreeCAD.Units.Length))
+        if sketch.solve() != 0:
+            raise RuntimeError("sketch can't be solved")
+
+    def cleanup():
+        FreeCAD.closeDocument(doc.Name)
+
+    return run, cleanup, {"rectangles": count, "constraints": len(constraints)}
+
+
+@workload("partdesign.patterns", "Changes the feature of a linear and a polar pattern "
+                                 "and recomputes the body")
+def partdesign_patterns(scale):
+    require("PartDesign")
+    occurrences = scaled(20, scale)
+    doc = FreeCAD.newDocument("PartDesignBenchmark")
+    body = doc.addObject("PartDesign::Body", "Body")
+    box = doc.addObject("PartDesign::AdditiveBox", "Box")
+    body.addObject(box)
+    box.Length = 4.0
+    box.Width = 4.0
+    box.Height = 4.0
+    box.Placement.Base = FreeCAD.Vector(50, 0, 0)
+    doc.recompute()
+    linear = doc.addObject("PartDesign::LinearPattern", "LinearPattern")
+    linear.Originals = [box]
+    linear.Direction = (doc.Z_Axis, [""])
+    linear.Length = 10.0 * (occurrences - 1)
+    linear.Occurrences = occurrences
+    body.addObject(linear)
+    polar = doc.addObject("PartDesign::PolarPattern", "PolarPattern")
+    polar.Originals = [box]
+    polar.Axis = (doc.Z_Axis, [""])
+    polar.Angle = 360.0
+    polar.Occurrences = occurrences
+    body.addObject(polar)
+    doc.recompute()
+
+    values = [5.0, 4.0]
+    calls = [0]
+
+    def run():
+        calls[0] += 1
+        box.Length = values[calls[0] % 2]
+        doc.recompute()
+        if not polar.isValid():
+            raise RuntimeError("pattern failed")
+
+    def cleanup():
+        FreeCAD.closeDocument(doc.Name)
+
+    return run, cleanup, {"occurrences": occurrences}
+
+
+def make_part_document(scale):
+    require("Part")
+    count = scaled(200, scale)
+    doc = FreeCAD.newDocument("DocumentBenchmark")
+    for i in range(count):
+        box = doc.addObject("Part::Box", "Box")
+        box.Placement.Base = FreeCAD.Vector(20 * i, 0, 0)
+        cylinder = doc.addObject("Part::Cylinder", "Cylinder")
+        cylinder.Radius = 3.0
+        cylinder.Placement.Base = FreeCAD.Vector(20 * i + 5, 5, 0)
+        cut = doc.addObject("Part::Cut", "Cut")
+        cut.Base = box
+        cut.Tool = cylinder
+    doc.recompute()
+    return doc, count
+
+
+@workload("document.save", "Saves a document of Part features")
+def document_save(scale):
+    doc, count = make_part_document(scale)
+    tmp = TempDir()
+    path = tmp.file("DocumentBenchmark.FCStd")
+    doc.saveAs(path)
+
+    def cleanup():
+        FreeCAD.closeDocument(doc.Name)
+        tmp.remove()
+
+    return doc.save, cleanup, {"objects": len(doc.Objects), "bytes": os.path.getsize(path)}
+
+
+@workload("document.restore", "Opens and closes a document of Part features")
+def document_restore(scale):
+    doc, count = make_part_document(scale)
+    objects = len(doc.Objects)
+    tmp = TempDir()
+    path = tmp.file("DocumentBenchmark.FCStd")
+    doc.saveAs(path)
+    FreeCAD.closeDocument(doc.Name)
+
+    def run():
+        doc = FreeCAD.openDocument(path, True)
+        name = doc.Name
+        count = len(doc.Objects)
+        FreeCAD.closeDocument(name)
+        if count != objects:
+            raise RuntimeError("{} of {} objects restored".format(count, objects))
+
+    return run, tmp.remove, {"objects": objects, "bytes": os.path.getsize(path)}
+
+
+@workload("spreadsheet.recompute", "Changes the first cell of a sheet with chained "
+                                   "expressions and recomputes it")
+def spreadsheet_recompute(scale):
+    require("Spreadsheet")
+    rows = scaled(1000, scale)
+    doc = FreeCAD.newDocument("SpreadsheetBenchmark")
+    sheet = doc.addObject("Spreadsheet::Sheet", "Spreadsheet")
+    for i in range(1, rows + 1):
+        sheet.set("A{}".format(i), "{}".format(i))
+        if i == 1:
+            sheet.set("B1", "=A1 * 2")
+        else:
+            sheet.set("B{}".format(i), "=B{} + A{} * 2".format(i - 1, i))
+        sheet.set("C{}".format(i), "=sin(A{0}) * cos(B{0}) + sqrt(abs(B{0})) / (A{0} + 1)".format(i))
+        sheet.set("D{}".format(i), "=C{0} > 0 ? C{0} : -C{0}".format(i))
+    sheet.set("E1", "=sum(D1:D{})".format(rows))
+    doc.recompute()
+
+    values = [2, 1]
+    calls = [0]
+
+    def run():
+        calls[0] += 1
+        sheet.set("A1", "{}".format(values[calls[0] % 2]))
+        doc.recompute()
+        expected = rows * (rows + 1) + 2 * (values[calls[0] % 2] - 1)
+        if abs(sheet.get("B{}".format(rows)) - expected) > 1e-6:
+            raise RuntimeError("wrong result")
+
+    def cleanup():
+        FreeCAD.closeDocument(doc.Name)
+
+    return run, cleanup, {"rows": rows, "cells": 4 * rows + 1}
+
+
+@workload("path.gcode", "Parses G-code into a path")
+def path_gcode(scale):
+    Path = require("Path")
+    count = scaled(100000, scale)
+    lines = ["G90", "G21", "G0 X0.000 Y0.000 Z5.000"]
+    for i in range(count):
+        angle = 0.01 * i
+        radius = 10.0 + 0.001 * i
+        x = radius * math.cos(angle)
+        y = radius * math.sin(angle)
+        if i % 10 == 9:
+            lines.append("G2 X{:.3f} Y{:.3f} I{:.3f} J{:.3f} F600".format(x, y, -0.5 * x, -0.5 * y))
+        else:
+            lines.append("G1 X{:.3f} Y{:.3f} Z{:.3f} F1200".format(x, y, -0.001 * (i % 1000)))
+    gcode = "\n".join(lines)
+
+    def run():
+        path = Path.Path()
+        path.setFromGCode(gcode)
+        if path.Size != len(lines):
+            raise RuntimeError("{} of {} commands parsed".format(path.Size, len(lines)))
+
+    return run, None, {"commands": len(lines), "bytes": len(gcode)}
+
+
+def fem_import(scale, ext):
+    Fem = require("Fem")
+    bm = require("femtest.app.benchmark_mesh")
+    # cells ** 3 hexahedra, each split into six tetras
+    cells = scaled(25, scale, 3.0)
+    mesh = bm.make_tetra_grid(cells)
+    volumes = mesh.VolumeCount
+    tmp = TempDir()
+    path = tmp.file("grid." + ext)
+    if ext == "inp":
+        mesh.writeABAQUS(path, 1, False)
+    else:
+        mesh.write(path)
+    del mesh
+
+    def run():
+        mesh = Fem.FemMesh()
+        mesh.read(path)
+        if mesh.VolumeCount != volumes:
+            raise RuntimeError("{} of {} volumes read".format(mesh.VolumeCount, volumes))
+
+    return run, tmp.remove, {"volumes": volumes, "bytes": os.path.getsize(path)}
+
+
+@workload("fem.import_inp", "Reads an Abaqus file of a tetrahedral mesh")
+def fem_import_inp(scale):
+    return fem_import(scale, "inp")
+
+
+@workload("fem.import_z88", "Reads a Z88 file of a tetrahedral mesh")
+def fem_import_z88(scale):
+    return fem_import(scale, "z88")
+
+
+def script(module, func, **kwargs):
+    # times a function of one of the benchmark scripts of the modules
+    def create(scale):
+        mod = require(module)
+        sizes = {k: scaled(v[0], scale, v[1]) if isinstance(v, tuple) else v
+                 for k, v in kwargs.items()}
+        function = getattr(mod, func)
+        return lambda: function(**sizes), None, sizes
+    return create
+
+
+for module, function, kwargs in (
+    ("BaseBenchmark", "run_writer", {"count": (10000, 1.0), "repeat": 1}),
+    ("BaseBenchmark", "run_xml_reader", {"count": (10000, 1.0), "repeat": 1}),
+    ("BaseBenchmark", "run_dependencies", {"count": (20000, 1.0), "repeat": 1}),
+    ("MeshBenchmark", "run_curvature", {"sampling": (300, 2.0), "repeat": 1}),
+    ("MeshBenchmark", "run_self_intersection", {"sampling": (100, 2.0), "repeat": 1}),
+    ("PointsBenchmark", "run_nearest", {"count": (200000, 1.0), "queries": (20000, 1.0), "repeat": 1}),
+    ("femtest.app.benchmark_mesh", "run_surface_extraction", {"cells": (20, 3.0), "repeat": 1}),
+):
+    workload("script.{}.{}".format(module.split(".")[-1], function),
+             "Runs {}.{}".format(module, function))(script(module, function, **kwargs))
+
+
+# --------------------------------------------------------------------------
+# Driver
+
+def list_workloads():
+    for name, description, func in WORKLOADS:
+        print("{:44} {}".format(name, description))
+
+
+def select(names):
+    if not names:
+        return list(WORKLOADS)
+    pattern = re.compile(names)
+    return [w for w in WORKLOADS if pattern.search(w[0])]
+
+
+def run_workload(name, repeat=5, warmup=1, scale=1.0):
+    """Runs a workload in this process and returns its result"""
+    entry = [w for w in WORKLOADS if w[0] == name]
+    if not entry:
+        raise ValueError("unknown workload: {}".format(name))
+    name, description, create = entry[0]
+    result = {"name": name, "description": description, "status": "ok"}
+    print("{}:".format(name))
+    cleanup = None
+    try:
+        start = time.perf_counter()
+        func, cleanup, params = create(scale)
+        result["setup"] = time.perf_counter() - start
+        result["params"] = params
+        result["setup_peak_rss_kb"] = peak_rss_kb()
+        for r in range(warmup):
+            func()
+        times = []
+        for r in range(repeat):
+            start = time.perf_counter()
+            func()
+            times.append(time.perf_counter() - start)
+        result["times"] = times
+        result["min"] = min(times)
+        result["max"] = max(times)
+        result["mean"] = statistics.mean(times)
+        result["median"] = statistics.median(times)
+        result["stdev"] = statistics.stdev(times) if len(times) > 1 else 0.0
+        print("  {}: median of {}: {:.3f} s, min {:.3f} s, stdev {:.3f} s".format(
+            name, repeat, result["median"], result["min"], result["stdev"]))
+    except Skipped as e:
+        result["status"] = "skipped"
+        result["message"] = str(e)
+        print("  skipped: {}".format(e))
+    except Exception as e:
+        result["status"] = "failed"
+        result["message"] = "{}: {}".format(type(e).__name__, e)
+        traceback.print_exc()
+    finally:
+        if cleanup:
+            try:
+                cleanup()
+            except Exception:
+                traceback.print_exc()
+    result["peak_rss_kb"] = peak_rss_kb()
+    return result
+
+
+def run_child(name, output, repeat, warmup, scale):
+    # the entry point of a workload in a process of its own
+    result = run_workload(name, repeat, warmup, scale)
+    with open(output, "w") as f:
+        json.dump(result, f)
+
+
+def run_isolated(executable, name, repeat, warmup, scale, tmp):
+    output = tmp.file("result.json")
+    if os.path.exists(output):
+        os.remove(output)
+    code = "import FreeCADBenchmarks; FreeCADBenchmarks.run_child({!r}, {!r}, {!r}, {!r}, {!r})".format(
+        name, output, repeat, warmup, scale)
+    # separate parameter files so that the settings of the user don't matter
+    args = [executable, "--user-cfg", tmp.file("user.cfg"),
+            "--system-cfg", tmp.file("system.cfg"), "-c", code]
+    status = subprocess.call(args)
+    if os.path.exists(output):
+        with open(output) as f:
+            return json.load(f)
+    return {"name": name, "status": "failed",
+            "message": "process exited with status {}".format(status)}
+
+
+def run(output, names=None, repeat=5, warmup=1, scale=1.0, executable=None):
+    """Runs the workloads whose names match the regular expression names and
+    writes the results to the JSON file output. Returns the results."""
+    version = FreeCAD.Version()
+    results = {
+        "format": FORMAT_VERSION,
+        "version": ".".join(version[0:3]),
+        "revision": version[3] if len(version) > 3 else "",
+        "date": datetime.datetime.utcnow().isoformat(timespec="seconds") + "Z",
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+        "processor": platform.processor(),
+        "cpu_count": os.cpu_count(),
+        "python": platform.python_version(),
+        "repeat": repeat,
+        "warmup": warmup,
+        "scale": scale,
+        "isolated": bool(executable),
+        "benchmarks": [],
+    }
+
+    tmp = TempDir()
+    try:
+        for name, description, func in select(names):
+            if executable:
+                result = run_isolated(executable, name, repeat, warmup, scale, tmp)
+            else:
+                result = run_workload(name, repeat, warmup, scale)
+            results["benchmarks"].append(result)
+    finally:
+        tmp.remove()
+
+    with open(output, "w") as f:
+        json.dump(results, f, indent=2)
+        f.write("\n")
+
+    failed = [r["name"] for r in results["benchmarks"] if r["status"] == "failed"]
+    print("{} workloads, {} failed, results written to {}".format(
+        len(results["benchmarks"]), len(failed), output))
+    for name in failed:
+        print("  failed: {}".format(name))
+    return results
+
+
+def main():
+    """Runs the suite with the settings of the environment variables
+    FC_BENCHMARK_OUTPUT, FC_BENCHMARK_FILTER, FC_BENCHMARK_REPEAT,
+    FC_BENCHMARK_WARMUP, FC_BENCHMARK_SCALE and FC_BENCHMARK_EXECUTABLE
+    and exits with a non-zero status if a workload failed."""
+    env = os.environ
+    results = run(env.get("FC_BENCHMARK_OUTPUT") or "FreeCADBenchmarks.json",
+                  names=env.get("FC_BENCHMARK_FILTER") or None,
+                  repeat=int(env.get("FC_BENCHMARK_REPEAT") or 5),
+                  warmup=int(env.get("FC_BENCHMARK_WARMUP") or 1),
+                  scale=float(env.get("FC_BENCHMARK_SCALE") or 1.0),
+                  executable=env.get("FC_BENCHMARK_EXECUTABLE") or None)
+    failed = any(r["status"] == "failed" for r in results["benchmarks"])
+    sys.exit(1 if failed else 0)
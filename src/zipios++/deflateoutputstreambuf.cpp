@@ -19,9 +19,9 @@ DeflateOutputStreambuf::DeflateOutputStreambuf( streambuf *outbuf, bool user_ini
 						bool del_outbuf ) 
   : FilterOutputStreambuf( outbuf, del_outbuf ),
     _zs_initialized ( false            ),
-    _invecsize      ( 1000             ),
+    _invecsize      ( 65536            ),
     _invec          ( _invecsize       ),
-    _outvecsize     ( 1000             ),
+    _outvecsize     ( 65536            ),
     _outvec         ( _outvecsize      )
 {
   // NOTICE: It is important that this constructor and the methods it